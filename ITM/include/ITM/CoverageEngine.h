@@ -0,0 +1,70 @@
+#ifndef ITM_COVERAGE_ENGINE_H
+#define ITM_COVERAGE_ENGINE_H
+
+#include <ITM/Enums.h>
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/WorkStealingThreadPool.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Evaluates ITM point-to-point loss over a coverage area (grid cells or radials around one transmitter)
+    /// on all cores, writing each result straight into a caller-owned raster.
+    /// The transmitter, frequency, climate etc. come from one configured ItmCommonCalculator, which all worker threads
+    /// share through its const evaluation path, each with its own ItmWorkspace.
+    /// An engine runs one coverage job at a time (its workspaces are reused from one job to the next): jobs started from
+    /// several threads at once are run one after another by its thread pool
+    class CoverageEngine {
+    public:
+        /// @brief Start the worker threads
+        /// @param numThreads Number of worker threads (0 = one per hardware thread)
+        explicit CoverageEngine(const std::size_t numThreads = 0);
+
+        std::size_t getNumThreads() const {
+            return m_threadPool.getNumThreads();
+        }
+
+        /// @brief Evaluate one path per grid cell, each with its own terrain profile from the Tx to the cell
+        /// @param calculator Calculator holding the Tx, Rx & environment parameters shared by every path
+        /// @param terrainHeightBuffer_m Terrain heights of every profile, stored back-to-back (meters)
+        /// @param profileOffsetList Start index of each profile within terrainHeightBuffer_m, followed by one final
+        ///         entry marking the end of the last profile (size = number of cells + 1)
+        /// @param terrainSampleResolutionList_m Sample resolution of each profile (meters)
+        /// @param rasterIndList Raster index receiving the result of each cell (empty = cell i is written to raster index i)
+        /// @param attenRaster_dB Caller-owned output raster receiving the ITM basic transmission loss of each cell (dB)
+        /// @param propModeRaster Caller-owned output raster receiving the mode of propagation of each cell (may be empty)
+        void calcCellLoss_dB(const ItmCommonCalculator& calculator, std::span<const double> terrainHeightBuffer_m,
+                    std::span<const std::size_t> profileOffsetList, std::span<const double> terrainSampleResolutionList_m,
+                    std::span<const std::size_t> rasterIndList, std::span<double> attenRaster_dB,
+                    std::span<PropagationMode> propModeRaster = {});
+
+        /// @brief Evaluate every receiver position along each radial leaving the Tx (see ItmCommonCalculator::calcItmLoss_P2P_radial_dB()).
+        /// The raster holds one row per radial: the receiver at point rxInd of radial radialInd is written to
+        /// raster index radialInd * rasterRowStride + (rxInd - firstRxInd). Raster entries past the end of a shorter radial are left as they were
+        /// @param calculator Calculator holding the Tx, Rx & environment parameters shared by every path
+        /// @param radialHeightBuffer_m Terrain heights of every radial, each starting at the Tx, stored back-to-back (meters)
+        /// @param radialOffsetList Start index of each radial within radialHeightBuffer_m, followed by one final
+        ///         entry marking the end of the last radial (size = number of radials + 1)
+        /// @param terrainSampleResolutionList_m Sample resolution of each radial (meters)
+        /// @param firstRxInd Index of the first receiver position to evaluate on each radial (must be >= 1)
+        /// @param rasterRowStride Distance between the starts of two successive raster rows (number of entries)
+        /// @param attenRaster_dB Caller-owned output raster receiving the ITM basic transmission loss at each receiver position (dB)
+        /// @param propModeRaster Caller-owned output raster receiving the mode of propagation at each receiver position (may be empty)
+        void calcRadialLoss_dB(const ItmCommonCalculator& calculator, std::span<const double> radialHeightBuffer_m,
+                    std::span<const std::size_t> radialOffsetList, std::span<const double> terrainSampleResolutionList_m,
+                    const std::size_t firstRxInd, const std::size_t rasterRowStride, std::span<double> attenRaster_dB,
+                    std::span<PropagationMode> propModeRaster = {});
+
+    private:
+        WorkStealingThreadPool m_threadPool;
+
+        // Per worker thread state, indexed by thread index
+        std::vector<ItmWorkspace> m_workspaceList;
+        std::vector<std::vector<PropagationMode>> m_discardedPropModeListList;    // Stand-in output when no mode raster is given
+    };
+} // end namespace
+
+#endif // ITM_COVERAGE_ENGINE_H
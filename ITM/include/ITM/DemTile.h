@@ -0,0 +1,116 @@
+#ifndef ITM_DEM_TILE_H
+#define ITM_DEM_TILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Accuracy of one level of a tile's terrain pyramid (see DemTile)
+    struct DemLevelAccuracy {
+        double m_sampleSpacing_deg;     // Spacing between the samples of the level (degrees)
+        double m_maxOverstatement_m;    // Bound on how far the level's heights may lie above the full resolution terrain, outside its voids (meters)
+    };
+
+    /// @brief One SRTM height tile (.hgt), memory-mapped read-only.
+    /// A tile covers 1 x 1 degree, named after its south-west corner (e.g. N37W122.hgt), and holds a square grid
+    /// of big-endian signed 16-bit heights in meters: 1201 x 1201 samples (3 arc-second) or 3601 x 3601 (1 arc-second).
+    /// Row 0 is the northern edge and column 0 the western edge; edge rows & columns are shared with the neighbouring tiles.
+    /// Nothing is copied out of the file, so only the pages a profile actually crosses are ever read from disk.
+    ///
+    /// Long paths don't need every sample, so the tile also keeps a pyramid of coarser levels, each built the first time it is read.
+    /// Level k keeps every 2^k-th sample, and each of its samples is the highest full resolution sample within one coarse sample
+    /// of it. Every point of a coarse cell is then covered by all four of its corners, so heights interpolated on a coarse level
+    /// never lie below those of the full resolution terrain: obstructions (and so horizons) are kept, at the cost of a bounded
+    /// overstatement recorded with the level (see getLevelAccuracy()). Both hold wherever the full resolution terrain has data;
+    /// where all four samples around a point are void, full resolution reads sea level, while a coarse level fills the void
+    /// in from the samples around it
+    class DemTile {
+    public:
+        /// @brief Map a tile into memory
+        /// @param filePath Path of the .hgt file
+        /// @param southLat_deg Latitude of the south-west corner of the tile (degrees)
+        /// @param westLon_deg Longitude of the south-west corner of the tile (degrees)
+        DemTile(const std::string& filePath, const int southLat_deg, const int westLon_deg);
+        ~DemTile();
+
+        DemTile(const DemTile&) = delete;
+        DemTile& operator=(const DemTile&) = delete;
+
+        int getSouthLat_deg() const {
+            return m_southLat_deg;
+        }
+
+        int getWestLon_deg() const {
+            return m_westLon_deg;
+        }
+
+        std::size_t getNumSamplesPerSide() const {
+            return m_numSamplesPerSide;
+        }
+
+        /// @return Size of the mapping (bytes)
+        std::size_t getSizeBytes() const {
+            return m_sizeBytes;
+        }
+
+        /// @brief Height of one grid sample
+        /// @param rowInd Row of the sample (0 = northern edge)
+        /// @param colInd Column of the sample (0 = western edge)
+        /// @return Height (meters), or kVoidHeight for samples the survey has no data for
+        std::int16_t getSample_m(const std::size_t rowInd, const std::size_t colInd) const {
+            const unsigned char* sample = m_data + 2u * (rowInd * m_numSamplesPerSide + colInd);
+            return static_cast<std::int16_t>((static_cast<std::uint16_t>(sample[0]) << 8) | static_cast<std::uint16_t>(sample[1]));
+        }
+
+        /// @brief Bilinear interpolation between the four samples surrounding a point of the tile.
+        /// Void samples are left out (the remaining weights are renormalized), and a point whose weight falls on voids only is at sea level
+        /// @param lat_deg Latitude of the point, within [southLat_deg, southLat_deg + 1] (degrees)
+        /// @param lon_deg Longitude of the point, within [westLon_deg, westLon_deg + 1] (degrees)
+        /// @param levelInd Pyramid level to read (0 = full resolution, up to kNumLevels - 1)
+        /// @return Terrain height (meters)
+        double calcHeight_m(const double& lat_deg, const double& lon_deg, const std::size_t levelInd = 0u) const;
+
+        /// @param levelInd Pyramid level (0 = full resolution, up to kNumLevels - 1)
+        /// @return Sample spacing & overstatement bound of the level (building the level if needed)
+        DemLevelAccuracy getLevelAccuracy(const std::size_t levelInd) const;
+
+        /// @brief Number of pyramid levels, including full resolution (1200 & 3600 are both multiples of 2^4)
+        static constexpr std::size_t kNumLevels = 5u;
+
+        /// @brief Ask the OS to start reading the whole tile in, without waiting for it (meant for prefetching)
+        void adviseWillNeed() const;
+
+        /// @brief Height value marking a void sample
+        static constexpr std::int16_t kVoidHeight = -32768;
+
+    private:
+        /// @brief Heights of one coarse level, in native byte order (kVoidHeight where the whole window is void)
+        struct Level {
+            std::vector<std::int16_t> m_heightList_m;
+            std::size_t m_numSamplesPerSide = 0u;
+            double m_maxOverstatement_m = 0.0;
+        };
+
+        const Level& getLevel(const std::size_t levelInd) const;
+        void buildLevel(const std::size_t levelInd, Level& level) const;
+
+        int m_southLat_deg;
+        int m_westLon_deg;
+        std::size_t m_numSamplesPerSide;
+        std::size_t m_sizeBytes;
+        const unsigned char* m_data;
+
+        mutable std::array<std::once_flag, kNumLevels> m_levelOnceFlagList;
+        mutable std::array<Level, kNumLevels> m_levelList;      // Entry 0 is unused (full resolution is read from the mapping)
+#ifdef _WIN32
+        void* m_fileHandle;
+        void* m_mappingHandle;
+#endif
+    };
+} // end namespace
+
+#endif // ITM_DEM_TILE_H
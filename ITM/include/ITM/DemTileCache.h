@@ -0,0 +1,100 @@
+#ifndef ITM_DEM_TILE_CACHE_H
+#define ITM_DEM_TILE_CACHE_H
+
+#include <ITM/DemTile.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+namespace NTIA::ITM {
+    /// @brief Counters of a DemTileCache, as of the time they were read
+    struct DemTileCacheStats {
+        std::uint64_t m_numHits;            // Requests answered by a tile already mapped (including tiles mapped by a prefetch)
+        std::uint64_t m_numMisses;          // Requests which had to map their tile (or look for its file) themselves
+        std::uint64_t m_numPrefetched;      // Tiles mapped by the prefetch thread
+        std::uint64_t m_numEvictions;       // Tiles dropped to stay within the budget
+        std::size_t m_numCachedTiles;       // Tiles mapped right now
+        std::size_t m_cachedBytes;          // Bytes of the tiles mapped right now
+    };
+
+    /// @brief Bounded cache of the SRTM tiles (see DemTile) of one directory, with least-recently-used eviction and a prefetch thread.
+    /// The mapped tiles are kept within a byte budget, so their share of the address space and page cache stays fixed however
+    /// much ground is covered. Prefetching maps upcoming tiles and asks the OS to start reading them, on a thread of its own,
+    /// so that disk reads overlap the ITM runs of the profiles before them.
+    /// The budget counts the mappings only: pyramid levels built on a tile (see DemTile) add up to a third of its size on the heap.
+    /// Tiles still held by a caller when evicted stay mapped until it lets go of them. All functions may be called concurrently
+    class DemTileCache {
+    public:
+        /// @param directoryPath Directory holding the .hgt files
+        /// @param budget_bytes Largest total size of the mapped tiles (at least one tile is always kept, whatever its size)
+        DemTileCache(std::string directoryPath, const std::size_t budget_bytes);
+        ~DemTileCache();
+
+        DemTileCache(const DemTileCache&) = delete;
+        DemTileCache& operator=(const DemTileCache&) = delete;
+
+        /// @brief Tile covering [southLat_deg, southLat_deg + 1] x [westLon_deg, westLon_deg + 1], mapping it if needed
+        /// @param southLat_deg Latitude of the south-west corner of the tile (degrees)
+        /// @param westLon_deg Longitude of the south-west corner of the tile (degrees)
+        /// @return The tile, or nullptr if the directory has no file for it
+        std::shared_ptr<const DemTile> getTile(const int southLat_deg, const int westLon_deg);
+
+        /// @brief Queue a tile for the prefetch thread (does nothing if it is already mapped, queued, or known to be missing)
+        /// @param southLat_deg Latitude of the south-west corner of the tile (degrees)
+        /// @param westLon_deg Longitude of the south-west corner of the tile (degrees)
+        void prefetchTile(const int southLat_deg, const int westLon_deg);
+
+        DemTileCacheStats getStats() const;
+
+        const std::string& getDirectoryPath() const {
+            return m_directoryPath;
+        }
+
+    private:
+        using TileCorner = std::pair<int, int>;    // South-west corner of a tile (latitude, longitude)
+
+        struct CacheEntry {
+            TileCorner m_corner;
+            std::shared_ptr<const DemTile> m_tile;
+        };
+
+        /// @brief Find a tile in the cache, mapping its file on a miss (m_cacheMutex must be held)
+        /// @param isCached Set to whether the tile (or the absence of its file) was already known
+        std::shared_ptr<const DemTile> findOrLoadTile(const TileCorner& corner, bool& isCached);
+        void runPrefetchThread();
+
+        std::string m_directoryPath;
+        std::size_t m_budget_bytes;
+
+        mutable std::mutex m_cacheMutex;
+        std::list<CacheEntry> m_lruList;                                    // Most recently used first
+        std::map<TileCorner, std::list<CacheEntry>::iterator> m_entryMap;
+        std::set<TileCorner> m_missingTileSet;                              // Tiles with no file in the directory
+        std::size_t m_cachedBytes;
+
+        std::atomic<std::uint64_t> m_numHits;
+        std::atomic<std::uint64_t> m_numMisses;
+        std::atomic<std::uint64_t> m_numPrefetched;
+        std::atomic<std::uint64_t> m_numEvictions;
+
+        std::mutex m_prefetchMutex;
+        std::condition_variable m_prefetchCondition;
+        std::deque<TileCorner> m_prefetchQueue;
+        std::set<TileCorner> m_queuedTileSet;
+        bool m_isStopping;
+        std::thread m_prefetchThread;
+    };
+} // end namespace
+
+#endif // ITM_DEM_TILE_CACHE_H
@@ -0,0 +1,103 @@
+#ifndef ITM_DEM_TILE_STORE_H
+#define ITM_DEM_TILE_STORE_H
+
+#include <ITM/DemTile.h>
+#include <ITM/DemTileCache.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Point on the earth's surface
+    struct GeoPoint {
+        double m_lat_deg;       // Latitude, positive north (degrees)
+        double m_lon_deg;       // Longitude, positive east (degrees)
+    };
+
+    /// @brief How a profile was sampled by DemTileStore::extractProfile()
+    struct DemProfileInfo {
+        double m_sampleResolution_m;        // Distance between successive samples (meters)
+        std::size_t m_maxLevelInd;          // Coarsest pyramid level read from any tile along the path (0 = full resolution)
+        double m_maxOverstatement_m;        // Most any sample may exceed the full resolution terrain under it (meters)
+    };
+
+    /// @brief Local directory of SRTM height tiles (see DemTile), from which terrain profiles are extracted for point-to-point ITM.
+    /// Tiles are mapped the first time a profile crosses them and kept in a bounded cache (see DemTileCache), and areas with
+    /// no tile file (such as the open sea, which SRTM leaves out) are taken to be at sea level.
+    /// All functions may be called concurrently
+    class DemTileStore {
+    public:
+        /// @brief Default budget of the tile cache: 20 one arc-second tiles, or about 180 three arc-second ones
+        static constexpr std::size_t kDefaultCacheBudget_bytes = std::size_t{512u} << 20u;
+
+        /// @param directoryPath Directory holding the .hgt files
+        /// @param cacheBudget_bytes Largest total size of the tiles kept mapped
+        explicit DemTileStore(std::string directoryPath, const std::size_t cacheBudget_bytes = kDefaultCacheBudget_bytes);
+
+        /// @brief Tile covering [southLat_deg, southLat_deg + 1] x [westLon_deg, westLon_deg + 1], mapping it if needed
+        /// @param southLat_deg Latitude of the south-west corner of the tile (degrees)
+        /// @param westLon_deg Longitude of the south-west corner of the tile (degrees)
+        /// @return The tile, or nullptr if the directory has no file for it
+        std::shared_ptr<const DemTile> getTile(const int southLat_deg, const int westLon_deg);
+
+        /// @brief Terrain height at one point, interpolated bilinearly between the surrounding samples
+        /// @param point Point to sample
+        /// @return Terrain height (meters)
+        double calcHeight_m(const GeoPoint& point);
+
+        /// @brief Sample the terrain along the great circle between two points, at equal steps no longer than the given resolution.
+        /// The result feeds ItmCommonCalculator::calcItmLoss_P2P_dB() directly
+        /// @param txPoint Location of the Tx (first point of the profile)
+        /// @param rxPoint Location of the Rx (last point of the profile)
+        /// @param maxSampleResolution_m Largest distance allowed between successive samples (meters)
+        /// @param terrainHeightList_m Output terrain heights along the path, Tx --> Rx (at least 2 points; resized as needed,
+        ///         so a vector reused between calls stops allocating once it is large enough)
+        /// @return Actual distance between successive samples (meters)
+        double extractProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& maxSampleResolution_m,
+                    std::vector<double>& terrainHeightList_m);
+
+        /// @brief Sample the terrain along the great circle between two points with a cap on the number of points, for long paths
+        /// where the full resolution would give far more points than the ITM run can use. When the cap forces samples further
+        /// apart than the tiles' own spacing, they are read from the coarsest pyramid level (see DemTile) whose spacing is still
+        /// within the distance between them, so that peaks between samples still show up as obstacles
+        /// @param txPoint Location of the Tx (first point of the profile)
+        /// @param rxPoint Location of the Rx (last point of the profile)
+        /// @param maxSampleResolution_m Largest distance allowed between successive samples, if the cap allows it (meters)
+        /// @param maxNumPoints Largest number of points in the profile (at least 2)
+        /// @param terrainHeightList_m Output terrain heights along the path, Tx --> Rx (resized as needed)
+        /// @return Actual distance between samples, the pyramid level used & its accuracy bound
+        DemProfileInfo extractProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& maxSampleResolution_m,
+                    const std::size_t maxNumPoints, std::vector<double>& terrainHeightList_m);
+
+        /// @brief Queue the tiles crossed by the great circle between two points for the cache's prefetch thread, so that they
+        /// are read in while earlier profiles are extracted & evaluated (e.g. the next few radials of a coverage run).
+        /// Returns straight away; prefetch no more ground ahead than the cache budget holds, or prefetched tiles evict each other
+        /// @param txPoint Location of the Tx
+        /// @param rxPoint Location of the Rx
+        void prefetchProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint);
+
+        /// @return Hit, miss, prefetch & eviction counters of the tile cache
+        DemTileCacheStats getCacheStats() const {
+            return m_tileCache.getStats();
+        }
+
+        /// @brief Great circle distance between two points, on a sphere of the mean earth radius
+        /// @return Distance (meters)
+        static double calcGreatCircleDist_m(const GeoPoint& startPoint, const GeoPoint& endPoint);
+
+        /// @return File name of the tile with the given south-west corner (e.g. N37W122.hgt)
+        static std::string makeTileFileName(const int southLat_deg, const int westLon_deg);
+
+    private:
+        /// @brief Sample the terrain at equal steps along the great circle between two points
+        /// @param maxLevelSpacing_m Largest sample spacing of the pyramid level to read from each tile (meters; 0 reads full resolution)
+        DemProfileInfo sampleProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& pathDist_m,
+                    const std::size_t numPointsMinusTx, const double& maxLevelSpacing_m, std::vector<double>& terrainHeightList_m);
+
+        DemTileCache m_tileCache;
+    };
+} // end namespace
+
+#endif // ITM_DEM_TILE_STORE_H
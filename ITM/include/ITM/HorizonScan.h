@@ -0,0 +1,62 @@
+#ifndef ITM_HORIZON_SCAN_H
+#define ITM_HORIZON_SCAN_H
+
+#include <cstddef>
+#include <span>
+
+namespace NTIA::ITM::HorizonScan {
+    /// @brief Instruction set used by findHorizonPoint(), picked once at runtime from the features of the CPU
+    enum KernelType {
+        Scalar,
+        Avx2,
+        Avx512
+    };
+
+    /// @brief Best horizon candidate among the interior points of a path
+    struct HorizonCandidate {
+        std::size_t m_pointInd;     // Index of the point with the largest angle (0 if the path has no interior points)
+        double m_angle_rad;         // Horizon angle to that point
+    };
+
+    /// @return Kernel selected for this CPU
+    KernelType getKernelType();
+
+    /// @param kernelType Kernel to check
+    /// @return Whether this build & CPU can run the given kernel (Scalar always can)
+    bool isKernelSupported(const KernelType& kernelType);
+
+    /// @brief Fill the distance of every point from the Tx, accumulated one sample at a time exactly as the scalar scan does
+    /// @param distList_m Output distances, one entry per point of the path not including the Rx (entry 0 is the Tx itself)
+    /// @param sampleResolution_m Sampling resolution between terrain heights (meters)
+    void fillTxDistances(std::span<double> distList_m, const double& sampleResolution_m);
+
+    /// @brief Fill the distance of every point from the Rx, accumulated one sample at a time exactly as the scalar scan does
+    /// @param distList_m Output distances, one entry per point of the path not including the Rx (entry 0 is the Tx itself)
+    /// @param pathDist_m Path distance (meters)
+    /// @param sampleResolution_m Sampling resolution between terrain heights (meters)
+    void fillRxDistances(std::span<double> distList_m, const double& pathDist_m, const double& sampleResolution_m);
+
+    /// @brief Find the interior point with the largest horizon angle, (h_k - radial) / d_k - d_k / (2 * a), as seen by one terminal.
+    /// Points 1 to distList_m.size() - 1 are considered, and ties go to the lowest index, so the result is bit-identical
+    /// to a scalar scan keeping the first strictly larger angle, whichever kernel runs it
+    /// @param terrainHeightList_m Terrain heights along the path (first ind = Tx --> last ind = Rx)
+    /// @param distList_m Distance from the terminal to each point (see fillTxDistances() & fillRxDistances())
+    /// @param radial_m Height of the terminal antenna above mean sea level (meters)
+    /// @param effEarthRadius_m Effective earth radius (meters)
+    /// @return Best candidate point (m_pointInd = 0 if there are no interior points)
+    HorizonCandidate findHorizonPoint(std::span<const double> terrainHeightList_m, std::span<const double> distList_m,
+                const double& radial_m, const double& effEarthRadius_m);
+
+    /// @brief Same as findHorizonPoint(), run by the given kernel instead of the one selected for this CPU, so each
+    /// kernel can be checked against the scalar scan (throws if isKernelSupported() is false for that kernel)
+    /// @param terrainHeightList_m Terrain heights along the path (first ind = Tx --> last ind = Rx)
+    /// @param distList_m Distance from the terminal to each point (see fillTxDistances() & fillRxDistances())
+    /// @param radial_m Height of the terminal antenna above mean sea level (meters)
+    /// @param effEarthRadius_m Effective earth radius (meters)
+    /// @param kernelType Kernel to run the scan with
+    /// @return Best candidate point (m_pointInd = 0 if there are no interior points)
+    HorizonCandidate findHorizonPoint(std::span<const double> terrainHeightList_m, std::span<const double> distList_m,
+                const double& radial_m, const double& effEarthRadius_m, const KernelType& kernelType);
+} // end namespace
+
+#endif // ITM_HORIZON_SCAN_H
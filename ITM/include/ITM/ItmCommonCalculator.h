@@ -2,16 +2,24 @@
 #define ITM_COMMON_CALCULATOR_H
 
 #include <ITM/ItmConstructs.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/MathHelpers.h>
+#include <ITM/PreparedTerrainProfile.h>
+#include <ITM/ReferenceAttenuationCurve.h>
+#include <ITM/VariabilityCalculator.h>
 
 #include <complex>
 #include <iostream>
+#include <span>
 #include <sstream>
 #include <vector>
 
 namespace NTIA::ITM {
     namespace {
-        // NOTE: WGS-84 mean Earth radius is 6371008.7714 meters
-        double constexpr kActualEarthCurvature_perMeter { 1.0 / 6371008.7714 };
+        // NOTE: gamma_a of the reference ITM, a radius of about 6369.4 km rather than the WGS-84 mean of 6371008.7714 meters
+        double constexpr kActualEarthCurvature_perMeter { 157.0e-9 };
+        // NOTE: Radius of the earth in Vogler's 4/3 earth ratio, C_0, as the reference ITM takes it
+        double constexpr kVoglerEarthRadius_m { 6370.0e3 };
         double constexpr kDefaultMaxLoss_dB { 999.0 };
     }
 
@@ -26,7 +34,7 @@ namespace NTIA::ITM {
         /// @param isTxHorizPolariz Indicates transmitter antenna polarization (true = horizontal, false = vertical)
         /// @param relPermittivity Relative permittivity
         /// @param conductivity Conductivity
-        /// @param varMode Mode of variability
+        /// @param varMode Mode of variability, plus any NoLocationVariability / NoSituationVariability flags
         /// @param timePercent Time percentage (0 < time < 100%)
         /// @param locationPercent Location percentage (0 < location < 100%)
         /// @param situationPercent Situation percentage (0 < situation < 100%)
@@ -37,7 +45,9 @@ namespace NTIA::ITM {
                 const VariabilityMode& varMode, const double& timePercent, const double& locationPercent, const double& situationPercent,
                 const bool performValidation = true) : 
                     m_txHeight_m(txHeight_m), m_rxHeight_m(rxHeight_m), 
-                    m_radioClimate(climateCode), m_refractivity_N(refractivity_N), m_freq_MHz(freq_MHz) {
+                    m_radioClimate(climateCode), m_refractivity_N(refractivity_N), m_freq_MHz(freq_MHz),
+                    m_isTxHorizPolariz(isTxHorizPolariz), m_relPermittivity(relPermittivity), m_conductivity(conductivity),
+                    m_varMode(varMode), m_timePercent(timePercent), m_locationPercent(locationPercent), m_situationPercent(situationPercent) {
             if (performValidation) {
                 validateInputs();
             }
@@ -51,7 +61,148 @@ namespace NTIA::ITM {
         /// @return Results struct containing ITM basic transmission loss (dB) and various intermediate calculated values
         ItmResults calcItmLoss_P2P_dB(const std::vector<double>& terrainHeightList_m, 
                     const double& terrainSampleResolution_m);
-        
+
+        /// @brief The ITS Irregular Terrain Model (ITM), reading the terrain profile through a borrowed view.
+        /// This function exposes point-to-point mode functionality, 
+        /// with variability specified with time/location/situation (TLS)
+        /// @param terrainHeightList_m View of terrain heights along path between Tx --> Rx (meters), which must outlive the call
+        /// @param terrainSampleResolution_m Sample resolution between successive terrain height values in terrainHeightList_m (meters)
+        /// @param storeTerrainProfile Indicates whether the returned results should carry their own copy of the terrain profile
+        ///         (when false, the returned terrain profile is left empty and no copy of the heights is ever made)
+        /// @return Results struct containing ITM basic transmission loss (dB) and various intermediate calculated values
+        ItmResults calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                    const double& terrainSampleResolution_m, const bool storeTerrainProfile);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_dB(), keeping all per-path state in the caller's workspace
+        /// (the calculator itself is left untouched, so it may be shared by concurrent calls using different workspaces)
+        ItmResults calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                    const double& terrainSampleResolution_m, const bool storeTerrainProfile, ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), reading a terrain profile prepared ahead of time.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS).
+        /// The path average height and least squares fits are answered from the prepared profile's running sums,
+        /// so calculators with different terminal heights, frequencies or variability can share one prepared profile
+        /// @param preparedProfile Prepared terrain profile between Tx --> Rx, which must outlive the call
+        /// @param storeTerrainProfile Indicates whether the returned results should carry their own copy of the terrain profile
+        ///         (when false, the returned terrain profile is left empty and no copy of the heights is ever made)
+        /// @return Results struct containing ITM basic transmission loss (dB) and various intermediate calculated values
+        ItmResults calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const bool storeTerrainProfile = false);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_dB(), keeping all per-path state in the caller's workspace
+        ItmResults calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const bool storeTerrainProfile,
+                    ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), handing back no more of its results than asked for.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS).
+        /// Below FullResults, neither the reference attenuation nor the free space loss are kept as intermediate values
+        /// (the mode too is dropped at LossOnly), and neither the results nor the terrain profile's storage are copied or
+        /// touched. At FullResults, every intermediate value is left in the workspace's results (with no terrain profile)
+        /// @param terrainHeightList_m View of terrain heights along path between Tx --> Rx (meters), which must outlive the call
+        /// @param terrainSampleResolution_m Sample resolution between successive terrain height values in terrainHeightList_m (meters)
+        /// @param resultLevel How much of the results to work out
+        /// @return ITM basic transmission loss (dB) and, from ResultLevel LossAndMode, the mode of propagation
+        ItmLossResult calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                    const double& terrainSampleResolution_m, const ResultLevel& resultLevel);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_dB() at a ResultLevel, keeping all per-path state in the caller's workspace
+        ItmLossResult calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                    const double& terrainSampleResolution_m, const ResultLevel& resultLevel, ItmWorkspace& workspace) const;
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_dB() at a ResultLevel, reading a terrain profile prepared ahead of time
+        ItmLossResult calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const ResultLevel& resultLevel,
+                    ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), evaluated over many terrain profiles in one call.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS)
+        /// @param terrainHeightBuffer_m Terrain heights of every profile, stored back-to-back (meters)
+        /// @param profileOffsetList Start index of each profile within terrainHeightBuffer_m, followed by one final
+        ///         entry marking the end of the last profile (size = number of profiles + 1)
+        /// @param terrainSampleResolutionList_m Sample resolution of each profile (meters)
+        /// @param attenList_dB Caller-owned output array receiving the ITM basic transmission loss of each profile (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation of each profile
+        void calcItmLoss_P2P_batch_dB(std::span<const double> terrainHeightBuffer_m,
+                    std::span<const std::size_t> profileOffsetList,
+                    std::span<const double> terrainSampleResolutionList_m,
+                    std::span<double> attenList_dB, std::span<PropagationMode> propModeList);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_batch_dB(), keeping all per-path state in the caller's workspace
+        void calcItmLoss_P2P_batch_dB(std::span<const double> terrainHeightBuffer_m,
+                    std::span<const std::size_t> profileOffsetList,
+                    std::span<const double> terrainSampleResolutionList_m,
+                    std::span<double> attenList_dB, std::span<PropagationMode> propModeList, ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), evaluated over one terrain profile at many frequencies.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS).
+        /// The path geometry (horizons, effective heights, terrain irregularity) doesn't depend on frequency, so it is
+        /// computed once; only the ground impedance, reference attenuation, free space loss & variability are repeated per frequency.
+        /// All other parameters (including the frequency given on construction, which is ignored here) come from this calculator
+        /// @param terrainHeightList_m List of terrain heights along path between Tx --> Rx (meters)
+        /// @param terrainSampleResolution_m Sample resolution between successive terrain height values in terrainHeightList_m (meters)
+        /// @param freqList_MHz Frequencies to evaluate (MHz)
+        /// @param attenList_dB Caller-owned output array receiving the ITM basic transmission loss at each frequency (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation at each frequency
+        void calcItmLoss_P2P_multiFreq_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                    std::span<const double> freqList_MHz, std::span<double> attenList_dB, std::span<PropagationMode> propModeList);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_multiFreq_dB(), keeping all per-path state in the caller's workspace
+        void calcItmLoss_P2P_multiFreq_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                    std::span<const double> freqList_MHz, std::span<double> attenList_dB, std::span<PropagationMode> propModeList,
+                    ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), evaluated over one terrain profile for many pairs of terminal heights.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS).
+        /// The profile is prepared once (running sums & horizon hulls, see PreparedTerrainProfile), and the path length,
+        /// average height, refractivity & ground impedance are shared by every pair, so each pair only pays for its own
+        /// horizons (O(log N)), least squares fits (O(1)) and delta_h window, whatever the length of the profile.
+        /// Results are those of calcItmLoss_P2P_dB() reading a PreparedTerrainProfile with its horizon index built.
+        /// All other parameters (including the heights given on construction, which are ignored here) come from this calculator
+        /// @param terrainHeightList_m List of terrain heights along path between Tx --> Rx (meters)
+        /// @param terrainSampleResolution_m Sample resolution between successive terrain height values in terrainHeightList_m (meters)
+        /// @param txHeightList_m Structural height of the Tx for each pair (meters)
+        /// @param rxHeightList_m Structural height of the Rx for each pair (meters)
+        /// @param attenList_dB Caller-owned output array receiving the ITM basic transmission loss of each pair (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation of each pair
+        void calcItmLoss_P2P_heightSweep_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                    std::span<const double> txHeightList_m, std::span<const double> rxHeightList_m,
+                    std::span<double> attenList_dB, std::span<PropagationMode> propModeList);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_heightSweep_dB(), keeping all per-path state in the caller's workspace
+        void calcItmLoss_P2P_heightSweep_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                    std::span<const double> txHeightList_m, std::span<const double> rxHeightList_m,
+                    std::span<double> attenList_dB, std::span<PropagationMode> propModeList, ItmWorkspace& workspace) const;
+
+        /// @brief The ITS Irregular Terrain Model (ITM), evaluated at every receiver position along a single radial.
+        /// This function exposes point-to-point mode functionality,
+        /// with variability specified with time/location/situation (TLS).
+        /// The Tx sits at the first point of the radial and the Rx is moved out one point at a time, so that the
+        /// receiver at index rxInd sees the profile [0, rxInd]. Work shared between neighbouring receivers
+        /// (Tx horizon, path average height, least squares fits) is carried forward rather than recomputed.
+        /// @param radialHeightList_m Terrain heights along the radial, starting at the Tx (meters)
+        /// @param terrainSampleResolution_m Sample resolution between successive terrain height values in radialHeightList_m (meters)
+        /// @param firstRxInd Index of the first receiver position to evaluate (must be >= 1)
+        /// @param attenList_dB Caller-owned output array receiving the ITM basic transmission loss at each receiver position,
+        ///         starting with firstRxInd (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation at each receiver position
+        void calcItmLoss_P2P_radial_dB(std::span<const double> radialHeightList_m, const double& terrainSampleResolution_m,
+                    const std::size_t firstRxInd, std::span<double> attenList_dB, std::span<PropagationMode> propModeList);
+
+        /// @brief Thread-safe form of calcItmLoss_P2P_radial_dB(), keeping all per-path state in the caller's workspace
+        void calcItmLoss_P2P_radial_dB(std::span<const double> radialHeightList_m, const double& terrainSampleResolution_m,
+                    const std::size_t firstRxInd, std::span<double> attenList_dB, std::span<PropagationMode> propModeList,
+                    ItmWorkspace& workspace) const;
+
+        /// @brief Prepare the variability of a path already evaluated by this calculator, so that its loss can be
+        /// read off at any number of further time/location/situation or confidence/reliability quantiles.
+        /// The loss at a quantile is then VariabilityCalculator::calcVariabilityLoss_dB(m_refAtten_dB, ...) + m_fsplAtten_dB
+        /// @param itmResults Results of a point-to-point evaluation by this calculator
+        /// @return Variability calculator of the path (climate, variability mode & frequency taken from this calculator)
+        VariabilityCalculator createVariabilityCalculator(const ItmResults& itmResults) const;
+
         /// @brief The ITS Irregular Terrain Model (ITM).
         /// This function exposes area mode functionality, 
         /// with variability specified with time/location/situation (TLS)
@@ -62,6 +213,43 @@ namespace NTIA::ITM {
         /// @return Results struct containing ITM basic transmission loss (dB) and various intermediate calculated values
         ItmResults calcItmLoss_area_dB(const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria, const double& dist_km,
                 const double& terrainIrregularityParam_m);
+
+        /// @brief The ITS Irregular Terrain Model (ITM), evaluated over many area mode links in one call.
+        /// This function exposes area mode functionality, with variability specified with time/location/situation (TLS).
+        /// Heights, siting, distance, terrain irregularity & frequency come from each link, while the climate, refractivity,
+        /// ground constants, polarization, variability mode & percentages come from this calculator. Each link is evaluated on
+        /// its own by the same scalar code as calcItmLoss_area_dB(), nothing is vectorized across links: the batch only saves
+        /// repeated setup. Terms shared by every link (sea level refractivity, normal deviates of the percentages) are worked
+        /// out once per call and the ground impedance once per run of links on the same frequency, and consecutive links
+        /// differing only in distance share one reference attenuation curve, so listing the links of each pair of terminals
+        /// together saves most of the Longley-Rice work
+        /// @param linkBatch Links to evaluate (every list must hold the same number of entries)
+        /// @param attenList_dB Caller-owned output array receiving the ITM basic transmission loss of each link (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation of each link
+        void calcItmLoss_area_batch_dB(const AreaLinkBatch& linkBatch, std::span<double> attenList_dB, std::span<PropagationMode> propModeList);
+
+        /// @brief Thread-safe form of calcItmLoss_area_batch_dB(), keeping all per-link state in the caller's workspace
+        void calcItmLoss_area_batch_dB(const AreaLinkBatch& linkBatch, std::span<double> attenList_dB, std::span<PropagationMode> propModeList,
+                ItmWorkspace& workspace) const;
+
+        /// @brief Prepare the area mode reference attenuation curve, A_ref(d), of this link for sweeping the path distance.
+        /// Everything in the Longley-Rice reference attenuation except the path distance itself is worked out here once,
+        /// so the returned curve can then be evaluated at any distance in [minDist_km, maxDist_km] for a few multiplies each
+        /// @param txSitingCriteria Tx siting criteria (indicating how well the Tx was sited to communicate with the Rx)
+        /// @param rxSitingCriteria Rx siting criteria (indicating how well the Rx was sited to communicate with the Tx)
+        /// @param terrainIrregularityParam_m Parameter indicating how much the regional terrain fluctuates over space (meters)
+        /// @param minDist_km Shortest path length the curve will be evaluated at (km)
+        /// @param maxDist_km Longest path length the curve will be evaluated at (km)
+        /// @return Reference attenuation curve of the link
+        ReferenceAttenuationCurve prepareRefAttenCurve_area(const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria,
+                const double& terrainIrregularityParam_m, const double& minDist_km, const double& maxDist_km);
+
+        /// @brief Thread-safe form of prepareRefAttenCurve_area(), keeping all intermediate state in the caller's workspace
+        ReferenceAttenuationCurve prepareRefAttenCurve_area(const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria,
+                const double& terrainIrregularityParam_m, const double& minDist_km, const double& maxDist_km, ItmWorkspace& workspace) const;
+
+        // The benchmarks (benchmarks/) time the private stages of the calculation one at a time
+        friend struct ItmStageBenchmarkAccess;
     private:
         void validateInputs() {
             std::ostringstream oStrStream;
@@ -117,6 +305,14 @@ namespace NTIA::ITM {
                             << m_conductivity << ")";
                 throw std::domain_error(oStrStream.str());
             }
+            const int varModeCode = static_cast<int>(m_varMode);
+            if (varModeCode < SingleMessageMode || varModeCode > NoSituationVariability + NoLocationVariability + BroadcastMode
+                        || varModeCode % NoLocationVariability > BroadcastMode) {
+                oStrStream << "ERROR: ItuCommonCalculator::validateInputs(): " 
+                            << "ITM does not support modes of variability other than 0 - 3, plus 10 and/or 20 (varMode = " 
+                            << varModeCode << ")";
+                throw std::domain_error(oStrStream.str());
+            }
             if (m_timePercent <= 0.0 || m_timePercent >= 100.0) {
                 oStrStream << "ERROR: ItuCommonCalculator::validateInputs(): " 
                             << "ITM does not support time percentages outside of the range 0 < timePercent < 100 (timePercent = " 
@@ -188,19 +384,38 @@ namespace NTIA::ITM {
             */
         }
 
-        void initialize_P2P(const double& avgPathHeightAmsl_m);
-        void setHorizonParameters(const double& effEarthRadius_km);
-        void calcHorizonParameters();
-        double calcTerrainIrreg_m(const double& distToStart_m, const double& distToEnd_m);
-        double calcLongleyRiceLoss_dB(PropagationMode& propMode, const bool isP2P);
-        double calcLineOfSightLoss_dB(const double& inputDist_m, 
-                const double& diffractSlope, const double& diffractLineIntercept, const double& maxDistSmoothEarth_LoS_m);
-        double calcSmoothEarthDiffractLoss_dB(const double& diffractPathLength_m, const double& effEarthRadius_km, const double& angularDist_LoS_rad);
-        double calcKnifeEdgeDiffractLoss_dB(const double& inputDist_m, const double& effEarthRadius_km, const double& angularDist_LoS_rad);
-        double calcDiffractLoss_dB(const double& inputDist_m, const double& effEarthRadius_m, const bool isP2P, 
-                const double& angularDist_LoS_rad, const double& maxDistSmoothEarth_LoS_m);
-        double calcTroposcatterLoss_dB(const double& tropoPathLength_m, const double& earthEffRadius_m, 
-                const double& angularDist_LoS_rad, double& initialH0_dB);
+        ItmCommonCalculator copyParameters() const;
+        ItmLossResult calcP2PLossResult_dB(ItmWorkspace& workspace, std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const ResultLevel& resultLevel) const;
+        double calcP2PLoss_dB(ItmWorkspace& workspace, const double& terrainSampleResolution_m, const ResultLevel& resultLevel = FullResults) const;
+        void calcP2PGeometry(ItmWorkspace& workspace, const double& terrainSampleResolution_m) const;
+        void setPathParameters(ItmWorkspace& workspace, const double& terrainSampleResolution_m) const;
+        double calcP2PLossFromGeometry_dB(ItmWorkspace& workspace, const ResultLevel& resultLevel = FullResults) const;
+        void initialize_P2P(ItmWorkspace& workspace, const double& avgPathHeightAmsl_m) const;
+        void setGroundImpedance(ItmWorkspace& workspace) const;
+        void initialize_area(ItmWorkspace& workspace, const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria,
+                const double& terrainIrregularityParam_m) const;
+        void setHorizonParameters(ItmWorkspace& workspace, const double& effEarthRadius_m) const;
+        void setRadialHorizonParameters(ItmWorkspace& workspace, const double& effEarthRadius_m, const std::size_t txCandidateInd, 
+                const double& txCandidateDist_m, const std::size_t rxCandidateInd, const double& rxCandidateDist_m) const;
+        void calcHorizonParameters(ItmWorkspace& workspace) const;
+        void setEffectiveHeights(ItmWorkspace& workspace, const double& effEarthRadius_m) const;
+        MathHelpers::TerrainFitResults fitTerrainProfile_linearLeastSquares(const ItmWorkspace& workspace, 
+                const double& distToStart_m, const double& distToEnd_m) const;
+        double calcTerrainIrreg_m(ItmWorkspace& workspace, const double& distToStart_m, const double& distToEnd_m) const;
+        double calcLongleyRiceLoss_dB(const ItmWorkspace& workspace, PropagationMode& propMode, const bool isP2P) const;
+        ReferenceAttenuationCurve buildRefAttenCurve(const ItmWorkspace& workspace, const bool isP2P,
+                const double& minPathDist_m, const double& maxPathDist_m) const;
+        double calcLineOfSightLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, 
+                const double& diffractSlope, const double& diffractLineIntercept, const double& maxDistSmoothEarth_LoS_m) const;
+        double calcSmoothEarthDiffractLoss_dB(const ItmWorkspace& workspace, const double& diffractPathLength_m, 
+                const double& effEarthRadius_m, const double& angularDist_LoS_rad) const;
+        double calcKnifeEdgeDiffractLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, 
+                const double& effEarthRadius_m, const double& angularDist_LoS_rad) const;
+        double calcDiffractLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, const double& effEarthRadius_m, const bool isP2P, 
+                const double& angularDist_LoS_rad, const double& maxDistSmoothEarth_LoS_m) const;
+        double calcTroposcatterLoss_dB(const ItmWorkspace& workspace, const double& tropoPathLength_m, const double& earthEffRadius_m, 
+                const double& angularDist_LoS_rad, double& initialH0_dB) const;
 
         // Initial parameters
         double m_txHeight_m;
@@ -216,13 +431,8 @@ namespace NTIA::ITM {
         double m_locationPercent;
         double m_situationPercent;
 
-        // Intermediate parameters
-        std::complex<double> m_groundImpedance;
-        double m_surfaceRefractivity_N;     // Surface refractivity, in N-Units
-        double m_effEarthCurvature_perM;    // Curvature of the effective earth
-
-        // Output parameters (updated by each member function)
-        ItmResults m_itmResults;
+        // Working state of the non-const calculation functions (the const ones use the caller's workspace instead)
+        ItmWorkspace m_workspace;
     };
 } // end namespace
 
@@ -1,12 +1,91 @@
 #ifndef NTIA_ITM_CONSTRUCTS_H
 #define NTIA_ITM_CONSTRUCTS_H
 
+#include <cstddef>
+#include <span>
+#include <vector>
+
 namespace NTIA::ITM {
+    /// @brief Tx & Rx siting criteria required as an input to area-mode ITM calculations
+    enum SitingCriteria {
+        Random,
+        Careful,
+        VeryCareful
+    };
+
+    /// @brief Mode of variability. As with mdvar in the reference ITM, a mode may carry flags added to it,
+    /// e.g. static_cast<VariabilityMode>(MobileMode + NoLocationVariability) = 12
+    enum VariabilityMode {
+        SingleMessageMode,
+        AccidentalMode,
+        MobileMode,
+        BroadcastMode,
+
+        NoLocationVariability = 10,     // Flag: location variability is eliminated
+        NoSituationVariability = 20     // Flag: direct situation variability is eliminated
+    };
+
+    enum PropagationMode {
+        NotSet,
+        LineOfSight,
+        Diffraction,
+        Troposcatter
+    };
+
+    /// @brief How much of its results a point-to-point evaluation hands back (see ItmLossResult)
+    enum ResultLevel {
+        LossOnly,           // Basic transmission loss
+        LossAndMode,        // Basic transmission loss & mode of propagation
+        FullResults         // Basic transmission loss & every intermediate value of ItmResults (free space loss included)
+    };
+
+    enum RadioClimate {
+        Equatorial,
+        ContinentalSubtropical,
+        MaritimeSubtropical,
+        Desert,
+        Temperate,
+        MaritimeTemperateOverLand,
+        MaritimeTemperateOverSea
+    };
+
     struct TerrainProfile {
         // Default construct will zero out all values
         TerrainProfile() = default;
         
-        std::vector<double> m_terrainHeightList_m;  // Terrain heights along the path (first ind = Tx --> last ind = Rx)
+        TerrainProfile(const TerrainProfile& other) { *this = other; }
+        TerrainProfile(TerrainProfile&& other) = default;
+        TerrainProfile& operator=(TerrainProfile&& other) = default;
+
+        TerrainProfile& operator=(const TerrainProfile& other) {
+            m_ownedTerrainHeightList_m = other.m_ownedTerrainHeightList_m;
+            m_terrainHeightList_m = other.ownsTerrainHeights() ? std::span<const double>(m_ownedTerrainHeightList_m) : other.m_terrainHeightList_m;
+            m_numPointsMinusTx = other.m_numPointsMinusTx;
+            m_pathDist_km = other.m_pathDist_km;
+            m_sampleResolution_m = other.m_sampleResolution_m;
+            return *this;
+        }
+
+        /// @brief Point the profile at a borrowed list of terrain heights, optionally taking a copy of them
+        /// @param terrainHeightList_m Terrain heights along the path (first ind = Tx --> last ind = Rx)
+        /// @param copyTerrainHeights Indicates whether the profile should own a copy of the heights (true) or only view them (false)
+        void setTerrainHeights(std::span<const double> terrainHeightList_m, const bool copyTerrainHeights) {
+            if (copyTerrainHeights) {
+                m_ownedTerrainHeightList_m.assign(terrainHeightList_m.begin(), terrainHeightList_m.end());
+                m_terrainHeightList_m = m_ownedTerrainHeightList_m;
+            }
+            else {
+                m_ownedTerrainHeightList_m.clear();
+                m_terrainHeightList_m = terrainHeightList_m;
+            }
+        }
+
+        bool ownsTerrainHeights() const {
+            return !m_ownedTerrainHeightList_m.empty() && m_terrainHeightList_m.data() == m_ownedTerrainHeightList_m.data();
+        }
+
+        std::span<const double> m_terrainHeightList_m;      // Terrain heights along the path (first ind = Tx --> last ind = Rx), borrowed unless owned below
+        std::vector<double> m_ownedTerrainHeightList_m;     // Storage behind m_terrainHeightList_m when the profile owns its heights (empty otherwise)
         std::size_t m_numPointsMinusTx;             // Number of points in the path, not including the Tx
         double m_pathDist_km;                       // Path distance, in km
         double m_sampleResolution_m;                // Sampling resolution between terrain heights, in meters
@@ -31,6 +110,39 @@ namespace NTIA::ITM {
         double m_fsplAtten_dB;              // Free space basic transmission loss, in dB
         TerrainProfile m_terrainProfile;    // Terrain profile along Tx --> Rx path
         PropagationMode m_propMode;         // Mode of propagation value
+
+        /// @brief Zero out every value, as in a default constructed IntermResults, without touching the storage behind
+        /// the terrain profile (which is left pointing at no heights)
+        void clearValues() {
+            m_txHorizonAngle_rad = 0.0;
+            m_rxHorizonAngle_rad = 0.0;
+            m_txHorizonDist_m = 0.0;
+            m_rxHorizonDist_m = 0.0;
+            m_txEffHorizonDist_m = 0.0;
+            m_rxEffHorizonDist_m = 0.0;
+            m_txEffHeight_m = 0.0;
+            m_rxEffHeight_m = 0.0;
+            m_surfRefract_N = 0.0;
+            m_terrainIrreg_m = 0.0;
+            m_refAtten_dB = 0.0;
+            m_fsplAtten_dB = 0.0;
+            m_terrainProfile.m_terrainHeightList_m = {};
+            m_terrainProfile.m_numPointsMinusTx = 0u;
+            m_terrainProfile.m_pathDist_km = 0.0;
+            m_terrainProfile.m_sampleResolution_m = 0.0;
+            m_propMode = NotSet;
+        }
+    };
+
+    /// @brief Area mode links stored as a structure of arrays (entry i of every list describes link i)
+    struct AreaLinkBatch {
+        std::span<const double> m_txHeightList_m;                   // Structural height of each Tx, in meters
+        std::span<const double> m_rxHeightList_m;                   // Structural height of each Rx, in meters
+        std::span<const SitingCriteria> m_txSitingCriteriaList;     // Siting criteria of each Tx
+        std::span<const SitingCriteria> m_rxSitingCriteriaList;     // Siting criteria of each Rx
+        std::span<const double> m_distList_km;                      // Path distance of each link, in km
+        std::span<const double> m_terrainIrregList_m;               // Terrain irregularity parameter of each link, in meters
+        std::span<const double> m_freqList_MHz;                     // Frequency of each link, in MHz
     };
 
     struct ItmResults {
@@ -40,36 +152,12 @@ namespace NTIA::ITM {
         double m_atten_dB;
         IntermResults m_intermResults;
     };
-    
-    /// @brief Tx & Rx siting criteria required as an input to area-mode ITM calculations
-    enum SitingCriteria {
-        Random,
-        Careful,
-        VeryCareful
-    };
-
-    enum VariabilityMode {
-        SingleMessageMode,
-        AccidentalMode,
-        MobileMode,
-        BroadcastMode
-    };
-
-    enum PropagationMode {
-        NotSet,
-        LineOfSight,
-        Diffraction,
-        Troposcatter
-    };
 
-    enum RadioClimate {
-        Equatorial,
-        ContinentalSubtropical,
-        MaritimeSubtropical,
-        Desert,
-        Temperate,
-        MaritimeTemperateOverLand,
-        MaritimeTemperateOverSea
+    /// @brief Results of a point-to-point evaluation at a lean ResultLevel: a couple of values, returned without copying
+    /// any intermediate values or terrain profile
+    struct ItmLossResult {
+        double m_atten_dB;                  // Basic transmission loss, in dB
+        PropagationMode m_propMode;         // Mode of propagation (NotSet at ResultLevel LossOnly)
     };
 }
 
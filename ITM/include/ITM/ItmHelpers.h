@@ -1,7 +1,10 @@
 #ifndef ITM_CORE_HELPERS_H
 #define ITM_CORE_HELPERS_H
 
+#include <ITM/ItmConstructs.h>
+
 #define _USE_MATH_DEFINES
+#include <algorithm>
 #include <cmath>
 
 namespace NTIA::ITM::ItmHelpers {
@@ -10,14 +13,25 @@ namespace NTIA::ITM::ItmHelpers {
 
     double calcFSPL_dB(const double& dist_m, const double& freq_MHz);
 
+    /// @brief Scale the local refractivity into a surface refractivity based on a path's average elevation, [TN101, Eq 4.3]
+    /// @param refractivity_N Refractivity (N-units)
+    /// @param avgPathHeightAmsl_m Average height of the path above mean sea level (meters)
+    /// @return Surface refractivity (N-units)
+    double calcSurfaceRefractivity_N(const double& refractivity_N, const double& avgPathHeightAmsl_m);
+
+    /// @brief Curvature of the effective earth, [TN101, Eq 4.4], reworked
+    /// @param surfaceRefractivity_N Surface refractivity (N-units)
+    /// @return Curvature of the effective earth (1/meters)
+    double calcEffEarthCurvature_perM(const double& surfaceRefractivity_N);
+
     double calcSmoothEarthGainHeight_dB(const double& inputDist_km, const double& kValue);
     double calcSigmaH_m(const double& terrainIrreg_m);
     double calcTerrainRoughness_m(const double& pathDist_m, const double& terrainIrreg_m);
 
     /// @brief Approximation of the Fresnel integral, as defined in "6. Addenda - Numerical Approximations" from ITM Algorithm Whitepaper
-    /// @param nu Nu is the input the Frensel integral
+    /// @param nuSqrd Square of the Fresnel-Kirchhoff diffraction parameter, nu^2
     /// @return Frensel integration result from nu --> infinity    
-    double calcFresnelIntegral(const double& nu);
+    double calcFresnelIntegral(const double& nuSqrd);
 
     /// @brief Curve fit helper for calculating troposcatter frequency gain function, H_0()
     /// @param arrayInd Index of array defined in algorithm document (a & b)
@@ -27,11 +41,56 @@ namespace NTIA::ITM::ItmHelpers {
 
     /// @brief Troposcatter frequency gain function, H_0(), from [TN101v1, Ch 9.2]
     /// @param rParam Input parameter defined in algorithm document (r_1 or r_2)
-    /// @param scatterEfficiency Scatter efficiency found in algorithm document (eta_s)
+    /// @param scatterEfficiency Scatter efficiency found in algorithm document (eta_s), clamped to 1 <= eta_s <= 5 here
     /// @return Troposcatter frequency gain (dB)
-    double calcTropoFreqGain_dB(const double& rParam, double& scatterEfficiency);
+    double calcTropoFreqGain_dB(const double& rParam, const double& scatterEfficiency);
 
     double calcTropoAttenFunction_dB(const double& inputDist_m);
+
+    /// @brief Area mode geometry of one terminal
+    struct AreaTerminalGeometry {
+        double m_effHeight_m;           // Effective height (meters)
+        double m_horizonDist_m;         // Horizon distance (meters)
+        double m_horizonAngle_rad;      // Horizon angle (radians)
+    };
+
+    /// @brief Effective height, horizon distance & horizon angle of an area mode terminal, [Algorithm, Eqns 3.2 - 3.4]
+    /// @param sitingCriteria Siting criteria of the terminal
+    /// @param height_m Structural height of the terminal (meters)
+    /// @param terrainIrregularityParam_m Terrain irregularity parameter (meters)
+    /// @param effEarthCurvature_perM Curvature of the effective earth (1/meters)
+    /// @return Geometry of the terminal
+    inline AreaTerminalGeometry calcAreaTerminalGeometry(const SitingCriteria& sitingCriteria, const double& height_m,
+                const double& terrainIrregularityParam_m, const double& effEarthCurvature_perM) {
+        AreaTerminalGeometry geometry;
+
+        if (sitingCriteria == SitingCriteria::Random) {
+            geometry.m_effHeight_m = height_m;
+        }
+        else {
+            double sitingFactor = (sitingCriteria == SitingCriteria::Careful) ? 4.0 : 9.0;
+            if (height_m < 5.0) {
+                sitingFactor *= std::sin(0.1 * M_PI * height_m);
+            }
+
+            // [Algorithm, Eqn 3.2]
+            geometry.m_effHeight_m = height_m + (1.0 + sitingFactor) *
+                        std::exp(-std::min({20.0, 2.0 * height_m / std::max({1.0e-3, terrainIrregularityParam_m})}));
+        }
+
+        const double smoothEarthHorizonDist_m = std::sqrt(2.0 * geometry.m_effHeight_m / effEarthCurvature_perM);
+
+        // [Algorithm, Eqn 3.3]
+        const double H3_m = 5.0;
+        geometry.m_horizonDist_m = smoothEarthHorizonDist_m *
+                    std::exp(-0.07 * std::sqrt(terrainIrregularityParam_m / std::max({geometry.m_effHeight_m, H3_m})));
+
+        // [Algorithm, Eqn 3.4]
+        geometry.m_horizonAngle_rad = (0.65 * terrainIrregularityParam_m * (smoothEarthHorizonDist_m / geometry.m_horizonDist_m - 1.0) -
+                    2.0 * geometry.m_effHeight_m) / smoothEarthHorizonDist_m;
+
+        return geometry;
+    }
 } // end namespace
 
 #endif // ITM_CORE_HELPERS_H
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef ITM_STATS_H
+#define ITM_STATS_H
+
+#include <ITM/ItmConstructs.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef NTIA_ITM_ENABLE_STATS
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace NTIA::ITM {
+    /// @brief Stages of an ITM evaluation timed by the stats (see ItmStats). Stages nest: the Longley-Rice stage includes
+    /// its diffraction & troposcatter calls, so its cycles include theirs
+    enum class ItmStage : std::size_t {
+        Initialize_P2P,             // Surface refractivity, effective earth curvature & ground impedance of a path
+        Horizons,                   // Terminal horizon search over the profile
+        TerrainIrregularity,        // Terrain irregularity parameter (delta h) of the profile
+        LongleyRice,                // Reference attenuation curve of a path
+        Diffraction,                // Diffraction loss at one distance
+        Troposcatter,               // Troposcatter loss at one distance
+        Variability,                // Variability of a path, and its loss at a set (or table) of quantiles
+        NumStages
+    };
+
+    std::size_t constexpr kNumItmStages { static_cast<std::size_t>(ItmStage::NumStages) };
+
+    // Bins of the profile length & path distance histograms
+    std::size_t constexpr kNumProfileLengthBins { 24u };
+    std::size_t constexpr kNumPropModeBins { 4u };
+    std::size_t constexpr kNumPathDistBins { 13u };
+
+    struct ItmStageStats {
+        std::uint64_t m_numCalls;
+        std::uint64_t m_numCycles;      // Time stamp counter cycles (steady clock nanoseconds on CPUs without one)
+    };
+
+    /// @brief Totals of the stats over every thread, since the last ItmStats::reset()
+    struct ItmStatsSnapshot {
+        std::array<ItmStageStats, kNumItmStages> m_stageStatsList {};
+
+        // Point-to-point profiles evaluated, by number of points not counting the Tx: bin i holds [2^i, 2^(i+1)),
+        // the last bin everything longer
+        std::array<std::uint64_t, kNumProfileLengthBins> m_profileLengthHistogram {};
+
+        // Paths evaluated (each distance of an area mode sweep counting as one), by mode of propagation (index = PropagationMode)
+        std::array<std::uint64_t, kNumPropModeBins> m_propModeHistogram {};
+
+        // Paths evaluated, by distance: bin 0 holds < 1 km, bin i holds [2^(i-1), 2^i) km, the last bin everything longer
+        std::array<std::uint64_t, kNumPathDistBins> m_pathDistHistogram {};
+
+        const ItmStageStats& getStageStats(const ItmStage stage) const {
+            return m_stageStatsList[static_cast<std::size_t>(stage)];
+        }
+    };
+
+    /// @brief Per-stage timings & path statistics, built in when the library is compiled with NTIA_ITM_ENABLE_STATS
+    /// (CMake option of the same name); otherwise the recording sites compile to nothing and snapshots are all zero.
+    /// Each thread counts into its own block, with no locking or shared cache lines on the hot path; a snapshot sums the
+    /// blocks of the running threads and the totals left by finished ones
+    namespace ItmStats {
+#ifdef NTIA_ITM_ENABLE_STATS
+        bool constexpr kIsEnabled { true };
+#else
+        bool constexpr kIsEnabled { false };
+#endif
+
+        /// @brief Sum the stats of every thread (safe to call while evaluations are running on other threads)
+        /// @return Totals since the last reset()
+        ItmStatsSnapshot takeSnapshot();
+
+        /// @brief Start counting afresh: later snapshots only hold what was recorded after this call
+        void reset();
+
+        /// @return Name of a stage, for reports
+        const char* getStageName(const ItmStage stage);
+
+        // Recording, called by the library through the ITM_STATS_* macros below
+        void recordStage(const ItmStage stage, const std::uint64_t numCycles);
+        void recordProfileLength(const std::size_t numPointsMinusTx);
+        void recordPath(const double& pathDist_m, const PropagationMode& propMode);
+
+#ifdef NTIA_ITM_ENABLE_STATS
+        inline std::uint64_t readCycleCounter() {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+#else
+            return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+        }
+
+        /// @brief Records the cycles between its construction & destruction against a stage
+        class StageTimer {
+        public:
+            explicit StageTimer(const ItmStage stage) : m_stage(stage), m_startCycle(readCycleCounter()) {
+            }
+
+            ~StageTimer() {
+                recordStage(m_stage, readCycleCounter() - m_startCycle);
+            }
+
+            StageTimer(const StageTimer&) = delete;
+            StageTimer& operator=(const StageTimer&) = delete;
+
+        private:
+            ItmStage m_stage;
+            std::uint64_t m_startCycle;
+        };
+#endif
+    } // end namespace ItmStats
+} // end namespace
+
+#ifdef NTIA_ITM_ENABLE_STATS
+#define ITM_STATS_STAGE(stage) const ::NTIA::ITM::ItmStats::StageTimer itmStatsStageTimer(::NTIA::ITM::ItmStage::stage)
+#define ITM_STATS_RECORD_PROFILE_LENGTH(numPointsMinusTx) ::NTIA::ITM::ItmStats::recordProfileLength(numPointsMinusTx)
+#define ITM_STATS_RECORD_PATH(pathDist_m, propMode) ::NTIA::ITM::ItmStats::recordPath(pathDist_m, propMode)
+#else
+#define ITM_STATS_STAGE(stage) static_cast<void>(0)
+#define ITM_STATS_RECORD_PROFILE_LENGTH(numPointsMinusTx) static_cast<void>(0)
+#define ITM_STATS_RECORD_PATH(pathDist_m, propMode) static_cast<void>(0)
+#endif
+
+#endif // ITM_STATS_H
@@ -0,0 +1,124 @@
+#ifndef ITM_TRACE_H
+#define ITM_TRACE_H
+
+#include <ITM/ItmStats.h>
+
+#include <cstdint>
+#include <string>
+
+namespace NTIA::ITM {
+    /// @brief Per-path tracing of the stages of each evaluation, written out in the Chrome trace-event JSON format (opens in
+    /// chrome://tracing or Perfetto). Built in when the library is compiled with NTIA_ITM_ENABLE_TRACING (CMake option of
+    /// the same name), and then only recording between start() & stop(): until then each span costs one relaxed atomic load.
+    /// Without the option the spans compile to nothing, start() does nothing and the trace written is empty.
+    ///
+    /// Each point-to-point profile (calcItmLoss_P2P_dB() and its batch & prepared forms, and calcItmLoss_P2P_multiFreq_dB()),
+    /// each pair of heights of calcItmLoss_P2P_heightSweep_dB(), each receiver position of calcItmLoss_P2P_radial_dB() and each
+    /// area mode evaluation (calcItmLoss_area_dB()) is one "path" span, enclosing a span per stage (see ItmStage) it goes through.
+    /// Every span carries a path ID: the one set by the caller through a PathIdScope, or else a sequence number of its own.
+    ///
+    /// Each thread keeps at most 2^20 spans (48 MB) per recording; any past that are dropped, and their number is written
+    /// to the trace as otherData.droppedEvents. Trace a few thousand paths at a time rather than a whole run
+    namespace ItmTrace {
+#ifdef NTIA_ITM_ENABLE_TRACING
+        bool constexpr kIsEnabled { true };
+#else
+        bool constexpr kIsEnabled { false };
+#endif
+
+        /// @brief Drop any spans recorded so far & start recording (timestamps count from here)
+        void start();
+
+        /// @brief Stop recording; the spans recorded are kept until the next start()
+        void stop();
+
+        /// @return Whether spans are being recorded
+        bool isRecording();
+
+        /// @brief Write the spans recorded so far (on every thread) as a trace-event JSON file
+        /// @param filePath Output file path
+        void writeTraceJson(const std::string& filePath);
+
+        /// @brief Tags the paths evaluated by this thread with a caller's ID (e.g. the row of an input file) for its lifetime
+        class PathIdScope {
+        public:
+            explicit PathIdScope(const std::uint64_t pathId);
+            ~PathIdScope();
+
+            PathIdScope(const PathIdScope&) = delete;
+            PathIdScope& operator=(const PathIdScope&) = delete;
+
+        private:
+            bool m_hadPathId;
+            std::uint64_t m_prevPathId;
+        };
+
+#ifdef NTIA_ITM_ENABLE_TRACING
+        // Recording, called by the library through the ITM_TRACE_* macros below
+        bool isRecordingRelaxed();
+        std::int64_t readTimestamp_ns();
+        void beginPath();
+        void endPath(const char* name, const std::int64_t startTimestamp_ns);
+        void recordStage(const ItmStage stage, const std::int64_t startTimestamp_ns);
+
+        /// @brief Records a path span (& tags the stage spans within it) from its construction to its destruction
+        class PathSpan {
+        public:
+            explicit PathSpan(const char* name) : m_name(name), m_isRecording(isRecordingRelaxed()) {
+                if (m_isRecording) {
+                    beginPath();
+                    m_startTimestamp_ns = readTimestamp_ns();
+                }
+            }
+
+            ~PathSpan() {
+                if (m_isRecording) {
+                    endPath(m_name, m_startTimestamp_ns);
+                }
+            }
+
+            PathSpan(const PathSpan&) = delete;
+            PathSpan& operator=(const PathSpan&) = delete;
+
+        private:
+            const char* m_name;
+            bool m_isRecording;
+            std::int64_t m_startTimestamp_ns = 0;
+        };
+
+        /// @brief Records a stage span from its construction to its destruction
+        class StageSpan {
+        public:
+            explicit StageSpan(const ItmStage stage) : m_stage(stage), m_isRecording(isRecordingRelaxed()) {
+                if (m_isRecording) {
+                    m_startTimestamp_ns = readTimestamp_ns();
+                }
+            }
+
+            ~StageSpan() {
+                if (m_isRecording) {
+                    recordStage(m_stage, m_startTimestamp_ns);
+                }
+            }
+
+            StageSpan(const StageSpan&) = delete;
+            StageSpan& operator=(const StageSpan&) = delete;
+
+        private:
+            ItmStage m_stage;
+            bool m_isRecording;
+            std::int64_t m_startTimestamp_ns = 0;
+        };
+#endif
+    } // end namespace ItmTrace
+} // end namespace
+
+#ifdef NTIA_ITM_ENABLE_TRACING
+#define ITM_TRACE_PATH(name) const ::NTIA::ITM::ItmTrace::PathSpan itmTracePathSpan(name)
+#define ITM_TRACE_STAGE(stage) const ::NTIA::ITM::ItmTrace::StageSpan itmTraceStageSpan(::NTIA::ITM::ItmStage::stage)
+#else
+#define ITM_TRACE_PATH(name) static_cast<void>(0)
+#define ITM_TRACE_STAGE(stage) static_cast<void>(0)
+#endif
+
+#endif // ITM_TRACE_H
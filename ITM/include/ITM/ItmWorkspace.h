@@ -0,0 +1,57 @@
+#ifndef ITM_WORKSPACE_H
+#define ITM_WORKSPACE_H
+
+#include <ITM/ItmConstructs.h>
+#include <ITM/PreparedTerrainProfile.h>
+#include <ITM/TerrainIrregularityEstimator.h>
+
+#include <complex>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Per-path working state of an ITM evaluation.
+    /// The const calculation functions of ItmCommonCalculator keep everything they compute along the way in here,
+    /// so one configured calculator can be evaluated from many threads at once, each thread passing its own workspace.
+    /// A workspace may be reused from one call to the next (its buffers are then only allocated once), but must not
+    /// be shared by two calls running at the same time
+    struct ItmWorkspace {
+        // Output parameters (updated by each calculation function)
+        ItmResults m_itmResults;
+
+        // Intermediate parameters
+        std::complex<double> m_groundImpedance;
+        double m_surfaceRefractivity_N;     // Surface refractivity, in N-Units
+        double m_effEarthCurvature_perM;    // Curvature of the effective earth
+
+        // Terrain irregularity working state, reused from one path to the next
+        TerrainIrregularityEstimator m_terrainIrregEstimator;
+
+        // Horizon scan working buffers (distance of each point from the Tx & Rx), reused from one path to the next
+        std::vector<double> m_txDistList_m;
+        std::vector<double> m_rxDistList_m;
+
+        // Prepared terrain profile the current path is read from (only set while a prepared or radial call is in progress)
+        const PreparedTerrainProfile* m_preparedProfile = nullptr;
+    };
+
+    /// @brief Points a workspace at a prepared terrain profile for its lifetime, and clears the pointer again when it goes
+    /// out of scope (also when the evaluation throws), so the workspace is never left viewing a profile that may be gone
+    class PreparedProfileBinding {
+    public:
+        PreparedProfileBinding(ItmWorkspace& workspace, const PreparedTerrainProfile& preparedProfile) : m_workspace(workspace) {
+            m_workspace.m_preparedProfile = &preparedProfile;
+        }
+
+        ~PreparedProfileBinding() {
+            m_workspace.m_preparedProfile = nullptr;
+        }
+
+        PreparedProfileBinding(const PreparedProfileBinding&) = delete;
+        PreparedProfileBinding& operator=(const PreparedProfileBinding&) = delete;
+
+    private:
+        ItmWorkspace& m_workspace;
+    };
+} // end namespace
+
+#endif // ITM_WORKSPACE_H
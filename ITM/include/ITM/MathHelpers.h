@@ -1,8 +1,12 @@
 #ifndef ITM_MATH_HELPERS_H
 #define ITM_MATH_HELPERS_H
 
+#include <ITM/ItmConstructs.h>
+
 #define _USE_MATH_DEFINES
 #include <cmath>
+#include <cstddef>
+#include <span>
 
 namespace NTIA::ITM::MathHelpers {
     namespace {
@@ -23,7 +27,7 @@ namespace NTIA::ITM::MathHelpers {
     /// described in Formula 26.2.23 in Abramowitz & Stegun. This approximation has an error of abs(epsilon(p)) < 4.5e-4
     /// @param q Quantile fraction (0.0 < q < 1.0)
     /// @return Inverse complementary cumulative distribution function, Q(q)^-1
-    double calcInvComplCumulDistribFunc(const double& q) {
+    inline double calcInvComplCumulDistribFunc(const double& q) {
         const double xVal = (q > 0.5) ? 1.0 - q : q;
 
         const double T_x = std::sqrt(-2.0 * std::log(xVal));
@@ -35,13 +39,65 @@ namespace NTIA::ITM::MathHelpers {
         const double Q_q = T_x - zeta_x;
         return (q > 0.5) ? -Q_q : Q_q;
     }
+
+    struct TerrainFitIndexRange {
+        int m_startInd;
+        int m_endInd;
+    };
+
+    /// @brief Indices of the first and last terrain points covered by a least squares fit between two distances
+    /// @param numPointsMinusTx Number of points in the path, not including the Tx
+    /// @param sampleResolution_m Spacing between terrain heights (meters)
+    /// @param distToStart_m Start distance (meters)
+    /// @param distToEnd_m End distance (meters)
+    /// @return Index range of the fit window (both ends inclusive)
+    inline TerrainFitIndexRange calcFitIndexRange(const std::size_t numPointsMinusTx, const double& sampleResolution_m,
+                const double& distToStart_m, const double& distToEnd_m) {
+        // Clamp the window onto the path with positive differences (FORTRAN dim()), as z1sq1 of the reference ITM does.
+        // The end index is truncated as a distance back from the Rx, not from the Tx
+        const int numPoints = static_cast<int>(numPointsMinusTx);
+        int startInd = static_cast<int>(std::fdim(distToStart_m / sampleResolution_m, 0.0));
+        int endInd = numPoints - static_cast<int>(std::fdim(numPoints, distToEnd_m / sampleResolution_m));
+
+        // A window with no width (e.g. a horizon within one sample of its terminal) is widened by a point on each side
+        if (endInd <= startInd) {
+            startInd = std::max(startInd - 1, 0);
+            endInd = std::min(endInd + 1, numPoints);
+        }
+
+        return { startInd, endInd };
+    }
+
+    /// @brief Turn the sums accumulated over a fit window into the fitted values at both ends of the path
+    /// @param sumOfY Sum of heights over the window (end points weighted by 1/2)
+    /// @param scaledSumOfY Sum of heights over the window, each scaled by its index relative to the window center
+    /// @param indexRange Index range of the fit window
+    /// @param numPointsMinusTx Number of points in the path, not including the Tx
+    /// @return Fitted heights at the Tx (y1) and Rx (y2) ends of the path
+    inline TerrainFitResults finishTerrainFit(double sumOfY, double scaledSumOfY, const TerrainFitIndexRange& indexRange,
+                const std::size_t numPointsMinusTx) {
+        const std::size_t xLength = indexRange.m_endInd - indexRange.m_startInd;
+        const double middleShiftedEndInd_double = indexRange.m_endInd - 0.5 * static_cast<double>(xLength);
+
+        sumOfY /= xLength;
+        const double sumOfYScale = 12.0 / ((xLength * xLength + 2.0) * xLength);
+        scaledSumOfY *= sumOfYScale;
+
+        TerrainFitResults results;
+        results.m_y1Value = sumOfY - scaledSumOfY * middleShiftedEndInd_double;
+        results.m_y2Value = sumOfY + scaledSumOfY * (static_cast<double>(numPointsMinusTx) - middleShiftedEndInd_double);
+
+        return results;
+    }
+
     /*=============================================================================
     |
     |  Description:  Perform a linear least squares fit to the terrain data
     |
-    |        Input:  pfl[2]         - Input data array, in pfl format
-    |                d_start        - Start distance
-    |                d_end          - End distance
+    |        Input:  terrainHeightList_m - Borrowed terrain heights (Tx --> Rx)
+    |                sampleResolution_m  - Spacing between terrain heights
+    |                d_start             - Start distance
+    |                d_end               - End distance
     |
     |      Outputs:  fit_y1         - Fitted y1 value
     |                fit_y2         - Fitted y2 value
@@ -49,48 +105,71 @@ namespace NTIA::ITM::MathHelpers {
     |      Returns:  [None]
     |
     *===========================================================================*/
-    TerrainFitResults fitTerrainProfile_linearLeastSquares(const TerrainProfile& terrainProfile, 
-                const double& distToStart_m, const double& distToEnd_m) {
+    inline TerrainFitResults fitTerrainProfile_linearLeastSquares(std::span<const double> terrainHeightList_m,
+                const double& sampleResolution_m, const double& distToStart_m, const double& distToEnd_m) {
         // For ease of reference in the code
-        const std::size_t& numPointsMinusTx = terrainProfile.m_numPointsMinusTx;
-        const double& sampleResolution_m = terrainProfile.m_sampleResolution_m;
-        const auto& terrainHeightList_m = terrainProfile.m_terrainHeightList_m;
-
-        int startInd = std::abs(distToStart_m / sampleResolution_m);
-        int endInd = numPointsMinusTx - std::abs(numPointsMinusTx - distToEnd_m / sampleResolution_m);
-
-        // TODO(vmartin): Figure out with Alex what this means? Why is it done this way?
-        if (endInd <= startInd) {
-            startInd = std::abs(startInd - 1);
-            const int endIndDiff = static_cast<int>(numPointsMinusTx) - (endInd + 1);
-            endInd = numPointsMinusTx - std::abs(endIndDiff);
-        }
+        const std::size_t numPointsMinusTx = terrainHeightList_m.size() - 1u;
 
-        const std::size_t xLength = endInd - startInd;
+        const TerrainFitIndexRange indexRange = calcFitIndexRange(numPointsMinusTx, sampleResolution_m, distToStart_m, distToEnd_m);
+        const int& startInd = indexRange.m_startInd;
+        const int& endInd = indexRange.m_endInd;
 
-        double middleShiftedInd_double = -0.5 * static_cast<double>(xLength);
-        double middleShiftedEndInd_double = endInd + middleShiftedInd_double;
+        double middleShiftedInd_double = -0.5 * static_cast<double>(endInd - startInd);
 
         double sumOfY = 0.5 * (terrainHeightList_m[startInd] + terrainHeightList_m[endInd]);
         double scaledSumOfY = 0.5 * (terrainHeightList_m[startInd] - terrainHeightList_m[endInd]) * middleShiftedInd_double;
 
-        for (std::size_t profileInd = startInd; profileInd <= endInd; profileInd++) {
-            startInd++;
+        // Interior points of the window (the end points were added above, at half weight)
+        for (int profileInd = startInd + 1; profileInd < endInd; profileInd++) {
             middleShiftedInd_double++;
 
-            sumOfY += terrainHeightList_m[startInd];
-            scaledSumOfY += terrainHeightList_m[startInd] * middleShiftedInd_double;
+            sumOfY += terrainHeightList_m[profileInd];
+            scaledSumOfY += terrainHeightList_m[profileInd] * middleShiftedInd_double;
         }
 
-        sumOfY /= xLength;
-        const double sumOfYScale = 12.0 / ((xLength * xLength + 2.0) * xLength);
-        scaledSumOfY *= sumOfYScale;
+        return finishTerrainFit(sumOfY, scaledSumOfY, indexRange, numPointsMinusTx);
+    }
 
-        TerrainFitResults results;
-        results.m_y1Value = sumOfY - scaledSumOfY * middleShiftedEndInd_double;
-        results.m_y2Value = sumOfY + scaledSumOfY * (static_cast<double>(numPointsMinusTx) - middleShiftedEndInd_double);
+    /// @brief Linear least squares fit over a terrain profile, answered in constant time from running sums of its heights
+    /// @param terrainHeightList_m Terrain heights along the path (Tx --> Rx)
+    /// @param heightPrefixSumList_m Running sums of the heights, where entry i holds the sum of heights [0, i)
+    ///         (may extend past the end of terrainHeightList_m)
+    /// @param scaledHeightPrefixSumList_m Running sums of index * height, where entry i holds the sum over [0, i)
+    /// @param sampleResolution_m Spacing between terrain heights (meters)
+    /// @param distToStart_m Start distance (meters)
+    /// @param distToEnd_m End distance (meters)
+    /// @return Fitted heights at the Tx (y1) and Rx (y2) ends of the path
+    inline TerrainFitResults fitTerrainProfile_linearLeastSquares(std::span<const double> terrainHeightList_m,
+                std::span<const double> heightPrefixSumList_m, std::span<const double> scaledHeightPrefixSumList_m,
+                const double& sampleResolution_m, const double& distToStart_m, const double& distToEnd_m) {
+        // For ease of reference in the code
+        const std::size_t numPointsMinusTx = terrainHeightList_m.size() - 1u;
 
-        return results;
+        const TerrainFitIndexRange indexRange = calcFitIndexRange(numPointsMinusTx, sampleResolution_m, distToStart_m, distToEnd_m);
+        const int& startInd = indexRange.m_startInd;
+        const int& endInd = indexRange.m_endInd;
+
+        const double middleShiftedInd_double = -0.5 * static_cast<double>(endInd - startInd);
+        const double windowCenterInd_double = startInd - middleShiftedInd_double;
+
+        // Interior points of the window, [startInd + 1, endInd)
+        const double interiorSumOfY = (endInd > startInd + 1)
+                    ? heightPrefixSumList_m[endInd] - heightPrefixSumList_m[startInd + 1] : 0.0;
+        const double interiorScaledSumOfY = (endInd > startInd + 1)
+                    ? scaledHeightPrefixSumList_m[endInd] - scaledHeightPrefixSumList_m[startInd + 1] : 0.0;
+
+        const double sumOfY = 0.5 * (terrainHeightList_m[startInd] + terrainHeightList_m[endInd]) + interiorSumOfY;
+        const double scaledSumOfY = 0.5 * (terrainHeightList_m[startInd] - terrainHeightList_m[endInd]) * middleShiftedInd_double + 
+                    (interiorScaledSumOfY - windowCenterInd_double * interiorSumOfY);
+
+        return finishTerrainFit(sumOfY, scaledSumOfY, indexRange, numPointsMinusTx);
+    }
+
+    /// @brief Linear least squares fit over a terrain profile (see span overload above)
+    inline TerrainFitResults fitTerrainProfile_linearLeastSquares(const TerrainProfile& terrainProfile, 
+                const double& distToStart_m, const double& distToEnd_m) {
+        return fitTerrainProfile_linearLeastSquares(terrainProfile.m_terrainHeightList_m.first(terrainProfile.m_numPointsMinusTx + 1u),
+                    terrainProfile.m_sampleResolution_m, distToStart_m, distToEnd_m);
     }
 } // end namespace MathHelpers
 
@@ -0,0 +1,79 @@
+#ifndef ITM_PREPARED_TERRAIN_PROFILE_H
+#define ITM_PREPARED_TERRAIN_PROFILE_H
+
+#include <ITM/ItmConstructs.h>
+#include <ITM/MathHelpers.h>
+#include <ITM/TerrainHorizonIndex.h>
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Terrain profile prepared once for repeated ITM evaluations over the same terrain.
+    /// Running sums of the heights (y) and of index * height (i * y) are stored alongside the profile, so that
+    /// path averages and least squares fits over any window of it are answered in constant time. The same prepared
+    /// profile can be shared by calls using different terminal heights, frequencies or variability settings.
+    /// Any prefix [0, n] of the profile can also be evaluated on its own (as the radial sweep does)
+    class PreparedTerrainProfile {
+    public:
+        /// @brief Prepare a terrain profile
+        /// @param terrainHeightList_m Terrain heights along the path (first ind = Tx --> last ind = Rx), at least 2 points
+        /// @param sampleResolution_m Sampling resolution between terrain heights (meters)
+        /// @param copyTerrainHeights Indicates whether to keep a copy of the heights (true), or only view them (false),
+        ///         in which case they must outlive this object
+        PreparedTerrainProfile(std::span<const double> terrainHeightList_m, const double& sampleResolution_m,
+                    const bool copyTerrainHeights = false);
+
+        const TerrainProfile& getTerrainProfile() const {
+            return m_terrainProfile;
+        }
+
+        /// @brief Average height of the path ignoring its first & last 10%, as used for the surface refractivity
+        /// @param numPointsMinusTx Number of points in the (prefix of the) path, not including the Tx
+        /// @return Average path height above mean sea level (meters)
+        double calcAvgPathHeight_m(const std::size_t numPointsMinusTx) const;
+
+        double calcAvgPathHeight_m() const {
+            return calcAvgPathHeight_m(m_terrainProfile.m_numPointsMinusTx);
+        }
+
+        /// @brief Mean terrain height over a window of the profile
+        /// @param startInd Index of the first point in the window
+        /// @param endInd Index of the last point in the window (inclusive)
+        /// @return Mean terrain height (meters)
+        double calcMeanHeight_m(const std::size_t startInd, const std::size_t endInd) const;
+
+        /// @brief Linear least squares fit to the terrain between two distances (see MathHelpers)
+        /// @param numPointsMinusTx Number of points in the (prefix of the) path, not including the Tx
+        /// @param distToStart_m Start distance (meters)
+        /// @param distToEnd_m End distance (meters)
+        /// @return Fitted heights at the Tx (y1) and Rx (y2) ends of the path
+        MathHelpers::TerrainFitResults fitTerrainProfile_linearLeastSquares(const std::size_t numPointsMinusTx,
+                    const double& distToStart_m, const double& distToEnd_m) const;
+
+        MathHelpers::TerrainFitResults fitTerrainProfile_linearLeastSquares(const double& distToStart_m, const double& distToEnd_m) const {
+            return fitTerrainProfile_linearLeastSquares(m_terrainProfile.m_numPointsMinusTx, distToStart_m, distToEnd_m);
+        }
+
+        /// @brief Build the horizon hulls of the full profile, so that calculators using the given refractivity find
+        /// their terminal horizons in O(log N) rather than with a scan, whatever their antenna heights
+        /// (must be called before the prepared profile is shared between threads)
+        /// @param refractivity_N Refractivity (N-units) of the calculators which will read this profile
+        void buildHorizonIndex(const double& refractivity_N);
+
+        /// @return Horizon hulls of the full profile, or nullptr if buildHorizonIndex() hasn't been called
+        const TerrainHorizonIndex* getHorizonIndex() const {
+            return m_horizonIndex.has_value() ? &m_horizonIndex.value() : nullptr;
+        }
+
+    private:
+        TerrainProfile m_terrainProfile;
+        std::vector<double> m_heightPrefixSumList_m;        // Entry i holds the sum of heights [0, i)
+        std::vector<double> m_scaledHeightPrefixSumList_m;  // Entry i holds the sum of index * height over [0, i)
+        std::optional<TerrainHorizonIndex> m_horizonIndex;
+    };
+} // end namespace
+
+#endif // ITM_PREPARED_TERRAIN_PROFILE_H
@@ -0,0 +1,62 @@
+#ifndef ITM_REFERENCE_ATTENUATION_CURVE_H
+#define ITM_REFERENCE_ATTENUATION_CURVE_H
+
+#include <ITM/ItmConstructs.h>
+
+#include <span>
+
+namespace NTIA::ITM {
+    class ItmCommonCalculator;
+
+    /// @brief Reference attenuation A_ref(d) of one link as a function of path distance alone.
+    /// The diffraction line (fit through d3 & d4), the troposcatter line (fit through d5 & d6) and the line-of-sight
+    /// coefficients (kHat1 & kHat2) only depend on the link geometry, so they are worked out once by
+    /// ItmCommonCalculator and every distance then costs a few multiplies (plus a log in the line-of-sight region).
+    /// A curve only holds the regions covering the distance range it was prepared for
+    class ReferenceAttenuationCurve {
+    public:
+        // Default construct gives an empty curve (no regions prepared)
+        ReferenceAttenuationCurve() = default;
+
+        /// @brief Reference attenuation at one path distance, identical to a full Longley-Rice evaluation of that path
+        /// @param pathDist_m Path distance (meters)
+        /// @param propMode Output mode of propagation at that distance
+        /// @return Reference attenuation (dB)
+        double calcRefAtten_dB(const double& pathDist_m, PropagationMode& propMode) const;
+
+        /// @brief Reference attenuation at many path distances
+        /// @param pathDistList_m Path distances (meters)
+        /// @param refAttenList_dB Caller-owned output array receiving the reference attenuation at each distance (dB)
+        /// @param propModeList Caller-owned output array receiving the mode of propagation at each distance
+        void calcRefAtten_dB(std::span<const double> pathDistList_m, std::span<double> refAttenList_dB,
+                    std::span<PropagationMode> propModeList) const;
+
+        /// @return Maximum line-of-sight distance for a smooth earth, splitting the line-of-sight & trans-horizon regions (meters)
+        double getSmoothEarthMaxLoSDist_m() const {
+            return m_smoothEarthDist_maxLoS_m;
+        }
+
+    private:
+        friend class ItmCommonCalculator;
+
+        double m_smoothEarthDist_maxLoS_m = 0.0;
+
+        // Diffraction line, [ERL 79-ITS 67, Eqn 3.15]
+        double m_diffractLineSlope = 0.0;
+        double m_diffractLineIntercept_dB = 0.0;
+
+        // Line-of-sight region (pathDist_m < m_smoothEarthDist_maxLoS_m), [ERL 79-ITS 67, Eqn 3.19]
+        bool m_hasLineOfSightRegion = false;
+        double m_losIntercept_dB = 0.0;
+        double m_kHat1_dBPerM = 0.0;
+        double m_kHat2_dBPerM = 0.0;
+
+        // Trans-horizon region (pathDist_m >= m_smoothEarthDist_maxLoS_m)
+        bool m_hasTransHorizonRegion = false;
+        double m_tropoLineSlope = 0.0;
+        double m_tropoLineIntercept_dB = 0.0;
+        double m_diffractTropoTransitionDist_m = 0.0;
+    };
+} // end namespace
+
+#endif // ITM_REFERENCE_ATTENUATION_CURVE_H
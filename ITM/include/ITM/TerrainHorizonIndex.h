@@ -0,0 +1,67 @@
+#ifndef ITM_TERRAIN_HORIZON_INDEX_H
+#define ITM_TERRAIN_HORIZON_INDEX_H
+
+#include <ITM/ItmConstructs.h>
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Horizon point of one terminal, as found by TerrainHorizonIndex
+    struct HorizonPoint {
+        std::size_t m_pointInd;     // Index of the horizon point along the profile (0 if the path has no interior points)
+        double m_angle_rad;         // Horizon angle to the point
+        double m_dist_m;            // Distance from the terminal to the point, in meters
+    };
+
+    /// @brief Upper convex hulls of the earth curvature adjusted terrain, as seen from each end of a profile.
+    /// The horizon angle from a terminal to point k is the slope from the terminal to (d_k, h_k - d_k^2 / (2 * a)),
+    /// where d_k is the distance from the terminal and a the effective earth radius. The point with the steepest slope
+    /// always lies on the upper hull of those adjusted points, so once the hulls are built for a given effective earth
+    /// curvature, the horizon of a terminal at any antenna height is found with a binary search instead of a full scan.
+    /// Angles and distances are evaluated with the exact expressions of the horizon scan, and ties go to the point the
+    /// scan would keep (the one nearest the Tx), so results match the scan except where two candidate angles agree
+    /// to within rounding
+    class TerrainHorizonIndex {
+    public:
+        /// @brief Build the Tx & Rx horizon hulls of a terrain profile
+        /// @param terrainProfile Terrain profile between Tx --> Rx (the index keeps what it needs, so the heights may go away)
+        /// @param effEarthCurvature_perM Curvature of the effective earth (1/meters)
+        TerrainHorizonIndex(const TerrainProfile& terrainProfile, const double& effEarthCurvature_perM);
+
+        double getEffEarthCurvature_perM() const {
+            return m_effEarthCurvature_perM;
+        }
+
+        /// @brief Find the Tx horizon point among the interior points of the profile
+        /// @param txRadial_m Height of the Tx antenna above mean sea level (terrain height + structural height, in meters)
+        /// @return Horizon point with the largest Tx horizon angle (m_pointInd = 0 if the path has no interior points)
+        HorizonPoint findTxHorizon(const double& txRadial_m) const;
+
+        /// @brief Find the Rx horizon point among the interior points of the profile
+        /// @param rxRadial_m Height of the Rx antenna above mean sea level (terrain height + structural height, in meters)
+        /// @return Horizon point with the largest Rx horizon angle (m_pointInd = 0 if the path has no interior points)
+        HorizonPoint findRxHorizon(const double& rxRadial_m) const;
+
+    private:
+        struct HullPoint {
+            std::size_t m_pointInd;
+            double m_height_m;          // Terrain height
+            double m_dist_m;            // Distance from the terminal owning the hull
+            double m_adjHeight_m;       // Terrain height lowered by the earth's bulge at m_dist_m
+        };
+
+        std::vector<HullPoint> buildHull(std::span<const double> terrainHeightList_m, const std::vector<double>& distList_m,
+                    const bool isFromRx) const;
+        HorizonPoint findHorizon(const std::vector<HullPoint>& hull, const double& radial_m, const bool isFromRx) const;
+        double calcHorizonAngle_rad(const HullPoint& hullPoint, const double& radial_m, const bool isFromRx) const;
+
+        double m_effEarthCurvature_perM;
+        double m_effEarthRadius_m;
+        std::vector<HullPoint> m_txHull;                // Ordered by increasing distance from the Tx
+        std::vector<HullPoint> m_rxHull;                // Ordered by increasing distance from the Rx
+    };
+} // end namespace
+
+#endif // ITM_TERRAIN_HORIZON_INDEX_H
@@ -0,0 +1,37 @@
+#ifndef ITM_TERRAIN_IRREGULARITY_ESTIMATOR_H
+#define ITM_TERRAIN_IRREGULARITY_ESTIMATOR_H
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace NTIA::ITM {
+    /// @brief Computes the terrain irregularity parameter (delta_h) of a path. Every call resamples & fits its own path
+    /// from scratch; what an estimator kept across calls (e.g. one per workspace, or one per radial) saves is the
+    /// allocation, since the resampled profile goes into a fixed-size buffer it owns. The 10% / 90% points are then found
+    /// by keeping only the 4 - 25 largest differences from the fit on each side, rather than sorting all of them.
+    /// The result is the 10% / 90% interdecile range of the detrended, resampled profile, exactly as defined by
+    /// ItmCommonCalculator::calcTerrainIrreg_m() (which is itself computed with this class)
+    class TerrainIrregularityEstimator {
+    public:
+        TerrainIrregularityEstimator() = default;
+
+        /// @brief Compute the terrain irregularity parameter, delta_h
+        /// @param terrainHeightList_m Terrain heights along the path (first ind = Tx --> last ind = Rx)
+        /// @param sampleResolution_m Sampling resolution between terrain heights (meters)
+        /// @param distToStart_m Distance into the terrain profile to start considering data (meters)
+        /// @param distToEnd_m Distance into the terrain profile to end considering data (meters)
+        /// @return Terrain irregularity parameter (meters)
+        double calcTerrainIrreg_m(std::span<const double> terrainHeightList_m, const double& sampleResolution_m,
+                    const double& distToStart_m, const double& distToEnd_m);
+
+        /// @brief Largest number of points the profile is resampled onto (10 * 25 - 5, reached on long paths)
+        static constexpr std::size_t kMaxNumAdjustedPoints = 245u;
+
+    private:
+        // Working buffer of fixed capacity, so that no call ever touches the heap
+        std::array<double, kMaxNumAdjustedPoints> m_adjustedHeightList_m;  // Profile resampled onto the delta_h grid
+    };
+} // end namespace
+
+#endif // ITM_TERRAIN_IRREGULARITY_ESTIMATOR_H
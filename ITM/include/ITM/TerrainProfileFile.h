@@ -0,0 +1,131 @@
+#ifndef ITM_TERRAIN_PROFILE_FILE_H
+#define ITM_TERRAIN_PROFILE_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Binary file of many terrain profiles, memory-mapped read-only, in place of the text profiles of testData/pfls.csv.
+    /// The file holds (all little-endian, every section 8-byte aligned):
+    ///     - a 64 byte header: magic "ITMPROF1", version, height encoding, number of profiles & heights, and section offsets
+    ///     - the start index of each profile within the heights, plus one final entry for the end of the last (uint64)
+    ///     - the sample resolution of each profile (float64, meters)
+    ///     - for scaled int16 heights only, the scale & offset of each profile (float64 pairs, meters)
+    ///     - the heights of every profile back-to-back, Tx --> Rx
+    /// The offsets & resolutions follow the layout of ItmCommonCalculator::calcItmLoss_P2P_batch_dB(), so a float64 file feeds
+    /// it (or calcItmLoss_P2P_dB()) straight from the mapping. Float32 & scaled int16 heights are a half & a quarter of the size,
+    /// and are decoded into a caller buffer per profile. Nothing is parsed on open beyond the header & offsets, so only the pages
+    /// of the profiles actually read come from disk. All functions may be called concurrently
+    class TerrainProfileFile {
+    public:
+        /// @brief Storage of the heights; values are fixed by the file format
+        enum HeightEncoding : std::uint32_t {
+            Float64 = 0u,           // Exact, and read without a copy
+            Float32 = 1u,           // Within a few mm for any terrain height on earth
+            ScaledInt16 = 2u        // Per-profile linear scale over the profile's range: error within (max - min) / 131068
+        };
+
+        /// @brief Scale of one profile of a ScaledInt16 file: height_m = m_offset_m + m_scale_m * sample
+        struct HeightScale {
+            double m_scale_m;
+            double m_offset_m;
+        };
+
+        /// @brief Map a profile file into memory, checking its header & offsets
+        /// @param filePath Path of the file
+        explicit TerrainProfileFile(const std::string& filePath);
+        ~TerrainProfileFile();
+
+        TerrainProfileFile(const TerrainProfileFile&) = delete;
+        TerrainProfileFile& operator=(const TerrainProfileFile&) = delete;
+
+        HeightEncoding getHeightEncoding() const {
+            return m_heightEncoding;
+        }
+
+        std::size_t getNumProfiles() const {
+            return m_profileOffsetList.size() - 1u;
+        }
+
+        /// @return Number of points of one profile, including the Tx & Rx
+        std::size_t getNumPoints(const std::size_t profileInd) const {
+            return m_profileOffsetList[profileInd + 1u] - m_profileOffsetList[profileInd];
+        }
+
+        /// @return Start index of each profile within the heights, followed by the end of the last (size = number of profiles + 1)
+        std::span<const std::size_t> getProfileOffsetList() const {
+            return m_profileOffsetList;
+        }
+
+        /// @return Sample resolution of each profile, read from the mapping (meters)
+        std::span<const double> getSampleResolutionList_m() const {
+            return m_sampleResolutionList_m;
+        }
+
+        /// @return Heights of every profile back-to-back, read from the mapping (Float64 files only; meters)
+        std::span<const double> getHeightBuffer_m() const;
+
+        /// @return Heights of one profile, read from the mapping (Float64 files only; meters)
+        std::span<const double> getHeights_m(const std::size_t profileInd) const;
+
+        /// @return Heights of one profile, read from the mapping (Float32 files only; meters)
+        std::span<const float> getFloat32Heights_m(const std::size_t profileInd) const;
+
+        /// @return Scaled samples of one profile, read from the mapping (ScaledInt16 files only; see getHeightScale())
+        std::span<const std::int16_t> getScaledInt16Heights(const std::size_t profileInd) const;
+
+        /// @return Scale of one profile (ScaledInt16 files only)
+        HeightScale getHeightScale(const std::size_t profileInd) const;
+
+        /// @brief Heights of one profile in the form the ITM calculators take, whatever the encoding
+        /// @param profileInd Index of the profile
+        /// @param decodeBuffer_m Buffer receiving the decoded heights of Float32 & ScaledInt16 files (resized as needed, so a
+        ///         buffer reused between calls stops allocating once it is large enough); left alone for Float64 files
+        /// @return Heights of the profile (meters): a view of the mapping for Float64 files, or of decodeBuffer_m otherwise
+        std::span<const double> readHeights_m(const std::size_t profileInd, std::vector<double>& decodeBuffer_m) const;
+
+        /// @brief Write a profile file
+        /// @param filePath Path of the file to write (replaced if it exists)
+        /// @param terrainHeightBuffer_m Heights of every profile back-to-back (meters)
+        /// @param profileOffsetList Start index of each profile within terrainHeightBuffer_m, followed by one final
+        ///         entry marking the end of the last profile (size = number of profiles + 1)
+        /// @param sampleResolutionList_m Sample resolution of each profile (meters)
+        /// @param heightEncoding Storage of the heights
+        static void write(const std::string& filePath, std::span<const double> terrainHeightBuffer_m,
+                    std::span<const std::size_t> profileOffsetList, std::span<const double> sampleResolutionList_m,
+                    const HeightEncoding heightEncoding);
+
+        /// @brief Convert a text profile file to a binary one. Each line of the text file holds one profile as comma separated
+        /// values: the number of points not including the Tx, the sample resolution (meters), then the heights (meters)
+        /// @param csvFilePath Path of the text file (e.g. testData/pfls.csv)
+        /// @param filePath Path of the binary file to write (replaced if it exists)
+        /// @param heightEncoding Storage of the heights
+        /// @return Number of profiles converted
+        static std::size_t convertCsv(const std::string& csvFilePath, const std::string& filePath, const HeightEncoding heightEncoding);
+
+    private:
+        /// @brief Read & check the header and offsets of the mapped file
+        void readLayout(const std::string& filePath);
+
+        /// @brief Check that the file's encoding is the one a read asks for
+        void checkHeightEncoding(const char* funcName, const HeightEncoding heightEncoding) const;
+
+        const unsigned char* m_data;
+        std::size_t m_sizeBytes;
+        HeightEncoding m_heightEncoding;
+        std::vector<std::size_t> m_profileOffsetList;
+        std::span<const double> m_sampleResolutionList_m;
+        const double* m_heightScaleList;                    // Scale & offset pairs of ScaledInt16 files, nullptr otherwise
+        const unsigned char* m_heightData;
+        std::size_t m_numHeights;
+#ifdef _WIN32
+        void* m_fileHandle;
+        void* m_mappingHandle;
+#endif
+    };
+} // end namespace
+
+#endif // ITM_TERRAIN_PROFILE_FILE_H
@@ -0,0 +1,84 @@
+#ifndef ITM_VARIABILITY_CALCULATOR_H
+#define ITM_VARIABILITY_CALCULATOR_H
+
+#include <ITM/ItmConstructs.h>
+
+#include <cstddef>
+#include <span>
+
+namespace NTIA::ITM {
+    /// @brief Time, location & situation quantiles of one variability evaluation
+    struct VariabilityQuantiles {
+        double m_timeFrac;          // Time fraction (0 < time < 1)
+        double m_locationFrac;      // Location fraction (0 < location < 1)
+        double m_situationFrac;     // Situation fraction (0 < situation < 1)
+    };
+
+    /// @brief Variability of the ITM reference attenuation over time, location & situation, [Algorithm, Section 5].
+    /// Everything that only depends on the path (effective distance, V_med, sigma_T-, sigma_T+, sigma_L & sigma_S) is
+    /// computed once on construction, so any number of quantiles can then be evaluated for the same path
+    class VariabilityCalculator {
+    public:
+        /// @brief Compute the quantile-independent variability terms of one path
+        /// @param climateCode Radio climate
+        /// @param varMode Mode of variability, plus any NoLocationVariability / NoSituationVariability flags
+        /// @param freq_MHz Frequency (MHz)
+        /// @param txEffHeight_m Effective height of the Tx (meters)
+        /// @param rxEffHeight_m Effective height of the Rx (meters)
+        /// @param terrainIrreg_m Terrain irregularity parameter (meters)
+        /// @param pathDist_m Path distance (meters)
+        VariabilityCalculator(const RadioClimate& climateCode, const VariabilityMode& varMode, const double& freq_MHz,
+                    const double& txEffHeight_m, const double& rxEffHeight_m, const double& terrainIrreg_m, const double& pathDist_m);
+
+        /// @brief Reference attenuation adjusted for variability at one set of quantiles (free space loss not included)
+        /// @param refAtten_dB Reference attenuation of the path (dB)
+        /// @param timeFrac Time fraction (0 < time < 1)
+        /// @param locationFrac Location fraction (0 < location < 1)
+        /// @param situationFrac Situation fraction (0 < situation < 1)
+        /// @return Variability-adjusted attenuation (dB)
+        double calcVariabilityLoss_dB(const double& refAtten_dB, const double& timeFrac, const double& locationFrac,
+                    const double& situationFrac) const;
+
+        /// @brief Reference attenuation adjusted for variability at many sets of time/location/situation (TLS) quantiles
+        /// @param refAtten_dB Reference attenuation of the path (dB)
+        /// @param quantilesList Quantiles to evaluate
+        /// @param lossList_dB Caller-owned output array receiving the variability-adjusted attenuation of each entry of quantilesList (dB)
+        void calcVariabilityLoss_TLS_dB(const double& refAtten_dB, std::span<const VariabilityQuantiles> quantilesList,
+                    std::span<double> lossList_dB) const;
+
+        /// @brief Reference attenuation adjusted for variability over a table of confidence/reliability (CR) values,
+        /// where reliability sets the time & location fractions and confidence sets the situation fraction
+        /// @param refAtten_dB Reference attenuation of the path (dB)
+        /// @param confidenceFracList Confidence fractions (0 < confidence < 1)
+        /// @param reliabilityFracList Reliability fractions (0 < reliability < 1)
+        /// @param lossTable_dB Caller-owned output table receiving the variability-adjusted attenuation (dB), one row per
+        ///         confidence: entry [confInd * reliabilityFracList.size() + relInd]
+        void calcVariabilityLoss_CR_dB(const double& refAtten_dB, std::span<const double> confidenceFracList,
+                    std::span<const double> reliabilityFracList, std::span<double> lossTable_dB) const;
+
+        /// @brief Same as calcVariabilityLoss_dB(), taking the standard normal deviates of the quantiles instead of the
+        /// quantiles themselves (see MathHelpers::calcInvComplCumulDistribFunc()), for callers reusing one set of deviates over many paths
+        /// @param refAtten_dB Reference attenuation of the path (dB)
+        /// @param timeDeviate Standard normal deviate of the time fraction
+        /// @param locationDeviate Standard normal deviate of the location fraction
+        /// @param situationDeviate Standard normal deviate of the situation fraction
+        /// @return Variability-adjusted attenuation (dB)
+        double calcVariabilityLossFromDeviates_dB(const double& refAtten_dB, double timeDeviate, double locationDeviate,
+                    const double& situationDeviate) const;
+
+    private:
+
+        VariabilityMode m_varMode;      // Mode of variability, without its flags
+        double m_zD;                    // Time deviate beyond which sigma_T tends towards sigma_TD, [Algorithm, Table 5.1]
+
+        double m_medianVariability_dB;  // V_med
+        double m_sigmaS_dB;             // Situation variability
+        double m_sigmaL_dB;             // Location variability
+        double m_sigmaTMinus_dB;        // Time variability, below the median
+        double m_sigmaTPlus_dB;         // Time variability, above the median
+        double m_sigmaTD_dB;            // Time variability, far above the median
+        double m_sigmaTSlope_dB;        // (sigma_T+ - sigma_TD) * z_D
+    };
+} // end namespace
+
+#endif // ITM_VARIABILITY_CALCULATOR_H
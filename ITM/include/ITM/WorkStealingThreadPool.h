@@ -0,0 +1,77 @@
+#ifndef ITM_WORK_STEALING_THREAD_POOL_H
+#define ITM_WORK_STEALING_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Fixed set of worker threads running indexed tasks, balanced by work stealing.
+    /// Each run() hands every worker a contiguous block of task indices. A worker takes tasks from the front of its own block,
+    /// and once that is empty steals the back half of another worker's remaining block, so that a few expensive tasks
+    /// (e.g. very long terrain profiles) don't leave the other cores idle
+    class WorkStealingThreadPool {
+    public:
+        using TaskFunction = std::function<void(const std::size_t taskInd, const std::size_t threadInd)>;
+
+        /// @brief Start the worker threads
+        /// @param numThreads Number of worker threads (0 = one per hardware thread)
+        explicit WorkStealingThreadPool(const std::size_t numThreads = 0);
+        ~WorkStealingThreadPool();
+
+        WorkStealingThreadPool(const WorkStealingThreadPool&) = delete;
+        WorkStealingThreadPool& operator=(const WorkStealingThreadPool&) = delete;
+
+        std::size_t getNumThreads() const {
+            return m_threadList.size();
+        }
+
+        /// @brief Run taskFunc(taskInd, threadInd) for every taskInd in [0, numTasks), returning once all of them are done.
+        /// threadInd identifies the worker running the task (0 <= threadInd < getNumThreads()), so per-thread state can be indexed by it.
+        /// If a task throws, no further tasks are started and the first exception is rethrown here.
+        /// The pool runs one job at a time: calls from several threads are serialized, each returning once its own tasks are
+        /// done. A task must not call run() on the pool running it (it would wait on its own job)
+        /// @param numTasks Number of tasks to run
+        /// @param taskFunc Task to run (must be safe to call from several threads at once)
+        void run(const std::size_t numTasks, const TaskFunction& taskFunc);
+
+    private:
+        /// @brief Block of task indices [m_startInd, m_endInd) still waiting to be run by one worker
+        struct TaskQueue {
+            std::mutex m_mutex;
+            std::size_t m_startInd = 0u;
+            std::size_t m_endInd = 0u;
+        };
+
+        void runWorker(const std::size_t threadInd);
+        void runTasks(const std::size_t threadInd);
+        bool takeOwnTask(const std::size_t threadInd, std::size_t& taskInd);
+        bool stealTasks(const std::size_t threadInd);
+
+        std::mutex m_runMutex;      // Held by run() for the whole of its job, so that concurrent callers take turns
+
+        std::vector<std::thread> m_threadList;
+        std::vector<std::unique_ptr<TaskQueue>> m_taskQueueList;   // One per worker
+
+        // Job handed to the workers by run(), guarded by m_mutex
+        std::mutex m_mutex;
+        std::condition_variable m_startCondition;
+        std::condition_variable m_doneCondition;
+        const TaskFunction* m_taskFunc = nullptr;
+        std::size_t m_jobGeneration = 0u;
+        std::size_t m_numBusyWorkers = 0u;
+        std::exception_ptr m_firstException;
+        bool m_isStopping = false;
+
+        // Set once a task of the current job throws. Checked before every task, so it is read without taking m_mutex
+        std::atomic<bool> m_isAborted { false };
+    };
+} // end namespace
+
+#endif // ITM_WORK_STEALING_THREAD_POOL_H
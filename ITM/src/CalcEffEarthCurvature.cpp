@@ -0,0 +1,15 @@
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
+
+namespace NTIA::ITM::ItmHelpers {
+    double calcSurfaceRefractivity_N(const double& refractivity_N, const double& avgPathHeightAmsl_m) {
+        return (avgPathHeightAmsl_m <= 0.0) 
+                    ? refractivity_N 
+                    : refractivity_N * std::exp(-avgPathHeightAmsl_m / 9460.0);
+    }
+
+    double calcEffEarthCurvature_perM(const double& surfaceRefractivity_N) {
+        const double effEarthCurvatureScaleTerm = 1.0 - 0.04665 * std::exp(surfaceRefractivity_N / 179.3);
+        return kActualEarthCurvature_perMeter * effEarthCurvatureScaleTerm;
+    }
+}
@@ -1,4 +1,7 @@
 #include <ITM/ItmCommonCalculator.h>
+#include <ITM/HorizonScan.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 #include <ITM/MathHelpers.h>
 
 #include <algorithm>
@@ -6,123 +9,153 @@
 #include <cmath>
 
 namespace NTIA::ITM {
-    void ItmCommonCalculator::setHorizonParameters(const double& effEarthRadius_km) {
+    void ItmCommonCalculator::setHorizonParameters(ItmWorkspace& workspace, const double& effEarthRadius_m) const {
+        ITM_STATS_STAGE(Horizons);
+        ITM_TRACE_STAGE(Horizons);
+
         // Compute radials for Tx & Rx (ignore radius of earth since it cancels out in the later math)
-        const auto& terrainHeightList_m = m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+        const auto& terrainHeightList_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
         double txRadial_m = terrainHeightList_m.front() + m_txHeight_m;
         double rxRadial_m = terrainHeightList_m.back() + m_rxHeight_m;
 
         // For ease of reference in the code
-        const std::size_t& numPointsMinusTx = m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx;
-        const double& sampleResolution_m = m_itmResults.m_intermResults.m_terrainProfile.m_sampleResolution_m;
-        const double& pathDist_km = m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km;
-        double& finalTxHorizonAngle_rad = m_itmResults.m_intermResults.m_txHorizonAngle_rad;
-        double& finalRxHorizonAngle_rad = m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
-        double& finalTxHorizonDist_km = m_itmResults.m_intermResults.m_txHorizonDist_m;
-        double& finalRxHorizonDist_km = m_itmResults.m_intermResults.m_rxHorizonDist_m;
+        const std::size_t& numPointsMinusTx = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx;
+        const double& sampleResolution_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_sampleResolution_m;
+        const double pathDist_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+        double& finalTxHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad;
+        double& finalRxHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
+        double& finalTxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+        double& finalRxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
 
         // Set the terminal horizon angles as if the terminals are line-of-sight, [TN101, Eq 6.15]
-        finalTxHorizonAngle_rad = (rxRadial_m - txRadial_m) / pathDist_km - pathDist_km / (2.0 * effEarthRadius_km);
-        finalRxHorizonAngle_rad = -(rxRadial_m - txRadial_m) / pathDist_km - pathDist_km / (2.0 * effEarthRadius_km);
-
-        finalTxHorizonDist_km = pathDist_km;
-        finalRxHorizonDist_km = pathDist_km;
-
-        // Initialize test tx & rx horizon distances
-        double txDist_m = 0.0;
-        double rxDist_m = pathDist_km;
-
-        for (std::size_t pointInd = 1u; pointInd < numPointsMinusTx; pointInd++) {
-            txDist_m += sampleResolution_m;
-            rxDist_m -= sampleResolution_m;
-
-            const double txHorizonAngle_deg = (terrainHeightList_m[pointInd] - txRadial_m) / txDist_m - txDist_m / (2.0 * effEarthRadius_km);
-            const double rxHorizonAngle_deg = -(rxRadial_m - terrainHeightList_m[pointInd]) / rxDist_m - rxDist_m / (2.0 * effEarthRadius_km);
-
-            // If better clearance to this point from Tx, shift its horizon
-            if (txHorizonAngle_deg > finalTxHorizonAngle_rad) {
-                finalTxHorizonAngle_rad = txHorizonAngle_deg;
-                finalTxHorizonDist_km = txDist_m;
+        finalTxHorizonAngle_rad = (rxRadial_m - txRadial_m) / pathDist_m - pathDist_m / (2.0 * effEarthRadius_m);
+        finalRxHorizonAngle_rad = -(rxRadial_m - txRadial_m) / pathDist_m - pathDist_m / (2.0 * effEarthRadius_m);
+
+        finalTxHorizonDist_m = pathDist_m;
+        finalRxHorizonDist_m = pathDist_m;
+
+        // Use the prepared profile's horizon hulls when they were built for this very path & effective earth
+        const TerrainHorizonIndex* horizonIndex = (workspace.m_preparedProfile != nullptr) ? workspace.m_preparedProfile->getHorizonIndex() : nullptr;
+        if (horizonIndex != nullptr && horizonIndex->getEffEarthCurvature_perM() == workspace.m_effEarthCurvature_perM &&
+                    workspace.m_preparedProfile->getTerrainProfile().m_numPointsMinusTx == numPointsMinusTx) {
+            const HorizonPoint txHorizonPoint = horizonIndex->findTxHorizon(txRadial_m);
+            if (txHorizonPoint.m_pointInd > 0u && txHorizonPoint.m_angle_rad > finalTxHorizonAngle_rad) {
+                finalTxHorizonAngle_rad = txHorizonPoint.m_angle_rad;
+                finalTxHorizonDist_m = txHorizonPoint.m_dist_m;
             }
-            // If better clearance to this point from Rx, shift its horizon
-            if (rxHorizonAngle_deg > finalRxHorizonAngle_rad) {
-                finalRxHorizonAngle_rad = rxHorizonAngle_deg;
-                finalRxHorizonDist_km = rxDist_m;
+            const HorizonPoint rxHorizonPoint = horizonIndex->findRxHorizon(rxRadial_m);
+            if (rxHorizonPoint.m_pointInd > 0u && rxHorizonPoint.m_angle_rad > finalRxHorizonAngle_rad) {
+                finalRxHorizonAngle_rad = rxHorizonPoint.m_angle_rad;
+                finalRxHorizonDist_m = rxHorizonPoint.m_dist_m;
             }
+            return;
         }
-    }
 
-    void ItmCommonCalculator::calcHorizonParameters() {
-        double delta_h__meter;      // Terrain irregularity parameter
-        double h_e__meter[2];       // Terminal effective heights
+        // Distances from each terminal, then the (vectorized) search for the steepest point seen by each of them
+        workspace.m_txDistList_m.resize(numPointsMinusTx);
+        workspace.m_rxDistList_m.resize(numPointsMinusTx);
+        HorizonScan::fillTxDistances(workspace.m_txDistList_m, sampleResolution_m);
+        HorizonScan::fillRxDistances(workspace.m_rxDistList_m, pathDist_m, sampleResolution_m);
+
+        // If better clearance to the best point from Tx, shift its horizon
+        const HorizonScan::HorizonCandidate txCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, workspace.m_txDistList_m, 
+                    txRadial_m, effEarthRadius_m);
+        if (txCandidate.m_pointInd > 0u && txCandidate.m_angle_rad > finalTxHorizonAngle_rad) {
+            finalTxHorizonAngle_rad = txCandidate.m_angle_rad;
+            finalTxHorizonDist_m = workspace.m_txDistList_m[txCandidate.m_pointInd];
+        }
+        // If better clearance to the best point from Rx, shift its horizon
+        const HorizonScan::HorizonCandidate rxCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, workspace.m_rxDistList_m, 
+                    rxRadial_m, effEarthRadius_m);
+        if (rxCandidate.m_pointInd > 0u && rxCandidate.m_angle_rad > finalRxHorizonAngle_rad) {
+            finalRxHorizonAngle_rad = rxCandidate.m_angle_rad;
+            finalRxHorizonDist_m = workspace.m_rxDistList_m[rxCandidate.m_pointInd];
+        }
+    }
 
-        const double effEarthRadius_km = 1.0 / m_effEarthCurvature_perM; // Effective earth radius
+    void ItmCommonCalculator::calcHorizonParameters(ItmWorkspace& workspace) const {
+        const double effEarthRadius_m = 1.0 / workspace.m_effEarthCurvature_perM; // Effective earth radius
 
-        setHorizonParameters(effEarthRadius_km);
+        setHorizonParameters(workspace, effEarthRadius_m);
+        setEffectiveHeights(workspace, effEarthRadius_m);
+    }
 
+    void ItmCommonCalculator::setEffectiveHeights(ItmWorkspace& workspace, const double& effEarthRadius_m) const {
         // For ease of reference in the code
-        const auto& terrainHeightList_m = m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
-        const double& pathDist_km = m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km;
-        double& txHorizonDist_m = m_itmResults.m_intermResults.m_txHorizonDist_m;
-        double& rxHorizonDist_m = m_itmResults.m_intermResults.m_rxHorizonDist_m;
+        const auto& terrainHeightList_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+        const double pathDist_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+        double& txHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+        double& rxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
 
         // "In our own work we have sometimes said that consideration of terrain elevations should begin at a point about 15 times the tower height"
         //      - [Hufford, 1982] Page 25
-        const double startDist_m = std::min({15.0 * m_txHeight_m, 0.1 * m_txHeight_m});                 // take lesser: 10% of horizon distance or 15x terminal height
-        const double endDist_m = pathDist_km - std::min({15.0 * m_rxHeight_m, 0.1 * m_rxHeight_m});    // same as above, but measured from Rx side
+        const double startDist_m = std::min({15.0 * m_txHeight_m, 0.1 * txHorizonDist_m});                 // take lesser: 10% of horizon distance or 15x terminal height
+        const double endDist_m = pathDist_m - std::min({15.0 * m_rxHeight_m, 0.1 * rxHorizonDist_m});    // same as above, but measured from Rx side
 
-        double& terrainIrreg_m = m_itmResults.m_intermResults.m_terrainIrreg_m;
-        terrainIrreg_m = calcTerrainIrreg_m(startDist_m, endDist_m);
+        double& terrainIrreg_m = workspace.m_itmResults.m_intermResults.m_terrainIrreg_m;
+        terrainIrreg_m = calcTerrainIrreg_m(workspace, startDist_m, endDist_m);
 
-        if (txHorizonDist_m + rxHorizonDist_m > 1.5 * pathDist_km) {
+        if (txHorizonDist_m + rxHorizonDist_m > 1.5 * pathDist_m) {
             // The combined horizon distance is at least 50% larger than the total path distance
             //  -> so we are well within the line-of-sight range
 
             // Y1 = Tx LLS fit, Y2 = Rx LLS fit
-            const auto fitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(m_itmResults.m_intermResults.m_terrainProfile, 
-                        startDist_m, endDist_m);
+            const auto fitResults = fitTerrainProfile_linearLeastSquares(workspace, startDist_m, endDist_m);
 
             // For ease of reference in the code
-            double& txHorizonAngle_rad = m_itmResults.m_intermResults.m_txHorizonAngle_rad;
-            double& rxHorizonAngle_rad = m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
-            double& txEffHorizDist_m = m_itmResults.m_intermResults.m_txEffHorizonDist_m;
-            double& rxEffHorizDist_m = m_itmResults.m_intermResults.m_rxEffHorizonDist_m;
-            double& txEffHeight_m = m_itmResults.m_intermResults.m_txEffHeight_m;
-            double& rxEffHeight_m = m_itmResults.m_intermResults.m_rxEffHeight_m;
-
-            txEffHorizDist_m = m_txHeight_m + std::abs(terrainHeightList_m.front() - fitResults.m_y1Value);
-            rxEffHorizDist_m = m_rxHeight_m + std::abs(terrainHeightList_m.back() - fitResults.m_y2Value);
-
-            // Recalculate horizon distances
-            txHorizonDist_m = std::sqrt(2.0 * txEffHorizDist_m * effEarthRadius_km) * 
-                        std::exp(-0.07 * std::sqrt(terrainIrreg_m / std::max({txEffHorizDist_m, 5.0})));
-            rxHorizonDist_m = std::sqrt(2.0 * rxEffHorizDist_m * effEarthRadius_km) * 
-                        std::exp(-0.07 * std::sqrt(terrainIrreg_m / std::max({rxEffHorizDist_m, 5.0})));
-
-            const double combinedHorizonDist_m = txHorizonDist_m + rxHorizonDist_m;
+            double& txHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad;
+            double& rxHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
+            double& txEffHorizDist_m = workspace.m_itmResults.m_intermResults.m_txEffHorizonDist_m;
+            double& rxEffHorizDist_m = workspace.m_itmResults.m_intermResults.m_rxEffHorizonDist_m;
+            double& txEffHeight_m = workspace.m_itmResults.m_intermResults.m_txEffHeight_m;
+            double& rxEffHeight_m = workspace.m_itmResults.m_intermResults.m_rxEffHeight_m;
+
+            txEffHeight_m = m_txHeight_m + std::fdim(terrainHeightList_m.front(), fitResults.m_y1Value);
+            rxEffHeight_m = m_rxHeight_m + std::fdim(terrainHeightList_m.back(), fitResults.m_y2Value);
+
+            // Recalculate horizon distances from the effective heights
+            txEffHorizDist_m = std::sqrt(2.0 * txEffHeight_m * effEarthRadius_m) * 
+                        std::exp(-0.07 * std::sqrt(terrainIrreg_m / std::max({txEffHeight_m, 5.0})));
+            rxEffHorizDist_m = std::sqrt(2.0 * rxEffHeight_m * effEarthRadius_m) * 
+                        std::exp(-0.07 * std::sqrt(terrainIrreg_m / std::max({rxEffHeight_m, 5.0})));
+
+            const double combinedHorizonDist_m = txEffHorizDist_m + rxEffHorizDist_m;
             double effScalar;
-            if (combinedHorizonDist_m <= pathDist_km) {
-                effScalar = (pathDist_km / combinedHorizonDist_m) * (pathDist_km / combinedHorizonDist_m);
+            if (combinedHorizonDist_m <= pathDist_m) {
+                effScalar = (pathDist_m / combinedHorizonDist_m) * (pathDist_m / combinedHorizonDist_m);
 
                 txEffHeight_m *= effScalar;
-                txEffHorizDist_m = std::sqrt(2.0 * txEffHeight_m * effEarthRadius_km) * std::exp(-0.07 * sqrt(terrainIrreg_m / std::max({txEffHeight_m, 5.0})));
+                txEffHorizDist_m = std::sqrt(2.0 * txEffHeight_m * effEarthRadius_m) * std::exp(-0.07 * sqrt(terrainIrreg_m / std::max({txEffHeight_m, 5.0})));
                 rxEffHeight_m *= effScalar;
-                rxEffHorizDist_m = std::sqrt(2.0 * rxEffHeight_m * effEarthRadius_km) * std::exp(-0.07 * sqrt(terrainIrreg_m / std::max({rxEffHeight_m, 5.0})));
+                rxEffHorizDist_m = std::sqrt(2.0 * rxEffHeight_m * effEarthRadius_m) * std::exp(-0.07 * sqrt(terrainIrreg_m / std::max({rxEffHeight_m, 5.0})));
             }
+            txHorizonDist_m = txEffHorizDist_m;
+            rxHorizonDist_m = rxEffHorizDist_m;
 
-            effScalar = sqrt(2.0 * txEffHeight_m * effEarthRadius_km);
+            effScalar = sqrt(2.0 * txEffHeight_m * effEarthRadius_m);
             txHorizonAngle_rad = (0.65 * terrainIrreg_m * (effScalar / txEffHorizDist_m - 1.0) - 2.0 * txEffHeight_m) / effScalar;
-            effScalar = sqrt(2.0 * rxEffHeight_m * effEarthRadius_km);
+            effScalar = sqrt(2.0 * rxEffHeight_m * effEarthRadius_m);
             rxHorizonAngle_rad = (0.65 * terrainIrreg_m * (effScalar / rxEffHorizDist_m - 1.0) - 2.0 * rxEffHeight_m) / effScalar;
         }
         else {
-            const auto txFitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(m_itmResults.m_intermResults.m_terrainProfile, 
-                        startDist_m, 0.9 * txHorizonDist_m);
-            m_itmResults.m_intermResults.m_txEffHeight_m = m_txHeight_m + std::abs(terrainHeightList_m.front() - txFitResults.m_y1Value);
+            const auto txFitResults = fitTerrainProfile_linearLeastSquares(workspace, startDist_m, 0.9 * txHorizonDist_m);
+            workspace.m_itmResults.m_intermResults.m_txEffHeight_m = m_txHeight_m + std::fdim(terrainHeightList_m.front(), txFitResults.m_y1Value);
+
+            const auto rxFitResults = fitTerrainProfile_linearLeastSquares(workspace, pathDist_m - 0.9 * rxHorizonDist_m, endDist_m);
+            workspace.m_itmResults.m_intermResults.m_rxEffHeight_m = m_rxHeight_m + std::fdim(terrainHeightList_m.back(), rxFitResults.m_y2Value);
+        }
+    }
 
-            const auto rxFitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(m_itmResults.m_intermResults.m_terrainProfile,
-                        pathDist_km - 0.9 * rxHorizonDist_m, endDist_m);
-            m_itmResults.m_intermResults.m_rxEffHeight_m = m_rxHeight_m + std::abs(terrainHeightList_m.back() - rxFitResults.m_y2Value);
+    MathHelpers::TerrainFitResults ItmCommonCalculator::fitTerrainProfile_linearLeastSquares(const ItmWorkspace& workspace, const double& distToStart_m, 
+                const double& distToEnd_m) const {
+        const auto& terrainProfile = workspace.m_itmResults.m_intermResults.m_terrainProfile;
+
+        // Fits are answered from running sums whenever the path comes from a prepared terrain profile
+        if (workspace.m_preparedProfile != nullptr) {
+            return workspace.m_preparedProfile->fitTerrainProfile_linearLeastSquares(terrainProfile.m_numPointsMinusTx, 
+                        distToStart_m, distToEnd_m);
         }
+
+        return MathHelpers::fitTerrainProfile_linearLeastSquares(terrainProfile, distToStart_m, distToEnd_m);
     }
 } // end namespace
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 #include <ITM/MathHelpers.h>
+#include <ITM/TerrainIrregularityEstimator.h>
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 /*=============================================================================
  |
@@ -20,9 +25,57 @@
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcTerrainIrreg_m(const double& distToStart_m, const double& distToEnd_m) {
-        const std::size_t& numPointsMinusTx = m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx;
-        const double& sampleResolution_m = m_itmResults.m_intermResults.m_terrainProfile.m_sampleResolution_m;
+    namespace {
+        /// @brief Keeps the N largest values added to it (N <= 25), sorted from largest to smallest.
+        /// With so few values kept, insertion into a small sorted array beats a general selection over the whole list
+        class LargestValueSelector {
+        public:
+            explicit LargestValueSelector(const std::size_t numValuesKept) : m_numValuesKept(numValuesKept) {}
+
+            void add(const double& value) {
+                std::size_t valueInd = m_numValues;
+                if (m_numValues < m_numValuesKept) {
+                    m_numValues++;
+                }
+                else if (value > m_valueList[m_numValuesKept - 1u]) {
+                    valueInd = m_numValuesKept - 1u;
+                }
+                else {
+                    return;
+                }
+
+                // Shift smaller values down to make room
+                for (; valueInd > 0u && m_valueList[valueInd - 1u] < value; valueInd--) {
+                    m_valueList[valueInd] = m_valueList[valueInd - 1u];
+                }
+                m_valueList[valueInd] = value;
+            }
+
+            /// @return The N-th largest value added so far
+            double getSmallestKept() const {
+                return m_valueList[m_numValues - 1u];
+            }
+
+        private:
+            std::array<double, 25u> m_valueList;
+            std::size_t m_numValuesKept;
+            std::size_t m_numValues = 0u;
+        };
+    }
+
+    double ItmCommonCalculator::calcTerrainIrreg_m(ItmWorkspace& workspace, const double& distToStart_m, const double& distToEnd_m) const {
+        ITM_STATS_STAGE(TerrainIrregularity);
+        ITM_TRACE_STAGE(TerrainIrregularity);
+
+        const auto& terrainProfile = workspace.m_itmResults.m_intermResults.m_terrainProfile;
+
+        return workspace.m_terrainIrregEstimator.calcTerrainIrreg_m(terrainProfile.m_terrainHeightList_m.first(terrainProfile.m_numPointsMinusTx + 1u),
+                    terrainProfile.m_sampleResolution_m, distToStart_m, distToEnd_m);
+    }
+
+    double TerrainIrregularityEstimator::calcTerrainIrreg_m(std::span<const double> terrainHeightList_m, const double& sampleResolution_m,
+                const double& distToStart_m, const double& distToEnd_m) {
+        const std::size_t numPointsMinusTx = terrainHeightList_m.size() - 1u;
 
         double xStart = distToStart_m / sampleResolution_m;    // index to start considering terrain points
         double xEnd = distToEnd_m /sampleResolution_m;         // index to stop considering terrain points
@@ -34,50 +87,55 @@ namespace NTIA::ITM {
 
         // TODO(vmartin): Work with Alex to figure out what this *intends* to do and maybe rewrite entirely?
         std::size_t tenPercentInd = static_cast<std::size_t>(0.1 * (xEnd - xStart + 8.0));
-        tenPercentInd = std::min({std::max({4u, tenPercentInd}), 25u});
+        tenPercentInd = std::min({std::max({std::size_t{4u}, tenPercentInd}), std::size_t{25u}});
 
         std::size_t maxInd = 10u * tenPercentInd - 5u;
-        std::size_t ninetyPercentInd = maxInd - tenPercentInd;
 
-        TerrainProfile adjustedProfile;
-        adjustedProfile.m_numPointsMinusTx = maxInd - 1u;
-        adjustedProfile.m_sampleResolution_m = 1.0;
+        // Resampled profile, at a resolution of 1 "meter" per point
+        static_assert(10u * 25u - 5u == kMaxNumAdjustedPoints, "Resampled profile must fit the largest 10% point allowed");
 
-        xEnd = (xEnd - xStart) / static_cast<double>(adjustedProfile.m_numPointsMinusTx);
+        xEnd = (xEnd - xStart) / static_cast<double>(maxInd - 1u);
         std::size_t xInd = static_cast<std::size_t>(xStart);
         xStart -= static_cast<double>(xInd) + 1.0;
 
-        const auto& terrainHeightList_m = m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
         for (std::size_t profileInd = 0; profileInd < maxInd; profileInd++)
         {
-            while (xStart > 0.0 && (xInd + 1u) < numPointsMinusTx) {
-                xStart--;
-                xInd++;
+            // Step forward to the profile point at or just past xStart. Subtracting whole numbers is exact, so jumping
+            // there in one go gives the same xStart as stepping one point at a time (and keeps this independent of path length)
+            if (xStart > 0.0 && (xInd + 1u) < numPointsMinusTx) {
+                const std::size_t numSteps = std::min(static_cast<std::size_t>(std::ceil(xStart)), numPointsMinusTx - (xInd + 1u));
+                xStart -= static_cast<double>(numSteps);
+                xInd += numSteps;
             }
 
             const double adjustedTerrainHeight_m = terrainHeightList_m[xInd + 1u] + (terrainHeightList_m[xInd + 1u] - terrainHeightList_m[xInd]) * xStart;
-            adjustedProfile.m_terrainHeightList_m.push_back(adjustedTerrainHeight_m);
+            m_adjustedHeightList_m[profileInd] = adjustedTerrainHeight_m;
 
             xStart += xEnd;
         }
 
-        auto fitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(adjustedProfile, distToStart_m, distToEnd_m);
+        // Fit over the whole resampled profile, which is in its own units of 1 "meter" per point (the original path
+        // distances would index far past its end)
+        const double adjustedNumPointsMinusTx = static_cast<double>(maxInd - 1u);
+        auto fitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(std::span<const double>(m_adjustedHeightList_m.data(), maxInd), 
+                    1.0, 0.0, adjustedNumPointsMinusTx);
 
-        fitResults.m_y2Value = (fitResults.m_y2Value - fitResults.m_y1Value) / static_cast<double>(numPointsMinusTx);
+        fitResults.m_y2Value = (fitResults.m_y2Value - fitResults.m_y1Value) / adjustedNumPointsMinusTx;
 
-        std::vector<double> fittedDiffList;
-        // Calculate the difference between fitted line and actual data
+        // Calculate the difference between fitted line and actual data, keeping only the extremes needed for the 10% & 90% points
+        LargestValueSelector largestDiffList_m(tenPercentInd);
+        LargestValueSelector largestNegatedDiffList_m(tenPercentInd);
         for (std::size_t adjustedProfileInd = 0; adjustedProfileInd < maxInd; adjustedProfileInd++) {
-            fittedDiffList.push_back(adjustedProfile.m_terrainHeightList_m[adjustedProfileInd] - fitResults.m_y1Value);
+            const double fittedDiff_m = m_adjustedHeightList_m[adjustedProfileInd] - fitResults.m_y1Value;
+            largestDiffList_m.add(fittedDiff_m);
+            largestNegatedDiffList_m.add(-fittedDiff_m);
 
             fitResults.m_y1Value += fitResults.m_y2Value;
         }
 
-        std::nth_element(fittedDiffList.begin(), fittedDiffList.begin() + tenPercentInd - 1u, fittedDiffList.end(), std::greater<double>());
-        const double q10 = fittedDiffList[tenPercentInd - 1u];
-
-        std::nth_element(fittedDiffList.begin(), fittedDiffList.begin() + ninetyPercentInd, fittedDiffList.end(), std::greater<double>());
-        const double q90 = fittedDiffList[ninetyPercentInd];
+        // q10 is the tenPercentInd-th largest difference and q90 the tenPercentInd-th smallest
+        const double q10 = largestDiffList_m.getSmallestKept();
+        const double q90 = -largestNegatedDiffList_m.getSmallestKept();
 
         double terrainIrreg_m = q10 - q90;
 
@@ -86,4 +144,4 @@ namespace NTIA::ITM {
 
         return terrainIrreg_m;
     }
-} // end namespace
\ No newline at end of file
+} // end namespace
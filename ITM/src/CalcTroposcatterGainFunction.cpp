@@ -1,6 +1,6 @@
-#include "ITM/itm.h"
+#include <ITM/ItmHelpers.h>
 
-namespace ITM::NTIA::ItmHelpers {
+namespace NTIA::ITM::ItmHelpers {
     namespace {
         // values from [Algorithm, 6.13]
         double constexpr aList[] = { 25.0, 80.0, 177.0, 395.0, 705.0 };
@@ -14,12 +14,13 @@ namespace ITM::NTIA::ItmHelpers {
                         bList[arrayInd] * inv_rTermSqrd);   // related to TN101v2, Eqn III.49, but from [Algorithm, 6.13]
     }
 
-    double calcTropoFreqGain_dB(const double& rParam, double& scatterEfficiency) {
-        // Force scatterEfficiency term to fall in between 1 <= eta_s <= 5
-        scatterEfficiency = std::min({std::max({scatterEfficiency, 1.0}), 5.0});
+    double calcTropoFreqGain_dB(const double& rParam, const double& scatterEfficiency) {
+        // Force scatterEfficiency term to fall in between 1 <= eta_s <= 5 (a local copy: the caller still needs its own
+        // eta_s, which may be below 1)
+        const double clampedScatterEfficiency = std::min({std::max({scatterEfficiency, 1.0}), 5.0});
 
-        const std::size_t scatterInd = static_cast<std::size_t>(scatterEfficiency);
-        const double scatterEffRemainder = scatterEfficiency - static_cast<double>(scatterInd);
+        const std::size_t scatterInd = static_cast<std::size_t>(clampedScatterEfficiency);
+        const double scatterEffRemainder = clampedScatterEfficiency - static_cast<double>(scatterInd);
 
         const double tropoGain_dB = calcTropoFreqGainCurveFit_dB(scatterInd - 1u, rParam);
         
@@ -0,0 +1,126 @@
+#include <ITM/CoverageEngine.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM {
+    namespace {
+        /// @brief Check that an offset list describes numProfiles profiles lying inside the height buffer
+        void checkProfileOffsets(const char* funcName, const char* profileName, std::span<const double> heightBuffer_m,
+                    std::span<const std::size_t> offsetList, const std::size_t numProfiles) {
+            if (offsetList.size() != numProfiles + 1u) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: CoverageEngine::" << funcName << "(): "
+                            << "Expected " << numProfiles + 1u << " " << profileName << " offsets (got " << offsetList.size() << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+            for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+                if (offsetList[profileInd] > offsetList[profileInd + 1u]) {
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: CoverageEngine::" << funcName << "(): "
+                                << "Offsets must not decrease (" << profileName << " " << profileInd << " spans ["
+                                << offsetList[profileInd] << ", " << offsetList[profileInd + 1u] << "))";
+                    throw std::domain_error(oStrStream.str());
+                }
+            }
+            if (offsetList.back() > heightBuffer_m.size()) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: CoverageEngine::" << funcName << "(): "
+                            << "Last " << profileName << " offset runs past the end of the terrain height buffer (offset = "
+                            << offsetList.back() << ", buffer size = " << heightBuffer_m.size() << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+    }
+
+    CoverageEngine::CoverageEngine(const std::size_t numThreads) :
+                m_threadPool(numThreads),
+                m_workspaceList(m_threadPool.getNumThreads()),
+                m_discardedPropModeListList(m_threadPool.getNumThreads()) {
+    }
+
+    void CoverageEngine::calcCellLoss_dB(const ItmCommonCalculator& calculator, std::span<const double> terrainHeightBuffer_m,
+                std::span<const std::size_t> profileOffsetList, std::span<const double> terrainSampleResolutionList_m,
+                std::span<const std::size_t> rasterIndList, std::span<double> attenRaster_dB,
+                std::span<PropagationMode> propModeRaster) {
+        const std::size_t numCells = terrainSampleResolutionList_m.size();
+        checkProfileOffsets("calcCellLoss_dB", "profile", terrainHeightBuffer_m, profileOffsetList, numCells);
+
+        const bool hasRasterIndList = !rasterIndList.empty();
+        if (hasRasterIndList && rasterIndList.size() != numCells) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: CoverageEngine::calcCellLoss_dB(): "
+                        << "Expected " << numCells << " raster indices (got " << rasterIndList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        for (std::size_t cellInd = 0; cellInd < numCells; cellInd++) {
+            const std::size_t rasterInd = hasRasterIndList ? rasterIndList[cellInd] : cellInd;
+            if (rasterInd >= attenRaster_dB.size() || (!propModeRaster.empty() && rasterInd >= propModeRaster.size())) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: CoverageEngine::calcCellLoss_dB(): "
+                            << "Cell " << cellInd << " falls outside the output raster (raster index = " << rasterInd
+                            << ", attenRaster_dB = " << attenRaster_dB.size() << ", propModeRaster = " << propModeRaster.size() << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+
+        m_threadPool.run(numCells, [&](const std::size_t cellInd, const std::size_t threadInd) {
+            const std::size_t rasterInd = hasRasterIndList ? rasterIndList[cellInd] : cellInd;
+
+            PropagationMode discardedPropMode;
+            std::span<PropagationMode> propModeList = propModeRaster.empty() ?
+                        std::span<PropagationMode>(&discardedPropMode, 1u) : propModeRaster.subspan(rasterInd, 1u);
+
+            // A batch of one: evaluates the profile in place, without copying heights or results
+            calculator.calcItmLoss_P2P_batch_dB(terrainHeightBuffer_m, profileOffsetList.subspan(cellInd, 2u),
+                        terrainSampleResolutionList_m.subspan(cellInd, 1u), attenRaster_dB.subspan(rasterInd, 1u), propModeList,
+                        m_workspaceList[threadInd]);
+        });
+    }
+
+    void CoverageEngine::calcRadialLoss_dB(const ItmCommonCalculator& calculator, std::span<const double> radialHeightBuffer_m,
+                std::span<const std::size_t> radialOffsetList, std::span<const double> terrainSampleResolutionList_m,
+                const std::size_t firstRxInd, const std::size_t rasterRowStride, std::span<double> attenRaster_dB,
+                std::span<PropagationMode> propModeRaster) {
+        const std::size_t numRadials = terrainSampleResolutionList_m.size();
+        checkProfileOffsets("calcRadialLoss_dB", "radial", radialHeightBuffer_m, radialOffsetList, numRadials);
+
+        const auto calcNumRxPoints = [&](const std::size_t radialInd) {
+            const std::size_t numRadialPoints = radialOffsetList[radialInd + 1u] - radialOffsetList[radialInd];
+            return (numRadialPoints > firstRxInd) ? numRadialPoints - firstRxInd : 0u;
+        };
+        for (std::size_t radialInd = 0; radialInd < numRadials; radialInd++) {
+            const std::size_t numRxPoints = calcNumRxPoints(radialInd);
+            const std::size_t rowEndInd = radialInd * rasterRowStride + numRxPoints;
+            if (numRxPoints > rasterRowStride || rowEndInd > attenRaster_dB.size() ||
+                        (!propModeRaster.empty() && rowEndInd > propModeRaster.size())) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: CoverageEngine::calcRadialLoss_dB(): "
+                            << "Radial " << radialInd << " (" << numRxPoints << " receivers) does not fit in its raster row (row stride = "
+                            << rasterRowStride << ", attenRaster_dB = " << attenRaster_dB.size()
+                            << ", propModeRaster = " << propModeRaster.size() << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+
+        m_threadPool.run(numRadials, [&](const std::size_t radialInd, const std::size_t threadInd) {
+            const std::size_t startInd = radialOffsetList[radialInd];
+            const std::size_t numRadialPoints = radialOffsetList[radialInd + 1u] - startInd;
+            const std::size_t numRxPoints = calcNumRxPoints(radialInd);
+            const std::size_t rowStartInd = radialInd * rasterRowStride;
+
+            std::span<PropagationMode> propModeList;
+            if (propModeRaster.empty()) {
+                std::vector<PropagationMode>& discardedPropModeList = m_discardedPropModeListList[threadInd];
+                discardedPropModeList.resize(numRxPoints);
+                propModeList = discardedPropModeList;
+            }
+            else {
+                propModeList = propModeRaster.subspan(rowStartInd, numRxPoints);
+            }
+
+            calculator.calcItmLoss_P2P_radial_dB(radialHeightBuffer_m.subspan(startInd, numRadialPoints), terrainSampleResolutionList_m[radialInd],
+                        firstRxInd, attenRaster_dB.subspan(rowStartInd, numRxPoints), propModeList, m_workspaceList[threadInd]);
+        });
+    }
+} // end namespace
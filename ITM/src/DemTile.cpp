@@ -0,0 +1,259 @@
+#include <ITM/DemTile.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NTIA::ITM {
+    namespace {
+        /// @return Samples per side of a tile of the given size, or 0 if the size doesn't match any SRTM product
+        std::size_t findNumSamplesPerSide(const std::size_t sizeBytes) {
+            for (const std::size_t numSamplesPerSide : { std::size_t{1201u}, std::size_t{3601u} }) {
+                if (sizeBytes == 2u * numSamplesPerSide * numSamplesPerSide) {
+                    return numSamplesPerSide;
+                }
+            }
+            return 0u;
+        }
+
+        [[noreturn]] void throwOpenError(const std::string& filePath, const std::string& reason) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTile::DemTile(): Unable to map " << filePath << " (" << reason << ")";
+            throw std::runtime_error(oStrStream.str());
+        }
+    }
+
+#ifdef _WIN32
+    DemTile::DemTile(const std::string& filePath, const int southLat_deg, const int westLon_deg)
+                : m_southLat_deg(southLat_deg), m_westLon_deg(westLon_deg), m_numSamplesPerSide(0u), m_sizeBytes(0u), m_data(nullptr),
+                m_fileHandle(nullptr), m_mappingHandle(nullptr) {
+        HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            throwOpenError(filePath, "CreateFile failed");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "GetFileSizeEx failed");
+        }
+        m_sizeBytes = static_cast<std::size_t>(fileSize.QuadPart);
+        m_numSamplesPerSide = findNumSamplesPerSide(m_sizeBytes);
+        if (m_numSamplesPerSide == 0u) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "size matches neither a 1201 x 1201 nor a 3601 x 3601 tile");
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "CreateFileMapping failed");
+        }
+        m_data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "MapViewOfFile failed");
+        }
+
+        m_fileHandle = fileHandle;
+        m_mappingHandle = mappingHandle;
+    }
+
+    DemTile::~DemTile() {
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+
+    void DemTile::adviseWillNeed() const {
+        // No asynchronous read-ahead to ask for here, so touch every page instead (callers do this off the critical path)
+        volatile unsigned char pageByte = 0u;
+        for (std::size_t byteInd = 0; byteInd < m_sizeBytes; byteInd += 4096u) {
+            pageByte = m_data[byteInd];
+        }
+        static_cast<void>(pageByte);
+    }
+#else
+    DemTile::DemTile(const std::string& filePath, const int southLat_deg, const int westLon_deg)
+                : m_southLat_deg(southLat_deg), m_westLon_deg(westLon_deg), m_numSamplesPerSide(0u), m_sizeBytes(0u), m_data(nullptr) {
+        const int fileDesc = ::open(filePath.c_str(), O_RDONLY);
+        if (fileDesc < 0) {
+            throwOpenError(filePath, std::strerror(errno));
+        }
+
+        struct stat fileStat;
+        if (::fstat(fileDesc, &fileStat) != 0) {
+            const int errorCode = errno;
+            ::close(fileDesc);
+            throwOpenError(filePath, std::strerror(errorCode));
+        }
+        m_sizeBytes = static_cast<std::size_t>(fileStat.st_size);
+        m_numSamplesPerSide = findNumSamplesPerSide(m_sizeBytes);
+        if (m_numSamplesPerSide == 0u) {
+            ::close(fileDesc);
+            throwOpenError(filePath, "size matches neither a 1201 x 1201 nor a 3601 x 3601 tile");
+        }
+
+        // The mapping keeps the file alive, so the descriptor can go straight away
+        void* mapping = ::mmap(nullptr, m_sizeBytes, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+        const int errorCode = errno;
+        ::close(fileDesc);
+        if (mapping == MAP_FAILED) {
+            throwOpenError(filePath, std::strerror(errorCode));
+        }
+        m_data = static_cast<const unsigned char*>(mapping);
+    }
+
+    DemTile::~DemTile() {
+        ::munmap(const_cast<unsigned char*>(m_data), m_sizeBytes);
+    }
+
+    void DemTile::adviseWillNeed() const {
+        ::madvise(const_cast<unsigned char*>(m_data), m_sizeBytes, MADV_WILLNEED);
+    }
+#endif
+
+    double DemTile::calcHeight_m(const double& lat_deg, const double& lon_deg, const std::size_t levelInd) const {
+        if (levelInd >= kNumLevels) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTile::calcHeight_m(): Pyramid level out of range (levelInd = " << levelInd
+                        << ", number of levels = " << kNumLevels << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        const Level* level = (levelInd > 0u) ? &getLevel(levelInd) : nullptr;
+        const std::size_t numSamplesPerSide = (level != nullptr) ? level->m_numSamplesPerSide : m_numSamplesPerSide;
+        const std::size_t lastInd = numSamplesPerSide - 1u;
+        const double samplesPerDeg = static_cast<double>(lastInd);
+
+        // Fractional grid position, clamped onto the tile (row 0 is the northern edge)
+        const double rowPos = std::clamp((static_cast<double>(m_southLat_deg + 1) - lat_deg) * samplesPerDeg, 0.0, samplesPerDeg);
+        const double colPos = std::clamp((lon_deg - static_cast<double>(m_westLon_deg)) * samplesPerDeg, 0.0, samplesPerDeg);
+
+        const std::size_t rowInd = std::min(static_cast<std::size_t>(rowPos), lastInd - 1u);
+        const std::size_t colInd = std::min(static_cast<std::size_t>(colPos), lastInd - 1u);
+        const double rowFrac = rowPos - static_cast<double>(rowInd);
+        const double colFrac = colPos - static_cast<double>(colInd);
+
+        std::int16_t sampleList[4];
+        if (level != nullptr) {
+            const std::int16_t* firstRowSample = level->m_heightList_m.data() + rowInd * numSamplesPerSide + colInd;
+            sampleList[0] = firstRowSample[0];
+            sampleList[1] = firstRowSample[1];
+            sampleList[2] = firstRowSample[numSamplesPerSide];
+            sampleList[3] = firstRowSample[numSamplesPerSide + 1u];
+        }
+        else {
+            sampleList[0] = getSample_m(rowInd, colInd);
+            sampleList[1] = getSample_m(rowInd, colInd + 1u);
+            sampleList[2] = getSample_m(rowInd + 1u, colInd);
+            sampleList[3] = getSample_m(rowInd + 1u, colInd + 1u);
+        }
+        const double weightList[4] = {
+            (1.0 - rowFrac) * (1.0 - colFrac), (1.0 - rowFrac) * colFrac,
+            rowFrac * (1.0 - colFrac), rowFrac * colFrac
+        };
+
+        double weightedHeight_m = 0.0;
+        double totalWeight = 0.0;
+        for (std::size_t cornerInd = 0; cornerInd < 4u; cornerInd++) {
+            if (sampleList[cornerInd] != kVoidHeight) {
+                weightedHeight_m += weightList[cornerInd] * static_cast<double>(sampleList[cornerInd]);
+                totalWeight += weightList[cornerInd];
+            }
+        }
+
+        return (totalWeight > 0.0) ? weightedHeight_m / totalWeight : 0.0;
+    }
+
+    DemLevelAccuracy DemTile::getLevelAccuracy(const std::size_t levelInd) const {
+        if (levelInd >= kNumLevels) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTile::getLevelAccuracy(): Pyramid level out of range (levelInd = " << levelInd
+                        << ", number of levels = " << kNumLevels << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        DemLevelAccuracy accuracy;
+        accuracy.m_sampleSpacing_deg = static_cast<double>(std::size_t{1u} << levelInd) / static_cast<double>(m_numSamplesPerSide - 1u);
+        accuracy.m_maxOverstatement_m = (levelInd > 0u) ? getLevel(levelInd).m_maxOverstatement_m : 0.0;
+        return accuracy;
+    }
+
+    const DemTile::Level& DemTile::getLevel(const std::size_t levelInd) const {
+        std::call_once(m_levelOnceFlagList[levelInd], [this, levelInd] { buildLevel(levelInd, m_levelList[levelInd]); });
+        return m_levelList[levelInd];
+    }
+
+    void DemTile::buildLevel(const std::size_t levelInd, Level& level) const {
+        const std::size_t factor = std::size_t{1u} << levelInd;
+        const std::size_t lastInd = m_numSamplesPerSide - 1u;
+        const std::size_t numCoarseSamples = lastInd / factor + 1u;
+
+        // Window of a coarse sample: every full resolution sample within one coarse sample of it
+        const auto findWindow = [factor, lastInd](const std::size_t coarseInd) {
+            const std::size_t centerInd = coarseInd * factor;
+            return std::make_pair((centerInd > factor) ? centerInd - factor : std::size_t{0u}, std::min(centerInd + factor, lastInd));
+        };
+
+        // The window is separable, so take the highest & lowest along each row first, then down the columns
+        std::vector<std::int16_t> rowMaxList(m_numSamplesPerSide * numCoarseSamples);
+        std::vector<std::int16_t> rowMinList(m_numSamplesPerSide * numCoarseSamples);
+        for (std::size_t rowInd = 0; rowInd < m_numSamplesPerSide; rowInd++) {
+            for (std::size_t coarseColInd = 0; coarseColInd < numCoarseSamples; coarseColInd++) {
+                const auto [startColInd, endColInd] = findWindow(coarseColInd);
+                int maxHeight_m = kVoidHeight;
+                int minHeight_m = INT16_MAX;
+                for (std::size_t colInd = startColInd; colInd <= endColInd; colInd++) {
+                    const std::int16_t height_m = getSample_m(rowInd, colInd);
+                    if (height_m != kVoidHeight) {
+                        maxHeight_m = std::max(maxHeight_m, static_cast<int>(height_m));
+                        minHeight_m = std::min(minHeight_m, static_cast<int>(height_m));
+                    }
+                }
+                rowMaxList[rowInd * numCoarseSamples + coarseColInd] = static_cast<std::int16_t>(maxHeight_m);
+                rowMinList[rowInd * numCoarseSamples + coarseColInd] = static_cast<std::int16_t>(minHeight_m);
+            }
+        }
+
+        level.m_numSamplesPerSide = numCoarseSamples;
+        level.m_heightList_m.resize(numCoarseSamples * numCoarseSamples);
+        level.m_maxOverstatement_m = 0.0;
+        for (std::size_t coarseRowInd = 0; coarseRowInd < numCoarseSamples; coarseRowInd++) {
+            const auto [startRowInd, endRowInd] = findWindow(coarseRowInd);
+            for (std::size_t coarseColInd = 0; coarseColInd < numCoarseSamples; coarseColInd++) {
+                int maxHeight_m = kVoidHeight;
+                int minHeight_m = INT16_MAX;
+                for (std::size_t rowInd = startRowInd; rowInd <= endRowInd; rowInd++) {
+                    const std::int16_t rowMax_m = rowMaxList[rowInd * numCoarseSamples + coarseColInd];
+                    if (rowMax_m != kVoidHeight) {
+                        maxHeight_m = std::max(maxHeight_m, static_cast<int>(rowMax_m));
+                        minHeight_m = std::min(minHeight_m, static_cast<int>(rowMinList[rowInd * numCoarseSamples + coarseColInd]));
+                    }
+                }
+                level.m_heightList_m[coarseRowInd * numCoarseSamples + coarseColInd] = static_cast<std::int16_t>(maxHeight_m);
+
+                // Any point interpolated from this sample lies in its window, so it can't be overstated by more than the window's range
+                if (maxHeight_m != kVoidHeight) {
+                    level.m_maxOverstatement_m = std::max(level.m_maxOverstatement_m, static_cast<double>(maxHeight_m - minHeight_m));
+                }
+            }
+        }
+    }
+} // end namespace
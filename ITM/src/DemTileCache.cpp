@@ -0,0 +1,141 @@
+#include <ITM/DemTileCache.h>
+#include <ITM/DemTileStore.h>
+
+#include <filesystem>
+
+namespace NTIA::ITM {
+    DemTileCache::DemTileCache(std::string directoryPath, const std::size_t budget_bytes)
+                : m_directoryPath(std::move(directoryPath)), m_budget_bytes(budget_bytes), m_cachedBytes(0u),
+                m_numHits(0u), m_numMisses(0u), m_numPrefetched(0u), m_numEvictions(0u), m_isStopping(false) {
+        m_prefetchThread = std::thread(&DemTileCache::runPrefetchThread, this);
+    }
+
+    DemTileCache::~DemTileCache() {
+        {
+            std::lock_guard<std::mutex> prefetchLock(m_prefetchMutex);
+            m_isStopping = true;
+        }
+        m_prefetchCondition.notify_all();
+        m_prefetchThread.join();
+    }
+
+    std::shared_ptr<const DemTile> DemTileCache::getTile(const int southLat_deg, const int westLon_deg) {
+        bool isCached = false;
+        std::shared_ptr<const DemTile> tile;
+        {
+            std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+            tile = findOrLoadTile({ southLat_deg, westLon_deg }, isCached);
+        }
+
+        if (isCached) {
+            m_numHits.fetch_add(1u, std::memory_order_relaxed);
+        }
+        else {
+            m_numMisses.fetch_add(1u, std::memory_order_relaxed);
+        }
+        return tile;
+    }
+
+    void DemTileCache::prefetchTile(const int southLat_deg, const int westLon_deg) {
+        const TileCorner corner { southLat_deg, westLon_deg };
+        {
+            std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+            if (m_entryMap.count(corner) > 0u || m_missingTileSet.count(corner) > 0u) {
+                return;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> prefetchLock(m_prefetchMutex);
+            if (!m_queuedTileSet.insert(corner).second) {
+                return;
+            }
+            m_prefetchQueue.push_back(corner);
+        }
+        m_prefetchCondition.notify_one();
+    }
+
+    DemTileCacheStats DemTileCache::getStats() const {
+        DemTileCacheStats stats;
+        stats.m_numHits = m_numHits.load(std::memory_order_relaxed);
+        stats.m_numMisses = m_numMisses.load(std::memory_order_relaxed);
+        stats.m_numPrefetched = m_numPrefetched.load(std::memory_order_relaxed);
+        stats.m_numEvictions = m_numEvictions.load(std::memory_order_relaxed);
+
+        std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+        stats.m_numCachedTiles = m_lruList.size();
+        stats.m_cachedBytes = m_cachedBytes;
+        return stats;
+    }
+
+    std::shared_ptr<const DemTile> DemTileCache::findOrLoadTile(const TileCorner& corner, bool& isCached) {
+        const auto entryIter = m_entryMap.find(corner);
+        if (entryIter != m_entryMap.end()) {
+            // Move to the front of the list, as the most recently used
+            m_lruList.splice(m_lruList.begin(), m_lruList, entryIter->second);
+            isCached = true;
+            return entryIter->second->m_tile;
+        }
+        if (m_missingTileSet.count(corner) > 0u) {
+            isCached = true;
+            return nullptr;
+        }
+        isCached = false;
+
+        // Mapping a tile doesn't read it, so it's cheap enough to do while holding the lock
+        const std::filesystem::path tilePath = std::filesystem::path(m_directoryPath) / DemTileStore::makeTileFileName(corner.first, corner.second);
+        if (!std::filesystem::exists(tilePath)) {
+            m_missingTileSet.insert(corner);
+            return nullptr;
+        }
+        std::shared_ptr<const DemTile> tile = std::make_shared<const DemTile>(tilePath.string(), corner.first, corner.second);
+
+        m_lruList.push_front({ corner, tile });
+        m_entryMap.emplace(corner, m_lruList.begin());
+        m_cachedBytes += tile->getSizeBytes();
+
+        // Drop the least recently used tiles until back within the budget (always keeping the new one)
+        while (m_cachedBytes > m_budget_bytes && m_lruList.size() > 1u) {
+            const CacheEntry& lastEntry = m_lruList.back();
+            m_cachedBytes -= lastEntry.m_tile->getSizeBytes();
+            m_entryMap.erase(lastEntry.m_corner);
+            m_lruList.pop_back();
+            m_numEvictions.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        return tile;
+    }
+
+    void DemTileCache::runPrefetchThread() {
+        while (true) {
+            TileCorner corner;
+            {
+                std::unique_lock<std::mutex> prefetchLock(m_prefetchMutex);
+                m_prefetchCondition.wait(prefetchLock, [this] { return m_isStopping || !m_prefetchQueue.empty(); });
+                if (m_isStopping) {
+                    return;
+                }
+                corner = m_prefetchQueue.front();
+                m_prefetchQueue.pop_front();
+                m_queuedTileSet.erase(corner);
+            }
+
+            bool isCached = false;
+            std::shared_ptr<const DemTile> tile;
+            try {
+                std::lock_guard<std::mutex> cacheLock(m_cacheMutex);
+                tile = findOrLoadTile(corner, isCached);
+            }
+            catch (const std::exception&) {
+                // Prefetching is only a hint: a tile which can't be mapped fails again, and is reported, when it's actually needed
+                continue;
+            }
+
+            if (tile != nullptr && !isCached) {
+                m_numPrefetched.fetch_add(1u, std::memory_order_relaxed);
+
+                // Start reading the tile in, outside of the lock
+                tile->adviseWillNeed();
+            }
+        }
+    }
+} // end namespace
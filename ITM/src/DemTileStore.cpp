@@ -0,0 +1,229 @@
+#include <ITM/DemTileStore.h>
+
+#include <algorithm>
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM {
+    namespace {
+        // NOTE: WGS-84 mean Earth radius is 6371008.7714 meters
+        double constexpr kMeanEarthRadius_m { 6371008.7714 };
+        double constexpr kDegToRad { M_PI / 180.0 };
+
+        /// @brief South-west corner of the tile holding a point, with the longitude wrapped into [-180, 180)
+        std::pair<int, int> findTileCorner(const double& lat_deg, const double& lon_deg) {
+            const double wrappedLon_deg = lon_deg - 360.0 * std::floor((lon_deg + 180.0) / 360.0);
+            const int southLat_deg = std::clamp(static_cast<int>(std::floor(lat_deg)), -90, 89);
+            const int westLon_deg = std::clamp(static_cast<int>(std::floor(wrappedLon_deg)), -180, 179);
+            return { southLat_deg, westLon_deg };
+        }
+
+        /// @brief Points along the great circle between two points, found by spherical linear interpolation of their unit vectors
+        class GreatCirclePath {
+        public:
+            GreatCirclePath(const GeoPoint& startPoint, const GeoPoint& endPoint, const double& pathDist_m)
+                        : m_startPoint(startPoint), m_endPoint(endPoint) {
+                const double startLat_rad = startPoint.m_lat_deg * kDegToRad;
+                const double startLon_rad = startPoint.m_lon_deg * kDegToRad;
+                const double endLat_rad = endPoint.m_lat_deg * kDegToRad;
+                const double endLon_rad = endPoint.m_lon_deg * kDegToRad;
+                m_startVector[0] = std::cos(startLat_rad) * std::cos(startLon_rad);
+                m_startVector[1] = std::cos(startLat_rad) * std::sin(startLon_rad);
+                m_startVector[2] = std::sin(startLat_rad);
+                m_endVector[0] = std::cos(endLat_rad) * std::cos(endLon_rad);
+                m_endVector[1] = std::cos(endLat_rad) * std::sin(endLon_rad);
+                m_endVector[2] = std::sin(endLat_rad);
+
+                m_angularDist_rad = pathDist_m / kMeanEarthRadius_m;
+                m_sinAngularDist = std::sin(m_angularDist_rad);
+            }
+
+            /// @param pathFrac Fraction of the way from the start point to the end point (0 <= pathFrac <= 1)
+            GeoPoint calcPoint(const double& pathFrac) const {
+                if (pathFrac <= 0.0) {
+                    return m_startPoint;
+                }
+                if (pathFrac >= 1.0) {
+                    return m_endPoint;
+                }
+
+                // Nearly coincident end points are interpolated linearly, where the spherical weights lose precision
+                double startWeight = 1.0 - pathFrac;
+                double endWeight = pathFrac;
+                if (m_sinAngularDist > 1.0e-12) {
+                    startWeight = std::sin((1.0 - pathFrac) * m_angularDist_rad) / m_sinAngularDist;
+                    endWeight = std::sin(pathFrac * m_angularDist_rad) / m_sinAngularDist;
+                }
+
+                const double x = startWeight * m_startVector[0] + endWeight * m_endVector[0];
+                const double y = startWeight * m_startVector[1] + endWeight * m_endVector[1];
+                const double z = startWeight * m_startVector[2] + endWeight * m_endVector[2];
+                return { std::atan2(z, std::sqrt(x * x + y * y)) / kDegToRad, std::atan2(y, x) / kDegToRad };
+            }
+
+        private:
+            GeoPoint m_startPoint;
+            GeoPoint m_endPoint;
+            double m_startVector[3];
+            double m_endVector[3];
+            double m_angularDist_rad;
+            double m_sinAngularDist;
+        };
+
+        // Step used to find the tiles a path crosses when prefetching (about 1 km, well under the size of a tile)
+        double constexpr kPrefetchStep_deg { 0.01 };
+    }
+
+    DemTileStore::DemTileStore(std::string directoryPath, const std::size_t cacheBudget_bytes)
+                : m_tileCache(std::move(directoryPath), cacheBudget_bytes) {
+        if (!std::filesystem::is_directory(m_tileCache.getDirectoryPath())) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTileStore::DemTileStore(): " << m_tileCache.getDirectoryPath() << " is not a directory";
+            throw std::domain_error(oStrStream.str());
+        }
+    }
+
+    std::string DemTileStore::makeTileFileName(const int southLat_deg, const int westLon_deg) {
+        std::ostringstream oStrStream;
+        oStrStream << ((southLat_deg < 0) ? 'S' : 'N') << std::setfill('0') << std::setw(2) << std::abs(southLat_deg)
+                    << ((westLon_deg < 0) ? 'W' : 'E') << std::setw(3) << std::abs(westLon_deg) << ".hgt";
+        return oStrStream.str();
+    }
+
+    std::shared_ptr<const DemTile> DemTileStore::getTile(const int southLat_deg, const int westLon_deg) {
+        return m_tileCache.getTile(southLat_deg, westLon_deg);
+    }
+
+    double DemTileStore::calcHeight_m(const GeoPoint& point) {
+        const auto [southLat_deg, westLon_deg] = findTileCorner(point.m_lat_deg, point.m_lon_deg);
+        const std::shared_ptr<const DemTile> tile = getTile(southLat_deg, westLon_deg);
+        if (tile == nullptr) {
+            return 0.0;
+        }
+
+        const double wrappedLon_deg = static_cast<double>(westLon_deg) + (point.m_lon_deg - std::floor(point.m_lon_deg));
+        return tile->calcHeight_m(point.m_lat_deg, wrappedLon_deg);
+    }
+
+    double DemTileStore::calcGreatCircleDist_m(const GeoPoint& startPoint, const GeoPoint& endPoint) {
+        // Haversine formula, which stays accurate for the short distances profiles are sampled at
+        const double startLat_rad = startPoint.m_lat_deg * kDegToRad;
+        const double endLat_rad = endPoint.m_lat_deg * kDegToRad;
+        const double sinHalfDeltaLat = std::sin(0.5 * (endLat_rad - startLat_rad));
+        const double sinHalfDeltaLon = std::sin(0.5 * (endPoint.m_lon_deg - startPoint.m_lon_deg) * kDegToRad);
+
+        const double haversine = sinHalfDeltaLat * sinHalfDeltaLat + std::cos(startLat_rad) * std::cos(endLat_rad) * sinHalfDeltaLon * sinHalfDeltaLon;
+        return 2.0 * kMeanEarthRadius_m * std::asin(std::min(1.0, std::sqrt(haversine)));
+    }
+
+    double DemTileStore::extractProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& maxSampleResolution_m,
+                std::vector<double>& terrainHeightList_m) {
+        if (!(maxSampleResolution_m > 0.0)) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTileStore::extractProfile(): "
+                        << "Sample resolution must be positive (maxSampleResolution_m = " << maxSampleResolution_m << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        const double pathDist_m = calcGreatCircleDist_m(txPoint, rxPoint);
+        const std::size_t numPointsMinusTx = std::max(std::size_t{1u}, static_cast<std::size_t>(std::ceil(pathDist_m / maxSampleResolution_m)));
+        return sampleProfile(txPoint, rxPoint, pathDist_m, numPointsMinusTx, 0.0, terrainHeightList_m).m_sampleResolution_m;
+    }
+
+    DemProfileInfo DemTileStore::extractProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& maxSampleResolution_m,
+                const std::size_t maxNumPoints, std::vector<double>& terrainHeightList_m) {
+        if (!(maxSampleResolution_m > 0.0)) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTileStore::extractProfile(): "
+                        << "Sample resolution must be positive (maxSampleResolution_m = " << maxSampleResolution_m << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (maxNumPoints < 2u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: DemTileStore::extractProfile(): "
+                        << "A profile needs at least 2 points (maxNumPoints = " << maxNumPoints << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        const double pathDist_m = calcGreatCircleDist_m(txPoint, rxPoint);
+        const std::size_t numPointsMinusTx = std::clamp(static_cast<std::size_t>(std::ceil(pathDist_m / maxSampleResolution_m)),
+                    std::size_t{1u}, maxNumPoints - 1u);
+        const double sampleResolution_m = pathDist_m / static_cast<double>(numPointsMinusTx);
+        return sampleProfile(txPoint, rxPoint, pathDist_m, numPointsMinusTx, sampleResolution_m, terrainHeightList_m);
+    }
+
+    DemProfileInfo DemTileStore::sampleProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint, const double& pathDist_m,
+                const std::size_t numPointsMinusTx, const double& maxLevelSpacing_m, std::vector<double>& terrainHeightList_m) {
+        terrainHeightList_m.resize(numPointsMinusTx + 1u);
+
+        const GreatCirclePath greatCirclePath(txPoint, rxPoint, pathDist_m);
+
+        DemProfileInfo profileInfo;
+        profileInfo.m_sampleResolution_m = pathDist_m / static_cast<double>(numPointsMinusTx);
+        profileInfo.m_maxLevelInd = 0u;
+        profileInfo.m_maxOverstatement_m = 0.0;
+
+        // The tile under the previous point is kept at hand, since successive points almost always share it
+        std::shared_ptr<const DemTile> currentTile;
+        std::size_t currentLevelInd = 0u;
+        std::pair<int, int> currentTileCorner { 0, 0 };
+        bool hasCurrentTile = false;
+
+        for (std::size_t pointInd = 0; pointInd <= numPointsMinusTx; pointInd++) {
+            const GeoPoint point = greatCirclePath.calcPoint(static_cast<double>(pointInd) / static_cast<double>(numPointsMinusTx));
+
+            const std::pair<int, int> tileCorner = findTileCorner(point.m_lat_deg, point.m_lon_deg);
+            if (!hasCurrentTile || tileCorner != currentTileCorner) {
+                currentTile = getTile(tileCorner.first, tileCorner.second);
+                currentTileCorner = tileCorner;
+                hasCurrentTile = true;
+
+                // Tiles may differ in resolution, so the level is picked for each. Spacing is measured north-south, which is
+                // never less than east-west
+                currentLevelInd = 0u;
+                while (currentTile != nullptr && currentLevelInd + 1u < DemTile::kNumLevels
+                            && currentTile->getLevelAccuracy(currentLevelInd + 1u).m_sampleSpacing_deg * kDegToRad * kMeanEarthRadius_m <= maxLevelSpacing_m) {
+                    currentLevelInd++;
+                }
+                if (currentTile != nullptr && currentLevelInd > 0u) {
+                    profileInfo.m_maxLevelInd = std::max(profileInfo.m_maxLevelInd, currentLevelInd);
+                    profileInfo.m_maxOverstatement_m = std::max(profileInfo.m_maxOverstatement_m,
+                                currentTile->getLevelAccuracy(currentLevelInd).m_maxOverstatement_m);
+                }
+            }
+
+            if (currentTile == nullptr) {
+                terrainHeightList_m[pointInd] = 0.0;
+            }
+            else {
+                const double wrappedLon_deg = static_cast<double>(tileCorner.second) + (point.m_lon_deg - std::floor(point.m_lon_deg));
+                terrainHeightList_m[pointInd] = currentTile->calcHeight_m(point.m_lat_deg, wrappedLon_deg, currentLevelInd);
+            }
+        }
+
+        return profileInfo;
+    }
+
+    void DemTileStore::prefetchProfile(const GeoPoint& txPoint, const GeoPoint& rxPoint) {
+        const double pathDist_m = calcGreatCircleDist_m(txPoint, rxPoint);
+        const GreatCirclePath greatCirclePath(txPoint, rxPoint, pathDist_m);
+
+        const double pathDist_deg = pathDist_m / kMeanEarthRadius_m / kDegToRad;
+        const std::size_t numSteps = std::max(std::size_t{1u}, static_cast<std::size_t>(std::ceil(pathDist_deg / kPrefetchStep_deg)));
+
+        std::pair<int, int> lastTileCorner { 0, 0 };
+        for (std::size_t stepInd = 0; stepInd <= numSteps; stepInd++) {
+            const GeoPoint point = greatCirclePath.calcPoint(static_cast<double>(stepInd) / static_cast<double>(numSteps));
+            const std::pair<int, int> tileCorner = findTileCorner(point.m_lat_deg, point.m_lon_deg);
+            if (stepInd == 0u || tileCorner != lastTileCorner) {
+                m_tileCache.prefetchTile(tileCorner.first, tileCorner.second);
+                lastTileCorner = tileCorner;
+            }
+        }
+    }
+} // end namespace
@@ -1,5 +1,7 @@
 #include <ITM/ItmCommonCalculator.h>
 #include <ITM/ItmHelpers.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 
 /*=============================================================================
  |
@@ -25,14 +27,17 @@
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcDiffractLoss_dB(const double& inputDist_m, const double& effEarthRadius_m, const bool isP2P, 
-                const double& angularDist_LoS_rad, const double& maxDistSmoothEarth_LoS_m) {
-        const double attenKnifeEdge_dB = calcKnifeEdgeDiffractLoss_dB(inputDist_m, effEarthRadius_m, angularDist_LoS_rad);
+    double ItmCommonCalculator::calcDiffractLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, const double& effEarthRadius_m, const bool isP2P, 
+                const double& angularDist_LoS_rad, const double& maxDistSmoothEarth_LoS_m) const {
+        ITM_STATS_STAGE(Diffraction);
+        ITM_TRACE_STAGE(Diffraction);
 
-        const double attenSmoothEarth_dB = calcSmoothEarthDiffractLoss_dB(inputDist_m, effEarthRadius_m, angularDist_LoS_rad);
+        const double attenKnifeEdge_dB = calcKnifeEdgeDiffractLoss_dB(workspace, inputDist_m, effEarthRadius_m, angularDist_LoS_rad);
+
+        const double attenSmoothEarth_dB = calcSmoothEarthDiffractLoss_dB(workspace, inputDist_m, effEarthRadius_m, angularDist_LoS_rad);
 
         // Terrain roughness term, using d_sML__meter, per [ERL 79-ITS 67, page 3-13]
-        const double tempTerrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(maxDistSmoothEarth_LoS_m, m_itmResults.m_intermResults.m_terrainIrreg_m);
+        const double tempTerrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(maxDistSmoothEarth_LoS_m, workspace.m_itmResults.m_intermResults.m_terrainIrreg_m);
 
         const double sigmaH_m = ItmHelpers::calcSigmaH_m(tempTerrainIrreg_m);
 
@@ -41,10 +46,10 @@ namespace NTIA::ITM {
         const double attenClutterFactor_dB = std::min({15.0, 5.0 * std::log10(1.0 + 1.0e-5 * m_txHeight_m * m_rxHeight_m * m_freq_MHz * sigmaH_m)});
 
         // compute the weighting factor in the following calculations
-        double temp2_terrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(inputDist_m, m_itmResults.m_intermResults.m_terrainIrreg_m);
+        double temp2_terrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(inputDist_m, workspace.m_itmResults.m_intermResults.m_terrainIrreg_m);
 
         double q = m_txHeight_m * m_rxHeight_m;
-        const double qSubK = m_itmResults.m_intermResults.m_txEffHeight_m * m_itmResults.m_intermResults.m_rxEffHeight_m - q;
+        const double qSubK = workspace.m_itmResults.m_intermResults.m_txEffHeight_m * workspace.m_itmResults.m_intermResults.m_rxEffHeight_m - q;
 
         // For low antennas with known path parameters, C ~= 10 [ERL 79-ITS 67, page 3-8]
         if (isP2P) {
@@ -52,8 +57,8 @@ namespace NTIA::ITM {
         }
         const double term1 = sqrt(1.0 + qSubK / q);                              // square root term in [ERL 79-ITS 67, Eqn 2.23]
 
-        const double maxDist_LoS_m = m_itmResults.m_intermResults.m_txHorizonDist_m + 
-                        m_itmResults.m_intermResults.m_rxHorizonDist_m;         // Maximum line-of-sight distance for actual path
+        const double maxDist_LoS_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m + 
+                        workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;         // Maximum line-of-sight distance for actual path
         q = (term1 + (-angularDist_LoS_rad * effEarthRadius_m + maxDist_LoS_m) / inputDist_m) * 
                     std::min({temp2_terrainIrreg_m * m_freq_MHz / ItmHelpers::kWaveToMHzFreqTerm, 6283.2});
 
@@ -1,4 +1,4 @@
-#include "ITM/itm.h"
+#include <ITM/ItmHelpers.h>
 
 namespace NTIA::ITM::ItmHelpers {
     double calcFSPL_dB(const double& dist_m, const double& freq_MHz) {
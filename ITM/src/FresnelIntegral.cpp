@@ -1,11 +1,12 @@
 #include <ITM/ItmHelpers.h>
 
 namespace NTIA::ITM::ItmHelpers {
-    double calcFresnelIntegral(const double& nu)
+    double calcFresnelIntegral(const double& nuSqrd)
     {
-        if (nu < 2.4)
-            return 6.02 + 9.11 * nu - 1.27 * nu * nu;   // [TN101v2, Eqn III.24b] and [ERL 79-ITS 67, Eqn 3.27a & 3.27b]
+        // The caller hands over nu^2 (see [TN101, Eqn I.7]), so the break point nu = 2.4 sits at nu^2 = 5.76
+        if (nuSqrd < 5.76)
+            return 6.02 + 9.11 * std::sqrt(nuSqrd) - 1.27 * nuSqrd;     // [TN101v2, Eqn III.24b] and [ERL 79-ITS 67, Eqn 3.27a & 3.27b]
         else
-            return 12.953 + 20.0 * std::log10(nu);      // [TN101v2, Eqn III.24c] and [ERL 79-ITS 67, Eqn 3.27a & 3.27b]
+            return 12.953 + 10.0 * std::log10(nuSqrd);                  // [TN101v2, Eqn III.24c] and [ERL 79-ITS 67, Eqn 3.27a & 3.27b]
     }
 }
\ No newline at end of file
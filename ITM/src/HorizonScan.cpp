@@ -0,0 +1,208 @@
+#include <ITM/HorizonScan.h>
+
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define ITM_HORIZON_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace NTIA::ITM::HorizonScan {
+    namespace {
+        using KernelFunction = HorizonCandidate (*)(const double*, const double*, std::size_t, double, double);
+
+        /// @brief Carry a scan on from the given best candidate over points [firstInd, numPoints), one at a time
+        HorizonCandidate scanRemainingPoints(const double* heightList_m, const double* distList_m, std::size_t firstInd,
+                    const std::size_t numPoints, const double radial_m, const double twoEffEarthRadius_m, HorizonCandidate bestCandidate) {
+            for (; firstInd < numPoints; firstInd++) {
+                const double angle_rad = (heightList_m[firstInd] - radial_m) / distList_m[firstInd] - distList_m[firstInd] / twoEffEarthRadius_m;
+                if (angle_rad > bestCandidate.m_angle_rad) {
+                    bestCandidate = HorizonCandidate { firstInd, angle_rad };
+                }
+            }
+            return bestCandidate;
+        }
+
+        /// @brief Merge per-lane candidates (each the first strict maximum of its own lane) into the first strict maximum overall
+        HorizonCandidate reduceLanes(const double* laneAngleList_rad, const double* laneIndList, const std::size_t numLanes) {
+            HorizonCandidate bestCandidate { 0u, -std::numeric_limits<double>::infinity() };
+            for (std::size_t laneInd = 0; laneInd < numLanes; laneInd++) {
+                const std::size_t pointInd = static_cast<std::size_t>(laneIndList[laneInd]);
+                if (pointInd == 0u) {
+                    continue;
+                }
+                if (laneAngleList_rad[laneInd] > bestCandidate.m_angle_rad ||
+                            (laneAngleList_rad[laneInd] == bestCandidate.m_angle_rad && pointInd < bestCandidate.m_pointInd)) {
+                    bestCandidate = HorizonCandidate { pointInd, laneAngleList_rad[laneInd] };
+                }
+            }
+            return bestCandidate;
+        }
+
+        HorizonCandidate findHorizonPoint_scalar(const double* heightList_m, const double* distList_m, const std::size_t numPoints,
+                    const double radial_m, const double twoEffEarthRadius_m) {
+            return scanRemainingPoints(heightList_m, distList_m, 1u, numPoints, radial_m, twoEffEarthRadius_m,
+                        HorizonCandidate { 0u, -std::numeric_limits<double>::infinity() });
+        }
+
+#ifdef ITM_HORIZON_SCAN_X86
+        __attribute__((target("avx2")))
+        HorizonCandidate findHorizonPoint_avx2(const double* heightList_m, const double* distList_m, const std::size_t numPoints,
+                    const double radial_m, const double twoEffEarthRadius_m) {
+            constexpr std::size_t kNumLanes = 4u;
+            if (numPoints < 1u + kNumLanes) {
+                return findHorizonPoint_scalar(heightList_m, distList_m, numPoints, radial_m, twoEffEarthRadius_m);
+            }
+
+            const __m256d radialVec = _mm256_set1_pd(radial_m);
+            const __m256d twoEffEarthRadiusVec = _mm256_set1_pd(twoEffEarthRadius_m);
+            const __m256d indStepVec = _mm256_set1_pd(static_cast<double>(kNumLanes));
+            __m256d bestAngleVec = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+            __m256d bestIndVec = _mm256_setzero_pd();
+            __m256d indVec = _mm256_setr_pd(1.0, 2.0, 3.0, 4.0);
+
+            std::size_t pointInd = 1u;
+            for (; pointInd + kNumLanes <= numPoints; pointInd += kNumLanes) {
+                const __m256d heightVec = _mm256_loadu_pd(heightList_m + pointInd);
+                const __m256d distVec = _mm256_loadu_pd(distList_m + pointInd);
+                const __m256d angleVec = _mm256_sub_pd(_mm256_div_pd(_mm256_sub_pd(heightVec, radialVec), distVec),
+                            _mm256_div_pd(distVec, twoEffEarthRadiusVec));
+
+                // Strictly larger only, so each lane keeps the first point reaching its maximum
+                const __m256d isBetterMask = _mm256_cmp_pd(angleVec, bestAngleVec, _CMP_GT_OQ);
+                bestAngleVec = _mm256_blendv_pd(bestAngleVec, angleVec, isBetterMask);
+                bestIndVec = _mm256_blendv_pd(bestIndVec, indVec, isBetterMask);
+                indVec = _mm256_add_pd(indVec, indStepVec);
+            }
+
+            alignas(32) double laneAngleList_rad[kNumLanes];
+            alignas(32) double laneIndList[kNumLanes];
+            _mm256_store_pd(laneAngleList_rad, bestAngleVec);
+            _mm256_store_pd(laneIndList, bestIndVec);
+
+            return scanRemainingPoints(heightList_m, distList_m, pointInd, numPoints, radial_m, twoEffEarthRadius_m,
+                        reduceLanes(laneAngleList_rad, laneIndList, kNumLanes));
+        }
+
+        __attribute__((target("avx512f")))
+        HorizonCandidate findHorizonPoint_avx512(const double* heightList_m, const double* distList_m, const std::size_t numPoints,
+                    const double radial_m, const double twoEffEarthRadius_m) {
+            constexpr std::size_t kNumLanes = 8u;
+            if (numPoints < 1u + kNumLanes) {
+                return findHorizonPoint_scalar(heightList_m, distList_m, numPoints, radial_m, twoEffEarthRadius_m);
+            }
+
+            const __m512d radialVec = _mm512_set1_pd(radial_m);
+            const __m512d twoEffEarthRadiusVec = _mm512_set1_pd(twoEffEarthRadius_m);
+            const __m512d indStepVec = _mm512_set1_pd(static_cast<double>(kNumLanes));
+            __m512d bestAngleVec = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+            __m512d bestIndVec = _mm512_setzero_pd();
+            __m512d indVec = _mm512_setr_pd(1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0);
+
+            std::size_t pointInd = 1u;
+            for (; pointInd + kNumLanes <= numPoints; pointInd += kNumLanes) {
+                const __m512d heightVec = _mm512_loadu_pd(heightList_m + pointInd);
+                const __m512d distVec = _mm512_loadu_pd(distList_m + pointInd);
+                const __m512d angleVec = _mm512_sub_pd(_mm512_div_pd(_mm512_sub_pd(heightVec, radialVec), distVec),
+                            _mm512_div_pd(distVec, twoEffEarthRadiusVec));
+
+                // Strictly larger only, so each lane keeps the first point reaching its maximum
+                const __mmask8 isBetterMask = _mm512_cmp_pd_mask(angleVec, bestAngleVec, _CMP_GT_OQ);
+                bestAngleVec = _mm512_mask_blend_pd(isBetterMask, bestAngleVec, angleVec);
+                bestIndVec = _mm512_mask_blend_pd(isBetterMask, bestIndVec, indVec);
+                indVec = _mm512_add_pd(indVec, indStepVec);
+            }
+
+            alignas(64) double laneAngleList_rad[kNumLanes];
+            alignas(64) double laneIndList[kNumLanes];
+            _mm512_store_pd(laneAngleList_rad, bestAngleVec);
+            _mm512_store_pd(laneIndList, bestIndVec);
+
+            return scanRemainingPoints(heightList_m, distList_m, pointInd, numPoints, radial_m, twoEffEarthRadius_m,
+                        reduceLanes(laneAngleList_rad, laneIndList, kNumLanes));
+        }
+#endif
+
+        KernelType selectKernelType() {
+#ifdef ITM_HORIZON_SCAN_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return Avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return Avx2;
+            }
+#endif
+            return Scalar;
+        }
+
+        KernelFunction selectKernel(const KernelType& kernelType) {
+            switch (kernelType) {
+#ifdef ITM_HORIZON_SCAN_X86
+                case Avx512:
+                    return findHorizonPoint_avx512;
+                case Avx2:
+                    return findHorizonPoint_avx2;
+#endif
+                default:
+                    return findHorizonPoint_scalar;
+            }
+        }
+    }
+
+    KernelType getKernelType() {
+        static const KernelType kernelType = selectKernelType();
+        return kernelType;
+    }
+
+    bool isKernelSupported(const KernelType& kernelType) {
+        switch (kernelType) {
+            case Scalar:
+                return true;
+#ifdef ITM_HORIZON_SCAN_X86
+            case Avx2:
+                return getKernelType() == Avx2 || getKernelType() == Avx512;
+            case Avx512:
+                return getKernelType() == Avx512;
+#endif
+            default:
+                return false;
+        }
+    }
+
+    void fillTxDistances(std::span<double> distList_m, const double& sampleResolution_m) {
+        double dist_m = 0.0;
+        for (double& pointDist_m : distList_m) {
+            pointDist_m = dist_m;
+            dist_m += sampleResolution_m;
+        }
+    }
+
+    void fillRxDistances(std::span<double> distList_m, const double& pathDist_m, const double& sampleResolution_m) {
+        double dist_m = pathDist_m;
+        for (double& pointDist_m : distList_m) {
+            pointDist_m = dist_m;
+            dist_m -= sampleResolution_m;
+        }
+    }
+
+    HorizonCandidate findHorizonPoint(std::span<const double> terrainHeightList_m, std::span<const double> distList_m,
+                const double& radial_m, const double& effEarthRadius_m) {
+        static const KernelFunction kernel = selectKernel(getKernelType());
+        return kernel(terrainHeightList_m.data(), distList_m.data(), distList_m.size(), radial_m, 2.0 * effEarthRadius_m);
+    }
+
+    HorizonCandidate findHorizonPoint(std::span<const double> terrainHeightList_m, std::span<const double> distList_m,
+                const double& radial_m, const double& effEarthRadius_m, const KernelType& kernelType) {
+        if (!isKernelSupported(kernelType)) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: HorizonScan::findHorizonPoint(): "
+                        << "Kernel type " << kernelType << " is not supported by this build or CPU";
+            throw std::domain_error(oStrStream.str());
+        }
+        const KernelFunction kernel = selectKernel(kernelType);
+        return kernel(terrainHeightList_m.data(), distList_m.data(), distList_m.size(), radial_m, 2.0 * effEarthRadius_m);
+    }
+} // end namespace
@@ -1,4 +1,6 @@
 #include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ItmTrace.h>
 
 /*=============================================================================
  |
@@ -46,67 +48,68 @@
  |
  *===========================================================================*/
 namespace NTIA::ITM {
-    ItmResults ItmCommonCalculator::calcItmLoss_area_dB(const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria, const double& dist_km,
-                const double& terrainIrregularityParam_m) {
-        // switch from percentages to ratios
-        time /= 100;
-        location /= 100;
-        situation /= 100;
+    ReferenceAttenuationCurve ItmCommonCalculator::prepareRefAttenCurve_area(const SitingCriteria& txSitingCriteria,
+                const SitingCriteria& rxSitingCriteria, const double& terrainIrregularityParam_m, const double& minDist_km, const double& maxDist_km) {
+        return prepareRefAttenCurve_area(txSitingCriteria, rxSitingCriteria, terrainIrregularityParam_m, minDist_km, maxDist_km, m_workspace);
+    }
 
-        // additional area mode parameter validation checks
-        if (d__km <= 0)
-            return ERROR__PATH_DISTANCE;
-        if (delta_h__meter < 0)
-            return ERROR__DELTA_H;
-        if (tx_site_criteria != SITING_CRITERIA__RANDOM &&
-            tx_site_criteria != SITING_CRITERIA__CAREFUL &&
-            tx_site_criteria != SITING_CRITERIA__VERY_CAREFUL)
-            return ERROR__TX_SITING_CRITERIA;
-        if (rx_site_criteria != SITING_CRITERIA__RANDOM &&
-            rx_site_criteria != SITING_CRITERIA__CAREFUL &&
-            rx_site_criteria != SITING_CRITERIA__VERY_CAREFUL)
-            return ERROR__RX_SITING_CRITERIA;
+    ReferenceAttenuationCurve ItmCommonCalculator::prepareRefAttenCurve_area(const SitingCriteria& txSitingCriteria,
+                const SitingCriteria& rxSitingCriteria, const double& terrainIrregularityParam_m, const double& minDist_km, const double& maxDist_km,
+                ItmWorkspace& workspace) const {
+        if (minDist_km <= 0.0 || maxDist_km < minDist_km) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::prepareRefAttenCurve_area(): "
+                        << "Expected a distance range with 0 < minDist_km <= maxDist_km (minDist_km = " << minDist_km
+                        << ", maxDist_km = " << maxDist_km << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (terrainIrregularityParam_m < 0.0) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::prepareRefAttenCurve_area(): "
+                        << "ITM does not support negative terrain irregularity values (terrainIrregularityParam_m = "
+                        << terrainIrregularityParam_m << ")";
+            throw std::domain_error(oStrStream.str());
+        }
 
-        int site_criteria[2] = { tx_site_criteria, rx_site_criteria };
-        double h__meter[2] = { h_tx__meter, h_rx__meter };
-        interValues->d__km = d__km;
+        for (const SitingCriteria& sitingCriteria : { txSitingCriteria, rxSitingCriteria }) {
+            if (sitingCriteria != Random && sitingCriteria != Careful && sitingCriteria != VeryCareful) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ItmCommonCalculator::prepareRefAttenCurve_area(): "
+                            << "Siting criteria must be 0 (random), 1 (careful) or 2 (very careful) (txSitingCriteria = "
+                            << static_cast<int>(txSitingCriteria) << ", rxSitingCriteria = " << static_cast<int>(rxSitingCriteria) << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
 
-        double theta_hzn[2];
-        double d_hzn__meter[2];
-        double h_e__meter[2];
-        complex<double> Z_g;
-        double N_s;
-        double gamma_e;
-        double A_ref__db = 0;
+        // Zero out / reset ITM results object
+        workspace.m_itmResults = ItmResults();
+        initialize_area(workspace, txSitingCriteria, rxSitingCriteria, terrainIrregularityParam_m);
 
-        InitializePointToPoint(f__mhz, 0.0, N_0, pol, epsilon, sigma, &Z_g, &gamma_e, &N_s);
+        return buildRefAttenCurve(workspace, false, minDist_km * 1.0e3, maxDist_km * 1.0e3);
+    }
 
-        InitializeArea(site_criteria, gamma_e, delta_h__meter, h__meter, h_e__meter, d_hzn__meter, theta_hzn);
+    ItmResults ItmCommonCalculator::calcItmLoss_area_dB(const SitingCriteria& txSitingCriteria, const SitingCriteria& rxSitingCriteria, const double& dist_km,
+                const double& terrainIrregularityParam_m) {
+        ITM_TRACE_PATH("area path");
 
-        double d__meter = d__km * 1000;
-        int propmode = MODE__NOT_SET;
-        rtn = LongleyRice(theta_hzn, f__mhz, Z_g, d_hzn__meter, h_e__meter, gamma_e, N_s, delta_h__meter, h__meter, d__meter, MODE__AREA, 
-            &A_ref__db, warnings, &propmode);
-        if (rtn != SUCCESS)
-            return rtn;
+        // Validates the inputs, resets the results & sets up the area mode geometry
+        const ReferenceAttenuationCurve refAttenCurve = prepareRefAttenCurve_area(txSitingCriteria, rxSitingCriteria,
+                    terrainIrregularityParam_m, dist_km, dist_km, m_workspace);
 
-        double A_fs__db = FreeSpaceLoss(d__meter, f__mhz);
+        IntermResults& intermResults = m_workspace.m_itmResults.m_intermResults;
+        intermResults.m_terrainProfile.m_pathDist_km = dist_km;
+        const double pathDist_m = dist_km * 1.0e3;
 
-        *A__db = A_fs__db + Variability(time, location, situation, h_e__meter, delta_h__meter, f__mhz, d__meter, A_ref__db, climate, mdvar, warnings);
+        PropagationMode propMode = NotSet;
+        intermResults.m_refAtten_dB = refAttenCurve.calcRefAtten_dB(pathDist_m, propMode);
+        intermResults.m_propMode = propMode;
+        intermResults.m_fsplAtten_dB = ItmHelpers::calcFSPL_dB(pathDist_m, m_freq_MHz);
 
-        // Save off intermediate values
-        interValues->A_ref__db = A_ref__db;
-        interValues->A_fs__db = A_fs__db;
-        interValues->delta_h__meter = delta_h__meter;
-        interValues->d_hzn__meter[0] = d_hzn__meter[0];
-        interValues->d_hzn__meter[1] = d_hzn__meter[1];
-        interValues->h_e__meter[0] = h_e__meter[0];
-        interValues->h_e__meter[1] = h_e__meter[1];
-        interValues->N_s = N_s;
-        interValues->theta_hzn[0] = theta_hzn[0];
-        interValues->theta_hzn[1] = theta_hzn[1];
-        interValues->mode = propmode;
+        // switch from percentages to ratios
+        const VariabilityCalculator variabilityCalculator = createVariabilityCalculator(m_workspace.m_itmResults);
+        m_workspace.m_itmResults.m_atten_dB = intermResults.m_fsplAtten_dB + variabilityCalculator.calcVariabilityLoss_dB(intermResults.m_refAtten_dB,
+                    m_timePercent / 100.0, m_locationPercent / 100.0, m_situationPercent / 100.0);
 
-        return results;
+        return m_workspace.m_itmResults;
     }
 } // end namespace
\ No newline at end of file
@@ -0,0 +1,160 @@
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ReferenceAttenuationCurve.h>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace NTIA::ITM {
+    namespace {
+        // Links are taken in blocks of this many, the terminal geometry of a block being worked out (one link at a time) ahead of its losses
+        constexpr std::size_t kAreaBatchBlockSize { 256u };
+
+        bool isValidSitingCriteria(const SitingCriteria& sitingCriteria) {
+            return sitingCriteria == Random || sitingCriteria == Careful || sitingCriteria == VeryCareful;
+        }
+
+        /// @return Whether two links differ in nothing but their path distance
+        bool hasSameTerminals(const AreaLinkBatch& linkBatch, const std::size_t firstLinkInd, const std::size_t secondLinkInd) {
+            return linkBatch.m_txHeightList_m[firstLinkInd] == linkBatch.m_txHeightList_m[secondLinkInd] &&
+                        linkBatch.m_rxHeightList_m[firstLinkInd] == linkBatch.m_rxHeightList_m[secondLinkInd] &&
+                        linkBatch.m_txSitingCriteriaList[firstLinkInd] == linkBatch.m_txSitingCriteriaList[secondLinkInd] &&
+                        linkBatch.m_rxSitingCriteriaList[firstLinkInd] == linkBatch.m_rxSitingCriteriaList[secondLinkInd] &&
+                        linkBatch.m_terrainIrregList_m[firstLinkInd] == linkBatch.m_terrainIrregList_m[secondLinkInd] &&
+                        linkBatch.m_freqList_MHz[firstLinkInd] == linkBatch.m_freqList_MHz[secondLinkInd];
+        }
+    }
+
+    void ItmCommonCalculator::calcItmLoss_area_batch_dB(const AreaLinkBatch& linkBatch, std::span<double> attenList_dB,
+                std::span<PropagationMode> propModeList) {
+        calcItmLoss_area_batch_dB(linkBatch, attenList_dB, propModeList, m_workspace);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_area_batch_dB(const AreaLinkBatch& linkBatch, std::span<double> attenList_dB,
+                std::span<PropagationMode> propModeList, ItmWorkspace& workspace) const {
+        const std::size_t numLinks = linkBatch.m_distList_km.size();
+        if (linkBatch.m_txHeightList_m.size() != numLinks || linkBatch.m_rxHeightList_m.size() != numLinks ||
+                    linkBatch.m_txSitingCriteriaList.size() != numLinks || linkBatch.m_rxSitingCriteriaList.size() != numLinks ||
+                    linkBatch.m_terrainIrregList_m.size() != numLinks || linkBatch.m_freqList_MHz.size() != numLinks) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_area_batch_dB(): "
+                        << "Every list of the link batch must hold " << numLinks << " entries (txHeight = " << linkBatch.m_txHeightList_m.size()
+                        << ", rxHeight = " << linkBatch.m_rxHeightList_m.size() << ", txSiting = " << linkBatch.m_txSitingCriteriaList.size()
+                        << ", rxSiting = " << linkBatch.m_rxSitingCriteriaList.size() << ", terrainIrreg = " << linkBatch.m_terrainIrregList_m.size()
+                        << ", freq = " << linkBatch.m_freqList_MHz.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (attenList_dB.size() < numLinks || propModeList.size() < numLinks) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_area_batch_dB(): "
+                        << "Expected room for " << numLinks << " outputs (attenList_dB = " << attenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        for (std::size_t linkInd = 0; linkInd < numLinks; linkInd++) {
+            const double& txHeight_m = linkBatch.m_txHeightList_m[linkInd];
+            const double& rxHeight_m = linkBatch.m_rxHeightList_m[linkInd];
+            const double& freq_MHz = linkBatch.m_freqList_MHz[linkInd];
+            if (txHeight_m < 0.5 || txHeight_m > 3.0e3 || rxHeight_m < 0.5 || rxHeight_m > 3.0e3 || freq_MHz < 20.0 || freq_MHz > 20.0e3 ||
+                        linkBatch.m_distList_km[linkInd] <= 0.0 || linkBatch.m_terrainIrregList_m[linkInd] < 0.0 ||
+                        !isValidSitingCriteria(linkBatch.m_txSitingCriteriaList[linkInd]) || !isValidSitingCriteria(linkBatch.m_rxSitingCriteriaList[linkInd])) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_area_batch_dB(): "
+                            << "Link " << linkInd << " is outside of the range supported by ITM (txHeight_m = " << txHeight_m
+                            << ", rxHeight_m = " << rxHeight_m << ", freq_MHz = " << freq_MHz
+                            << ", dist_km = " << linkBatch.m_distList_km[linkInd]
+                            << ", terrainIrregularityParam_m = " << linkBatch.m_terrainIrregList_m[linkInd]
+                            << ", txSitingCriteria = " << static_cast<int>(linkBatch.m_txSitingCriteriaList[linkInd])
+                            << ", rxSitingCriteria = " << static_cast<int>(linkBatch.m_rxSitingCriteriaList[linkInd]) << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+
+        // One calculator is retargeted at the heights & frequency of each link in turn, everything else is shared
+        ItmCommonCalculator linkCalculator = copyParameters();
+
+        // Percentages are the same for every link, and so are their normal deviates
+        const double timeDeviate = MathHelpers::calcInvComplCumulDistribFunc(m_timePercent / 100.0);
+        const double locationDeviate = MathHelpers::calcInvComplCumulDistribFunc(m_locationPercent / 100.0);
+        const double situationDeviate = MathHelpers::calcInvComplCumulDistribFunc(m_situationPercent / 100.0);
+
+        // Zero out / reset ITM results object
+        workspace.m_itmResults = ItmResults();
+        IntermResults& intermResults = workspace.m_itmResults.m_intermResults;
+
+        // Area mode takes refractivity at sea level, so every link sees the same effective earth
+        initialize_P2P(workspace, 0.0);
+        const double effEarthCurvature_perM = workspace.m_effEarthCurvature_perM;
+        intermResults.m_surfRefract_N = workspace.m_surfaceRefractivity_N;
+        double groundImpedanceFreq_MHz = std::numeric_limits<double>::quiet_NaN();
+
+        std::array<ItmHelpers::AreaTerminalGeometry, kAreaBatchBlockSize> txGeometryList;
+        std::array<ItmHelpers::AreaTerminalGeometry, kAreaBatchBlockSize> rxGeometryList;
+
+        for (std::size_t blockStartInd = 0; blockStartInd < numLinks; blockStartInd += kAreaBatchBlockSize) {
+            const std::size_t blockSize = std::min(kAreaBatchBlockSize, numLinks - blockStartInd);
+            const std::size_t blockEndInd = blockStartInd + blockSize;
+
+            // Terminal geometry of the whole block, straight from the link arrays
+            for (std::size_t blockLinkInd = 0; blockLinkInd < blockSize; blockLinkInd++) {
+                const std::size_t linkInd = blockStartInd + blockLinkInd;
+                txGeometryList[blockLinkInd] = ItmHelpers::calcAreaTerminalGeometry(linkBatch.m_txSitingCriteriaList[linkInd],
+                            linkBatch.m_txHeightList_m[linkInd], linkBatch.m_terrainIrregList_m[linkInd], effEarthCurvature_perM);
+                rxGeometryList[blockLinkInd] = ItmHelpers::calcAreaTerminalGeometry(linkBatch.m_rxSitingCriteriaList[linkInd],
+                            linkBatch.m_rxHeightList_m[linkInd], linkBatch.m_terrainIrregList_m[linkInd], effEarthCurvature_perM);
+            }
+
+            // A run of links differing only in distance (e.g. one pair of terminals at many ranges) shares one reference
+            // attenuation curve, prepared over the distances of the whole run
+            ReferenceAttenuationCurve refAttenCurve;
+            std::size_t runEndInd = blockStartInd;
+
+            for (std::size_t blockLinkInd = 0; blockLinkInd < blockSize; blockLinkInd++) {
+                const std::size_t linkInd = blockStartInd + blockLinkInd;
+                const double& freq_MHz = linkBatch.m_freqList_MHz[linkInd];
+                const double pathDist_m = linkBatch.m_distList_km[linkInd] * 1.0e3;
+
+                if (linkInd >= runEndInd) {
+                    double minRunDist_m = pathDist_m;
+                    double maxRunDist_m = pathDist_m;
+                    for (runEndInd = linkInd + 1u; runEndInd < blockEndInd && hasSameTerminals(linkBatch, linkInd, runEndInd); runEndInd++) {
+                        minRunDist_m = std::min(minRunDist_m, linkBatch.m_distList_km[runEndInd] * 1.0e3);
+                        maxRunDist_m = std::max(maxRunDist_m, linkBatch.m_distList_km[runEndInd] * 1.0e3);
+                    }
+
+                    linkCalculator.m_txHeight_m = linkBatch.m_txHeightList_m[linkInd];
+                    linkCalculator.m_rxHeight_m = linkBatch.m_rxHeightList_m[linkInd];
+                    if (freq_MHz != groundImpedanceFreq_MHz) {
+                        linkCalculator.m_freq_MHz = freq_MHz;
+                        linkCalculator.setGroundImpedance(workspace);
+                        groundImpedanceFreq_MHz = freq_MHz;
+                    }
+
+                    intermResults.m_txEffHeight_m = txGeometryList[blockLinkInd].m_effHeight_m;
+                    intermResults.m_txHorizonDist_m = txGeometryList[blockLinkInd].m_horizonDist_m;
+                    intermResults.m_txHorizonAngle_rad = txGeometryList[blockLinkInd].m_horizonAngle_rad;
+                    intermResults.m_rxEffHeight_m = rxGeometryList[blockLinkInd].m_effHeight_m;
+                    intermResults.m_rxHorizonDist_m = rxGeometryList[blockLinkInd].m_horizonDist_m;
+                    intermResults.m_rxHorizonAngle_rad = rxGeometryList[blockLinkInd].m_horizonAngle_rad;
+                    intermResults.m_terrainIrreg_m = linkBatch.m_terrainIrregList_m[linkInd];
+
+                    refAttenCurve = linkCalculator.buildRefAttenCurve(workspace, false, minRunDist_m, maxRunDist_m);
+                }
+
+                PropagationMode propMode = NotSet;
+                const double refAtten_dB = refAttenCurve.calcRefAtten_dB(pathDist_m, propMode);
+                const double fsplAtten_dB = ItmHelpers::calcFSPL_dB(pathDist_m, freq_MHz);
+
+                // Every term of the variability (effective distance, V_med, sigma_T, sigma_L & sigma_S) moves with the path distance
+                const VariabilityCalculator variabilityCalculator(m_radioClimate, static_cast<VariabilityMode>(m_varMode), freq_MHz,
+                            intermResults.m_txEffHeight_m, intermResults.m_rxEffHeight_m, intermResults.m_terrainIrreg_m, pathDist_m);
+
+                attenList_dB[linkInd] = fsplAtten_dB + variabilityCalculator.calcVariabilityLossFromDeviates_dB(refAtten_dB,
+                            timeDeviate, locationDeviate, situationDeviate);
+                propModeList[linkInd] = propMode;
+            }
+        }
+    }
+} // end namespace
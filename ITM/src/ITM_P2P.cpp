@@ -1,50 +1,236 @@
 #include <ITM/ItmCommonCalculator.h>
 #include <ITM/ItmHelpers.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 
 #include <complex>
 
 namespace NTIA::ITM {
-    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(const std::vector<double>& terrainHeightList_m, 
+    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(const std::vector<double>& terrainHeightList_m,
                 const double& terrainSampleResolution_m) {
+        return calcItmLoss_P2P_dB(std::span<const double>(terrainHeightList_m), terrainSampleResolution_m, true);
+    }
+
+    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const bool storeTerrainProfile) {
+        return calcItmLoss_P2P_dB(terrainHeightList_m, terrainSampleResolution_m, storeTerrainProfile, m_workspace);
+    }
+
+    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const bool storeTerrainProfile, ItmWorkspace& workspace) const {
+        // Zero out / reset ITM results object
+        workspace.m_itmResults = ItmResults();
+
+        // Populate terrainProfile (only copying the heights when the caller wants them back)
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.setTerrainHeights(terrainHeightList_m, storeTerrainProfile);
+
+        workspace.m_itmResults.m_atten_dB = calcP2PLoss_dB(workspace, terrainSampleResolution_m);
+
+        // Don't hand back (or hold on to) a view of the caller's heights
+        if (!storeTerrainProfile) {
+            workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+        }
+
+        return workspace.m_itmResults;
+    }
+
+    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const bool storeTerrainProfile) {
+        return calcItmLoss_P2P_dB(preparedProfile, storeTerrainProfile, m_workspace);
+    }
+
+    ItmResults ItmCommonCalculator::calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const bool storeTerrainProfile,
+                ItmWorkspace& workspace) const {
         // Zero out / reset ITM results object
-        m_itmResults = ItmResults();
+        workspace.m_itmResults = ItmResults();
+
+        // Populate terrainProfile (only copying the heights when the caller wants them back)
+        const TerrainProfile& preparedTerrainProfile = preparedProfile.getTerrainProfile();
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.setTerrainHeights(preparedTerrainProfile.m_terrainHeightList_m, storeTerrainProfile);
+
+        {
+            const PreparedProfileBinding profileBinding(workspace, preparedProfile);
+            workspace.m_itmResults.m_atten_dB = calcP2PLoss_dB(workspace, preparedTerrainProfile.m_sampleResolution_m);
+        }
+
+        // Don't hand back (or hold on to) a view of the caller's heights
+        if (!storeTerrainProfile) {
+            workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+        }
+
+        return workspace.m_itmResults;
+    }
+
+    ItmLossResult ItmCommonCalculator::calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const ResultLevel& resultLevel) {
+        return calcItmLoss_P2P_dB(terrainHeightList_m, terrainSampleResolution_m, resultLevel, m_workspace);
+    }
+
+    ItmLossResult ItmCommonCalculator::calcItmLoss_P2P_dB(std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const ResultLevel& resultLevel, ItmWorkspace& workspace) const {
+        return calcP2PLossResult_dB(workspace, terrainHeightList_m, terrainSampleResolution_m, resultLevel);
+    }
+
+    ItmLossResult ItmCommonCalculator::calcItmLoss_P2P_dB(const PreparedTerrainProfile& preparedProfile, const ResultLevel& resultLevel,
+                ItmWorkspace& workspace) const {
+        const TerrainProfile& preparedTerrainProfile = preparedProfile.getTerrainProfile();
+
+        const PreparedProfileBinding profileBinding(workspace, preparedProfile);
+        return calcP2PLossResult_dB(workspace, preparedTerrainProfile.m_terrainHeightList_m, preparedTerrainProfile.m_sampleResolution_m,
+                    resultLevel);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_batch_dB(std::span<const double> terrainHeightBuffer_m,
+                std::span<const std::size_t> profileOffsetList,
+                std::span<const double> terrainSampleResolutionList_m,
+                std::span<double> attenList_dB, std::span<PropagationMode> propModeList) {
+        calcItmLoss_P2P_batch_dB(terrainHeightBuffer_m, profileOffsetList, terrainSampleResolutionList_m, attenList_dB, propModeList, m_workspace);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_batch_dB(std::span<const double> terrainHeightBuffer_m,
+                std::span<const std::size_t> profileOffsetList,
+                std::span<const double> terrainSampleResolutionList_m,
+                std::span<double> attenList_dB, std::span<PropagationMode> propModeList, ItmWorkspace& workspace) const {
+        const std::size_t numProfiles = terrainSampleResolutionList_m.size();
+        if (profileOffsetList.size() != numProfiles + 1u || attenList_dB.size() < numProfiles || propModeList.size() < numProfiles) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_batch_dB(): "
+                        << "Expected " << numProfiles + 1u << " profile offsets and room for " << numProfiles
+                        << " outputs (profileOffsetList = " << profileOffsetList.size()
+                        << ", attenList_dB = " << attenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (numProfiles > 0u && profileOffsetList.back() > terrainHeightBuffer_m.size()) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_batch_dB(): "
+                        << "Last profile offset runs past the end of the terrain height buffer (offset = "
+                        << profileOffsetList.back() << ", buffer size = " << terrainHeightBuffer_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+            const std::size_t startInd = profileOffsetList[profileInd];
+            const std::size_t endInd = profileOffsetList[profileInd + 1u];
+            if (endInd < startInd + 2u) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_batch_dB(): "
+                            << "Terrain profiles must contain at least 2 points (profile " << profileInd
+                            << " spans [" << startInd << ", " << endInd << "))";
+                throw std::domain_error(oStrStream.str());
+            }
+
+            // Viewing the profile in place
+            const ItmLossResult lossResult = calcP2PLossResult_dB(workspace, terrainHeightBuffer_m.subspan(startInd, endInd - startInd),
+                        terrainSampleResolutionList_m[profileInd], LossAndMode);
+            attenList_dB[profileInd] = lossResult.m_atten_dB;
+            propModeList[profileInd] = lossResult.m_propMode;
+        }
+    }
+
+    ItmLossResult ItmCommonCalculator::calcP2PLossResult_dB(ItmWorkspace& workspace, std::span<const double> terrainHeightList_m,
+                const double& terrainSampleResolution_m, const ResultLevel& resultLevel) const {
+        // Zero out / reset the ITM results (only the values, below FullResults, so as to leave the profile's storage alone),
+        // then view the profile in place
+        IntermResults& intermResults = workspace.m_itmResults.m_intermResults;
+        if (resultLevel == FullResults) {
+            workspace.m_itmResults = ItmResults();
+        }
+        else {
+            intermResults.clearValues();
+        }
+        intermResults.m_terrainProfile.m_terrainHeightList_m = terrainHeightList_m;
+
+        const double atten_dB = calcP2PLoss_dB(workspace, terrainSampleResolution_m, resultLevel);
+        if (resultLevel == FullResults) {
+            workspace.m_itmResults.m_atten_dB = atten_dB;
+        }
+
+        // Don't hold on to a view of the caller's heights
+        intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+
+        return ItmLossResult { atten_dB, intermResults.m_propMode };
+    }
+
+    double ItmCommonCalculator::calcP2PLoss_dB(ItmWorkspace& workspace, const double& terrainSampleResolution_m,
+                const ResultLevel& resultLevel) const {
+        ITM_TRACE_PATH("P2P path");
+
+        calcP2PGeometry(workspace, terrainSampleResolution_m);
+        return calcP2PLossFromGeometry_dB(workspace, resultLevel);
+    }
+
+    void ItmCommonCalculator::calcP2PGeometry(ItmWorkspace& workspace, const double& terrainSampleResolution_m) const {
+        setPathParameters(workspace, terrainSampleResolution_m);
+        calcHorizonParameters(workspace);
+    }
+
+    void ItmCommonCalculator::setPathParameters(ItmWorkspace& workspace, const double& terrainSampleResolution_m) const {
+        // For ease of reference in the code
+        const auto& terrainHeightList_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_sampleResolution_m = terrainSampleResolution_m;
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx = terrainHeightList_m.size() - 1u;
 
-        // Populate terrainProfile
-        m_itmResults.m_intermResults.m_terrainProfile.m_sampleResolution_m = terrainSampleResolution_m;
-        m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = terrainHeightList_m;
-        m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx = terrainHeightList_m.size() - 1u;
-        
         // For ease of reference in the code
-        const std::size_t& numPointsMinusTx = m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx;
+        const std::size_t& numPointsMinusTx = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx;
         const double numPointsMinusTx_double = static_cast<double>(numPointsMinusTx);
-        
-        m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km = numPointsMinusTx_double * terrainSampleResolution_m;
-        m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km *= 1.0e-3;
+
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km = numPointsMinusTx_double * terrainSampleResolution_m;
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km *= 1.0e-3;
 
         // Calculate average path height, ignoring first & last 10% of the path
-        const std::size_t oneTenthNumPoints = 0.1 * numPointsMinusTx_double;
         double avgPathHeightAmsl_m = 0;
-        for (std::size_t pointInd = oneTenthNumPoints; pointInd <= numPointsMinusTx - oneTenthNumPoints; pointInd++) {
-            avgPathHeightAmsl_m += terrainHeightList_m[pointInd];
+        if (workspace.m_preparedProfile != nullptr) {
+            avgPathHeightAmsl_m = workspace.m_preparedProfile->calcAvgPathHeight_m(numPointsMinusTx);
+        }
+        else {
+            const std::size_t oneTenthNumPoints = 0.1 * numPointsMinusTx_double;
+            for (std::size_t pointInd = oneTenthNumPoints; pointInd <= numPointsMinusTx - oneTenthNumPoints; pointInd++) {
+                avgPathHeightAmsl_m += terrainHeightList_m[pointInd];
+            }
+            avgPathHeightAmsl_m /= static_cast<double>(numPointsMinusTx - 2u * oneTenthNumPoints + 1u);
         }
-        avgPathHeightAmsl_m /= static_cast<double>(numPointsMinusTx - 2u * oneTenthNumPoints + 1u);
 
-        initialize_P2P(avgPathHeightAmsl_m);
-        calcHorizonParameters();
+        initialize_P2P(workspace, avgPathHeightAmsl_m);
+    }
+
+    double ItmCommonCalculator::calcP2PLossFromGeometry_dB(ItmWorkspace& workspace, const ResultLevel& resultLevel) const {
+        ITM_STATS_RECORD_PROFILE_LENGTH(workspace.m_itmResults.m_intermResults.m_terrainProfile.m_numPointsMinusTx);
 
         // Reference attenuation, in dB
         PropagationMode propMode = NotSet;
-        const double finalLoss_dB = calcLongleyRiceLoss_dB(propMode, true);
-        
-        m_itmResults.m_intermResults.m_fsplAtten_dB = ItmHelpers::calcFSPL_dB(m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3, m_freq_MHz);
+        const double finalLoss_dB = calcLongleyRiceLoss_dB(workspace, propMode, true);
+
+        // The free space loss is part of the basic transmission loss, but is only kept (with the reference attenuation) in full results
+        const double fsplAtten_dB = ItmHelpers::calcFSPL_dB(workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3, m_freq_MHz);
+        if (resultLevel != LossOnly) {
+            workspace.m_itmResults.m_intermResults.m_propMode = propMode;
+        }
+        if (resultLevel == FullResults) {
+            workspace.m_itmResults.m_intermResults.m_refAtten_dB = finalLoss_dB;
+            workspace.m_itmResults.m_intermResults.m_fsplAtten_dB = fsplAtten_dB;
+        }
 
         // switch from percentages to ratios
         const double timeFrac = m_timePercent / 100.0;
         const double locationFrac = m_locationPercent / 100.0;
         const double situationFrac = m_situationPercent / 100.0;
 
-        m_itmResults.m_atten_dB = Variability(timeFrac, locationFrac, situationFrac, d__meter, finalLoss_dB) + m_itmResults.m_intermResults.m_fsplAtten_dB;
+        const VariabilityCalculator variabilityCalculator = createVariabilityCalculator(workspace.m_itmResults);
+        return variabilityCalculator.calcVariabilityLoss_dB(finalLoss_dB, timeFrac, locationFrac, situationFrac) + fsplAtten_dB;
+    }
+
+    ItmCommonCalculator ItmCommonCalculator::copyParameters() const {
+        // Fresh calculator with the same parameters (inputs were already validated by this one), but none of its working state
+        return ItmCommonCalculator(m_txHeight_m, m_rxHeight_m, m_radioClimate, m_refractivity_N, m_freq_MHz, m_isTxHorizPolariz != 0.0,
+                    m_relPermittivity, m_conductivity, static_cast<VariabilityMode>(m_varMode), m_timePercent, m_locationPercent,
+                    m_situationPercent, false);
+    }
 
-        return m_itmResults;
+    VariabilityCalculator ItmCommonCalculator::createVariabilityCalculator(const ItmResults& itmResults) const {
+        const IntermResults& intermResults = itmResults.m_intermResults;
+        return VariabilityCalculator(m_radioClimate, static_cast<VariabilityMode>(m_varMode), m_freq_MHz,
+                    intermResults.m_txEffHeight_m, intermResults.m_rxEffHeight_m, intermResults.m_terrainIrreg_m,
+                    intermResults.m_terrainProfile.m_pathDist_km * 1.0e3);
     }
-} // end namespace
\ No newline at end of file
+} // end namespace
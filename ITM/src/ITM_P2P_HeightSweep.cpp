@@ -0,0 +1,75 @@
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmTrace.h>
+
+namespace NTIA::ITM {
+    void ItmCommonCalculator::calcItmLoss_P2P_heightSweep_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                std::span<const double> txHeightList_m, std::span<const double> rxHeightList_m,
+                std::span<double> attenList_dB, std::span<PropagationMode> propModeList) {
+        calcItmLoss_P2P_heightSweep_dB(terrainHeightList_m, terrainSampleResolution_m, txHeightList_m, rxHeightList_m,
+                    attenList_dB, propModeList, m_workspace);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_heightSweep_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                std::span<const double> txHeightList_m, std::span<const double> rxHeightList_m,
+                std::span<double> attenList_dB, std::span<PropagationMode> propModeList, ItmWorkspace& workspace) const {
+        const std::size_t numPairs = txHeightList_m.size();
+        if (rxHeightList_m.size() != numPairs || attenList_dB.size() < numPairs || propModeList.size() < numPairs) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_heightSweep_dB(): "
+                        << "Expected " << numPairs << " Rx heights and room for " << numPairs
+                        << " outputs (rxHeightList_m = " << rxHeightList_m.size()
+                        << ", attenList_dB = " << attenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (terrainHeightList_m.size() < 2u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_heightSweep_dB(): "
+                        << "Terrain profiles must contain at least 2 points (number of points = " << terrainHeightList_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        for (std::size_t pairInd = 0; pairInd < numPairs; pairInd++) {
+            const double& txHeight_m = txHeightList_m[pairInd];
+            const double& rxHeight_m = rxHeightList_m[pairInd];
+            if (txHeight_m < 0.5 || txHeight_m > 3.0e3 || rxHeight_m < 0.5 || rxHeight_m > 3.0e3) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_heightSweep_dB(): "
+                            << "ITM does not support terminal heights outside of the range 0.5 m < height_m < 3 km (pair " << pairInd
+                            << ": txHeight_m = " << txHeight_m << ", rxHeight_m = " << rxHeight_m << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+
+        // Running sums for the average height & least squares fits, and horizon hulls for this calculator's effective earth
+        PreparedTerrainProfile preparedProfile(terrainHeightList_m, terrainSampleResolution_m);
+        preparedProfile.buildHorizonIndex(m_refractivity_N);
+
+        // Zero out / reset ITM results object, then view the profile in place
+        workspace.m_itmResults = ItmResults();
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.setTerrainHeights(terrainHeightList_m, false);
+        const PreparedProfileBinding profileBinding(workspace, preparedProfile);
+
+        // Path length, average height, refractivity & ground impedance don't depend on the terminal heights
+        setPathParameters(workspace, terrainSampleResolution_m);
+        const IntermResults pathIntermResults = workspace.m_itmResults.m_intermResults;
+
+        // One calculator is retargeted at each pair of heights in turn, everything else is shared
+        ItmCommonCalculator heightCalculator = copyParameters();
+        for (std::size_t pairInd = 0; pairInd < numPairs; pairInd++) {
+            ITM_TRACE_PATH("P2P height sweep path");
+
+            heightCalculator.m_txHeight_m = txHeightList_m[pairInd];
+            heightCalculator.m_rxHeight_m = rxHeightList_m[pairInd];
+
+            // Start every pair from the same state a single path evaluation would reach its horizons with
+            workspace.m_itmResults.m_intermResults = pathIntermResults;
+            heightCalculator.calcHorizonParameters(workspace);
+
+            attenList_dB[pairInd] = heightCalculator.calcP2PLossFromGeometry_dB(workspace);
+            propModeList[pairInd] = workspace.m_itmResults.m_intermResults.m_propMode;
+        }
+
+        // Drop the view of the caller's heights (the binding drops the prepared profile, so single-path calls go back to scanning)
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+    }
+} // end namespace
@@ -0,0 +1,60 @@
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmTrace.h>
+
+namespace NTIA::ITM {
+    void ItmCommonCalculator::calcItmLoss_P2P_multiFreq_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                std::span<const double> freqList_MHz, std::span<double> attenList_dB, std::span<PropagationMode> propModeList) {
+        calcItmLoss_P2P_multiFreq_dB(terrainHeightList_m, terrainSampleResolution_m, freqList_MHz, attenList_dB, propModeList, m_workspace);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_multiFreq_dB(std::span<const double> terrainHeightList_m, const double& terrainSampleResolution_m,
+                std::span<const double> freqList_MHz, std::span<double> attenList_dB, std::span<PropagationMode> propModeList,
+                ItmWorkspace& workspace) const {
+        // One profile, so one path span enclosing its shared geometry & every frequency
+        ITM_TRACE_PATH("P2P multi-frequency path");
+
+        const std::size_t numFreqs = freqList_MHz.size();
+        if (attenList_dB.size() < numFreqs || propModeList.size() < numFreqs) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_multiFreq_dB(): "
+                        << "Expected room for " << numFreqs << " outputs (attenList_dB = " << attenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (terrainHeightList_m.size() < 2u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_multiFreq_dB(): "
+                        << "Terrain profiles must contain at least 2 points (number of points = " << terrainHeightList_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        for (const double& freq_MHz : freqList_MHz) {
+            if (freq_MHz < 20.0 || freq_MHz > 20.0e3) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_multiFreq_dB(): "
+                            << "ITM does not support frequencies outside of the range 20 MHz < freq_MHz < 20 GHz (freq_MHz = "
+                            << freq_MHz << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+
+        // Zero out / reset ITM results object, then view the profile in place
+        workspace.m_itmResults = ItmResults();
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.setTerrainHeights(terrainHeightList_m, false);
+
+        // Horizons, effective heights & terrain irregularity are shared by every frequency
+        calcP2PGeometry(workspace, terrainSampleResolution_m);
+
+        // One calculator is retargeted at each frequency in turn, everything else is shared
+        ItmCommonCalculator freqCalculator = copyParameters();
+        for (std::size_t freqInd = 0; freqInd < numFreqs; freqInd++) {
+            freqCalculator.m_freq_MHz = freqList_MHz[freqInd];
+            freqCalculator.setGroundImpedance(workspace);
+
+            attenList_dB[freqInd] = freqCalculator.calcP2PLossFromGeometry_dB(workspace);
+            propModeList[freqInd] = workspace.m_itmResults.m_intermResults.m_propMode;
+        }
+
+        // Don't hold on to a view of the caller's buffer
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+    }
+} // end namespace
@@ -0,0 +1,278 @@
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/HorizonScan.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace NTIA::ITM {
+    namespace {
+        /// @brief Upper envelope of the Tx horizon angles of every terrain point seen so far along a radial.
+        /// Point k contributes the line angle_k(c) = u_k - t_k * c, where u_k = (h_k - txRadial) / t_k,
+        /// t_k is the distance from the Tx and c = 1 / (2 * effective earth radius). Since the effective earth radius
+        /// changes with every receiver position, keeping the envelope lets each receiver find its best point in O(log N).
+        /// The envelope compares u_k - t_k * c, which rounds differently from the scan's (h_k - txRadial) / t_k - t_k / (2 * a),
+        /// so two points within rounding of each other may resolve differently than in a single-path scan
+        class TxHorizonEnvelope {
+        public:
+            /// @brief Add the next point along the radial (points must be added in order of increasing distance)
+            void addPoint(const std::size_t pointInd, const double& angleIntercept, const double& txDist_m) {
+                const Line newLine { pointInd, angleIntercept, -txDist_m };
+
+                // Drop lines which can no longer be the best for any curvature (ties go to the earlier point)
+                while (m_lineList.size() >= 2u) {
+                    const Line& firstLine = m_lineList[m_lineList.size() - 2u];
+                    const Line& lastLine = m_lineList.back();
+                    if ((newLine.m_intercept - lastLine.m_intercept) * (firstLine.m_slope - lastLine.m_slope) <
+                                (lastLine.m_intercept - firstLine.m_intercept) * (lastLine.m_slope - newLine.m_slope)) {
+                        break;
+                    }
+                    m_lineList.pop_back();
+                }
+                m_lineList.push_back(newLine);
+            }
+
+            /// @brief Find the point with the largest horizon angle for the given earth curvature term
+            /// @return Index of the best point along the radial, or 0 if no points have been added
+            std::size_t findBestPoint(const double& curvatureTerm) const {
+                if (m_lineList.empty()) {
+                    return 0u;
+                }
+
+                // Angles along the envelope rise and then fall, so search for the first line beating its successor
+                std::size_t lowInd = 0u;
+                std::size_t highInd = m_lineList.size() - 1u;
+                while (lowInd < highInd) {
+                    const std::size_t midInd = lowInd + (highInd - lowInd) / 2u;
+                    if (m_lineList[midInd].valueAt(curvatureTerm) >= m_lineList[midInd + 1u].valueAt(curvatureTerm)) {
+                        highInd = midInd;
+                    }
+                    else {
+                        lowInd = midInd + 1u;
+                    }
+                }
+                return m_lineList[lowInd].m_pointInd;
+            }
+
+        private:
+            struct Line {
+                std::size_t m_pointInd;
+                double m_intercept;
+                double m_slope;
+
+                double valueAt(const double& curvatureTerm) const {
+                    return m_intercept + m_slope * curvatureTerm;
+                }
+            };
+
+            std::vector<Line> m_lineList;
+        };
+
+        /// @brief Rx horizon search along a radial, which skips any block of points that cannot beat the best angle found so
+        /// far. The angle to a point at distance r_k from the Rx is (h_k - rxRadial) / r_k - r_k / (2 * a): with every height
+        /// of a block at most its maximum, and r_k at least the distance to its point nearest the Rx, the angles of the block
+        /// are bounded by max(0, blockMax - rxRadial) / r_min - r_min / (2 * a). Starting from the previous receiver's
+        /// horizon, which is usually still the best or close to it, most blocks are skipped & the sweep stays near-linear
+        class RxHorizonSearch {
+        public:
+            RxHorizonSearch(std::span<const double> radialHeightList_m, std::span<const double> txDistList_m)
+                        : m_radialHeightList_m(radialHeightList_m), m_txDistList_m(txDistList_m) {
+                const std::size_t numBlocks = (radialHeightList_m.size() + kBlockSize - 1u) / kBlockSize;
+                m_blockMaxHeightList_m.resize(numBlocks);
+                m_prefixMaxHeightList_m.resize(numBlocks);
+                for (std::size_t blockInd = 0; blockInd < numBlocks; blockInd++) {
+                    const std::size_t blockEndInd = std::min((blockInd + 1u) * kBlockSize, radialHeightList_m.size());
+                    m_blockMaxHeightList_m[blockInd] = *std::max_element(radialHeightList_m.begin() + blockInd * kBlockSize,
+                                radialHeightList_m.begin() + blockEndInd);
+                    m_prefixMaxHeightList_m[blockInd] = (blockInd > 0u)
+                                ? std::max(m_prefixMaxHeightList_m[blockInd - 1u], m_blockMaxHeightList_m[blockInd]) : m_blockMaxHeightList_m[blockInd];
+                }
+            }
+
+            /// @brief Find the interior point (1 to rxInd - 1) with the largest Rx horizon angle, ties going to the lowest index
+            /// as in the scan. Distances from the Rx are taken as pathDist_m - txDist_k, which agree with the scan's
+            /// accumulated distances to within rounding
+            /// @param rxInd Index of the receiver along the radial
+            /// @param rxRadial_m Height of the Rx antenna above mean sea level (meters)
+            /// @param pathDist_m Path distance (meters)
+            /// @param effEarthRadius_m Effective earth radius (meters)
+            /// @return Best candidate point (m_pointInd = 0 if there are no interior points)
+            HorizonScan::HorizonCandidate findBestPoint(const std::size_t rxInd, const double& rxRadial_m, const double& pathDist_m,
+                        const double& effEarthRadius_m) {
+                HorizonScan::HorizonCandidate bestCandidate { 0u, -std::numeric_limits<double>::infinity() };
+                if (rxInd < 2u) {
+                    return bestCandidate;
+                }
+                const double twoEffEarthRadius_m = 2.0 * effEarthRadius_m;
+                const auto calcAngle_rad = [&](const std::size_t pointInd) {
+                    const double rxDist_m = pathDist_m - m_txDistList_m[pointInd];
+                    return (m_radialHeightList_m[pointInd] - rxRadial_m) / rxDist_m - rxDist_m / twoEffEarthRadius_m;
+                };
+                const auto calcBound_rad = [&](const double& maxHeight_m, const std::size_t nearestInd) {
+                    const double rxDist_m = pathDist_m - m_txDistList_m[nearestInd];
+                    return std::max(maxHeight_m - rxRadial_m, 0.0) / rxDist_m - rxDist_m / twoEffEarthRadius_m + kBoundMargin_rad;
+                };
+
+                if (m_prevBestInd > 0u && m_prevBestInd < rxInd) {
+                    bestCandidate = HorizonScan::HorizonCandidate { m_prevBestInd, calcAngle_rad(m_prevBestInd) };
+                }
+
+                // Blocks from the Rx back towards the Tx, stopping once no remaining point can beat the best
+                const std::size_t lastInd = rxInd - 1u;
+                for (std::size_t blockInd = lastInd / kBlockSize + 1u; blockInd-- > 0u;) {
+                    const std::size_t blockStartInd = std::max<std::size_t>(blockInd * kBlockSize, 1u);
+                    const std::size_t blockLastInd = std::min((blockInd + 1u) * kBlockSize - 1u, lastInd);
+                    if (calcBound_rad(m_prefixMaxHeightList_m[blockInd], blockLastInd) < bestCandidate.m_angle_rad) {
+                        break;
+                    }
+                    if (calcBound_rad(m_blockMaxHeightList_m[blockInd], blockLastInd) < bestCandidate.m_angle_rad) {
+                        continue;
+                    }
+                    for (std::size_t pointInd = blockStartInd; pointInd <= blockLastInd; pointInd++) {
+                        const double angle_rad = calcAngle_rad(pointInd);
+                        if (angle_rad > bestCandidate.m_angle_rad || (angle_rad == bestCandidate.m_angle_rad && pointInd < bestCandidate.m_pointInd)) {
+                            bestCandidate = HorizonScan::HorizonCandidate { pointInd, angle_rad };
+                        }
+                    }
+                }
+
+                m_prevBestInd = bestCandidate.m_pointInd;
+                return bestCandidate;
+            }
+
+        private:
+            // Points per block of the height maxima
+            static constexpr std::size_t kBlockSize { 32u };
+            // Allowance for the rounding of the bounds against the angles they bound (radians)
+            static constexpr double kBoundMargin_rad { 1.0e-9 };
+
+            std::span<const double> m_radialHeightList_m;
+            std::span<const double> m_txDistList_m;
+            std::vector<double> m_blockMaxHeightList_m;
+            std::vector<double> m_prefixMaxHeightList_m;      // Maximum height of blocks [0, blockInd]
+            std::size_t m_prevBestInd = 0u;
+        };
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_radial_dB(std::span<const double> radialHeightList_m, const double& terrainSampleResolution_m,
+                const std::size_t firstRxInd, std::span<double> attenList_dB, std::span<PropagationMode> propModeList) {
+        calcItmLoss_P2P_radial_dB(radialHeightList_m, terrainSampleResolution_m, firstRxInd, attenList_dB, propModeList, m_workspace);
+    }
+
+    void ItmCommonCalculator::calcItmLoss_P2P_radial_dB(std::span<const double> radialHeightList_m, const double& terrainSampleResolution_m,
+                const std::size_t firstRxInd, std::span<double> attenList_dB, std::span<PropagationMode> propModeList,
+                ItmWorkspace& workspace) const {
+        const std::size_t numRadialPoints = radialHeightList_m.size();
+        if (firstRxInd < 1u || firstRxInd >= numRadialPoints) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_radial_dB(): "
+                        << "The first receiver must sit between the second and last points of the radial (firstRxInd = "
+                        << firstRxInd << ", number of points = " << numRadialPoints << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        const std::size_t numRxPoints = numRadialPoints - firstRxInd;
+        if (attenList_dB.size() < numRxPoints || propModeList.size() < numRxPoints) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmCommonCalculator::calcItmLoss_P2P_radial_dB(): "
+                        << "Expected room for " << numRxPoints << " outputs (attenList_dB = " << attenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        // Running sums, shared by the path average height and every least squares fit
+        const PreparedTerrainProfile preparedRadial(radialHeightList_m, terrainSampleResolution_m);
+        const PreparedProfileBinding profileBinding(workspace, preparedRadial);
+
+        // Distances from the Tx, accumulated exactly as setHorizonParameters() does
+        std::vector<double> txDistList_m(numRadialPoints, 0.0);
+        HorizonScan::fillTxDistances(txDistList_m, terrainSampleResolution_m);
+
+        const double txRadial_m = radialHeightList_m.front() + m_txHeight_m;
+        TxHorizonEnvelope txHorizonEnvelope;
+        std::size_t nextEnvelopeInd = 1u;
+        RxHorizonSearch rxHorizonSearch(radialHeightList_m, txDistList_m);
+
+        for (std::size_t rxInd = firstRxInd; rxInd < numRadialPoints; rxInd++) {
+            ITM_TRACE_PATH("P2P radial path");
+
+            // Zero out / reset ITM results object, then view the radial up to the current receiver
+            workspace.m_itmResults = ItmResults();
+            TerrainProfile& terrainProfile = workspace.m_itmResults.m_intermResults.m_terrainProfile;
+            terrainProfile.setTerrainHeights(radialHeightList_m.first(rxInd + 1u), false);
+            terrainProfile.m_sampleResolution_m = terrainSampleResolution_m;
+            terrainProfile.m_numPointsMinusTx = rxInd;
+            terrainProfile.m_pathDist_km = static_cast<double>(rxInd) * terrainSampleResolution_m * 1.0e-3;
+            const double pathDist_m = terrainProfile.m_pathDist_km * 1.0e3;
+
+            initialize_P2P(workspace, preparedRadial.calcAvgPathHeight_m(rxInd));
+            const double effEarthRadius_m = 1.0 / workspace.m_effEarthCurvature_perM;
+
+            // Every interior point of the path is a Tx horizon candidate
+            for (; nextEnvelopeInd < rxInd; nextEnvelopeInd++) {
+                const double& txDist_m = txDistList_m[nextEnvelopeInd];
+                txHorizonEnvelope.addPoint(nextEnvelopeInd, (radialHeightList_m[nextEnvelopeInd] - txRadial_m) / txDist_m, txDist_m);
+            }
+            const std::size_t txCandidateInd = txHorizonEnvelope.findBestPoint(1.0 / (2.0 * effEarthRadius_m));
+
+            const double rxRadial_m = radialHeightList_m[rxInd] + m_rxHeight_m;
+            const HorizonScan::HorizonCandidate rxCandidate = rxHorizonSearch.findBestPoint(rxInd, rxRadial_m, pathDist_m, effEarthRadius_m);
+
+            setRadialHorizonParameters(workspace, effEarthRadius_m, txCandidateInd, txDistList_m[txCandidateInd], rxCandidate.m_pointInd,
+                        pathDist_m - txDistList_m[rxCandidate.m_pointInd]);
+            setEffectiveHeights(workspace, effEarthRadius_m);
+
+            attenList_dB[rxInd - firstRxInd] = calcP2PLossFromGeometry_dB(workspace);
+            propModeList[rxInd - firstRxInd] = workspace.m_itmResults.m_intermResults.m_propMode;
+        }
+
+        // Drop the view of the caller's radial (the binding drops the running sums, so single-path calls go back to scanning)
+        workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m = {};
+    }
+
+    void ItmCommonCalculator::setRadialHorizonParameters(ItmWorkspace& workspace, const double& effEarthRadius_m, const std::size_t txCandidateInd,
+                const double& txCandidateDist_m, const std::size_t rxCandidateInd, const double& rxCandidateDist_m) const {
+        ITM_STATS_STAGE(Horizons);
+        ITM_TRACE_STAGE(Horizons);
+
+        // Compute radials for Tx & Rx (ignore radius of earth since it cancels out in the later math)
+        const auto& terrainHeightList_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+        double txRadial_m = terrainHeightList_m.front() + m_txHeight_m;
+        double rxRadial_m = terrainHeightList_m.back() + m_rxHeight_m;
+
+        // For ease of reference in the code
+        const double pathDist_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+        double& finalTxHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad;
+        double& finalRxHorizonAngle_rad = workspace.m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
+        double& finalTxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+        double& finalRxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
+
+        // Set the terminal horizon angles as if the terminals are line-of-sight, [TN101, Eq 6.15]
+        finalTxHorizonAngle_rad = (rxRadial_m - txRadial_m) / pathDist_m - pathDist_m / (2.0 * effEarthRadius_m);
+        finalRxHorizonAngle_rad = -(rxRadial_m - txRadial_m) / pathDist_m - pathDist_m / (2.0 * effEarthRadius_m);
+
+        finalTxHorizonDist_m = pathDist_m;
+        finalRxHorizonDist_m = pathDist_m;
+
+        // The best Tx candidate comes from the radial's envelope, so only it needs to be compared against line-of-sight
+        if (txCandidateInd > 0u) {
+            const double txHorizonAngle_deg = (terrainHeightList_m[txCandidateInd] - txRadial_m) / txCandidateDist_m -
+                        txCandidateDist_m / (2.0 * effEarthRadius_m);
+            if (txHorizonAngle_deg > finalTxHorizonAngle_rad) {
+                finalTxHorizonAngle_rad = txHorizonAngle_deg;
+                finalTxHorizonDist_m = txCandidateDist_m;
+            }
+        }
+
+        // Likewise the best Rx candidate comes from the radial's block search
+        if (rxCandidateInd > 0u) {
+            const double rxHorizonAngle_rad = (terrainHeightList_m[rxCandidateInd] - rxRadial_m) / rxCandidateDist_m -
+                        rxCandidateDist_m / (2.0 * effEarthRadius_m);
+            if (rxHorizonAngle_rad > finalRxHorizonAngle_rad) {
+                finalRxHorizonAngle_rad = rxHorizonAngle_rad;
+                finalRxHorizonDist_m = rxCandidateDist_m;
+            }
+        }
+    }
+} // end namespace
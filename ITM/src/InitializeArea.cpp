@@ -1,5 +1,5 @@
-#include "ITM/itm.h"
-#include "ITM/Enums.h"
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
 
 /*=============================================================================
  |
@@ -20,36 +20,26 @@
  |      Returns:  [None]
  |
  *===========================================================================*/
-void InitializeArea(int site_criteria[2], double gamma_e, double delta_h__meter,
-    double h__meter[2], double h_e__meter[2], double d_hzn__meter[2],  double theta_hzn[2])
-{
-    for (int i = 0; i < 2; i++)
-    {
-        if (site_criteria[i] == SITING_CRITERIA__RANDOM)
-            h_e__meter[i] = h__meter[i];
-        else
-        {
-            double B;
 
-            if (site_criteria[i] == SITING_CRITERIA__CAREFUL)
-                B = 4.0;
-            else // SITING_CRITERIA__VERY_CAREFUL
-                B = 9.0;
+namespace NTIA::ITM {
+    void ItmCommonCalculator::initialize_area(ItmWorkspace& workspace, const SitingCriteria& txSitingCriteria,
+                const SitingCriteria& rxSitingCriteria, const double& terrainIrregularityParam_m) const {
+        // Area mode has no terrain profile, so refractivity is taken at sea level
+        initialize_P2P(workspace, 0.0);
 
-            if (h__meter[i] < 5.0)
-                B = B * sin(0.1 * PI * h__meter[i]);
+        IntermResults& intermResults = workspace.m_itmResults.m_intermResults;
+        intermResults.m_terrainIrreg_m = terrainIrregularityParam_m;
 
-            // [Algorithm, Eqn 3.2]
-            h_e__meter[i] = h__meter[i] + (1.0 + B) * exp(-MIN(20.0, 2.0 * h__meter[i] / MAX(1e-3, delta_h__meter)));
-        }
+        const ItmHelpers::AreaTerminalGeometry txGeometry = ItmHelpers::calcAreaTerminalGeometry(txSitingCriteria, m_txHeight_m,
+                    terrainIrregularityParam_m, workspace.m_effEarthCurvature_perM);
+        intermResults.m_txEffHeight_m = txGeometry.m_effHeight_m;
+        intermResults.m_txHorizonDist_m = txGeometry.m_horizonDist_m;
+        intermResults.m_txHorizonAngle_rad = txGeometry.m_horizonAngle_rad;
 
-        double d_Ls__meter = sqrt(2.0 * h_e__meter[i] / gamma_e);
-
-        // [Algorithm, Eqn 3.3]
-        double H_3__meter = 5;
-        d_hzn__meter[i] = d_Ls__meter * exp(-0.07 * sqrt(delta_h__meter / MAX(h_e__meter[i], H_3__meter)));
-
-        // [Algorithm, Eqn 3.4]
-        theta_hzn[i] = (0.65 * delta_h__meter * (d_Ls__meter / d_hzn__meter[i] - 1.0) - 2.0 * h_e__meter[i]) / d_Ls__meter;
+        const ItmHelpers::AreaTerminalGeometry rxGeometry = ItmHelpers::calcAreaTerminalGeometry(rxSitingCriteria, m_rxHeight_m,
+                    terrainIrregularityParam_m, workspace.m_effEarthCurvature_perM);
+        intermResults.m_rxEffHeight_m = rxGeometry.m_effHeight_m;
+        intermResults.m_rxHorizonDist_m = rxGeometry.m_horizonDist_m;
+        intermResults.m_rxHorizonAngle_rad = rxGeometry.m_horizonAngle_rad;
     }
-}
\ No newline at end of file
+}
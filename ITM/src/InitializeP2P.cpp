@@ -1,4 +1,7 @@
 #include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 
 /*=============================================================================
  |
@@ -23,22 +26,26 @@
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    void ItmCommonCalculator::initialize_P2P(const double& avgPathHeightAmsl_m) {
+    void ItmCommonCalculator::initialize_P2P(ItmWorkspace& workspace, const double& avgPathHeightAmsl_m) const {
+        ITM_STATS_STAGE(Initialize_P2P);
+        ITM_TRACE_STAGE(Initialize_P2P);
+
         // Scale local refractivity into a surface refractivity based on the path's average elevation AMSL
-        m_surfaceRefractivity_N = (avgPathHeightAmsl_m <= 0.0) 
-                    ? m_refractivity_N 
-                    : m_refractivity_N * std::exp(-avgPathHeightAmsl_m / 9460.0);   // [TN101, Eq 4.3]
-        
-        const double effEarthCurvatureScaleTerm = 1.0 - 0.04665 * std::exp(m_surfaceRefractivity_N / 179.3);
-        m_effEarthCurvature_perM = kActualEarthCurvature_perMeter * effEarthCurvatureScaleTerm;   // [TN101, Eq 4.4], reworked
+        workspace.m_surfaceRefractivity_N = ItmHelpers::calcSurfaceRefractivity_N(m_refractivity_N, avgPathHeightAmsl_m);
+        workspace.m_effEarthCurvature_perM = ItmHelpers::calcEffEarthCurvature_perM(workspace.m_surfaceRefractivity_N);
+        workspace.m_itmResults.m_intermResults.m_surfRefract_N = workspace.m_surfaceRefractivity_N;
+
+        setGroundImpedance(workspace);
+    }
 
+    void ItmCommonCalculator::setGroundImpedance(ItmWorkspace& workspace) const {
         std::complex<double> complexRelPermittivity(m_relPermittivity, 18.0e3 * m_conductivity / m_freq_MHz);
 
         // Ground impedance for horizontal polarization
-        m_groundImpedance = std::sqrt(complexRelPermittivity - 1.0);
-        if (m_isTxHorizPolariz) {
+        workspace.m_groundImpedance = std::sqrt(complexRelPermittivity - 1.0);
+        if (!m_isTxHorizPolariz) {
             // Adjust for vertical polarization
-            m_groundImpedance /= complexRelPermittivity;
+            workspace.m_groundImpedance /= complexRelPermittivity;
         }
     }
 
@@ -0,0 +1,193 @@
+#include <ITM/ItmStats.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <vector>
+
+namespace NTIA::ITM::ItmStats {
+    namespace {
+        /// @brief Counters of one thread. Only the owning thread writes them, so an add is a plain load & store (no locked
+        /// read-modify-write); they are atomic so that snapshots on other threads can read them while they change
+        struct alignas(64) ThreadCounters {
+            std::array<std::atomic<std::uint64_t>, kNumItmStages> m_numCallsList {};
+            std::array<std::atomic<std::uint64_t>, kNumItmStages> m_numCyclesList {};
+            std::array<std::atomic<std::uint64_t>, kNumProfileLengthBins> m_profileLengthHistogram {};
+            std::array<std::atomic<std::uint64_t>, kNumPropModeBins> m_propModeHistogram {};
+            std::array<std::atomic<std::uint64_t>, kNumPathDistBins> m_pathDistHistogram {};
+
+            void addTo(ItmStatsSnapshot& snapshot) const {
+                for (std::size_t stageInd = 0; stageInd < kNumItmStages; stageInd++) {
+                    snapshot.m_stageStatsList[stageInd].m_numCalls += m_numCallsList[stageInd].load(std::memory_order_relaxed);
+                    snapshot.m_stageStatsList[stageInd].m_numCycles += m_numCyclesList[stageInd].load(std::memory_order_relaxed);
+                }
+                addHistogram(m_profileLengthHistogram, snapshot.m_profileLengthHistogram);
+                addHistogram(m_propModeHistogram, snapshot.m_propModeHistogram);
+                addHistogram(m_pathDistHistogram, snapshot.m_pathDistHistogram);
+            }
+
+        private:
+            template <std::size_t NumBins>
+            static void addHistogram(const std::array<std::atomic<std::uint64_t>, NumBins>& histogram, std::array<std::uint64_t, NumBins>& totals) {
+                for (std::size_t binInd = 0; binInd < NumBins; binInd++) {
+                    totals[binInd] += histogram[binInd].load(std::memory_order_relaxed);
+                }
+            }
+        };
+
+        void addCount(std::atomic<std::uint64_t>& counter, const std::uint64_t count) {
+            counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+        }
+
+        template <std::size_t NumBins>
+        void subtractHistogram(std::array<std::uint64_t, NumBins>& histogram, const std::array<std::uint64_t, NumBins>& baseline) {
+            for (std::size_t binInd = 0; binInd < NumBins; binInd++) {
+                histogram[binInd] -= baseline[binInd];
+            }
+        }
+
+        /// @brief Counters of the running threads, the totals of finished ones, and the totals at the last reset()
+        struct StatsRegistry {
+            std::mutex m_mutex;
+            std::vector<const ThreadCounters*> m_threadCountersList;
+            ThreadCounters m_finishedThreadCounters;
+            ItmStatsSnapshot m_baseline;
+
+            ItmStatsSnapshot sumLocked() const {
+                ItmStatsSnapshot snapshot;
+                m_finishedThreadCounters.addTo(snapshot);
+                for (const ThreadCounters* threadCounters : m_threadCountersList) {
+                    threadCounters->addTo(snapshot);
+                }
+                return snapshot;
+            }
+        };
+
+        // Constructed before any thread's counters (which register with it), so it outlives them all
+        StatsRegistry& getRegistry() {
+            static StatsRegistry registry;
+            return registry;
+        }
+
+        /// @brief A thread's counters, registered while the thread runs & folded into the finished totals when it ends
+        class ThreadCountersEntry {
+        public:
+            ThreadCountersEntry() : m_registry(getRegistry()) {
+                const std::lock_guard<std::mutex> lock(m_registry.m_mutex);
+                m_registry.m_threadCountersList.push_back(&m_counters);
+            }
+
+            ~ThreadCountersEntry() {
+                const std::lock_guard<std::mutex> lock(m_registry.m_mutex);
+                ItmStatsSnapshot threadTotals;
+                m_counters.addTo(threadTotals);
+
+                ThreadCounters& finishedCounters = m_registry.m_finishedThreadCounters;
+                for (std::size_t stageInd = 0; stageInd < kNumItmStages; stageInd++) {
+                    addCount(finishedCounters.m_numCallsList[stageInd], threadTotals.m_stageStatsList[stageInd].m_numCalls);
+                    addCount(finishedCounters.m_numCyclesList[stageInd], threadTotals.m_stageStatsList[stageInd].m_numCycles);
+                }
+                for (std::size_t binInd = 0; binInd < kNumProfileLengthBins; binInd++) {
+                    addCount(finishedCounters.m_profileLengthHistogram[binInd], threadTotals.m_profileLengthHistogram[binInd]);
+                }
+                for (std::size_t binInd = 0; binInd < kNumPropModeBins; binInd++) {
+                    addCount(finishedCounters.m_propModeHistogram[binInd], threadTotals.m_propModeHistogram[binInd]);
+                }
+                for (std::size_t binInd = 0; binInd < kNumPathDistBins; binInd++) {
+                    addCount(finishedCounters.m_pathDistHistogram[binInd], threadTotals.m_pathDistHistogram[binInd]);
+                }
+
+                m_registry.m_threadCountersList.erase(std::find(m_registry.m_threadCountersList.begin(),
+                            m_registry.m_threadCountersList.end(), &m_counters));
+            }
+
+            ThreadCountersEntry(const ThreadCountersEntry&) = delete;
+            ThreadCountersEntry& operator=(const ThreadCountersEntry&) = delete;
+
+            ThreadCounters& getCounters() {
+                return m_counters;
+            }
+
+        private:
+            StatsRegistry& m_registry;
+            ThreadCounters m_counters;
+        };
+
+        ThreadCounters& getThreadCounters() {
+            thread_local ThreadCountersEntry entry;
+            return entry.getCounters();
+        }
+    }
+
+    ItmStatsSnapshot takeSnapshot() {
+        StatsRegistry& registry = getRegistry();
+        const std::lock_guard<std::mutex> lock(registry.m_mutex);
+        ItmStatsSnapshot snapshot = registry.sumLocked();
+
+        // Counters only ever grow, so the totals since the reset are the current totals less those at the reset
+        for (std::size_t stageInd = 0; stageInd < kNumItmStages; stageInd++) {
+            snapshot.m_stageStatsList[stageInd].m_numCalls -= registry.m_baseline.m_stageStatsList[stageInd].m_numCalls;
+            snapshot.m_stageStatsList[stageInd].m_numCycles -= registry.m_baseline.m_stageStatsList[stageInd].m_numCycles;
+        }
+        subtractHistogram(snapshot.m_profileLengthHistogram, registry.m_baseline.m_profileLengthHistogram);
+        subtractHistogram(snapshot.m_propModeHistogram, registry.m_baseline.m_propModeHistogram);
+        subtractHistogram(snapshot.m_pathDistHistogram, registry.m_baseline.m_pathDistHistogram);
+        return snapshot;
+    }
+
+    void reset() {
+        StatsRegistry& registry = getRegistry();
+        const std::lock_guard<std::mutex> lock(registry.m_mutex);
+        registry.m_baseline = registry.sumLocked();
+    }
+
+    const char* getStageName(const ItmStage stage) {
+        switch (stage) {
+            case ItmStage::Initialize_P2P:
+                return "initialize_P2P";
+            case ItmStage::Horizons:
+                return "horizons";
+            case ItmStage::TerrainIrregularity:
+                return "terrain irregularity";
+            case ItmStage::LongleyRice:
+                return "Longley-Rice";
+            case ItmStage::Diffraction:
+                return "diffraction";
+            case ItmStage::Troposcatter:
+                return "troposcatter";
+            case ItmStage::Variability:
+                return "variability";
+            default:
+                return "unknown";
+        }
+    }
+
+    void recordStage(const ItmStage stage, const std::uint64_t numCycles) {
+        ThreadCounters& counters = getThreadCounters();
+        const std::size_t stageInd = static_cast<std::size_t>(stage);
+        addCount(counters.m_numCallsList[stageInd], 1u);
+        addCount(counters.m_numCyclesList[stageInd], numCycles);
+    }
+
+    void recordProfileLength(const std::size_t numPointsMinusTx) {
+        // Bin i holds [2^i, 2^(i+1)) (a profile has at least one point past the Tx)
+        const std::size_t binInd = std::min<std::size_t>(std::bit_width(std::max<std::size_t>(numPointsMinusTx, 1u)) - 1u,
+                    kNumProfileLengthBins - 1u);
+        addCount(getThreadCounters().m_profileLengthHistogram[binInd], 1u);
+    }
+
+    void recordPath(const double& pathDist_m, const PropagationMode& propMode) {
+        ThreadCounters& counters = getThreadCounters();
+        addCount(counters.m_propModeHistogram[std::min<std::size_t>(static_cast<std::size_t>(propMode), kNumPropModeBins - 1u)], 1u);
+
+        // Bin 0 holds < 1 km, bin i holds [2^(i-1), 2^i) km
+        const double pathDist_km = pathDist_m * 1.0e-3;
+        std::size_t binInd = 0u;
+        if (pathDist_km >= 1.0) {
+            const double clampedDist_km = std::min(pathDist_km, static_cast<double>(std::uint64_t{1u} << kNumPathDistBins));
+            binInd = std::min<std::size_t>(std::bit_width(static_cast<std::uint64_t>(clampedDist_km)), kNumPathDistBins - 1u);
+        }
+        addCount(counters.m_pathDistHistogram[binInd], 1u);
+    }
+} // end namespace
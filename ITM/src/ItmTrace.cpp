@@ -0,0 +1,253 @@
+#include <ITM/ItmTrace.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace NTIA::ITM::ItmTrace {
+    namespace {
+        /// @brief Path ID state of one thread
+        struct ThreadPathState {
+            bool m_hasCallerPathId = false;
+            std::uint64_t m_callerPathId = 0u;      // Set by a PathIdScope
+            bool m_isInPath = false;
+            std::uint64_t m_activePathId = 0u;      // ID of the path span being recorded
+        };
+
+        thread_local ThreadPathState threadPathState;
+    }
+
+    PathIdScope::PathIdScope(const std::uint64_t pathId)
+                : m_hadPathId(threadPathState.m_hasCallerPathId), m_prevPathId(threadPathState.m_callerPathId) {
+        threadPathState.m_hasCallerPathId = true;
+        threadPathState.m_callerPathId = pathId;
+    }
+
+    PathIdScope::~PathIdScope() {
+        threadPathState.m_hasCallerPathId = m_hadPathId;
+        threadPathState.m_callerPathId = m_prevPathId;
+    }
+
+#ifdef NTIA_ITM_ENABLE_TRACING
+    namespace {
+        // Spans kept per thread (48 bytes each) between start() & the next start(); any more are counted & dropped
+        std::size_t constexpr kMaxNumEventsPerThread { std::size_t { 1u } << 20 };
+
+        struct TraceEvent {
+            const char* m_name;
+            const char* m_category;
+            std::int64_t m_startTimestamp_ns;
+            std::int64_t m_duration_ns;
+            bool m_hasPathId;
+            std::uint64_t m_pathId;
+        };
+
+        /// @brief Spans of one thread. Only the owning thread appends to them, so its lock is only ever contended by
+        /// start() & writeTraceJson()
+        struct ThreadEventBuffer {
+            std::uint32_t m_threadNum = 0u;
+            std::mutex m_mutex;
+            std::vector<TraceEvent> m_eventList;
+            std::uint64_t m_numDroppedEvents = 0u;
+        };
+
+        /// @brief Spans of a thread that has finished
+        struct FinishedThreadEvents {
+            std::uint32_t m_threadNum;
+            std::vector<TraceEvent> m_eventList;
+            std::uint64_t m_numDroppedEvents;
+        };
+
+        struct TraceRegistry {
+            std::atomic<bool> m_isRecording { false };
+            std::atomic<std::uint64_t> m_nextPathId { 0u };
+
+            std::mutex m_mutex;
+            std::int64_t m_startTimestamp_ns = 0;
+            std::uint32_t m_nextThreadNum = 1u;
+            std::vector<ThreadEventBuffer*> m_threadBufferList;
+            std::vector<FinishedThreadEvents> m_finishedThreadList;
+        };
+
+        // Constructed before any thread's buffer (which registers with it), so it outlives them all
+        TraceRegistry& getRegistry() {
+            static TraceRegistry registry;
+            return registry;
+        }
+
+        /// @brief A thread's spans, registered while the thread runs & handed over to the registry when it ends
+        class ThreadEventBufferEntry {
+        public:
+            ThreadEventBufferEntry() : m_registry(getRegistry()) {
+                const std::lock_guard<std::mutex> lock(m_registry.m_mutex);
+                m_buffer.m_threadNum = m_registry.m_nextThreadNum++;
+                m_registry.m_threadBufferList.push_back(&m_buffer);
+            }
+
+            ~ThreadEventBufferEntry() {
+                const std::lock_guard<std::mutex> lock(m_registry.m_mutex);
+                if (!m_buffer.m_eventList.empty() || m_buffer.m_numDroppedEvents > 0u) {
+                    m_registry.m_finishedThreadList.push_back({ m_buffer.m_threadNum, std::move(m_buffer.m_eventList),
+                                m_buffer.m_numDroppedEvents });
+                }
+                m_registry.m_threadBufferList.erase(std::find(m_registry.m_threadBufferList.begin(),
+                            m_registry.m_threadBufferList.end(), &m_buffer));
+            }
+
+            ThreadEventBufferEntry(const ThreadEventBufferEntry&) = delete;
+            ThreadEventBufferEntry& operator=(const ThreadEventBufferEntry&) = delete;
+
+            ThreadEventBuffer& getBuffer() {
+                return m_buffer;
+            }
+
+        private:
+            TraceRegistry& m_registry;
+            ThreadEventBuffer m_buffer;
+        };
+
+        void appendEvent(const TraceEvent& event) {
+            thread_local ThreadEventBufferEntry entry;
+            ThreadEventBuffer& buffer = entry.getBuffer();
+            const std::lock_guard<std::mutex> lock(buffer.m_mutex);
+            if (buffer.m_eventList.size() < kMaxNumEventsPerThread) {
+                buffer.m_eventList.push_back(event);
+            }
+            else {
+                buffer.m_numDroppedEvents++;
+            }
+        }
+
+        void writeEventList(std::ostream& outStream, const std::uint32_t threadNum, const std::vector<TraceEvent>& eventList,
+                    const std::int64_t traceStartTimestamp_ns) {
+            outStream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << threadNum
+                        << ",\"args\":{\"name\":\"ITM thread " << threadNum << "\"}},\n";
+            for (const TraceEvent& event : eventList) {
+                // Spans begun before the last start() belong to the previous trace
+                if (event.m_startTimestamp_ns < traceStartTimestamp_ns) {
+                    continue;
+                }
+
+                // Trace-event timestamps & durations are in microseconds
+                outStream << "{\"name\":\"" << event.m_name << "\",\"cat\":\"" << event.m_category << "\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                            << threadNum << ",\"ts\":" << (event.m_startTimestamp_ns - traceStartTimestamp_ns) * 1.0e-3
+                            << ",\"dur\":" << event.m_duration_ns * 1.0e-3;
+                if (event.m_hasPathId) {
+                    outStream << ",\"args\":{\"path\":" << event.m_pathId << "}";
+                }
+                outStream << "},\n";
+            }
+        }
+    }
+
+    void start() {
+        TraceRegistry& registry = getRegistry();
+        const std::lock_guard<std::mutex> lock(registry.m_mutex);
+        for (ThreadEventBuffer* buffer : registry.m_threadBufferList) {
+            const std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+            buffer->m_eventList.clear();
+            buffer->m_numDroppedEvents = 0u;
+        }
+        registry.m_finishedThreadList.clear();
+        registry.m_nextPathId.store(0u, std::memory_order_relaxed);
+        registry.m_startTimestamp_ns = readTimestamp_ns();
+        registry.m_isRecording.store(true, std::memory_order_release);
+    }
+
+    void stop() {
+        getRegistry().m_isRecording.store(false, std::memory_order_release);
+    }
+
+    bool isRecording() {
+        return getRegistry().m_isRecording.load(std::memory_order_acquire);
+    }
+
+    void writeTraceJson(const std::string& filePath) {
+        std::ofstream outStream(filePath, std::ios::trunc);
+        if (!outStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmTrace::writeTraceJson(): Unable to open " << filePath << " for writing";
+            throw std::runtime_error(oStrStream.str());
+        }
+        outStream << std::fixed << std::setprecision(3) << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+        TraceRegistry& registry = getRegistry();
+        std::uint64_t numDroppedEvents = 0u;
+        {
+            const std::lock_guard<std::mutex> lock(registry.m_mutex);
+            for (const FinishedThreadEvents& finishedThread : registry.m_finishedThreadList) {
+                writeEventList(outStream, finishedThread.m_threadNum, finishedThread.m_eventList, registry.m_startTimestamp_ns);
+                numDroppedEvents += finishedThread.m_numDroppedEvents;
+            }
+            for (ThreadEventBuffer* buffer : registry.m_threadBufferList) {
+                const std::lock_guard<std::mutex> bufferLock(buffer->m_mutex);
+                if (!buffer->m_eventList.empty()) {
+                    writeEventList(outStream, buffer->m_threadNum, buffer->m_eventList, registry.m_startTimestamp_ns);
+                }
+                numDroppedEvents += buffer->m_numDroppedEvents;
+            }
+        }
+
+        // Process name, which also spares the trailing comma of the last event, then the number of spans dropped past the cap
+        outStream << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"ITM\"}}\n],"
+                    << "\"otherData\":{\"droppedEvents\":" << numDroppedEvents << "}}\n";
+        if (!outStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmTrace::writeTraceJson(): Unable to write " << filePath;
+            throw std::runtime_error(oStrStream.str());
+        }
+    }
+
+    bool isRecordingRelaxed() {
+        return getRegistry().m_isRecording.load(std::memory_order_relaxed);
+    }
+
+    std::int64_t readTimestamp_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void beginPath() {
+        threadPathState.m_isInPath = true;
+        threadPathState.m_activePathId = threadPathState.m_hasCallerPathId ? threadPathState.m_callerPathId
+                    : getRegistry().m_nextPathId.fetch_add(1u, std::memory_order_relaxed);
+    }
+
+    void endPath(const char* name, const std::int64_t startTimestamp_ns) {
+        appendEvent({ name, "path", startTimestamp_ns, readTimestamp_ns() - startTimestamp_ns, true, threadPathState.m_activePathId });
+        threadPathState.m_isInPath = false;
+    }
+
+    void recordStage(const ItmStage stage, const std::int64_t startTimestamp_ns) {
+        // Stages run outside any path span (e.g. a reference attenuation curve prepared by a caller) carry the caller's ID, if any
+        const bool hasPathId = threadPathState.m_isInPath || threadPathState.m_hasCallerPathId;
+        const std::uint64_t pathId = threadPathState.m_isInPath ? threadPathState.m_activePathId : threadPathState.m_callerPathId;
+        appendEvent({ ItmStats::getStageName(stage), "stage", startTimestamp_ns, readTimestamp_ns() - startTimestamp_ns, hasPathId, pathId });
+    }
+#else
+    void start() {
+    }
+
+    void stop() {
+    }
+
+    bool isRecording() {
+        return false;
+    }
+
+    void writeTraceJson(const std::string& filePath) {
+        std::ofstream outStream(filePath, std::ios::trunc);
+        if (!outStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ItmTrace::writeTraceJson(): Unable to open " << filePath << " for writing";
+            throw std::runtime_error(oStrStream.str());
+        }
+        outStream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[]}\n";
+    }
+#endif
+} // end namespace
@@ -18,21 +18,21 @@
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcKnifeEdgeDiffractLoss_dB(const double& inputDist_m, const double& effEarthRadius_km, const double& angularDist_LoS_rad) {
-        const double& txHorizonDist_m = m_itmResults.m_intermResults.m_txHorizonDist_m;
-        const double& rxHorizonDist_m = m_itmResults.m_intermResults.m_rxHorizonDist_m;
+    double ItmCommonCalculator::calcKnifeEdgeDiffractLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, const double& effEarthRadius_m, const double& angularDist_LoS_rad) const {
+        const double& txHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+        const double& rxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
 
         const double maxDist_LoS_m = txHorizonDist_m + rxHorizonDist_m;                             // Maximum line-of-sight distance for actual path
-        const double angularDist_nLoS_rad = inputDist_m / effEarthRadius_km - angularDist_LoS_rad;  // Angular distance of diffraction region [Algorithm, Eqn 4.12]
+        const double angularDist_nLoS_rad = inputDist_m / effEarthRadius_m - angularDist_LoS_rad;  // Angular distance of diffraction region [Algorithm, Eqn 4.12]
         const double diffractDist_nLoS_m = inputDist_m - maxDist_LoS_m;                             // Diffraction distance, in meters
 
         // 1 / (4 pi) = 0.0795775
         // [TN101, Eqn I.7]
         const double angularDistSqrd = angularDist_nLoS_rad * angularDist_nLoS_rad;
         const double nuCommonTerm = 0.0795775 * (m_freq_MHz / ItmHelpers::kWaveToMHzFreqTerm) * angularDistSqrd * diffractDist_nLoS_m;
-        const double nu1 = nuCommonTerm * txHorizonDist_m / (diffractDist_nLoS_m + txHorizonDist_m);
-        const double nu2 = nuCommonTerm * rxHorizonDist_m / (diffractDist_nLoS_m + rxHorizonDist_m);
+        const double nu1Sqrd = nuCommonTerm * txHorizonDist_m / (diffractDist_nLoS_m + txHorizonDist_m);
+        const double nu2Sqrd = nuCommonTerm * rxHorizonDist_m / (diffractDist_nLoS_m + rxHorizonDist_m);
 
-        return ItmHelpers::calcFresnelIntegral(nu1) + ItmHelpers::calcFresnelIntegral(nu2);     // [TN101, Eqn I.1]
+        return ItmHelpers::calcFresnelIntegral(nu1Sqrd) + ItmHelpers::calcFresnelIntegral(nu2Sqrd);     // [TN101, Eqn I.1]
     }
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
  |
  |        Input:  inputDist_m          - Path distance, in meters
  |                h_e__meter[2]     - Terminal effective heights, in meters
- |                m_groundImpedance               - Complex surface transfer impedance
+ |                workspace.m_groundImpedance               - Complex surface transfer impedance
  |                delta_h__meter    - Terrain irregularity parameter
  |                diffractSlope               - Diffraction slope
  |                diffractLineIntercept              - Diffraction intercept
@@ -22,23 +22,23 @@
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcLineOfSightLoss_dB(const double& inputDist_m, 
-                const double& diffractSlope, const double& diffractLineIntercept, const double& maxDistSmoothEarth_LoS_m) {
-        const double tempTerrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(inputDist_m, m_itmResults.m_intermResults.m_terrainIrreg_m);
+    double ItmCommonCalculator::calcLineOfSightLoss_dB(const ItmWorkspace& workspace, const double& inputDist_m, 
+                const double& diffractSlope, const double& diffractLineIntercept, const double& maxDistSmoothEarth_LoS_m) const {
+        const double tempTerrainIrreg_m = ItmHelpers::calcTerrainRoughness_m(inputDist_m, workspace.m_itmResults.m_intermResults.m_terrainIrreg_m);
         const double tempSigmaH = ItmHelpers::calcSigmaH_m(tempTerrainIrreg_m);
 
         // Angular wavenumber, k
         const double waveNumber = m_freq_MHz / ItmHelpers::kWaveToMHzFreqTerm;
 
         // [Algorithm, Eqn 4.46]
-        const double& txEffHeight_m = m_itmResults.m_intermResults.m_txEffHeight_m;
-        const double& rxEffHeight_m = m_itmResults.m_intermResults.m_rxEffHeight_m;
+        const double& txEffHeight_m = workspace.m_itmResults.m_intermResults.m_txEffHeight_m;
+        const double& rxEffHeight_m = workspace.m_itmResults.m_intermResults.m_rxEffHeight_m;
 
         const double effHeightSum_m = txEffHeight_m + rxEffHeight_m;
         const double sinOfPsi = effHeightSum_m / std::sqrt(inputDist_m * inputDist_m + effHeightSum_m * effHeightSum_m);
 
         // [Algorithm, Eqn 4.47]
-        std::complex<double> reflCoeff_e = (sinOfPsi - m_groundImpedance) / (sinOfPsi + m_groundImpedance) * 
+        std::complex<double> reflCoeff_e = (sinOfPsi - workspace.m_groundImpedance) / (sinOfPsi + workspace.m_groundImpedance) * 
                     std::exp(-std::min({10.0, waveNumber * tempSigmaH * sinOfPsi}));
 
         // |R_e| = Magnitude of R_e', [Algorithm, Eqn 4.48]
@@ -61,7 +61,7 @@ namespace NTIA::ITM {
         const double diffractLoss_dB = diffractSlope * inputDist_m + diffractLineIntercept;
 
         // weighting factor
-        const double w = 1.0 / (1.0 + m_freq_MHz * m_itmResults.m_intermResults.m_terrainIrreg_m / std::max({10.0e3, maxDistSmoothEarth_LoS_m}));
+        const double w = 1.0 / (1.0 + m_freq_MHz * workspace.m_itmResults.m_intermResults.m_terrainIrreg_m / std::max({10.0e3, maxDistSmoothEarth_LoS_m}));
 
         return w * attenTwoRay_dB + (1.0 - w) * diffractLoss_dB;
     }
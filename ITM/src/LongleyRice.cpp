@@ -1,23 +1,39 @@
 #include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 
 #include <algorithm>
+#include <cmath>
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcLongleyRiceLoss_dB(PropagationMode& propMode, const bool isP2P) {
-        const double effEarthRadius_m = 1.0 / m_effEarthCurvature_perM;
+    double ItmCommonCalculator::calcLongleyRiceLoss_dB(const ItmWorkspace& workspace, PropagationMode& propMode, const bool isP2P) const {
+        const double pathDist_m = workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+
+        // A single path only needs the region of the curve its own distance falls in
+        return buildRefAttenCurve(workspace, isP2P, pathDist_m, pathDist_m).calcRefAtten_dB(pathDist_m, propMode);
+    }
+
+    ReferenceAttenuationCurve ItmCommonCalculator::buildRefAttenCurve(const ItmWorkspace& workspace, const bool isP2P,
+                const double& minPathDist_m, const double& maxPathDist_m) const {
+        ITM_STATS_STAGE(LongleyRice);
+        ITM_TRACE_STAGE(LongleyRice);
+
+        ReferenceAttenuationCurve refAttenCurve;
+
+        const double effEarthRadius_m = 1.0 / workspace.m_effEarthCurvature_perM;
 
         // Terrestrial smooth earth horizon distance approximation
-        const double txSmoothEarthHorizonDist_m = std::sqrt(2.0 * m_itmResults.m_intermResults.m_txEffHeight_m * effEarthRadius_m);
-        const double rxSmoothEarthHorizonDist_m = std::sqrt(2.0 * m_itmResults.m_intermResults.m_rxEffHeight_m * effEarthRadius_m);
+        const double txSmoothEarthHorizonDist_m = std::sqrt(2.0 * workspace.m_itmResults.m_intermResults.m_txEffHeight_m * effEarthRadius_m);
+        const double rxSmoothEarthHorizonDist_m = std::sqrt(2.0 * workspace.m_itmResults.m_intermResults.m_rxEffHeight_m * effEarthRadius_m);
 
         // Maximum line-of-sight distance for smooth earth
         double smoothEarthDist_maxLoS_m = txSmoothEarthHorizonDist_m + rxSmoothEarthHorizonDist_m;
 
         // Maximum line-of-sight distance for actual path
-        double actualDist_maxLoS_m = m_itmResults.m_intermResults.m_txHorizonDist_m + m_itmResults.m_intermResults.m_rxHorizonDist_m;
+        double actualDist_maxLoS_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m + workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
 
         // Angular distance of line-of-sight region
-        const double angularDistInLoS_rad = -std::max({m_itmResults.m_intermResults.m_txHorizonAngle_rad + m_itmResults.m_intermResults.m_rxHorizonAngle_rad, 
+        const double angularDistInLoS_rad = -std::max({workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad + workspace.m_itmResults.m_intermResults.m_rxHorizonAngle_rad, 
                     -actualDist_maxLoS_m / effEarthRadius_m});
 
         // Select two distances far in the diffraction region
@@ -25,20 +41,22 @@ namespace NTIA::ITM {
         const double diffractDist4_m = diffractDist3_m + 10.0 * pow(pow(effEarthRadius_m, 2) / m_freq_MHz, 1.0 / 3.0);
 
         // Compute the diffraction loss at the two distances
-        const double attenDiffract3_dB = calcDiffractLoss_dB(diffractDist3_m, effEarthRadius_m, isP2P, angularDistInLoS_rad, smoothEarthDist_maxLoS_m);
-        const double attenDiffract4_dB = calcDiffractLoss_dB(diffractDist4_m, effEarthRadius_m, isP2P, angularDistInLoS_rad, smoothEarthDist_maxLoS_m);
+        const double attenDiffract3_dB = calcDiffractLoss_dB(workspace, diffractDist3_m, effEarthRadius_m, isP2P, angularDistInLoS_rad, smoothEarthDist_maxLoS_m);
+        const double attenDiffract4_dB = calcDiffractLoss_dB(workspace, diffractDist4_m, effEarthRadius_m, isP2P, angularDistInLoS_rad, smoothEarthDist_maxLoS_m);
 
         // Compute the slope and intercept of the diffraction line
         const double diffractLineSlope = (attenDiffract4_dB - attenDiffract3_dB) / (diffractDist4_m - diffractDist3_m);
         const double diffractLineIntercept_dB = attenDiffract3_dB - diffractLineSlope * diffractDist3_m;
 
-        const double pathDist_m = m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+        refAttenCurve.m_smoothEarthDist_maxLoS_m = smoothEarthDist_maxLoS_m;
+        refAttenCurve.m_diffractLineSlope = diffractLineSlope;
+        refAttenCurve.m_diffractLineIntercept_dB = diffractLineIntercept_dB;
 
-        // if the path distance is less than the maximum smooth earth line of sight distance...
-        if (pathDist_m < smoothEarthDist_maxLoS_m)
+        // if any distance is less than the maximum smooth earth line of sight distance...
+        if (minPathDist_m < smoothEarthDist_maxLoS_m)
         {
-            const double& txEffHeight_m = m_itmResults.m_intermResults.m_txEffHeight_m;
-            const double& rxEffHeight_m = m_itmResults.m_intermResults.m_rxEffHeight_m;
+            const double& txEffHeight_m = workspace.m_itmResults.m_intermResults.m_txEffHeight_m;
+            const double& rxEffHeight_m = workspace.m_itmResults.m_intermResults.m_rxEffHeight_m;
             // Compute the diffraction loss at the maximum smooth earth line of sight distance
             const double diffractLoss_smoothEarth_maxLoS_dB = smoothEarthDist_maxLoS_m * diffractLineSlope + diffractLineIntercept_dB;
 
@@ -53,14 +71,14 @@ namespace NTIA::ITM {
             else
                 diffractDist1_m = std::max({-diffractLineIntercept_dB / diffractLineSlope, 0.25 * actualDist_maxLoS_m});
 
-            const double losLoss1_dB = calcLineOfSightLoss_dB(diffractDist1_m, diffractLineSlope, diffractLineIntercept_dB, smoothEarthDist_maxLoS_m);
+            const double losLoss1_dB = calcLineOfSightLoss_dB(workspace, diffractDist1_m, diffractLineSlope, diffractLineIntercept_dB, smoothEarthDist_maxLoS_m);
 
             bool foundPositiveValues = false;
 
             double kHat1_dBPerM = 0.0, kHat2_dBPerM = 0.0;
 
             if (diffractDist0_m < diffractDist1_m) {
-                const double losLoss0_dB = calcLineOfSightLoss_dB(diffractDist0_m, diffractLineSlope, diffractLineIntercept_dB, smoothEarthDist_maxLoS_m);
+                const double losLoss0_dB = calcLineOfSightLoss_dB(workspace, diffractDist0_m, diffractLineSlope, diffractLineIntercept_dB, smoothEarthDist_maxLoS_m);
 
                 // TODO(vmartin): Is this log supposed to be a log10??
                 const double q = std::log(smoothEarthDist_maxLoS_m / diffractDist0_m);
@@ -73,14 +91,14 @@ namespace NTIA::ITM {
                             (diffractDist1_m - diffractDist0_m) * q;
                 kHat2_dBPerM = std::max({0.0, kHat2_part2_numer / kHat2_part2_denom });
 
-                foundPositiveValues = diffractLineIntercept_dB > 0.0 || kHat2_dBPerM > 0.0;
+                foundPositiveValues = diffractLineIntercept_dB >= 0.0 || kHat2_dBPerM > 0.0;
                 if (foundPositiveValues) {
                     // [ERL 79-ITS 67, Eqn 3.21]
                     kHat1_dBPerM = (diffractLoss_smoothEarth_maxLoS_dB - losLoss0_dB - kHat2_dBPerM * q) / (smoothEarthDist_maxLoS_m - diffractDist0_m);
 
                     if (kHat1_dBPerM < 0.0) {
                         kHat1_dBPerM = 0.0;
-                        kHat2_dBPerM = std::abs(diffractLoss_smoothEarth_maxLoS_dB - losLoss0_dB) / q;
+                        kHat2_dBPerM = std::fdim(diffractLoss_smoothEarth_maxLoS_dB, losLoss0_dB) / q;
 
                         if (kHat2_dBPerM == 0.0) {
                             kHat1_dBPerM = diffractLineSlope;
@@ -90,7 +108,7 @@ namespace NTIA::ITM {
             }
 
             if (!foundPositiveValues) {
-                kHat1_dBPerM = std::abs(diffractLoss_smoothEarth_maxLoS_dB - losLoss1_dB) / (smoothEarthDist_maxLoS_m - diffractDist1_m);
+                kHat1_dBPerM = std::fdim(diffractLoss_smoothEarth_maxLoS_dB, losLoss1_dB) / (smoothEarthDist_maxLoS_m - diffractDist1_m);
                 kHat2_dBPerM = 0.0;
 
                 if (kHat1_dBPerM == 0.0)
@@ -100,24 +118,23 @@ namespace NTIA::ITM {
             // TODO(vmartin): Is this log supposed to be a log10??
             const double intermAtten_dB = diffractLoss_smoothEarth_maxLoS_dB - kHat1_dBPerM * smoothEarthDist_maxLoS_m - kHat2_dBPerM * log(smoothEarthDist_maxLoS_m);
 
-            // [ERL 79-ITS 67, Eqn 3.19]
-            // TODO(vmartin): Is this log supposed to be a log10??
-            const double finalLoss_dB = intermAtten_dB + kHat1_dBPerM * pathDist_m + kHat2_dBPerM * log(pathDist_m);
-            propMode = PropagationMode::LineOfSight;
-
-            // Don't allow a negative loss
-            return std::max({finalLoss_dB, 0.0});
+            refAttenCurve.m_hasLineOfSightRegion = true;
+            refAttenCurve.m_losIntercept_dB = intermAtten_dB;
+            refAttenCurve.m_kHat1_dBPerM = kHat1_dBPerM;
+            refAttenCurve.m_kHat2_dBPerM = kHat2_dBPerM;
         }
-        else {
-            // this is a trans-horizon path
+
+        // if any distance is trans-horizon (the exact complement of the line-of-sight test in calcRefAtten_dB(), so that
+        // a NaN line-of-sight limit from a negative effective height still falls through to here as it always has)...
+        if (!(maxPathDist_m < smoothEarthDist_maxLoS_m)) {
             // select to points far into the troposcatter region
             double tropoDist5_m = actualDist_maxLoS_m + 200.0e3;
             double tropoDist6_m = actualDist_maxLoS_m + 400.0e3;
 
             // Compute the troposcatter loss at the two distances
             double currentH0_dB = -1.0;
-            double attenTropo6_dB = calcTroposcatterLoss_dB(tropoDist6_m, effEarthRadius_m, angularDistInLoS_rad, &currentH0_dB);
-            double attenTropo5_dB = calcTroposcatterLoss_dB(tropoDist5_m, effEarthRadius_m, angularDistInLoS_rad, &currentH0_dB);
+            double attenTropo6_dB = calcTroposcatterLoss_dB(workspace, tropoDist6_m, effEarthRadius_m, angularDistInLoS_rad, currentH0_dB);
+            double attenTropo5_dB = calcTroposcatterLoss_dB(workspace, tropoDist5_m, effEarthRadius_m, angularDistInLoS_rad, currentH0_dB);
 
             double tropoLineSlope, tropoLineIntercept_dB, diffractTropoTransitionDist_m;
 
@@ -141,21 +158,12 @@ namespace NTIA::ITM {
                 diffractTropoTransitionDist_m = 10e6;
             }
 
-            double finalLoss_dB = 0.0;
-            // Determine if its diffraction or troposcatter and compute the loss
-            if (pathDist_m > diffractTropoTransitionDist_m)
-            {
-                finalLoss_dB = tropoLineSlope * pathDist_m + tropoLineIntercept_dB;
-                propMode = Troposcatter;
-            }
-            else
-            {
-                finalLoss_dB = diffractLineSlope * pathDist_m + diffractLineIntercept_dB;
-                propMode = Diffraction;
-            }
-        
-            // Don't allow a negative loss
-            return std::max({finalLoss_dB, 0.0});
+            refAttenCurve.m_hasTransHorizonRegion = true;
+            refAttenCurve.m_tropoLineSlope = tropoLineSlope;
+            refAttenCurve.m_tropoLineIntercept_dB = tropoLineIntercept_dB;
+            refAttenCurve.m_diffractTropoTransitionDist_m = diffractTropoTransitionDist_m;
         }
+
+        return refAttenCurve;
     }
 }
\ No newline at end of file
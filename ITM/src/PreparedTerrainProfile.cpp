@@ -0,0 +1,53 @@
+#include <ITM/PreparedTerrainProfile.h>
+#include <ITM/ItmHelpers.h>
+
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM {
+    PreparedTerrainProfile::PreparedTerrainProfile(std::span<const double> terrainHeightList_m, const double& sampleResolution_m,
+                const bool copyTerrainHeights) {
+        if (terrainHeightList_m.size() < 2u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: PreparedTerrainProfile::PreparedTerrainProfile(): "
+                        << "Terrain profiles must contain at least 2 points (number of points = " << terrainHeightList_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        m_terrainProfile.setTerrainHeights(terrainHeightList_m, copyTerrainHeights);
+        m_terrainProfile.m_sampleResolution_m = sampleResolution_m;
+        m_terrainProfile.m_numPointsMinusTx = terrainHeightList_m.size() - 1u;
+        m_terrainProfile.m_pathDist_km = static_cast<double>(m_terrainProfile.m_numPointsMinusTx) * sampleResolution_m * 1.0e-3;
+
+        const auto& heightList_m = m_terrainProfile.m_terrainHeightList_m;
+        m_heightPrefixSumList_m.assign(heightList_m.size() + 1u, 0.0);
+        m_scaledHeightPrefixSumList_m.assign(heightList_m.size() + 1u, 0.0);
+        for (std::size_t pointInd = 0; pointInd < heightList_m.size(); pointInd++) {
+            m_heightPrefixSumList_m[pointInd + 1u] = m_heightPrefixSumList_m[pointInd] + heightList_m[pointInd];
+            m_scaledHeightPrefixSumList_m[pointInd + 1u] = m_scaledHeightPrefixSumList_m[pointInd] +
+                        static_cast<double>(pointInd) * heightList_m[pointInd];
+        }
+    }
+
+    double PreparedTerrainProfile::calcAvgPathHeight_m(const std::size_t numPointsMinusTx) const {
+        // Ignore first & last 10% of the path
+        const std::size_t oneTenthNumPoints = 0.1 * static_cast<double>(numPointsMinusTx);
+        return calcMeanHeight_m(oneTenthNumPoints, numPointsMinusTx - oneTenthNumPoints);
+    }
+
+    double PreparedTerrainProfile::calcMeanHeight_m(const std::size_t startInd, const std::size_t endInd) const {
+        return (m_heightPrefixSumList_m[endInd + 1u] - m_heightPrefixSumList_m[startInd]) / static_cast<double>(endInd - startInd + 1u);
+    }
+
+    void PreparedTerrainProfile::buildHorizonIndex(const double& refractivity_N) {
+        // Same effective earth as ItmCommonCalculator::initialize_P2P() derives for the full profile
+        const double surfaceRefractivity_N = ItmHelpers::calcSurfaceRefractivity_N(refractivity_N, calcAvgPathHeight_m());
+        m_horizonIndex.emplace(m_terrainProfile, ItmHelpers::calcEffEarthCurvature_perM(surfaceRefractivity_N));
+    }
+
+    MathHelpers::TerrainFitResults PreparedTerrainProfile::fitTerrainProfile_linearLeastSquares(const std::size_t numPointsMinusTx,
+                const double& distToStart_m, const double& distToEnd_m) const {
+        return MathHelpers::fitTerrainProfile_linearLeastSquares(m_terrainProfile.m_terrainHeightList_m.first(numPointsMinusTx + 1u),
+                    m_heightPrefixSumList_m, m_scaledHeightPrefixSumList_m, m_terrainProfile.m_sampleResolution_m, distToStart_m, distToEnd_m);
+    }
+} // end namespace
@@ -0,0 +1,69 @@
+#include <ITM/ReferenceAttenuationCurve.h>
+#include <ITM/ItmStats.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM {
+    double ReferenceAttenuationCurve::calcRefAtten_dB(const double& pathDist_m, PropagationMode& propMode) const {
+        double finalLoss_dB = 0.0;
+
+        // if the path distance is less than the maximum smooth earth line of sight distance...
+        if (pathDist_m < m_smoothEarthDist_maxLoS_m) {
+            if (!m_hasLineOfSightRegion) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ReferenceAttenuationCurve::calcRefAtten_dB(): "
+                            << "The curve was not prepared for line-of-sight distances (pathDist_m = " << pathDist_m
+                            << ", smooth earth line-of-sight limit = " << m_smoothEarthDist_maxLoS_m << " m)";
+                throw std::domain_error(oStrStream.str());
+            }
+
+            // [ERL 79-ITS 67, Eqn 3.19]
+            // TODO(vmartin): Is this log supposed to be a log10??
+            finalLoss_dB = m_losIntercept_dB + m_kHat1_dBPerM * pathDist_m + m_kHat2_dBPerM * std::log(pathDist_m);
+            propMode = LineOfSight;
+        }
+        else {
+            if (!m_hasTransHorizonRegion) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: ReferenceAttenuationCurve::calcRefAtten_dB(): "
+                            << "The curve was not prepared for trans-horizon distances (pathDist_m = " << pathDist_m
+                            << ", smooth earth line-of-sight limit = " << m_smoothEarthDist_maxLoS_m << " m)";
+                throw std::domain_error(oStrStream.str());
+            }
+
+            // Determine if its diffraction or troposcatter and compute the loss
+            if (pathDist_m > m_diffractTropoTransitionDist_m) {
+                finalLoss_dB = m_tropoLineSlope * pathDist_m + m_tropoLineIntercept_dB;
+                propMode = Troposcatter;
+            }
+            else {
+                finalLoss_dB = m_diffractLineSlope * pathDist_m + m_diffractLineIntercept_dB;
+                propMode = Diffraction;
+            }
+        }
+
+        ITM_STATS_RECORD_PATH(pathDist_m, propMode);
+
+        // Don't allow a negative loss
+        return std::max({finalLoss_dB, 0.0});
+    }
+
+    void ReferenceAttenuationCurve::calcRefAtten_dB(std::span<const double> pathDistList_m, std::span<double> refAttenList_dB,
+                std::span<PropagationMode> propModeList) const {
+        const std::size_t numDists = pathDistList_m.size();
+        if (refAttenList_dB.size() < numDists || propModeList.size() < numDists) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: ReferenceAttenuationCurve::calcRefAtten_dB(): "
+                        << "Expected room for " << numDists << " outputs (refAttenList_dB = " << refAttenList_dB.size()
+                        << ", propModeList = " << propModeList.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        for (std::size_t distInd = 0; distInd < numDists; distInd++) {
+            refAttenList_dB[distInd] = calcRefAtten_dB(pathDistList_m[distInd], propModeList[distInd]);
+        }
+    }
+} // end namespace
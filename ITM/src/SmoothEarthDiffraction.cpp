@@ -13,7 +13,7 @@ namespace NTIA::ITM {
     |
     |        Input:  diffractPathLength_m          - Path distance, in meters
     |                f__mhz            - Frequency, in MHz
-    |                effEarthRadius_km        - Effective earth radius, in meters
+    |                effEarthRadius_m         - Effective earth radius, in meters
     |                angularDist_LoS_rad         - Angular distance of line-of-sight region
     |                d_hzn__meter[2]   - Horizon distances, in meters
     |                h_e__meter[2]     - Effective terminal heights, in meters
@@ -24,19 +24,19 @@ namespace NTIA::ITM {
     |      Returns:  A_r__db           - Smooth-earth diffraction loss, in dB
     |
     *===========================================================================*/
-    double ItmCommonCalculator::calcSmoothEarthDiffractLoss_dB(const double& diffractPathLength_m, const double& effEarthRadius_km, const double& angularDist_LoS_rad) {
-        const double& txHorizonDist_m = m_itmResults.m_intermResults.m_txHorizonDist_m;
-        const double& rxHorizonDist_m = m_itmResults.m_intermResults.m_rxHorizonDist_m;
-        const double& txEffHeight_m = m_itmResults.m_intermResults.m_txEffHeight_m;
-        const double& rxEffHeight_m = m_itmResults.m_intermResults.m_rxEffHeight_m;
+    double ItmCommonCalculator::calcSmoothEarthDiffractLoss_dB(const ItmWorkspace& workspace, const double& diffractPathLength_m, const double& effEarthRadius_m, const double& angularDist_LoS_rad) const {
+        const double& txHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+        const double& rxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
+        const double& txEffHeight_m = workspace.m_itmResults.m_intermResults.m_txEffHeight_m;
+        const double& rxEffHeight_m = workspace.m_itmResults.m_intermResults.m_rxEffHeight_m;
 
-        const double angularDist_nonLoS_rad = diffractPathLength_m / effEarthRadius_km - angularDist_LoS_rad;   // [Algorithm, Eqn 4.12]
+        const double angularDist_nonLoS_rad = diffractPathLength_m / effEarthRadius_m - angularDist_LoS_rad;   // [Algorithm, Eqn 4.12]
         const double actualDist_maxLoS_m = txHorizonDist_m + rxHorizonDist_m;                                   // Maximum line-of-sight distance for actual path
 
         // compute 3 radii
         double adjEffEarthRadiusList_km[3];
-        // which is effEarthRadius_km when angularDist_LoS_rad = d_ML__meter / effEarthRadius_km
-        adjEffEarthRadiusList_km[0] = (diffractPathLength_m - actualDist_maxLoS_m) / (diffractPathLength_m / effEarthRadius_km - angularDist_LoS_rad);
+        // which is effEarthRadius_m when angularDist_LoS_rad = d_ML__meter / effEarthRadius_m
+        adjEffEarthRadiusList_km[0] = (diffractPathLength_m - actualDist_maxLoS_m) / (diffractPathLength_m / effEarthRadius_m - angularDist_LoS_rad);
         // Compute the radius of the effective earth for terminal j using[Volger 1964, Eqn 3] re - arranged
         adjEffEarthRadiusList_km[1] = 0.5 * txHorizonDist_m * txHorizonDist_m / txEffHeight_m;
         adjEffEarthRadiusList_km[2] = 0.5 * rxHorizonDist_m * rxHorizonDist_m / rxEffHeight_m;
@@ -46,13 +46,12 @@ namespace NTIA::ITM {
         double earthRadiusConstList[3];
         for (std::size_t arrayInd = 0; arrayInd < 3; arrayInd++)
         {
-            const double earthRadius_km = 1.0 / kActualEarthCurvature_perMeter;
             // C_0 is the ratio of the 4/3 earth to effective earth (technically Vogler 1964 ratio is 4/3 to effective earth k value), all raised to the (1/3) power.
             // C_0 = (4 / 3k) ^ (1 / 3) [Vogler 1964, Eqn 2]
-            earthRadiusConstList[arrayInd] = std::pow((4.0 / 3.0) * earthRadius_km / adjEffEarthRadiusList_km[arrayInd], kOneThird);
+            earthRadiusConstList[arrayInd] = std::pow((4.0 / 3.0) * kVoglerEarthRadius_m / adjEffEarthRadiusList_km[arrayInd], kOneThird);
 
             // [Vogler 1964, Eqn 6a / 7a]
-            kValueList[arrayInd] = 0.017778 * earthRadiusConstList[arrayInd] * std::pow(m_freq_MHz, -kOneThird) / std::abs(m_groundImpedance);
+            kValueList[arrayInd] = 0.017778 * earthRadiusConstList[arrayInd] * std::pow(m_freq_MHz, -kOneThird) / std::abs(workspace.m_groundImpedance);
 
             // Compute B_0 for each radius
             // [Vogler 1964, Fig 4]
@@ -0,0 +1,105 @@
+#include <ITM/TerrainHorizonIndex.h>
+#include <ITM/HorizonScan.h>
+
+#include <algorithm>
+
+namespace NTIA::ITM {
+    TerrainHorizonIndex::TerrainHorizonIndex(const TerrainProfile& terrainProfile, const double& effEarthCurvature_perM) :
+                m_effEarthCurvature_perM(effEarthCurvature_perM),
+                m_effEarthRadius_m(1.0 / effEarthCurvature_perM) {
+        const std::size_t numPointsMinusTx = terrainProfile.m_numPointsMinusTx;
+        if (numPointsMinusTx < 2u) {
+            return;
+        }
+
+        // Distances to each terminal, accumulated exactly as the horizon scan does
+        std::vector<double> txDistList_m(numPointsMinusTx, 0.0);
+        std::vector<double> rxDistList_m(numPointsMinusTx, 0.0);
+        HorizonScan::fillTxDistances(txDistList_m, terrainProfile.m_sampleResolution_m);
+        HorizonScan::fillRxDistances(rxDistList_m, terrainProfile.m_pathDist_km * 1.0e3, terrainProfile.m_sampleResolution_m);
+
+        m_txHull = buildHull(terrainProfile.m_terrainHeightList_m, txDistList_m, false);
+        m_rxHull = buildHull(terrainProfile.m_terrainHeightList_m, rxDistList_m, true);
+    }
+
+    HorizonPoint TerrainHorizonIndex::findTxHorizon(const double& txRadial_m) const {
+        return findHorizon(m_txHull, txRadial_m, false);
+    }
+
+    HorizonPoint TerrainHorizonIndex::findRxHorizon(const double& rxRadial_m) const {
+        return findHorizon(m_rxHull, rxRadial_m, true);
+    }
+
+    std::vector<TerrainHorizonIndex::HullPoint> TerrainHorizonIndex::buildHull(std::span<const double> terrainHeightList_m,
+                const std::vector<double>& distList_m, const bool isFromRx) const {
+        const std::size_t numInteriorPoints = distList_m.size() - 1u;
+
+        std::vector<HullPoint> hull;
+        hull.reserve(numInteriorPoints);
+        for (std::size_t orderInd = 0; orderInd < numInteriorPoints; orderInd++) {
+            // Walk away from the terminal owning the hull
+            const std::size_t pointInd = isFromRx ? numInteriorPoints - orderInd : orderInd + 1u;
+            const double& dist_m = distList_m[pointInd];
+            const double& height_m = terrainHeightList_m[pointInd];
+            const HullPoint newPoint { pointInd, height_m, dist_m, height_m - dist_m * dist_m / (2.0 * m_effEarthRadius_m) };
+
+            // Drop points lying on or below the segment from their predecessor to the new point
+            while (hull.size() >= 2u) {
+                const HullPoint& firstPoint = hull[hull.size() - 2u];
+                const HullPoint& lastPoint = hull.back();
+                const double crossProduct = (lastPoint.m_dist_m - firstPoint.m_dist_m) * (newPoint.m_adjHeight_m - firstPoint.m_adjHeight_m) -
+                            (lastPoint.m_adjHeight_m - firstPoint.m_adjHeight_m) * (newPoint.m_dist_m - firstPoint.m_dist_m);
+                if (crossProduct < 0.0) {
+                    break;
+                }
+                hull.pop_back();
+            }
+            hull.push_back(newPoint);
+        }
+        return hull;
+    }
+
+    HorizonPoint TerrainHorizonIndex::findHorizon(const std::vector<HullPoint>& hull, const double& radial_m, const bool isFromRx) const {
+        if (hull.empty()) {
+            return HorizonPoint { 0u, 0.0, 0.0 };
+        }
+
+        const auto calcHullAngle_rad = [&](const std::size_t hullInd) {
+            return calcHorizonAngle_rad(hull[hullInd], radial_m, isFromRx);
+        };
+
+        // Angles along the hull rise and then fall, so search for the first point beating its successor
+        std::size_t lowInd = 0u;
+        std::size_t highInd = hull.size() - 1u;
+        while (lowInd < highInd) {
+            const std::size_t midInd = lowInd + (highInd - lowInd) / 2u;
+            if (calcHullAngle_rad(midInd) >= calcHullAngle_rad(midInd + 1u)) {
+                highInd = midInd;
+            }
+            else {
+                lowInd = midInd + 1u;
+            }
+        }
+
+        // Settle near-ties between neighbouring hull points the way the scan would (the point nearest the Tx wins)
+        HorizonPoint bestPoint { hull[lowInd].m_pointInd, calcHullAngle_rad(lowInd), hull[lowInd].m_dist_m };
+        const std::size_t firstInd = (lowInd > 0u) ? lowInd - 1u : lowInd;
+        const std::size_t lastInd = std::min(lowInd + 1u, hull.size() - 1u);
+        for (std::size_t hullInd = firstInd; hullInd <= lastInd; hullInd++) {
+            const double angle_rad = calcHullAngle_rad(hullInd);
+            if (angle_rad > bestPoint.m_angle_rad || (angle_rad == bestPoint.m_angle_rad && hull[hullInd].m_pointInd < bestPoint.m_pointInd)) {
+                bestPoint = HorizonPoint { hull[hullInd].m_pointInd, angle_rad, hull[hullInd].m_dist_m };
+            }
+        }
+        return bestPoint;
+    }
+
+    double TerrainHorizonIndex::calcHorizonAngle_rad(const HullPoint& hullPoint, const double& radial_m, const bool isFromRx) const {
+        // Same expressions as ItmCommonCalculator::setHorizonParameters(), so that equal points give equal angles
+        const double& dist_m = hullPoint.m_dist_m;
+        if (isFromRx) {
+            return -(radial_m - hullPoint.m_height_m) / dist_m - dist_m / (2.0 * m_effEarthRadius_m);
+        }
+        return (hullPoint.m_height_m - radial_m) / dist_m - dist_m / (2.0 * m_effEarthRadius_m);
+    }
+} // end namespace
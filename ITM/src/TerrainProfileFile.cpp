@@ -0,0 +1,439 @@
+#include <ITM/TerrainProfileFile.h>
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace NTIA::ITM {
+    namespace {
+        constexpr char kFileMagic[8] = { 'I', 'T', 'M', 'P', 'R', 'O', 'F', '1' };
+        constexpr std::uint32_t kFileVersion = 1u;
+
+        /// @brief Header at the start of every profile file (section offsets are from the start of the file, in bytes)
+        struct FileHeader {
+            char m_magic[8];
+            std::uint32_t m_version;
+            std::uint32_t m_heightEncoding;
+            std::uint64_t m_numProfiles;
+            std::uint64_t m_numHeights;
+            std::uint64_t m_offsetListStart;
+            std::uint64_t m_resolutionListStart;
+            std::uint64_t m_scaleListStart;         // 0 unless the heights are ScaledInt16
+            std::uint64_t m_heightStart;
+        };
+        static_assert(sizeof(FileHeader) == 64u, "The header is part of the file format");
+
+        // The file is written in the host's byte order, and the format says little-endian
+        static_assert(std::endian::native == std::endian::little, "TerrainProfileFile only supports little-endian hosts");
+
+        std::size_t findHeightSize(const std::uint32_t heightEncoding) {
+            switch (heightEncoding) {
+            case TerrainProfileFile::Float64:
+                return sizeof(double);
+            case TerrainProfileFile::Float32:
+                return sizeof(float);
+            case TerrainProfileFile::ScaledInt16:
+                return sizeof(std::int16_t);
+            default:
+                return 0u;
+            }
+        }
+
+        [[noreturn]] void throwOpenError(const std::string& filePath, const std::string& reason) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::TerrainProfileFile(): Unable to map " << filePath << " (" << reason << ")";
+            throw std::runtime_error(oStrStream.str());
+        }
+
+        /// @return Whether a section of count items of itemSize bytes, starting at the given offset, is aligned and lies within the file
+        bool isSectionValid(const std::uint64_t start, const std::uint64_t count, const std::size_t itemSize, const std::size_t sizeBytes) {
+            return start % 8u == 0u && start <= sizeBytes && count <= (sizeBytes - start) / itemSize;
+        }
+
+        template <typename T>
+        void writeValue(std::ofstream& outStream, const T& value) {
+            outStream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        void writeValueList(std::ofstream& outStream, std::span<const T> valueList) {
+            outStream.write(reinterpret_cast<const char*>(valueList.data()), static_cast<std::streamsize>(valueList.size_bytes()));
+        }
+
+        void writePadding(std::ofstream& outStream, const std::size_t numBytes) {
+            const char padding[8] = {};
+            outStream.write(padding, static_cast<std::streamsize>((8u - numBytes % 8u) % 8u));
+        }
+    }
+
+#ifdef _WIN32
+    TerrainProfileFile::TerrainProfileFile(const std::string& filePath)
+                : m_data(nullptr), m_sizeBytes(0u), m_heightEncoding(Float64), m_heightScaleList(nullptr), m_heightData(nullptr),
+                m_numHeights(0u), m_fileHandle(nullptr), m_mappingHandle(nullptr) {
+        HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (fileHandle == INVALID_HANDLE_VALUE) {
+            throwOpenError(filePath, "CreateFile failed");
+        }
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(fileHandle, &fileSize)) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "GetFileSizeEx failed");
+        }
+        m_sizeBytes = static_cast<std::size_t>(fileSize.QuadPart);
+        if (m_sizeBytes < sizeof(FileHeader)) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "too small to hold a header");
+        }
+
+        HANDLE mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mappingHandle == nullptr) {
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "CreateFileMapping failed");
+        }
+        m_data = static_cast<const unsigned char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throwOpenError(filePath, "MapViewOfFile failed");
+        }
+
+        m_fileHandle = fileHandle;
+        m_mappingHandle = mappingHandle;
+
+        try {
+            readLayout(filePath);
+        }
+        catch (...) {
+            UnmapViewOfFile(m_data);
+            CloseHandle(mappingHandle);
+            CloseHandle(fileHandle);
+            throw;
+        }
+    }
+
+    TerrainProfileFile::~TerrainProfileFile() {
+        UnmapViewOfFile(m_data);
+        CloseHandle(static_cast<HANDLE>(m_mappingHandle));
+        CloseHandle(static_cast<HANDLE>(m_fileHandle));
+    }
+#else
+    TerrainProfileFile::TerrainProfileFile(const std::string& filePath)
+                : m_data(nullptr), m_sizeBytes(0u), m_heightEncoding(Float64), m_heightScaleList(nullptr), m_heightData(nullptr),
+                m_numHeights(0u) {
+        const int fileDesc = ::open(filePath.c_str(), O_RDONLY);
+        if (fileDesc < 0) {
+            throwOpenError(filePath, std::strerror(errno));
+        }
+
+        struct stat fileStat;
+        if (::fstat(fileDesc, &fileStat) != 0) {
+            const int errorCode = errno;
+            ::close(fileDesc);
+            throwOpenError(filePath, std::strerror(errorCode));
+        }
+        m_sizeBytes = static_cast<std::size_t>(fileStat.st_size);
+        if (m_sizeBytes < sizeof(FileHeader)) {
+            ::close(fileDesc);
+            throwOpenError(filePath, "too small to hold a header");
+        }
+
+        // The mapping keeps the file alive, so the descriptor can go straight away
+        void* mapping = ::mmap(nullptr, m_sizeBytes, PROT_READ, MAP_PRIVATE, fileDesc, 0);
+        const int errorCode = errno;
+        ::close(fileDesc);
+        if (mapping == MAP_FAILED) {
+            throwOpenError(filePath, std::strerror(errorCode));
+        }
+        m_data = static_cast<const unsigned char*>(mapping);
+
+        try {
+            readLayout(filePath);
+        }
+        catch (...) {
+            ::munmap(mapping, m_sizeBytes);
+            throw;
+        }
+    }
+
+    TerrainProfileFile::~TerrainProfileFile() {
+        ::munmap(const_cast<unsigned char*>(m_data), m_sizeBytes);
+    }
+#endif
+
+    void TerrainProfileFile::readLayout(const std::string& filePath) {
+        FileHeader header;
+        std::memcpy(&header, m_data, sizeof(FileHeader));
+        if (std::memcmp(header.m_magic, kFileMagic, sizeof(kFileMagic)) != 0) {
+            throwOpenError(filePath, "not a terrain profile file");
+        }
+        if (header.m_version != kFileVersion) {
+            throwOpenError(filePath, "unsupported version " + std::to_string(header.m_version));
+        }
+        const std::size_t heightSize = findHeightSize(header.m_heightEncoding);
+        if (heightSize == 0u) {
+            throwOpenError(filePath, "unknown height encoding " + std::to_string(header.m_heightEncoding));
+        }
+        m_heightEncoding = static_cast<HeightEncoding>(header.m_heightEncoding);
+
+        // Check every section lies within the file before reading any of it
+        const bool hasScaleList = (m_heightEncoding == ScaledInt16);
+        if (header.m_numProfiles >= m_sizeBytes
+                    || !isSectionValid(header.m_offsetListStart, header.m_numProfiles + 1u, sizeof(std::uint64_t), m_sizeBytes)
+                    || !isSectionValid(header.m_resolutionListStart, header.m_numProfiles, sizeof(double), m_sizeBytes)
+                    || (hasScaleList && !isSectionValid(header.m_scaleListStart, 2u * header.m_numProfiles, sizeof(double), m_sizeBytes))
+                    || !isSectionValid(header.m_heightStart, header.m_numHeights, heightSize, m_sizeBytes)) {
+            throwOpenError(filePath, "truncated, or sections out of bounds");
+        }
+
+        const std::size_t numProfiles = static_cast<std::size_t>(header.m_numProfiles);
+        m_profileOffsetList.resize(numProfiles + 1u);
+        for (std::size_t offsetInd = 0; offsetInd <= numProfiles; offsetInd++) {
+            std::uint64_t offset;
+            std::memcpy(&offset, m_data + header.m_offsetListStart + offsetInd * sizeof(std::uint64_t), sizeof(std::uint64_t));
+            m_profileOffsetList[offsetInd] = static_cast<std::size_t>(offset);
+        }
+        for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+            if (m_profileOffsetList[profileInd + 1u] < m_profileOffsetList[profileInd]
+                        || m_profileOffsetList[profileInd + 1u] - m_profileOffsetList[profileInd] < 2u) {
+                throwOpenError(filePath, "profile " + std::to_string(profileInd) + " has fewer than 2 points");
+            }
+        }
+        if (m_profileOffsetList.back() > header.m_numHeights) {
+            throwOpenError(filePath, "profile offsets run past the heights");
+        }
+
+        // Sections are 8-byte aligned within a page-aligned mapping, so they can be read in place
+        m_sampleResolutionList_m = std::span<const double>(reinterpret_cast<const double*>(m_data + header.m_resolutionListStart), numProfiles);
+        m_heightScaleList = hasScaleList ? reinterpret_cast<const double*>(m_data + header.m_scaleListStart) : nullptr;
+        m_heightData = m_data + header.m_heightStart;
+        m_numHeights = static_cast<std::size_t>(header.m_numHeights);
+    }
+
+    void TerrainProfileFile::checkHeightEncoding(const char* funcName, const HeightEncoding heightEncoding) const {
+        if (m_heightEncoding != heightEncoding) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::" << funcName << "(): "
+                        << "Heights are stored with encoding " << m_heightEncoding << ", not " << heightEncoding;
+            throw std::domain_error(oStrStream.str());
+        }
+    }
+
+    std::span<const double> TerrainProfileFile::getHeightBuffer_m() const {
+        checkHeightEncoding("getHeightBuffer_m", Float64);
+        return { reinterpret_cast<const double*>(m_heightData), m_numHeights };
+    }
+
+    std::span<const double> TerrainProfileFile::getHeights_m(const std::size_t profileInd) const {
+        checkHeightEncoding("getHeights_m", Float64);
+        return { reinterpret_cast<const double*>(m_heightData) + m_profileOffsetList[profileInd], getNumPoints(profileInd) };
+    }
+
+    std::span<const float> TerrainProfileFile::getFloat32Heights_m(const std::size_t profileInd) const {
+        checkHeightEncoding("getFloat32Heights_m", Float32);
+        return { reinterpret_cast<const float*>(m_heightData) + m_profileOffsetList[profileInd], getNumPoints(profileInd) };
+    }
+
+    std::span<const std::int16_t> TerrainProfileFile::getScaledInt16Heights(const std::size_t profileInd) const {
+        checkHeightEncoding("getScaledInt16Heights", ScaledInt16);
+        return { reinterpret_cast<const std::int16_t*>(m_heightData) + m_profileOffsetList[profileInd], getNumPoints(profileInd) };
+    }
+
+    TerrainProfileFile::HeightScale TerrainProfileFile::getHeightScale(const std::size_t profileInd) const {
+        checkHeightEncoding("getHeightScale", ScaledInt16);
+        return { m_heightScaleList[2u * profileInd], m_heightScaleList[2u * profileInd + 1u] };
+    }
+
+    std::span<const double> TerrainProfileFile::readHeights_m(const std::size_t profileInd, std::vector<double>& decodeBuffer_m) const {
+        switch (m_heightEncoding) {
+        case Float32: {
+            const std::span<const float> heightList_m = getFloat32Heights_m(profileInd);
+            decodeBuffer_m.resize(heightList_m.size());
+            std::copy(heightList_m.begin(), heightList_m.end(), decodeBuffer_m.begin());
+            return decodeBuffer_m;
+        }
+        case ScaledInt16: {
+            const std::span<const std::int16_t> sampleList = getScaledInt16Heights(profileInd);
+            const HeightScale heightScale = getHeightScale(profileInd);
+            decodeBuffer_m.resize(sampleList.size());
+            for (std::size_t pointInd = 0; pointInd < sampleList.size(); pointInd++) {
+                decodeBuffer_m[pointInd] = heightScale.m_offset_m + heightScale.m_scale_m * static_cast<double>(sampleList[pointInd]);
+            }
+            return decodeBuffer_m;
+        }
+        default:
+            return getHeights_m(profileInd);
+        }
+    }
+
+    void TerrainProfileFile::write(const std::string& filePath, std::span<const double> terrainHeightBuffer_m,
+                std::span<const std::size_t> profileOffsetList, std::span<const double> sampleResolutionList_m,
+                const HeightEncoding heightEncoding) {
+        const std::size_t heightSize = findHeightSize(heightEncoding);
+        if (heightSize == 0u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::write(): Unknown height encoding (heightEncoding = " << heightEncoding << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        if (profileOffsetList.empty() || sampleResolutionList_m.size() != profileOffsetList.size() - 1u) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::write(): "
+                        << "Need one resolution per profile and one more offset than profiles (profileOffsetList = "
+                        << profileOffsetList.size() << ", sampleResolutionList_m = " << sampleResolutionList_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        const std::size_t numProfiles = sampleResolutionList_m.size();
+        for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+            if (profileOffsetList[profileInd + 1u] < profileOffsetList[profileInd]
+                        || profileOffsetList[profileInd + 1u] - profileOffsetList[profileInd] < 2u) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: TerrainProfileFile::write(): Profile " << profileInd << " has fewer than 2 points";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+        if (profileOffsetList.back() > terrainHeightBuffer_m.size()) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::write(): "
+                        << "Profile offsets run past the height buffer (last offset = " << profileOffsetList.back()
+                        << ", buffer size = " << terrainHeightBuffer_m.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        // Offsets are stored relative to the first profile, which need not start the caller's buffer
+        const std::size_t firstOffset = profileOffsetList.front();
+        const std::size_t numHeights = profileOffsetList.back() - firstOffset;
+
+        FileHeader header;
+        std::memcpy(header.m_magic, kFileMagic, sizeof(kFileMagic));
+        header.m_version = kFileVersion;
+        header.m_heightEncoding = heightEncoding;
+        header.m_numProfiles = numProfiles;
+        header.m_numHeights = numHeights;
+        header.m_offsetListStart = sizeof(FileHeader);
+        header.m_resolutionListStart = header.m_offsetListStart + (numProfiles + 1u) * sizeof(std::uint64_t);
+        header.m_scaleListStart = (heightEncoding == ScaledInt16) ? header.m_resolutionListStart + numProfiles * sizeof(double) : 0u;
+        header.m_heightStart = header.m_resolutionListStart + ((heightEncoding == ScaledInt16) ? 3u : 1u) * numProfiles * sizeof(double);
+
+        std::ofstream outStream(filePath, std::ios::binary | std::ios::trunc);
+        if (!outStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::write(): Unable to open " << filePath << " for writing";
+            throw std::runtime_error(oStrStream.str());
+        }
+
+        writeValue(outStream, header);
+        for (const std::size_t offset : profileOffsetList) {
+            writeValue(outStream, static_cast<std::uint64_t>(offset - firstOffset));
+        }
+        writeValueList(outStream, sampleResolutionList_m);
+
+        const std::span<const double> heightList_m = terrainHeightBuffer_m.subspan(firstOffset, numHeights);
+        switch (heightEncoding) {
+        case Float32: {
+            std::vector<float> float32HeightList_m(heightList_m.begin(), heightList_m.end());
+            writeValueList(outStream, std::span<const float>(float32HeightList_m));
+            break;
+        }
+        case ScaledInt16: {
+            // Centre each profile's range on 0 and spread it over [-32767, 32767]
+            std::vector<std::int16_t> sampleList(numHeights);
+            for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+                const std::size_t startInd = profileOffsetList[profileInd] - firstOffset;
+                const std::size_t endInd = profileOffsetList[profileInd + 1u] - firstOffset;
+                const auto [minIter, maxIter] = std::minmax_element(heightList_m.begin() + startInd, heightList_m.begin() + endInd);
+
+                const double offset_m = 0.5 * (*minIter + *maxIter);
+                const double scale_m = (*maxIter > *minIter) ? (*maxIter - *minIter) / 65534.0 : 1.0;
+                for (std::size_t pointInd = startInd; pointInd < endInd; pointInd++) {
+                    const double sample = std::clamp(std::round((heightList_m[pointInd] - offset_m) / scale_m), -32767.0, 32767.0);
+                    sampleList[pointInd] = static_cast<std::int16_t>(sample);
+                }
+                writeValue(outStream, scale_m);
+                writeValue(outStream, offset_m);
+            }
+            writeValueList(outStream, std::span<const std::int16_t>(sampleList));
+            break;
+        }
+        default:
+            writeValueList(outStream, heightList_m);
+            break;
+        }
+        writePadding(outStream, numHeights * heightSize);
+
+        if (!outStream.flush()) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::write(): Unable to write " << filePath;
+            throw std::runtime_error(oStrStream.str());
+        }
+    }
+
+    std::size_t TerrainProfileFile::convertCsv(const std::string& csvFilePath, const std::string& filePath, const HeightEncoding heightEncoding) {
+        std::ifstream inStream(csvFilePath);
+        if (!inStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: TerrainProfileFile::convertCsv(): Unable to open " << csvFilePath;
+            throw std::runtime_error(oStrStream.str());
+        }
+
+        std::vector<double> terrainHeightBuffer_m;
+        std::vector<std::size_t> profileOffsetList { 0u };
+        std::vector<double> sampleResolutionList_m;
+
+        std::string line;
+        std::vector<double> valueList;
+        for (std::size_t lineNum = 1; std::getline(inStream, line); lineNum++) {
+            valueList.clear();
+            const char* valueStart = line.c_str();
+            while (*valueStart != '\0' && *valueStart != '\r') {
+                char* valueEnd = nullptr;
+                valueList.push_back(std::strtod(valueStart, &valueEnd));
+                while (*valueEnd == ' ' || *valueEnd == '\t') {
+                    valueEnd++;
+                }
+                if (valueEnd == valueStart || (*valueEnd != ',' && *valueEnd != '\0' && *valueEnd != '\r')) {
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: TerrainProfileFile::convertCsv(): "
+                                << csvFilePath << ":" << lineNum << ": Bad value in column " << valueList.size();
+                    throw std::runtime_error(oStrStream.str());
+                }
+                valueStart = (*valueEnd == ',') ? valueEnd + 1 : valueEnd;
+            }
+            if (valueList.empty()) {
+                continue;
+            }
+
+            // The leading point count doesn't include the Tx, so a well-formed line has it + 3 values
+            if (valueList.size() < 4u || valueList[0] != std::floor(valueList[0]) || valueList[0] + 3.0 != static_cast<double>(valueList.size())) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: TerrainProfileFile::convertCsv(): " << csvFilePath << ":" << lineNum << ": "
+                            << "Point count doesn't match the number of heights (count = " << valueList[0]
+                            << ", heights = " << valueList.size() - std::min<std::size_t>(valueList.size(), 2u) << ")";
+                throw std::runtime_error(oStrStream.str());
+            }
+
+            sampleResolutionList_m.push_back(valueList[1]);
+            terrainHeightBuffer_m.insert(terrainHeightBuffer_m.end(), valueList.begin() + 2, valueList.end());
+            profileOffsetList.push_back(terrainHeightBuffer_m.size());
+        }
+
+        write(filePath, terrainHeightBuffer_m, profileOffsetList, sampleResolutionList_m, heightEncoding);
+        return sampleResolutionList_m.size();
+    }
+} // end namespace
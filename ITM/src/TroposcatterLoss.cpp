@@ -1,5 +1,7 @@
 #include <ITM/ItmCommonCalculator.h>
 #include <ITM/ItmHelpers.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 
 /*=============================================================================
  |
@@ -59,8 +61,11 @@ namespace NTIA::ITM::ItmHelpers {
  *===========================================================================*/
 
 namespace NTIA::ITM {
-    double ItmCommonCalculator::calcTroposcatterLoss_dB(const double& tropoPathLength_m, const double& earthEffRadius_m, 
-                const double& angularDist_LoS_rad, double& initialH0_dB) {
+    double ItmCommonCalculator::calcTroposcatterLoss_dB(const ItmWorkspace& workspace, const double& tropoPathLength_m, const double& earthEffRadius_m, 
+                const double& angularDist_LoS_rad, double& initialH0_dB) const {
+        ITM_STATS_STAGE(Troposcatter);
+        ITM_TRACE_STAGE(Troposcatter);
+
         double finalH0_dB = initialH0_dB;
 
         // Calculate angular wavelength
@@ -69,12 +74,12 @@ namespace NTIA::ITM {
 
         // If initialH0_dB is already set to a value > 15, no need to perform these calculations
         if (initialH0_dB <= 15.0) {
-            const double& txHorizonDist_m = m_itmResults.m_intermResults.m_txHorizonDist_m;
-            const double& rxHorizonDist_m = m_itmResults.m_intermResults.m_rxHorizonDist_m;
-            const double& txEffHeight_m = m_itmResults.m_intermResults.m_txEffHeight_m;
-            const double& rxEffHeight_m = m_itmResults.m_intermResults.m_rxEffHeight_m;
-            const double& txHorizAngle_rad = m_itmResults.m_intermResults.m_txHorizonAngle_rad;
-            const double& rxHorizAngle_rad = m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
+            const double& txHorizonDist_m = workspace.m_itmResults.m_intermResults.m_txHorizonDist_m;
+            const double& rxHorizonDist_m = workspace.m_itmResults.m_intermResults.m_rxHorizonDist_m;
+            const double& txEffHeight_m = workspace.m_itmResults.m_intermResults.m_txEffHeight_m;
+            const double& rxEffHeight_m = workspace.m_itmResults.m_intermResults.m_rxEffHeight_m;
+            const double& txHorizAngle_rad = workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad;
+            const double& rxHorizAngle_rad = workspace.m_itmResults.m_intermResults.m_rxHorizonAngle_rad;
 
             double horizonDistDelta_m = txHorizonDist_m - rxHorizonDist_m;
             double effHeightRatio = rxEffHeight_m / txEffHeight_m;
@@ -106,6 +111,7 @@ namespace NTIA::ITM {
 
             double Z_0__meter = 1.7556e3;       // Scale height, [Algorithm, 4.67]
             double Z_1__meter = 8.0e3;          // [Algorithm, 4.67]
+            const double& N_s = workspace.m_surfaceRefractivity_N;      // Surface refractivity, in N-Units
             double scatterEffTerm = (h_0__meter / Z_0__meter) * (1.0 + (0.031 - N_s * 2.32e-3 + N_s * N_s * 5.67e-6) * exp(-pow(std::min({1.7, h_0__meter / Z_1__meter}), 6)));     // Scattering efficiency factor, scatterEffTerm [TN101 Eqn 9.3a]
 
             const double tropoGain_r1 = ItmHelpers::calcTropoFreqGain_dB(r1_radSqrd, scatterEffTerm);
@@ -140,7 +146,7 @@ namespace NTIA::ITM {
         const double logTerm = waveNumber_radPerM * ItmHelpers::kWaveToMHzFreqTerm * thConst * thConst * thConst * thConst;
         return ItmHelpers::calcTropoAttenFunction_dB(thConst * tropoPathLength_m) + 
                     10.0 * log10(logTerm) - 
-                    0.1 * (m_surfaceRefractivity_N - 301.0) * exp(-thConst * tropoPathLength_m / kD0_m) +
+                    0.1 * (workspace.m_surfaceRefractivity_N - 301.0) * exp(-thConst * tropoPathLength_m / kD0_m) +
                     finalH0_dB;    // [Algorithm, 4.63]
     }
 }
\ No newline at end of file
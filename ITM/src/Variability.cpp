@@ -1,219 +1,242 @@
-#include "ITM/itm.h"
+#include <ITM/VariabilityCalculator.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ItmStats.h>
+#include <ITM/ItmTrace.h>
 #include <ITM/MathHelpers.h>
 
-/*=============================================================================
- |
- |  Description:  Curve helper function for TN101v2 Eqn III.69 & III.70
- |
- |        Input:  c1, c2, x1, x2, x3    - Curve fit parameters
- |                d_e__metre            - Effective distance, in meters
- |
- |      Outputs:  [None]
- |
- |      Returns:  Curve value           - in dB
- |
- *===========================================================================*/
-double Curve(double c1, double c2, double x1, double x2, double x3, double d_e__meter)
-{
-    return (c1 + c2 / (1.0 + pow((d_e__meter - x2) / x3, 2))) * (pow(d_e__meter / x1, 2)) / (1.0 + (pow(d_e__meter / x1, 2)));
-}
-
-/*=============================================================================
- |
- |  Description:  Compute the variability loss
- |
- |        Input:  time           - Time percentage, 0 < time < 1
- |                location       - Location percentage, 0 < location < 1
- |                situation      - Situation percentage, 0 < situation < 1
- |                h_e__meter[2]  - Effective antenna heights, in meters
- |                delta_h__meter - Terrain irregularity parameter
- |                f__mhz         - Frequency, in MHz
- |                d__meter       - Path distance, in meters
- |                A_ref__db      - Reference attenuation, in dB
- |                climate        - Radio climate enum
- |                                      + 1 : CLIMATE__EQUATORIAL
- |                                      + 2 : CLIMATE__CONTINENTAL_SUBTROPICAL
- |                                      + 3 : CLIMATE__MARITIME_SUBTROPICAL
- |                                      + 4 : CLIMATE__DESERT
- |                                      + 5 : CLIMATE__CONTINENTAL_TEMPERATE
- |                                      + 6 : CLIMATE__MARITIME_TEMPERATE_OVER_LAND
- |                                      + 7 : CLIMATE__MARITIME_TEMPERATE_OVER_SEA
- |                mdvar          - Mode of variability
- |
- |      Outputs:  warnings       - Warning flags
- |
- |      Returns:  F()            - in dB
- |
- *===========================================================================*/
-double Variability(double time, double location, double situation, double h_e__meter[2], double delta_h__meter, 
-    double f__mhz, double d__meter, double A_ref__db, int climate, int mdvar, long *warnings)
-{
-    // Asymptotic values from TN101, Fig 10.13
-    // -> approximate to TN101v2 Eqn III.69 & III.70
-    // -> to describe the curves for each climate
-    double all_year[5][7] =
-    {
-        {  -9.67,   -0.62,    1.26,   -9.21,   -0.62,   -0.39,      3.15 },
-        {  12.7,     9.19,   15.5,     9.05,    9.19,    2.86,   857.9   },
-        { 144.9e3, 228.9e3, 262.6e3,  84.1e3, 228.9e3, 141.7e3, 2222.e3  },
-        { 190.3e3, 205.2e3, 185.2e3, 101.1e3, 205.2e3, 315.9e3,  164.8e3 },
-        { 133.8e3, 143.6e3,  99.8e3,  98.6e3, 143.6e3, 167.4e3,  116.3e3 }
-    };
-
-    double bsm1[] = { 2.13,      2.66,    6.11,     1.98,   2.68,    6.86,    8.51 };
-    double bsm2[] = { 159.5,     7.67,    6.65,    13.11,   7.16,   10.38,  169.8 };
-    double xsm1[] = { 762.2e3, 100.4e3, 138.2e3, 139.1e3,  93.7e3, 187.8e3, 609.8e3 };
-    double xsm2[] = { 123.6e3, 172.5e3, 242.2e3, 132.7e3, 186.8e3, 169.6e3, 119.9e3 };
-    double xsm3[] = { 94.5e3,  136.4e3, 178.6e3, 193.5e3, 133.5e3, 108.9e3, 106.6e3 };
-
-    double bsp1[] = { 2.11, 6.87, 10.08, 3.68, 4.75, 8.58, 8.43 };
-    double bsp2[] = { 102.3, 15.53, 9.60, 159.3, 8.12, 13.97, 8.19 };
-    double xsp1[] = { 636.9e3, 138.7e3, 165.3e3, 464.4e3, 93.2e3, 216.0e3, 136.2e3 };
-    double xsp2[] = { 134.8e3, 143.7e3, 225.7e3, 93.1e3, 135.9e3, 152.0e3, 188.5e3 };
-    double xsp3[] = { 95.6e3, 98.6e3, 129.7e3, 94.2e3, 113.4e3, 122.7e3, 122.9e3 };
-
-    double C_D[] = { 1.224, 0.801, 1.380, 1.000, 1.224, 1.518, 1.518 };	    // [Algorithm, Table 5.1], C_d
-    double z_D[] = { 1.282, 2.161, 1.282, 20.0, 1.282, 1.282, 1.282 };		// [Algorithm, Table 5.1], z_d
-
-    double bfm1[] = { 1.0, 1.0, 1.0, 1.0, 0.92, 1.0, 1.0 };
-    double bfm2[] = { 0.0, 0.0, 0.0, 0.0, 0.25, 0.0, 0.0 };
-    double bfm3[] = { 0.0, 0.0, 0.0, 0.0, 1.77, 0.0, 0.0 };
-
-    double bfp1[] = { 1.0, 0.93, 1.0, 0.93, 0.93, 1.0, 1.0 };
-    double bfp2[] = { 0.0, 0.31, 0.0, 0.19, 0.31, 0.0, 0.0 };
-    double bfp3[] = { 0.0, 2.00, 0.0, 1.79, 2.00, 0.0, 0.0 };
-
-    double z_T = NTIA::ITM::MathHelpers::calcInvComplCumulDistribFunc(time);
-    double z_L = NTIA::ITM::MathHelpers::calcInvComplCumulDistribFunc(location);
-    double z_S = NTIA::ITM::MathHelpers::calcInvComplCumulDistribFunc(situation);
-
-    climate--; // 0-based indexes
-
-    double wn = f__mhz / 47.7;
-
-    // compute the effective distance
-    double d_ex__meter = sqrt(2 * a_9000__meter * h_e__meter[0]) + sqrt(2 * a_9000__meter * h_e__meter[1]) + pow((575.7e12 / wn), THIRD);		// [Algorithm, Eqn 5.3]
-
-    double d_e__meter;
-    if (d__meter < d_ex__meter)
-        d_e__meter = 130e3 * d__meter / d_ex__meter;
-    else
-        d_e__meter = 130e3 + d__meter - d_ex__meter;
-
-    //////////////////////////////////
-    // situation variability calcs
-
-    // if mdvar >= 20, then "Direct situation variability is to be eliminated as it should when
-    //                       considering interference problems.  Note that there may still be a 
-    //                       small residual situation variability" [Hufford, 1982]
-    bool plus20 = mdvar >= 20;
-    if (plus20)
-        mdvar -= 20;
-
-    double sigma_S;
-    if (plus20)
-        sigma_S = 0.0;
-    else
-    {
-        double D__meter = 100e3;                                // Scale distance, D = 100 km
-        sigma_S = 5.0 + 3.0 * exp(-d_e__meter / D__meter);      // [Algorithm, Eqn 5.10]
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM {
+    namespace {
+        // Asymptotic values from TN101, Fig 10.13
+        // -> approximate to TN101v2 Eqn III.69 & III.70
+        // -> to describe the curves for each climate
+        constexpr double kAllYear[5][7] =
+        {
+            {  -9.67,   -0.62,    1.26,   -9.21,   -0.62,   -0.39,      3.15 },
+            {  12.7,     9.19,   15.5,     9.05,    9.19,    2.86,   857.9   },
+            { 144.9e3, 228.9e3, 262.6e3,  84.1e3, 228.9e3, 141.7e3, 2222.e3  },
+            { 190.3e3, 205.2e3, 185.2e3, 101.1e3, 205.2e3, 315.9e3,  164.8e3 },
+            { 133.8e3, 143.6e3,  99.8e3,  98.6e3, 143.6e3, 167.4e3,  116.3e3 }
+        };
+
+        constexpr double kBsm1[] = { 2.13,      2.66,    6.11,     1.98,   2.68,    6.86,    8.51 };
+        constexpr double kBsm2[] = { 159.5,     7.67,    6.65,    13.11,   7.16,   10.38,  169.8 };
+        constexpr double kXsm1[] = { 762.2e3, 100.4e3, 138.2e3, 139.1e3,  93.7e3, 187.8e3, 609.8e3 };
+        constexpr double kXsm2[] = { 123.6e3, 172.5e3, 242.2e3, 132.7e3, 186.8e3, 169.6e3, 119.9e3 };
+        constexpr double kXsm3[] = { 94.5e3,  136.4e3, 178.6e3, 193.5e3, 133.5e3, 108.9e3, 106.6e3 };
+
+        constexpr double kBsp1[] = { 2.11, 6.87, 10.08, 3.68, 4.75, 8.58, 8.43 };
+        constexpr double kBsp2[] = { 102.3, 15.53, 9.60, 159.3, 8.12, 13.97, 8.19 };
+        constexpr double kXsp1[] = { 636.9e3, 138.7e3, 165.3e3, 464.4e3, 93.2e3, 216.0e3, 136.2e3 };
+        constexpr double kXsp2[] = { 134.8e3, 143.7e3, 225.7e3, 93.1e3, 135.9e3, 152.0e3, 188.5e3 };
+        constexpr double kXsp3[] = { 95.6e3, 98.6e3, 129.7e3, 94.2e3, 113.4e3, 122.7e3, 122.9e3 };
+
+        constexpr double kCD[] = { 1.224, 0.801, 1.380, 1.000, 1.224, 1.518, 1.518 };     // [Algorithm, Table 5.1], C_d
+        constexpr double kZD[] = { 1.282, 2.161, 1.282, 20.0, 1.282, 1.282, 1.282 };      // [Algorithm, Table 5.1], z_d
+
+        constexpr double kBfm1[] = { 1.0, 1.0, 1.0, 1.0, 0.92, 1.0, 1.0 };
+        constexpr double kBfm2[] = { 0.0, 0.0, 0.0, 0.0, 0.25, 0.0, 0.0 };
+        constexpr double kBfm3[] = { 0.0, 0.0, 0.0, 0.0, 1.77, 0.0, 0.0 };
+
+        constexpr double kBfp1[] = { 1.0, 0.93, 1.0, 0.93, 0.93, 1.0, 1.0 };
+        constexpr double kBfp2[] = { 0.0, 0.31, 0.0, 0.19, 0.31, 0.0, 0.0 };
+        constexpr double kBfp3[] = { 0.0, 2.00, 0.0, 1.79, 2.00, 0.0, 0.0 };
+
+        // Effective earth radius used for the effective distance, [Algorithm, Eqn 5.3]
+        constexpr double kEffEarthRadius_9000km_m { 9000e3 };
+
+        /*=============================================================================
+         |
+         |  Description:  Curve helper function for TN101v2 Eqn III.69 & III.70
+         |
+         |        Input:  c1, c2, x1, x2, x3    - Curve fit parameters
+         |                d_e__metre            - Effective distance, in meters
+         |
+         |      Outputs:  [None]
+         |
+         |      Returns:  Curve value           - in dB
+         |
+         *===========================================================================*/
+        double calcClimateCurve_dB(const double& c1, const double& c2, const double& x1, const double& x2, const double& x3,
+                    const double& effDist_m) {
+            return (c1 + c2 / (1.0 + std::pow((effDist_m - x2) / x3, 2))) * (std::pow(effDist_m / x1, 2)) / (1.0 + (std::pow(effDist_m / x1, 2)));
+        }
     }
 
-    //
-    //////////////////////////////////
-
-    
-    bool plus10 = mdvar >= 10;
-    if (plus10)
-        mdvar -= 10;
-
-    double V_med__db = Curve(all_year[0][climate], all_year[1][climate], all_year[2][climate], all_year[3][climate], all_year[4][climate], d_e__meter);
-
-    if (mdvar == SINGLE_MESSAGE_MODE)
-    {
-        z_T = z_S;
-        z_L = z_S;
+    VariabilityCalculator::VariabilityCalculator(const RadioClimate& climateCode, const VariabilityMode& varMode, const double& freq_MHz,
+                const double& txEffHeight_m, const double& rxEffHeight_m, const double& terrainIrreg_m, const double& pathDist_m) {
+        ITM_STATS_STAGE(Variability);
+        ITM_TRACE_STAGE(Variability);
+
+        // Split the flags off the mode
+        int varModeCode = static_cast<int>(varMode);
+        const bool isSituationVariabilityEliminated = varModeCode >= NoSituationVariability;
+        if (isSituationVariabilityEliminated) {
+            varModeCode -= NoSituationVariability;
+        }
+        const bool isLocationVariabilityEliminated = varModeCode >= NoLocationVariability;
+        if (isLocationVariabilityEliminated) {
+            varModeCode -= NoLocationVariability;
+        }
+        if (varModeCode < SingleMessageMode || varModeCode > BroadcastMode) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: VariabilityCalculator::VariabilityCalculator(): "
+                        << "Mode of variability must be 0 - 3, plus 10 and/or 20 (varMode = " << static_cast<int>(varMode) << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+        m_varMode = static_cast<VariabilityMode>(varModeCode);
+
+        const std::size_t climateInd = static_cast<std::size_t>(climateCode);
+        m_zD = kZD[climateInd];
+
+        const double waveNumber = freq_MHz / 47.7;
+
+        // compute the effective distance, [Algorithm, Eqn 5.3]
+        const double extendedDist_m = std::sqrt(2 * kEffEarthRadius_9000km_m * txEffHeight_m) + std::sqrt(2 * kEffEarthRadius_9000km_m * rxEffHeight_m) +
+                    std::pow((575.7e12 / waveNumber), 1.0 / 3.0);
+
+        double effDist_m;
+        if (pathDist_m < extendedDist_m) {
+            effDist_m = 130e3 * pathDist_m / extendedDist_m;
+        }
+        else {
+            effDist_m = 130e3 + pathDist_m - extendedDist_m;
+        }
+
+        // Situation variability, with scale distance D = 100 km, [Algorithm, Eqn 5.10]
+        m_sigmaS_dB = isSituationVariabilityEliminated ? 0.0 : 5.0 + 3.0 * std::exp(-effDist_m / 100e3);
+
+        m_medianVariability_dB = calcClimateCurve_dB(kAllYear[0][climateInd], kAllYear[1][climateInd], kAllYear[2][climateInd],
+                    kAllYear[3][climateInd], kAllYear[4][climateInd], effDist_m);
+
+        // Location variability, context of [Algorithm, Eqn 5.9]
+        if (isLocationVariabilityEliminated) {
+            m_sigmaL_dB = 0.0;
+        }
+        else {
+            const double terrainRoughness_m = ItmHelpers::calcTerrainRoughness_m(pathDist_m, terrainIrreg_m);
+            m_sigmaL_dB = 10.0 * waveNumber * terrainRoughness_m / (waveNumber * terrainRoughness_m + 13.0);
+        }
+
+        // Time variability
+        const double q = std::log(0.133 * waveNumber);
+        const double gMinus = kBfm1[climateInd] + kBfm2[climateInd] / (std::pow(kBfm3[climateInd] * q, 2) + 1.0);
+        const double gPlus = kBfp1[climateInd] + kBfp2[climateInd] / (std::pow(kBfp3[climateInd] * q, 2) + 1.0);
+
+        m_sigmaTMinus_dB = calcClimateCurve_dB(kBsm1[climateInd], kBsm2[climateInd], kXsm1[climateInd], kXsm2[climateInd], kXsm3[climateInd], effDist_m) * gMinus;
+        m_sigmaTPlus_dB = calcClimateCurve_dB(kBsp1[climateInd], kBsp2[climateInd], kXsp1[climateInd], kXsp2[climateInd], kXsp3[climateInd], effDist_m) * gPlus;
+
+        m_sigmaTD_dB = kCD[climateInd] * m_sigmaTPlus_dB;
+        m_sigmaTSlope_dB = (m_sigmaTPlus_dB - m_sigmaTD_dB) * m_zD;
     }
-    else if (mdvar == ACCIDENTAL_MODE)
-        z_L = z_S;
-    else if (mdvar == MOBILE_MODE)
-        z_L = z_T;
-    // else using Broadcast Mode (no additional operations)
-
-    if (fabs(z_T) > 3.10 || fabs(z_L) > 3.10 || fabs(z_S) > 3.10)
-        *warnings |= WARN__EXTREME_VARIABILITIES;
-
-    //////////////////////////////////
-    // location variability calcs
-
-    double sigma_L;
-    if (plus10)
-        sigma_L = 0.0;
-    else
-    {
-        double delta_h_d__meter = TerrainRoughness(d__meter, delta_h__meter);
-
-        sigma_L = 10.0 * wn * delta_h_d__meter / (wn * delta_h_d__meter + 13.0);    // Context of [Algorithm, Eqn 5.9]
-    }
-    double Y_L = sigma_L * z_L;
-
-    //
-    //////////////////////////////////
-
-    //////////////////////////////////
-    // time variability calcs
-
-    double q = log(0.133 * wn);
-    double g_minus = bfm1[climate] + bfm2[climate] / (pow(bfm3[climate] * q, 2) + 1.0);
-    double g_plus = bfp1[climate] + bfp2[climate] / (pow(bfp3[climate] * q, 2) + 1.0);
-
-    double sigma_T_minus = Curve(bsm1[climate], bsm2[climate], xsm1[climate], xsm2[climate], xsm3[climate], d_e__meter) * g_minus;
-    double sigma_T_plus = Curve(bsp1[climate], bsp2[climate], xsp1[climate], xsp2[climate], xsp3[climate], d_e__meter) * g_plus;
-
-    double sigma_TD = C_D[climate] * sigma_T_plus;
-    double tgtd = (sigma_T_plus - sigma_TD) * z_D[climate];
 
-    double sigma_T;
-    if (z_T < 0.0)
-        sigma_T = sigma_T_minus;
-    else if (z_T <= z_D[climate])
-        sigma_T = sigma_T_plus;
-    else
-        sigma_T = sigma_TD + tgtd / z_T;
-    double Y_T = sigma_T * z_T;
+    double VariabilityCalculator::calcVariabilityLoss_dB(const double& refAtten_dB, const double& timeFrac, const double& locationFrac,
+                const double& situationFrac) const {
+        ITM_STATS_STAGE(Variability);
+        ITM_TRACE_STAGE(Variability);
 
-    //
-    /////////////////////////////////
-
-    double Y_S_temp = pow(sigma_S, 2) + pow(Y_T, 2) / (7.8 + pow(z_S, 2)) + pow(Y_L, 2) / (24.0 + pow(z_S, 2));   // Part of [Algorithm, Eqn 5.11]
-
-    double Y_R, Y_S;
-    if (mdvar == SINGLE_MESSAGE_MODE)
-    {
-        Y_R = 0.0;
-        Y_S = sqrt(pow(sigma_T, 2) + pow(sigma_L, 2) + Y_S_temp) * z_S;
-    }
-    else if (mdvar == ACCIDENTAL_MODE)
-    {
-        Y_R = Y_T;
-        Y_S = sqrt(pow(sigma_L, 2) + Y_S_temp) * z_S;
-    }
-    else if (mdvar == MOBILE_MODE)
-    {
-        Y_R = sqrt(pow(sigma_T, 2) + pow(sigma_L, 2)) * z_T;
-        Y_S = sqrt(Y_S_temp) * z_S;
-    }
-    else // BROADCAST_MODE
-    {
-        Y_R = Y_T + Y_L;
-        Y_S = sqrt(Y_S_temp) * z_S;
+        return calcVariabilityLossFromDeviates_dB(refAtten_dB, MathHelpers::calcInvComplCumulDistribFunc(timeFrac),
+                    MathHelpers::calcInvComplCumulDistribFunc(locationFrac), MathHelpers::calcInvComplCumulDistribFunc(situationFrac));
     }
 
-    double result = A_ref__db - V_med__db - Y_R - Y_S;
+    void VariabilityCalculator::calcVariabilityLoss_TLS_dB(const double& refAtten_dB, std::span<const VariabilityQuantiles> quantilesList,
+                std::span<double> lossList_dB) const {
+        if (lossList_dB.size() < quantilesList.size()) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: VariabilityCalculator::calcVariabilityLoss_TLS_dB(): "
+                        << "Expected room for " << quantilesList.size() << " outputs (lossList_dB = " << lossList_dB.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        for (std::size_t quantilesInd = 0; quantilesInd < quantilesList.size(); quantilesInd++) {
+            const VariabilityQuantiles& quantiles = quantilesList[quantilesInd];
+            lossList_dB[quantilesInd] = calcVariabilityLoss_dB(refAtten_dB, quantiles.m_timeFrac, quantiles.m_locationFrac, quantiles.m_situationFrac);
+        }
+    }
 
-    // [Algorithm, Eqn 52]
-    if (result < 0.0)
-        result = result * (29.0 - result) / (29.0 - 10.0 * result);
+    void VariabilityCalculator::calcVariabilityLoss_CR_dB(const double& refAtten_dB, std::span<const double> confidenceFracList,
+                std::span<const double> reliabilityFracList, std::span<double> lossTable_dB) const {
+        ITM_STATS_STAGE(Variability);
+        ITM_TRACE_STAGE(Variability);
+
+        const std::size_t numReliabilities = reliabilityFracList.size();
+        if (lossTable_dB.size() < confidenceFracList.size() * numReliabilities) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: VariabilityCalculator::calcVariabilityLoss_CR_dB(): "
+                        << "Expected room for " << confidenceFracList.size() * numReliabilities
+                        << " outputs (lossTable_dB = " << lossTable_dB.size() << ")";
+            throw std::domain_error(oStrStream.str());
+        }
+
+        for (std::size_t confInd = 0; confInd < confidenceFracList.size(); confInd++) {
+            const double situationDeviate = MathHelpers::calcInvComplCumulDistribFunc(confidenceFracList[confInd]);
+            for (std::size_t relInd = 0; relInd < numReliabilities; relInd++) {
+                // Reliability sets both the time & location quantiles
+                const double reliabilityDeviate = MathHelpers::calcInvComplCumulDistribFunc(reliabilityFracList[relInd]);
+                lossTable_dB[confInd * numReliabilities + relInd] = calcVariabilityLossFromDeviates_dB(refAtten_dB, reliabilityDeviate, reliabilityDeviate, situationDeviate);
+            }
+        }
+    }
 
-    return result;
-}
\ No newline at end of file
+    double VariabilityCalculator::calcVariabilityLossFromDeviates_dB(const double& refAtten_dB, double timeDeviate, double locationDeviate,
+                const double& situationDeviate) const {
+        if (m_varMode == SingleMessageMode) {
+            timeDeviate = situationDeviate;
+            locationDeviate = situationDeviate;
+        }
+        else if (m_varMode == AccidentalMode) {
+            locationDeviate = situationDeviate;
+        }
+        else if (m_varMode == MobileMode) {
+            locationDeviate = timeDeviate;
+        }
+        // else using Broadcast Mode (no additional operations)
+
+        const double locationVariability_dB = m_sigmaL_dB * locationDeviate;
+
+        double sigmaT_dB;
+        if (timeDeviate < 0.0) {
+            sigmaT_dB = m_sigmaTMinus_dB;
+        }
+        else if (timeDeviate <= m_zD) {
+            sigmaT_dB = m_sigmaTPlus_dB;
+        }
+        else {
+            sigmaT_dB = m_sigmaTD_dB + m_sigmaTSlope_dB / timeDeviate;
+        }
+        const double timeVariability_dB = sigmaT_dB * timeDeviate;
+
+        // Part of [Algorithm, Eqn 5.11]
+        const double situationVarianceTerm = std::pow(m_sigmaS_dB, 2) + std::pow(timeVariability_dB, 2) / (7.8 + std::pow(situationDeviate, 2)) +
+                    std::pow(locationVariability_dB, 2) / (24.0 + std::pow(situationDeviate, 2));
+
+        double reliabilityVariability_dB, situationVariability_dB;
+        if (m_varMode == SingleMessageMode) {
+            reliabilityVariability_dB = 0.0;
+            situationVariability_dB = std::sqrt(std::pow(sigmaT_dB, 2) + std::pow(m_sigmaL_dB, 2) + situationVarianceTerm) * situationDeviate;
+        }
+        else if (m_varMode == AccidentalMode) {
+            reliabilityVariability_dB = timeVariability_dB;
+            situationVariability_dB = std::sqrt(std::pow(m_sigmaL_dB, 2) + situationVarianceTerm) * situationDeviate;
+        }
+        else if (m_varMode == MobileMode) {
+            reliabilityVariability_dB = std::sqrt(std::pow(sigmaT_dB, 2) + std::pow(m_sigmaL_dB, 2)) * timeDeviate;
+            situationVariability_dB = std::sqrt(situationVarianceTerm) * situationDeviate;
+        }
+        else { // BroadcastMode
+            reliabilityVariability_dB = timeVariability_dB + locationVariability_dB;
+            situationVariability_dB = std::sqrt(situationVarianceTerm) * situationDeviate;
+        }
+
+        double result_dB = refAtten_dB - m_medianVariability_dB - reliabilityVariability_dB - situationVariability_dB;
+
+        // [Algorithm, Eqn 52]
+        if (result_dB < 0.0) {
+            result_dB = result_dB * (29.0 - result_dB) / (29.0 - 10.0 * result_dB);
+        }
+
+        return result_dB;
+    }
+} // end namespace
@@ -0,0 +1,144 @@
+#include <ITM/WorkStealingThreadPool.h>
+
+#include <algorithm>
+
+namespace NTIA::ITM {
+    WorkStealingThreadPool::WorkStealingThreadPool(const std::size_t numThreads) {
+        const std::size_t numWorkers = (numThreads > 0u) ? numThreads : std::max(1u, std::thread::hardware_concurrency());
+
+        m_taskQueueList.reserve(numWorkers);
+        for (std::size_t threadInd = 0; threadInd < numWorkers; threadInd++) {
+            m_taskQueueList.push_back(std::make_unique<TaskQueue>());
+        }
+
+        m_threadList.reserve(numWorkers);
+        for (std::size_t threadInd = 0; threadInd < numWorkers; threadInd++) {
+            m_threadList.emplace_back(&WorkStealingThreadPool::runWorker, this, threadInd);
+        }
+    }
+
+    WorkStealingThreadPool::~WorkStealingThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_isStopping = true;
+        }
+        m_startCondition.notify_all();
+
+        for (std::thread& thread : m_threadList) {
+            thread.join();
+        }
+    }
+
+    void WorkStealingThreadPool::run(const std::size_t numTasks, const TaskFunction& taskFunc) {
+        if (numTasks == 0u) {
+            return;
+        }
+
+        // Only one job at a time: the task queues & the job state below belong to it until every worker is done
+        const std::lock_guard<std::mutex> runLock(m_runMutex);
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        // Hand each worker a contiguous block of tasks (workers are all idle, so their queues can be written freely)
+        const std::size_t numWorkers = m_taskQueueList.size();
+        for (std::size_t threadInd = 0; threadInd < numWorkers; threadInd++) {
+            m_taskQueueList[threadInd]->m_startInd = numTasks * threadInd / numWorkers;
+            m_taskQueueList[threadInd]->m_endInd = numTasks * (threadInd + 1u) / numWorkers;
+        }
+
+        m_taskFunc = &taskFunc;
+        m_firstException = nullptr;
+        m_isAborted.store(false, std::memory_order_relaxed);
+        m_numBusyWorkers = numWorkers;
+        m_jobGeneration++;
+        m_startCondition.notify_all();
+
+        m_doneCondition.wait(lock, [this]() { return m_numBusyWorkers == 0u; });
+        m_taskFunc = nullptr;
+
+        if (m_firstException) {
+            std::rethrow_exception(m_firstException);
+        }
+    }
+
+    void WorkStealingThreadPool::runWorker(const std::size_t threadInd) {
+        std::size_t lastJobGeneration = 0u;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_startCondition.wait(lock, [&]() { return m_isStopping || m_jobGeneration != lastJobGeneration; });
+                if (m_isStopping) {
+                    return;
+                }
+                lastJobGeneration = m_jobGeneration;
+            }
+
+            runTasks(threadInd);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_numBusyWorkers == 0u) {
+                m_doneCondition.notify_all();
+            }
+        }
+    }
+
+    void WorkStealingThreadPool::runTasks(const std::size_t threadInd) {
+        std::size_t taskInd;
+        while (takeOwnTask(threadInd, taskInd) || (stealTasks(threadInd) && takeOwnTask(threadInd, taskInd))) {
+            // Only a hint to stop early: the exception itself is handed over under m_mutex
+            if (m_isAborted.load(std::memory_order_relaxed)) {
+                return;
+            }
+
+            try {
+                (*m_taskFunc)(taskInd, threadInd);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!m_firstException) {
+                    m_firstException = std::current_exception();
+                }
+                m_isAborted.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    bool WorkStealingThreadPool::takeOwnTask(const std::size_t threadInd, std::size_t& taskInd) {
+        TaskQueue& taskQueue = *m_taskQueueList[threadInd];
+        std::lock_guard<std::mutex> lock(taskQueue.m_mutex);
+        if (taskQueue.m_startInd == taskQueue.m_endInd) {
+            return false;
+        }
+        taskInd = taskQueue.m_startInd++;
+        return true;
+    }
+
+    bool WorkStealingThreadPool::stealTasks(const std::size_t threadInd) {
+        // No tasks are added once a job starts, so a full pass over the other workers finding nothing means the job is drained
+        const std::size_t numWorkers = m_taskQueueList.size();
+        for (std::size_t offset = 1u; offset < numWorkers; offset++) {
+            TaskQueue& victimQueue = *m_taskQueueList[(threadInd + offset) % numWorkers];
+
+            std::size_t stolenStartInd, stolenEndInd;
+            {
+                std::lock_guard<std::mutex> lock(victimQueue.m_mutex);
+                const std::size_t numRemaining = victimQueue.m_endInd - victimQueue.m_startInd;
+                if (numRemaining == 0u) {
+                    continue;
+                }
+
+                // Take the back half (rounded up), leaving the victim the tasks nearest to what it is working on
+                stolenEndInd = victimQueue.m_endInd;
+                stolenStartInd = stolenEndInd - (numRemaining + 1u) / 2u;
+                victimQueue.m_endInd = stolenStartInd;
+            }
+
+            TaskQueue& ownQueue = *m_taskQueueList[threadInd];
+            std::lock_guard<std::mutex> lock(ownQueue.m_mutex);
+            ownQueue.m_startInd = stolenStartInd;
+            ownQueue.m_endInd = stolenEndInd;
+            return true;
+        }
+        return false;
+    }
+} // end namespace
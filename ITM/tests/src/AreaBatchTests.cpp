@@ -0,0 +1,96 @@
+/// The area mode batch must give each link the loss & mode of a single area mode evaluation of that link
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    /// @brief Links of a batch, kept alive for the spans of an AreaLinkBatch
+    struct AreaLinkLists {
+        std::vector<double> m_txHeightList_m;
+        std::vector<double> m_rxHeightList_m;
+        std::vector<SitingCriteria> m_txSitingCriteriaList;
+        std::vector<SitingCriteria> m_rxSitingCriteriaList;
+        std::vector<double> m_distList_km;
+        std::vector<double> m_terrainIrregList_m;
+        std::vector<double> m_freqList_MHz;
+
+        void addLink(const double& txHeight_m, const double& rxHeight_m, const SitingCriteria& txSitingCriteria,
+                    const SitingCriteria& rxSitingCriteria, const double& dist_km, const double& terrainIrreg_m, const double& freq_MHz) {
+            m_txHeightList_m.push_back(txHeight_m);
+            m_rxHeightList_m.push_back(rxHeight_m);
+            m_txSitingCriteriaList.push_back(txSitingCriteria);
+            m_rxSitingCriteriaList.push_back(rxSitingCriteria);
+            m_distList_km.push_back(dist_km);
+            m_terrainIrregList_m.push_back(terrainIrreg_m);
+            m_freqList_MHz.push_back(freq_MHz);
+        }
+
+        AreaLinkBatch getBatch() const {
+            return { m_txHeightList_m, m_rxHeightList_m, m_txSitingCriteriaList, m_rxSitingCriteriaList, m_distList_km,
+                        m_terrainIrregList_m, m_freqList_MHz };
+        }
+    };
+
+    AreaLinkLists makeTestLinks() {
+        // Runs of terminals at many ranges (sharing a reference attenuation curve), then links that change every time,
+        // over more than one block of the batch
+        const std::vector<double> distList_km { 0.5, 3.0, 12.0, 40.0, 95.0, 250.0, 30.0, 1.0 };
+        AreaLinkLists links;
+        for (int configInd = 0; configInd < 40; configInd++) {
+            const SitingCriteria txSitingCriteria = static_cast<SitingCriteria>(configInd % 3);
+            const SitingCriteria rxSitingCriteria = static_cast<SitingCriteria>((configInd / 3) % 3);
+            const double txHeight_m = 2.0 + 7.5 * (configInd % 9);
+            const double rxHeight_m = 1.0 + 3.0 * (configInd % 4);
+            const double terrainIrreg_m = 10.0 + 25.0 * (configInd % 7);
+            const double freq_MHz = (configInd % 5 < 3) ? 3500.0 : 150.0 + 100.0 * configInd;
+            for (const double& dist_km : distList_km) {
+                links.addLink(txHeight_m, rxHeight_m, txSitingCriteria, rxSitingCriteria, dist_km, terrainIrreg_m, freq_MHz);
+            }
+        }
+        for (int linkInd = 0; linkInd < 100; linkInd++) {
+            links.addLink(5.0 + linkInd, 2.0 + 0.25 * (linkInd % 11), static_cast<SitingCriteria>(linkInd % 3), Careful,
+                        1.0 + 3.7 * linkInd, 90.0, 900.0);
+        }
+        return links;
+    }
+}
+
+TEST(AreaBatchTests, MatchesSingleAreaEvaluations) {
+    const AreaLinkLists links = makeTestLinks();
+    const std::size_t numLinks = links.m_distList_km.size();
+    std::vector<double> attenList_dB(numLinks);
+    std::vector<PropagationMode> propModeList(numLinks);
+    ItmWorkspace workspace;
+    makeTestCalculator().calcItmLoss_area_batch_dB(links.getBatch(), attenList_dB, propModeList, workspace);
+
+    for (std::size_t linkInd = 0; linkInd < numLinks; linkInd++) {
+        ItmCommonCalculator linkCalculator = makeTestCalculator(links.m_txHeightList_m[linkInd], links.m_rxHeightList_m[linkInd],
+                    links.m_freqList_MHz[linkInd]);
+        const ItmResults results = linkCalculator.calcItmLoss_area_dB(links.m_txSitingCriteriaList[linkInd], links.m_rxSitingCriteriaList[linkInd],
+                    links.m_distList_km[linkInd], links.m_terrainIrregList_m[linkInd]);
+        EXPECT_DOUBLE_EQ(attenList_dB[linkInd], results.m_atten_dB) << "link " << linkInd;
+        EXPECT_EQ(propModeList[linkInd], results.m_intermResults.m_propMode) << "link " << linkInd;
+    }
+}
+
+TEST(AreaBatchTests, RejectsUnknownSitingCriteria) {
+    AreaLinkLists links;
+    links.addLink(15.0, 3.0, Careful, static_cast<SitingCriteria>(3), 20.0, 90.0, 3500.0);
+    std::vector<double> attenList_dB(1u);
+    std::vector<PropagationMode> propModeList(1u);
+    ItmWorkspace workspace;
+    EXPECT_THROW(makeTestCalculator().calcItmLoss_area_batch_dB(links.getBatch(), attenList_dB, propModeList, workspace), std::domain_error);
+
+    ItmCommonCalculator calculator = makeTestCalculator();
+    EXPECT_THROW(calculator.calcItmLoss_area_dB(static_cast<SitingCriteria>(-1), Random, 20.0, 90.0), std::domain_error);
+}
@@ -0,0 +1,86 @@
+/// The batch point-to-point form must give each profile the loss & mode of a single-path evaluation of it
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    struct ProfileBatch {
+        std::vector<double> m_terrainHeightBuffer_m;
+        std::vector<std::size_t> m_profileOffsetList { 0u };
+        std::vector<double> m_sampleResolutionList_m;
+        std::vector<std::vector<double>> m_terrainHeightLists_m;
+    };
+
+    ProfileBatch makeBatch() {
+        ProfileBatch batch;
+        unsigned int seed = 1u;
+        for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+            for (const double hillHeight_m : { 0.0, 80.0 }) {
+                std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++, hillHeight_m);
+                batch.m_terrainHeightBuffer_m.insert(batch.m_terrainHeightBuffer_m.end(), terrainHeightList_m.begin(),
+                            terrainHeightList_m.end());
+                batch.m_profileOffsetList.push_back(batch.m_terrainHeightBuffer_m.size());
+                batch.m_sampleResolutionList_m.push_back(kSyntheticSampleResolution_m);
+                batch.m_terrainHeightLists_m.push_back(std::move(terrainHeightList_m));
+            }
+        }
+        return batch;
+    }
+}
+
+TEST(BatchTests, MatchesSinglePathEvaluations) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const ProfileBatch batch = makeBatch();
+    const std::size_t numProfiles = batch.m_terrainHeightLists_m.size();
+
+    std::vector<double> attenList_dB(numProfiles);
+    std::vector<PropagationMode> propModeList(numProfiles);
+    ItmWorkspace batchWorkspace;
+    calculator.calcItmLoss_P2P_batch_dB(batch.m_terrainHeightBuffer_m, batch.m_profileOffsetList, batch.m_sampleResolutionList_m,
+                attenList_dB, propModeList, batchWorkspace);
+
+    ItmWorkspace workspace;
+    for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+        const ItmResults results = calculator.calcItmLoss_P2P_dB(batch.m_terrainHeightLists_m[profileInd], kSyntheticSampleResolution_m,
+                    false, workspace);
+        EXPECT_DOUBLE_EQ(attenList_dB[profileInd], results.m_atten_dB) << "profile " << profileInd;
+        EXPECT_EQ(propModeList[profileInd], results.m_intermResults.m_propMode) << "profile " << profileInd;
+    }
+}
+
+TEST(BatchTests, MatchesSinglePathEvaluationsThroughOwnWorkspace) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    const ProfileBatch batch = makeBatch();
+    const std::size_t numProfiles = batch.m_terrainHeightLists_m.size();
+
+    std::vector<double> attenList_dB(numProfiles);
+    std::vector<PropagationMode> propModeList(numProfiles);
+    calculator.calcItmLoss_P2P_batch_dB(batch.m_terrainHeightBuffer_m, batch.m_profileOffsetList, batch.m_sampleResolutionList_m,
+                attenList_dB, propModeList);
+
+    for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+        const ItmResults results = calculator.calcItmLoss_P2P_dB(batch.m_terrainHeightLists_m[profileInd], kSyntheticSampleResolution_m);
+        EXPECT_DOUBLE_EQ(attenList_dB[profileInd], results.m_atten_dB) << "profile " << profileInd;
+        EXPECT_EQ(propModeList[profileInd], results.m_intermResults.m_propMode) << "profile " << profileInd;
+    }
+}
+
+TEST(BatchTests, RejectsMismatchedOutputSizes) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const ProfileBatch batch = makeBatch();
+    std::vector<double> attenList_dB(batch.m_terrainHeightLists_m.size() - 1u);
+    std::vector<PropagationMode> propModeList(batch.m_terrainHeightLists_m.size());
+    ItmWorkspace workspace;
+    EXPECT_THROW(calculator.calcItmLoss_P2P_batch_dB(batch.m_terrainHeightBuffer_m, batch.m_profileOffsetList,
+                batch.m_sampleResolutionList_m, attenList_dB, propModeList, workspace), std::domain_error);
+}
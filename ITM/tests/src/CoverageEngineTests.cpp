@@ -0,0 +1,130 @@
+/// Every cell of a coverage raster must hold the loss & mode of a single-path evaluation of its profile, whichever worker
+/// evaluated it, and a failing cell must surface to the caller of the job
+
+#include "TestHelpers.h"
+
+#include <ITM/CoverageEngine.h>
+#include <ITM/ItmCommonCalculator.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    std::size_t constexpr kNumRasterRows { 4u };
+    std::size_t constexpr kNumRasterCols { 6u };
+
+    struct CellProfiles {
+        std::vector<double> m_terrainHeightBuffer_m;
+        std::vector<std::size_t> m_profileOffsetList { 0u };
+        std::vector<double> m_sampleResolutionList_m;
+        std::vector<std::vector<double>> m_terrainHeightLists_m;
+    };
+
+    /// Profiles of increasing length (line of sight to trans-horizon), one per cell of the raster
+    CellProfiles makeCellProfiles(const unsigned int firstSeed) {
+        CellProfiles cellProfiles;
+        for (std::size_t cellInd = 0; cellInd < kNumRasterRows * kNumRasterCols; cellInd++) {
+            std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(20u + 60u * cellInd,
+                        firstSeed + static_cast<unsigned int>(cellInd));
+            cellProfiles.m_terrainHeightBuffer_m.insert(cellProfiles.m_terrainHeightBuffer_m.end(), terrainHeightList_m.begin(),
+                        terrainHeightList_m.end());
+            cellProfiles.m_profileOffsetList.push_back(cellProfiles.m_terrainHeightBuffer_m.size());
+            cellProfiles.m_sampleResolutionList_m.push_back(kSyntheticSampleResolution_m);
+            cellProfiles.m_terrainHeightLists_m.push_back(std::move(terrainHeightList_m));
+        }
+        return cellProfiles;
+    }
+
+    /// Cells visited column by column, so that raster index & cell index differ
+    std::vector<std::size_t> makeTransposedRasterIndList() {
+        std::vector<std::size_t> rasterIndList;
+        for (std::size_t colInd = 0; colInd < kNumRasterCols; colInd++) {
+            for (std::size_t rowInd = 0; rowInd < kNumRasterRows; rowInd++) {
+                rasterIndList.push_back(rowInd * kNumRasterCols + colInd);
+            }
+        }
+        return rasterIndList;
+    }
+
+    void expectMatchesSinglePathEvaluations(ItmCommonCalculator& calculator, const CellProfiles& cellProfiles,
+                const std::vector<std::size_t>& rasterIndList, const std::vector<double>& attenRaster_dB,
+                const std::vector<PropagationMode>& propModeRaster) {
+        for (std::size_t cellInd = 0; cellInd < rasterIndList.size(); cellInd++) {
+            const ItmResults results = calculator.calcItmLoss_P2P_dB(cellProfiles.m_terrainHeightLists_m[cellInd], kSyntheticSampleResolution_m);
+            EXPECT_DOUBLE_EQ(attenRaster_dB[rasterIndList[cellInd]], results.m_atten_dB) << "cell " << cellInd;
+            EXPECT_EQ(propModeRaster[rasterIndList[cellInd]], results.m_intermResults.m_propMode) << "cell " << cellInd;
+        }
+    }
+}
+
+TEST(CoverageEngineTests, CellRasterMatchesSinglePathEvaluations) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    const CellProfiles cellProfiles = makeCellProfiles(1u);
+    const std::vector<std::size_t> rasterIndList = makeTransposedRasterIndList();
+
+    // More cells than workers, so that some of them are stolen
+    CoverageEngine engine(3u);
+    std::vector<double> attenRaster_dB(kNumRasterRows * kNumRasterCols, -1.0);
+    std::vector<PropagationMode> propModeRaster(kNumRasterRows * kNumRasterCols, NotSet);
+    engine.calcCellLoss_dB(calculator, cellProfiles.m_terrainHeightBuffer_m, cellProfiles.m_profileOffsetList,
+                cellProfiles.m_sampleResolutionList_m, rasterIndList, attenRaster_dB, propModeRaster);
+
+    expectMatchesSinglePathEvaluations(calculator, cellProfiles, rasterIndList, attenRaster_dB, propModeRaster);
+}
+
+TEST(CoverageEngineTests, JobsFromSeveralThreadsTakeTurns) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    const std::vector<CellProfiles> cellProfilesList { makeCellProfiles(1u), makeCellProfiles(101u) };
+    const std::vector<std::size_t> rasterIndList = makeTransposedRasterIndList();
+
+    CoverageEngine engine(3u);
+    std::vector<std::vector<double>> attenRasterList_dB(cellProfilesList.size(), std::vector<double>(kNumRasterRows * kNumRasterCols, -1.0));
+    std::vector<std::vector<PropagationMode>> propModeRasterList(cellProfilesList.size(),
+                std::vector<PropagationMode>(kNumRasterRows * kNumRasterCols, NotSet));
+    std::vector<std::thread> callerList;
+    for (std::size_t jobInd = 0; jobInd < cellProfilesList.size(); jobInd++) {
+        callerList.emplace_back([&, jobInd]() {
+            const CellProfiles& cellProfiles = cellProfilesList[jobInd];
+            for (int repeatInd = 0; repeatInd < 5; repeatInd++) {
+                engine.calcCellLoss_dB(calculator, cellProfiles.m_terrainHeightBuffer_m, cellProfiles.m_profileOffsetList,
+                            cellProfiles.m_sampleResolutionList_m, rasterIndList, attenRasterList_dB[jobInd], propModeRasterList[jobInd]);
+            }
+        });
+    }
+    for (std::thread& caller : callerList) {
+        caller.join();
+    }
+
+    for (std::size_t jobInd = 0; jobInd < cellProfilesList.size(); jobInd++) {
+        expectMatchesSinglePathEvaluations(calculator, cellProfilesList[jobInd], rasterIndList, attenRasterList_dB[jobInd],
+                    propModeRasterList[jobInd]);
+    }
+}
+
+TEST(CoverageEngineTests, CellFailurePropagatesToCaller) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    CellProfiles cellProfiles = makeCellProfiles(1u);
+
+    // A one point profile passes the engine's own checks but is rejected by the evaluation of its cell
+    const std::size_t badCellInd = cellProfiles.m_sampleResolutionList_m.size() / 2u;
+    cellProfiles.m_profileOffsetList[badCellInd + 1u] = cellProfiles.m_profileOffsetList[badCellInd] + 1u;
+
+    CoverageEngine engine(3u);
+    std::vector<double> attenRaster_dB(kNumRasterRows * kNumRasterCols);
+    EXPECT_THROW(engine.calcCellLoss_dB(calculator, cellProfiles.m_terrainHeightBuffer_m, cellProfiles.m_profileOffsetList,
+                cellProfiles.m_sampleResolutionList_m, {}, attenRaster_dB), std::domain_error);
+
+    // The engine is still usable afterwards
+    const CellProfiles goodCellProfiles = makeCellProfiles(1u);
+    const std::vector<std::size_t> rasterIndList = makeTransposedRasterIndList();
+    std::vector<PropagationMode> propModeRaster(kNumRasterRows * kNumRasterCols, NotSet);
+    engine.calcCellLoss_dB(calculator, goodCellProfiles.m_terrainHeightBuffer_m, goodCellProfiles.m_profileOffsetList,
+                goodCellProfiles.m_sampleResolutionList_m, rasterIndList, attenRaster_dB, propModeRaster);
+    expectMatchesSinglePathEvaluations(calculator, goodCellProfiles, rasterIndList, attenRaster_dB, propModeRaster);
+}
@@ -0,0 +1,107 @@
+/// The tile cache must stay within its budget by dropping the least recently used tile, count each request as a hit or
+/// a miss, and leave tiles still held by a caller readable after evicting them
+
+#include "TestHelpers.h"
+
+#include <ITM/DemTile.h>
+#include <ITM/DemTileCache.h>
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    std::size_t constexpr kTileSize_bytes { 2u * kSyntheticDemNumSamplesPerSide * kSyntheticDemNumSamplesPerSide };
+
+    /// Directory holding three synthetic tiles side by side, at longitudes 0, 1 & 2 on the equator
+    std::string makeTileDirectory(const std::string& name) {
+        const std::string directoryPath = makeTestDirectory(name);
+        for (const int westLon_deg : { 0, 1, 2 }) {
+            writeSyntheticDemTile(directoryPath, 0, westLon_deg);
+        }
+        return directoryPath;
+    }
+
+    /// Request a tile and check whether the cache already had it
+    std::shared_ptr<const DemTile> expectRequest(DemTileCache& tileCache, const int westLon_deg, const bool isHit) {
+        const DemTileCacheStats prevStats = tileCache.getStats();
+        std::shared_ptr<const DemTile> tile = tileCache.getTile(0, westLon_deg);
+        const DemTileCacheStats stats = tileCache.getStats();
+        EXPECT_EQ(stats.m_numHits - prevStats.m_numHits, isHit ? 1u : 0u) << "tile at longitude " << westLon_deg;
+        EXPECT_EQ(stats.m_numMisses - prevStats.m_numMisses, isHit ? 0u : 1u) << "tile at longitude " << westLon_deg;
+        return tile;
+    }
+}
+
+TEST(DemTileCacheTests, EvictsLeastRecentlyUsedTile) {
+    DemTileCache tileCache(makeTileDirectory("DemTileCacheTests_EvictsLeastRecentlyUsedTile"), 2u * kTileSize_bytes);
+
+    // Room for two: A & B are mapped, then A is used again, so C pushes out B
+    expectRequest(tileCache, 0, false);
+    expectRequest(tileCache, 1, false);
+    expectRequest(tileCache, 0, true);
+    expectRequest(tileCache, 2, false);
+    EXPECT_EQ(tileCache.getStats().m_numEvictions, 1u);
+    expectRequest(tileCache, 0, true);
+    expectRequest(tileCache, 2, true);
+
+    // Use order is now C, A: a tile brought back pushes out whichever of the other two was used longest ago
+    expectRequest(tileCache, 1, false);
+    expectRequest(tileCache, 2, true);
+    expectRequest(tileCache, 0, false);
+    expectRequest(tileCache, 2, true);
+    expectRequest(tileCache, 1, false);
+
+    const DemTileCacheStats stats = tileCache.getStats();
+    EXPECT_EQ(stats.m_numEvictions, 4u);
+    EXPECT_EQ(stats.m_numCachedTiles, 2u);
+    EXPECT_EQ(stats.m_cachedBytes, 2u * kTileSize_bytes);
+    EXPECT_EQ(stats.m_numPrefetched, 0u);
+}
+
+TEST(DemTileCacheTests, KeepsEvictedTilesReadableWhileHeld) {
+    // A budget smaller than one tile still keeps the last one mapped
+    DemTileCache tileCache(makeTileDirectory("DemTileCacheTests_KeepsEvictedTilesReadableWhileHeld"), 1u);
+    const std::shared_ptr<const DemTile> heldTile = expectRequest(tileCache, 0, false);
+    const std::shared_ptr<const DemTile> otherTile = expectRequest(tileCache, 1, false);
+    ASSERT_NE(heldTile, nullptr);
+    ASSERT_NE(otherTile, nullptr);
+
+    const DemTileCacheStats stats = tileCache.getStats();
+    EXPECT_EQ(stats.m_numEvictions, 1u);
+    EXPECT_EQ(stats.m_numCachedTiles, 1u);
+    EXPECT_EQ(stats.m_cachedBytes, kTileSize_bytes);
+
+    EXPECT_EQ(heldTile->getWestLon_deg(), 0);
+    EXPECT_EQ(heldTile->getSample_m(457u, 811u), getSyntheticDemSample_m(457u, 811u));
+    EXPECT_EQ(heldTile->getSample_m(kSyntheticDemNumSamplesPerSide - 1u, kSyntheticDemNumSamplesPerSide - 1u),
+                getSyntheticDemSample_m(kSyntheticDemNumSamplesPerSide - 1u, kSyntheticDemNumSamplesPerSide - 1u));
+}
+
+TEST(DemTileCacheTests, RemembersMissingTiles) {
+    DemTileCache tileCache(makeTileDirectory("DemTileCacheTests_RemembersMissingTiles"), 2u * kTileSize_bytes);
+    EXPECT_EQ(expectRequest(tileCache, 5, false), nullptr);
+    EXPECT_EQ(expectRequest(tileCache, 5, true), nullptr);
+
+    const DemTileCacheStats stats = tileCache.getStats();
+    EXPECT_EQ(stats.m_numCachedTiles, 0u);
+    EXPECT_EQ(stats.m_cachedBytes, 0u);
+}
+
+TEST(DemTileCacheTests, PrefetchedTileIsAHit) {
+    DemTileCache tileCache(makeTileDirectory("DemTileCacheTests_PrefetchedTileIsAHit"), 2u * kTileSize_bytes);
+    tileCache.prefetchTile(0, 1);
+
+    const auto giveUpTime = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (tileCache.getStats().m_numPrefetched == 0u && std::chrono::steady_clock::now() < giveUpTime) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(tileCache.getStats().m_numPrefetched, 1u);
+    EXPECT_NE(expectRequest(tileCache, 1, true), nullptr);
+}
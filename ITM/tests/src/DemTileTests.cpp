@@ -0,0 +1,253 @@
+/// Heights read from an SRTM tile must be its big-endian samples, interpolated bilinearly with void samples left out, and
+/// the tile store must hand back the same heights (and sea level where it has no tile). Each coarser level of the tile's
+/// pyramid must never put the terrain lower than full resolution does, nor higher than the bound it reports
+
+#include "TestHelpers.h"
+
+#include <ITM/DemTile.h>
+#include <ITM/DemTileStore.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    int constexpr kSouthLat_deg { 37 };
+    int constexpr kWestLon_deg { -122 };
+
+    double getSamplesPerDeg() {
+        return static_cast<double>(kSyntheticDemNumSamplesPerSide - 1u);
+    }
+
+    /// Latitude & longitude of a (fractional) grid position of the tile
+    GeoPoint makeGridPoint(const double& rowPos, const double& colPos) {
+        return GeoPoint { kSouthLat_deg + 1.0 - rowPos / getSamplesPerDeg(), kWestLon_deg + colPos / getSamplesPerDeg() };
+    }
+
+    /// Bilinear interpolation of the synthetic samples around a grid position, for cells with no void samples
+    double interpolateSyntheticSamples_m(const double& rowPos, const double& colPos) {
+        const std::size_t rowInd = static_cast<std::size_t>(rowPos);
+        const std::size_t colInd = static_cast<std::size_t>(colPos);
+        const double rowFrac = rowPos - static_cast<double>(rowInd);
+        const double colFrac = colPos - static_cast<double>(colInd);
+        return (1.0 - rowFrac) * ((1.0 - colFrac) * getSyntheticDemSample_m(rowInd, colInd) + colFrac * getSyntheticDemSample_m(rowInd, colInd + 1u))
+                    + rowFrac * ((1.0 - colFrac) * getSyntheticDemSample_m(rowInd + 1u, colInd) + colFrac * getSyntheticDemSample_m(rowInd + 1u, colInd + 1u));
+    }
+
+    bool isCellVoidFree(const std::size_t rowInd, const std::size_t colInd) {
+        for (const std::size_t cornerRowInd : { rowInd, rowInd + 1u }) {
+            for (const std::size_t cornerColInd : { colInd, colInd + 1u }) {
+                if (getSyntheticDemSample_m(cornerRowInd, cornerColInd) == DemTile::kVoidHeight) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /// Whether every sample around a point is void, so that full resolution reads sea level there
+    bool isPointInVoid(const GeoPoint& point) {
+        const double rowPos = (kSouthLat_deg + 1.0 - point.m_lat_deg) * getSamplesPerDeg();
+        const double colPos = (point.m_lon_deg - kWestLon_deg) * getSamplesPerDeg();
+        const std::size_t rowInd = std::min(static_cast<std::size_t>(rowPos), kSyntheticDemNumSamplesPerSide - 2u);
+        const std::size_t colInd = std::min(static_cast<std::size_t>(colPos), kSyntheticDemNumSamplesPerSide - 2u);
+        for (const std::size_t cornerRowInd : { rowInd, rowInd + 1u }) {
+            for (const std::size_t cornerColInd : { colInd, colInd + 1u }) {
+                if (getSyntheticDemSample_m(cornerRowInd, cornerColInd) != DemTile::kVoidHeight) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST(DemTileTests, ReadsBigEndianSamples) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_ReadsBigEndianSamples");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+    ASSERT_EQ(tile.getNumSamplesPerSide(), kSyntheticDemNumSamplesPerSide);
+    EXPECT_EQ(tile.getSizeBytes(), 2u * kSyntheticDemNumSamplesPerSide * kSyntheticDemNumSamplesPerSide);
+
+    // Every sample, including those below sea level & the voids
+    std::size_t numNegativeSamples = 0u;
+    for (std::size_t rowInd = 0; rowInd < kSyntheticDemNumSamplesPerSide; rowInd++) {
+        for (std::size_t colInd = 0; colInd < kSyntheticDemNumSamplesPerSide; colInd++) {
+            const std::int16_t expectedHeight_m = getSyntheticDemSample_m(rowInd, colInd);
+            ASSERT_EQ(tile.getSample_m(rowInd, colInd), expectedHeight_m) << "row " << rowInd << ", column " << colInd;
+            numNegativeSamples += (expectedHeight_m < 0 && expectedHeight_m != DemTile::kVoidHeight) ? 1u : 0u;
+        }
+    }
+    EXPECT_GT(numNegativeSamples, 0u);
+}
+
+TEST(DemTileTests, InterpolatesBilinearly) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_InterpolatesBilinearly");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+
+    // On the samples themselves, including the corners & edges of the tile
+    for (const std::size_t rowInd : { std::size_t { 0u }, std::size_t { 1u }, std::size_t { 457u }, kSyntheticDemNumSamplesPerSide - 1u }) {
+        for (const std::size_t colInd : { std::size_t { 0u }, std::size_t { 2u }, std::size_t { 811u }, kSyntheticDemNumSamplesPerSide - 1u }) {
+            const GeoPoint point = makeGridPoint(static_cast<double>(rowInd), static_cast<double>(colInd));
+            EXPECT_NEAR(tile.calcHeight_m(point.m_lat_deg, point.m_lon_deg), getSyntheticDemSample_m(rowInd, colInd), 1.0e-6)
+                        << "row " << rowInd << ", column " << colInd;
+        }
+    }
+
+    // Between them
+    std::mt19937 randomEngine(1u);
+    std::uniform_real_distribution<double> posDistrib(0.0, getSamplesPerDeg());
+    for (int pointInd = 0; pointInd < 2000; pointInd++) {
+        const double rowPos = posDistrib(randomEngine);
+        const double colPos = posDistrib(randomEngine);
+        if (!isCellVoidFree(static_cast<std::size_t>(rowPos), static_cast<std::size_t>(colPos))) {
+            continue;
+        }
+        const GeoPoint point = makeGridPoint(rowPos, colPos);
+        EXPECT_NEAR(tile.calcHeight_m(point.m_lat_deg, point.m_lon_deg), interpolateSyntheticSamples_m(rowPos, colPos), 1.0e-6)
+                    << "row " << rowPos << ", column " << colPos;
+    }
+}
+
+TEST(DemTileTests, LeavesOutVoidSamples) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_LeavesOutVoidSamples");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+
+    // Inside the void block, every corner is void: sea level
+    const GeoPoint voidPoint = makeGridPoint(604.25, 605.5);
+    EXPECT_DOUBLE_EQ(tile.calcHeight_m(voidPoint.m_lat_deg, voidPoint.m_lon_deg), 0.0);
+
+    // Next to the lone void sample at (300, 300), the other three corners share its weight
+    const double rowFrac = 0.25, colFrac = 0.6;
+    const double weightList[3] = { (1.0 - rowFrac) * (1.0 - colFrac), (1.0 - rowFrac) * colFrac, rowFrac * (1.0 - colFrac) };
+    const double expectedHeight_m = (weightList[0] * getSyntheticDemSample_m(299u, 299u) + weightList[1] * getSyntheticDemSample_m(299u, 300u)
+                + weightList[2] * getSyntheticDemSample_m(300u, 299u)) / (weightList[0] + weightList[1] + weightList[2]);
+    const GeoPoint nearVoidPoint = makeGridPoint(299.0 + rowFrac, 299.0 + colFrac);
+    EXPECT_NEAR(tile.calcHeight_m(nearVoidPoint.m_lat_deg, nearVoidPoint.m_lon_deg), expectedHeight_m, 1.0e-6);
+
+    // On the void sample itself, all of the weight falls on it: sea level
+    const GeoPoint onVoidPoint = makeGridPoint(300.0, 300.0);
+    EXPECT_DOUBLE_EQ(tile.calcHeight_m(onVoidPoint.m_lat_deg, onVoidPoint.m_lon_deg), 0.0);
+}
+
+TEST(DemTileTests, RejectsFilesOfOtherSizes) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_RejectsFilesOfOtherSizes");
+    const std::string filePath = (std::filesystem::path(directoryPath) / DemTileStore::makeTileFileName(kSouthLat_deg, kWestLon_deg)).string();
+    {
+        std::ofstream outStream(filePath, std::ios::binary);
+        const std::vector<char> byteList(2u * 1200u * 1200u);
+        outStream.write(byteList.data(), static_cast<std::streamsize>(byteList.size()));
+    }
+    EXPECT_THROW(DemTile(filePath, kSouthLat_deg, kWestLon_deg), std::runtime_error);
+    EXPECT_THROW(DemTile(filePath + ".missing", kSouthLat_deg, kWestLon_deg), std::runtime_error);
+}
+
+TEST(DemTileTests, StoreMatchesTileHeights) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_StoreMatchesTileHeights");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+    DemTileStore tileStore(directoryPath);
+
+    std::mt19937 randomEngine(2u);
+    std::uniform_real_distribution<double> posDistrib(0.0, getSamplesPerDeg());
+    for (int pointInd = 0; pointInd < 200; pointInd++) {
+        const GeoPoint point = makeGridPoint(posDistrib(randomEngine), posDistrib(randomEngine));
+        EXPECT_DOUBLE_EQ(tileStore.calcHeight_m(point), tile.calcHeight_m(point.m_lat_deg, point.m_lon_deg));
+    }
+
+    // No tile to the east: sea level
+    EXPECT_DOUBLE_EQ(tileStore.calcHeight_m(GeoPoint { kSouthLat_deg + 0.5, kWestLon_deg + 1.5 }), 0.0);
+
+    // A profile across the tile starts & ends on the heights of its end points
+    const GeoPoint txPoint = makeGridPoint(100.5, 150.25);
+    const GeoPoint rxPoint = makeGridPoint(1000.75, 900.5);
+    std::vector<double> terrainHeightList_m;
+    const double sampleResolution_m = tileStore.extractProfile(txPoint, rxPoint, 30.0, terrainHeightList_m);
+    ASSERT_GE(terrainHeightList_m.size(), 2u);
+    EXPECT_LE(sampleResolution_m, 30.0);
+    EXPECT_NEAR(sampleResolution_m * static_cast<double>(terrainHeightList_m.size() - 1u),
+                DemTileStore::calcGreatCircleDist_m(txPoint, rxPoint), 1.0e-6);
+    EXPECT_NEAR(terrainHeightList_m.front(), tile.calcHeight_m(txPoint.m_lat_deg, txPoint.m_lon_deg), 1.0e-6);
+    EXPECT_NEAR(terrainHeightList_m.back(), tile.calcHeight_m(rxPoint.m_lat_deg, rxPoint.m_lon_deg), 1.0e-6);
+}
+
+TEST(DemTileTests, PyramidLevelsStayWithinTheirBounds) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_PyramidLevelsStayWithinTheirBounds");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+
+    const DemLevelAccuracy fullAccuracy = tile.getLevelAccuracy(0u);
+    EXPECT_DOUBLE_EQ(fullAccuracy.m_sampleSpacing_deg, 1.0 / getSamplesPerDeg());
+    EXPECT_DOUBLE_EQ(fullAccuracy.m_maxOverstatement_m, 0.0);
+
+    // Points anywhere on the tile, plus points around the voids & along the edges (but not within a void, where full
+    // resolution has no terrain to bound)
+    std::mt19937 randomEngine(3u);
+    std::uniform_real_distribution<double> posDistrib(0.0, getSamplesPerDeg());
+    std::uniform_real_distribution<double> nearVoidDistrib(280.0, 630.0);
+    std::vector<GeoPoint> pointList;
+    for (int pointInd = 0; pointInd < 20000; pointInd++) {
+        pointList.push_back(makeGridPoint(posDistrib(randomEngine), posDistrib(randomEngine)));
+        pointList.push_back(makeGridPoint(nearVoidDistrib(randomEngine), nearVoidDistrib(randomEngine)));
+    }
+    std::erase_if(pointList, isPointInVoid);
+    for (int pointInd = 0; pointInd < 1000; pointInd++) {
+        pointList.push_back(makeGridPoint(0.0, posDistrib(randomEngine)));
+        pointList.push_back(makeGridPoint(posDistrib(randomEngine), getSamplesPerDeg()));
+    }
+
+    double prevMaxOverstatement_m = 0.0;
+    for (std::size_t levelInd = 1u; levelInd < DemTile::kNumLevels; levelInd++) {
+        const DemLevelAccuracy accuracy = tile.getLevelAccuracy(levelInd);
+        EXPECT_DOUBLE_EQ(accuracy.m_sampleSpacing_deg, static_cast<double>(std::size_t { 1u } << levelInd) / getSamplesPerDeg());
+        EXPECT_GT(accuracy.m_maxOverstatement_m, 0.0) << "level " << levelInd;
+        EXPECT_GE(accuracy.m_maxOverstatement_m, prevMaxOverstatement_m) << "level " << levelInd;
+        prevMaxOverstatement_m = accuracy.m_maxOverstatement_m;
+
+        double maxOverstatement_m = 0.0;
+        for (const GeoPoint& point : pointList) {
+            const double fullHeight_m = tile.calcHeight_m(point.m_lat_deg, point.m_lon_deg);
+            const double levelHeight_m = tile.calcHeight_m(point.m_lat_deg, point.m_lon_deg, levelInd);
+            ASSERT_GE(levelHeight_m, fullHeight_m - 1.0e-9) << "level " << levelInd << " at " << point.m_lat_deg << ", " << point.m_lon_deg;
+            ASSERT_LE(levelHeight_m - fullHeight_m, accuracy.m_maxOverstatement_m + 1.0e-9)
+                        << "level " << levelInd << " at " << point.m_lat_deg << ", " << point.m_lon_deg;
+            maxOverstatement_m = std::max(maxOverstatement_m, levelHeight_m - fullHeight_m);
+        }
+
+        // The terrain is rough enough for every level to overstate it somewhere
+        EXPECT_GT(maxOverstatement_m, 0.0) << "level " << levelInd;
+    }
+
+    EXPECT_THROW(tile.calcHeight_m(kSouthLat_deg + 0.5, kWestLon_deg + 0.5, DemTile::kNumLevels), std::domain_error);
+    EXPECT_THROW(tile.getLevelAccuracy(DemTile::kNumLevels), std::domain_error);
+}
+
+TEST(DemTileTests, CappedProfileReportsItsLevel) {
+    const std::string directoryPath = makeTestDirectory("DemTileTests_CappedProfileReportsItsLevel");
+    const DemTile tile(writeSyntheticDemTile(directoryPath, kSouthLat_deg, kWestLon_deg), kSouthLat_deg, kWestLon_deg);
+    DemTileStore tileStore(directoryPath);
+
+    // About 110 km across the tile: at full resolution it would take some 1300 points
+    const GeoPoint txPoint = makeGridPoint(10.5, 20.25);
+    const GeoPoint rxPoint = makeGridPoint(1180.75, 1150.5);
+    std::vector<double> terrainHeightList_m;
+    const DemProfileInfo fullInfo = tileStore.extractProfile(txPoint, rxPoint, 30.0, 100000u, terrainHeightList_m);
+    EXPECT_EQ(fullInfo.m_maxLevelInd, 0u);
+    EXPECT_DOUBLE_EQ(fullInfo.m_maxOverstatement_m, 0.0);
+
+    const DemProfileInfo cappedInfo = tileStore.extractProfile(txPoint, rxPoint, 30.0, 101u, terrainHeightList_m);
+    ASSERT_EQ(terrainHeightList_m.size(), 101u);
+    EXPECT_GT(cappedInfo.m_maxLevelInd, 0u);
+    EXPECT_DOUBLE_EQ(cappedInfo.m_maxOverstatement_m, tile.getLevelAccuracy(cappedInfo.m_maxLevelInd).m_maxOverstatement_m);
+
+    // The end points are read from the same level
+    EXPECT_NEAR(terrainHeightList_m.front(), tile.calcHeight_m(txPoint.m_lat_deg, txPoint.m_lon_deg, cappedInfo.m_maxLevelInd), 1.0e-6);
+    EXPECT_NEAR(terrainHeightList_m.back(), tile.calcHeight_m(rxPoint.m_lat_deg, rxPoint.m_lon_deg, cappedInfo.m_maxLevelInd), 1.0e-6);
+}
@@ -0,0 +1,51 @@
+/// The height sweep must give each pair of terminal heights the loss & mode of a single-path evaluation at those heights
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+TEST(HeightSweepTests, MatchesSinglePathEvaluations) {
+    const std::vector<double> txHeightList_m { 1.0, 3.0, 15.0, 30.0, 100.0, 300.0 };
+    const std::vector<double> rxHeightList_m { 1.5, 10.0, 3.0, 60.0, 2.0, 25.0 };
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    ItmWorkspace workspace;
+
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        std::vector<double> attenList_dB(txHeightList_m.size());
+        std::vector<PropagationMode> propModeList(txHeightList_m.size());
+        calculator.calcItmLoss_P2P_heightSweep_dB(terrainHeightList_m, kSyntheticSampleResolution_m, txHeightList_m, rxHeightList_m,
+                    attenList_dB, propModeList, workspace);
+        EXPECT_EQ(workspace.m_preparedProfile, nullptr);
+
+        for (std::size_t pairInd = 0; pairInd < txHeightList_m.size(); pairInd++) {
+            const ItmCommonCalculator pairCalculator = makeTestCalculator(txHeightList_m[pairInd], rxHeightList_m[pairInd]);
+            const ItmResults results = pairCalculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+            EXPECT_NEAR(attenList_dB[pairInd], results.m_atten_dB, 1.0e-6) << numPointsMinusTx << " points, pair " << pairInd;
+            EXPECT_EQ(propModeList[pairInd], results.m_intermResults.m_propMode) << numPointsMinusTx << " points, pair " << pairInd;
+        }
+    }
+}
+
+TEST(HeightSweepTests, RejectsUnsupportedHeights) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(150u);
+    const std::vector<double> txHeightList_m { 15.0, 0.1 };
+    const std::vector<double> rxHeightList_m { 3.0, 3.0 };
+    std::vector<double> attenList_dB(2u);
+    std::vector<PropagationMode> propModeList(2u);
+    ItmWorkspace workspace;
+    EXPECT_THROW(calculator.calcItmLoss_P2P_heightSweep_dB(terrainHeightList_m, kSyntheticSampleResolution_m, txHeightList_m,
+                rxHeightList_m, attenList_dB, propModeList, workspace), std::domain_error);
+    EXPECT_EQ(workspace.m_preparedProfile, nullptr);
+}
@@ -0,0 +1,95 @@
+/// Every vector kernel of the horizon scan must pick the same point & angle as the scalar kernel, ties included
+
+#include "TestHelpers.h"
+
+#include <ITM/HorizonScan.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    constexpr double kEffEarthRadius_m { 8.5e6 };
+
+    /// @brief Check each supported kernel against the scalar kernel, from both terminals & at several antenna heights
+    void expectKernelsMatchScalar(const std::vector<double>& terrainHeightList_m) {
+        const std::size_t numPointsMinusTx = terrainHeightList_m.size() - 1u;
+        const double pathDist_m = numPointsMinusTx * kSyntheticSampleResolution_m;
+        std::vector<double> txDistList_m(numPointsMinusTx);
+        std::vector<double> rxDistList_m(numPointsMinusTx);
+        HorizonScan::fillTxDistances(txDistList_m, kSyntheticSampleResolution_m);
+        HorizonScan::fillRxDistances(rxDistList_m, pathDist_m, kSyntheticSampleResolution_m);
+
+        for (const HorizonScan::KernelType kernelType : { HorizonScan::Avx2, HorizonScan::Avx512 }) {
+            if (!HorizonScan::isKernelSupported(kernelType)) {
+                continue;
+            }
+            for (const double& antennaHeight_m : { 0.5, 10.0, 200.0, 3000.0 }) {
+                for (const std::vector<double>* distList_m : { &txDistList_m, &rxDistList_m }) {
+                    const double radial_m = (distList_m == &txDistList_m ? terrainHeightList_m.front() : terrainHeightList_m.back()) + antennaHeight_m;
+                    const HorizonScan::HorizonCandidate scalarCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, *distList_m,
+                                radial_m, kEffEarthRadius_m, HorizonScan::Scalar);
+                    const HorizonScan::HorizonCandidate vectorCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, *distList_m,
+                                radial_m, kEffEarthRadius_m, kernelType);
+                    EXPECT_EQ(vectorCandidate.m_pointInd, scalarCandidate.m_pointInd) << "Kernel " << kernelType << ", "
+                                << numPointsMinusTx << " points, antenna at " << antennaHeight_m << " m";
+                    EXPECT_EQ(vectorCandidate.m_angle_rad, scalarCandidate.m_angle_rad) << "Kernel " << kernelType << ", "
+                                << numPointsMinusTx << " points, antenna at " << antennaHeight_m << " m";
+                }
+            }
+        }
+    }
+}
+
+TEST(HorizonScanTests, VectorKernelsMatchScalarOnRollingTerrain) {
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        expectKernelsMatchScalar(makeSyntheticProfile_m(numPointsMinusTx, seed++));
+    }
+}
+
+TEST(HorizonScanTests, VectorKernelsMatchScalarOnShortPaths) {
+    // Shorter than, equal to & just past one vector of each width, so the scalar fallback & tail handling are covered
+    for (std::size_t numPointsMinusTx = 1u; numPointsMinusTx <= 20u; numPointsMinusTx++) {
+        expectKernelsMatchScalar(makeSyntheticProfile_m(numPointsMinusTx, static_cast<unsigned int>(numPointsMinusTx)));
+    }
+}
+
+TEST(HorizonScanTests, VectorKernelsKeepTheFirstOfTiedPoints) {
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        // Flat terrain with no earth curvature to speak of, and repeated plateaus, both tie over many lanes at once
+        expectKernelsMatchScalar(std::vector<double>(numPointsMinusTx + 1u, 100.0));
+
+        std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx);
+        for (double& terrainHeight_m : terrainHeightList_m) {
+            terrainHeight_m = 50.0 * std::floor(terrainHeight_m / 50.0);
+        }
+        expectKernelsMatchScalar(terrainHeightList_m);
+
+        // The same peak repeated every few points, both on & off the vector width
+        for (const std::size_t peakPeriod : { 3u, 4u, 8u }) {
+            std::vector<double> peakHeightList_m(numPointsMinusTx + 1u, 0.0);
+            for (std::size_t pointInd = peakPeriod; pointInd < numPointsMinusTx; pointInd += peakPeriod) {
+                peakHeightList_m[pointInd] = 500.0;
+            }
+            expectKernelsMatchScalar(peakHeightList_m);
+        }
+    }
+}
+
+TEST(HorizonScanTests, SelectedKernelIsSupported) {
+    EXPECT_TRUE(HorizonScan::isKernelSupported(HorizonScan::Scalar));
+    EXPECT_TRUE(HorizonScan::isKernelSupported(HorizonScan::getKernelType()));
+    if (!HorizonScan::isKernelSupported(HorizonScan::Avx512)) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(33u);
+        std::vector<double> distList_m(33u);
+        HorizonScan::fillTxDistances(distList_m, kSyntheticSampleResolution_m);
+        EXPECT_THROW(HorizonScan::findHorizonPoint(terrainHeightList_m, distList_m, 100.0, kEffEarthRadius_m, HorizonScan::Avx512),
+                    std::domain_error);
+    }
+}
@@ -0,0 +1,157 @@
+/// The stats must count each stage & path of a known set of evaluations exactly once, whichever thread ran them, and be
+/// all zero when the library is built without NTIA_ITM_ENABLE_STATS
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmStats.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    // Each test profile is evaluated this many times
+    std::size_t constexpr kNumRepeats { 3u };
+
+    /// Counts expected from a set of point-to-point evaluations
+    struct ExpectedStats {
+        std::uint64_t m_numPaths = 0u;
+        std::uint64_t m_numTransHorizonPaths = 0u;
+        std::array<std::uint64_t, kNumProfileLengthBins> m_profileLengthHistogram {};
+        std::array<std::uint64_t, kNumPropModeBins> m_propModeHistogram {};
+        std::array<std::uint64_t, kNumPathDistBins> m_pathDistHistogram {};
+
+        void addPath(const std::size_t numPointsMinusTx, const PropagationMode propMode) {
+            m_numPaths++;
+            if (propMode != LineOfSight) {
+                m_numTransHorizonPaths++;
+            }
+
+            std::size_t lengthBinInd = 0u;
+            while ((std::size_t { 2u } << lengthBinInd) <= numPointsMinusTx) {
+                lengthBinInd++;
+            }
+            m_profileLengthHistogram[lengthBinInd]++;
+
+            m_propModeHistogram[propMode]++;
+
+            const double pathDist_km = static_cast<double>(numPointsMinusTx) * kSyntheticSampleResolution_m * 1.0e-3;
+            std::size_t distBinInd = 0u;
+            while (pathDist_km >= static_cast<double>(std::uint64_t { 1u } << distBinInd)) {
+                distBinInd++;
+            }
+            m_pathDistHistogram[distBinInd]++;
+        }
+    };
+
+    /// Evaluate every test profile kNumRepeats times, noting what the stats should count
+    void evaluateTestProfiles(ExpectedStats& expectedStats) {
+        ItmCommonCalculator calculator = makeTestCalculator();
+        unsigned int seed = 1u;
+        for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+            const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+            for (std::size_t repeatInd = 0; repeatInd < kNumRepeats; repeatInd++) {
+                const ItmResults results = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m);
+                expectedStats.addPath(numPointsMinusTx, results.m_intermResults.m_propMode);
+            }
+        }
+    }
+
+    void expectStats(const ItmStatsSnapshot& snapshot, const ExpectedStats& expectedStats) {
+        // Per path: one reference attenuation curve, with two diffraction losses & (past the horizon) two troposcatter
+        // losses, and the variability calculator's set up & its loss at the calculator's quantiles
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::Initialize_P2P).m_numCalls, expectedStats.m_numPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::Horizons).m_numCalls, expectedStats.m_numPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::TerrainIrregularity).m_numCalls, expectedStats.m_numPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::LongleyRice).m_numCalls, expectedStats.m_numPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::Diffraction).m_numCalls, 2u * expectedStats.m_numPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::Troposcatter).m_numCalls, 2u * expectedStats.m_numTransHorizonPaths);
+        EXPECT_EQ(snapshot.getStageStats(ItmStage::Variability).m_numCalls, 2u * expectedStats.m_numPaths);
+
+        // The Longley-Rice stage encloses its diffraction & troposcatter calls
+        EXPECT_GT(snapshot.getStageStats(ItmStage::LongleyRice).m_numCycles, 0u);
+        EXPECT_GE(snapshot.getStageStats(ItmStage::LongleyRice).m_numCycles,
+                    snapshot.getStageStats(ItmStage::Diffraction).m_numCycles + snapshot.getStageStats(ItmStage::Troposcatter).m_numCycles);
+
+        EXPECT_EQ(snapshot.m_profileLengthHistogram, expectedStats.m_profileLengthHistogram);
+        EXPECT_EQ(snapshot.m_propModeHistogram, expectedStats.m_propModeHistogram);
+        EXPECT_EQ(snapshot.m_pathDistHistogram, expectedStats.m_pathDistHistogram);
+    }
+
+    void expectAllZero(const ItmStatsSnapshot& snapshot) {
+        const ItmStatsSnapshot zeroSnapshot;
+        for (std::size_t stageInd = 0; stageInd < kNumItmStages; stageInd++) {
+            EXPECT_EQ(snapshot.m_stageStatsList[stageInd].m_numCalls, 0u) << ItmStats::getStageName(static_cast<ItmStage>(stageInd));
+            EXPECT_EQ(snapshot.m_stageStatsList[stageInd].m_numCycles, 0u) << ItmStats::getStageName(static_cast<ItmStage>(stageInd));
+        }
+        EXPECT_EQ(snapshot.m_profileLengthHistogram, zeroSnapshot.m_profileLengthHistogram);
+        EXPECT_EQ(snapshot.m_propModeHistogram, zeroSnapshot.m_propModeHistogram);
+        EXPECT_EQ(snapshot.m_pathDistHistogram, zeroSnapshot.m_pathDistHistogram);
+    }
+}
+
+TEST(ItmStatsTests, CountsEachStageOfKnownEvaluations) {
+    ItmStats::reset();
+    ExpectedStats expectedStats;
+    evaluateTestProfiles(expectedStats);
+    const ItmStatsSnapshot snapshot = ItmStats::takeSnapshot();
+
+    // The test profiles run from line of sight to troposcatter
+    ASSERT_GT(expectedStats.m_numTransHorizonPaths, 0u);
+    ASSERT_LT(expectedStats.m_numTransHorizonPaths, expectedStats.m_numPaths);
+    if (ItmStats::kIsEnabled) {
+        expectStats(snapshot, expectedStats);
+    }
+    else {
+        expectAllZero(snapshot);
+    }
+}
+
+TEST(ItmStatsTests, KeepsCountsOfFinishedThreads) {
+    ItmStats::reset();
+    std::vector<ExpectedStats> expectedStatsList(3u);
+    std::vector<std::thread> threadList;
+    for (ExpectedStats& expectedStats : expectedStatsList) {
+        threadList.emplace_back([&expectedStats]() { evaluateTestProfiles(expectedStats); });
+    }
+    for (std::thread& thread : threadList) {
+        thread.join();
+    }
+    const ItmStatsSnapshot snapshot = ItmStats::takeSnapshot();
+
+    ExpectedStats expectedStats;
+    for (const ExpectedStats& threadExpectedStats : expectedStatsList) {
+        expectedStats.m_numPaths += threadExpectedStats.m_numPaths;
+        expectedStats.m_numTransHorizonPaths += threadExpectedStats.m_numTransHorizonPaths;
+        for (std::size_t binInd = 0; binInd < kNumProfileLengthBins; binInd++) {
+            expectedStats.m_profileLengthHistogram[binInd] += threadExpectedStats.m_profileLengthHistogram[binInd];
+        }
+        for (std::size_t binInd = 0; binInd < kNumPropModeBins; binInd++) {
+            expectedStats.m_propModeHistogram[binInd] += threadExpectedStats.m_propModeHistogram[binInd];
+        }
+        for (std::size_t binInd = 0; binInd < kNumPathDistBins; binInd++) {
+            expectedStats.m_pathDistHistogram[binInd] += threadExpectedStats.m_pathDistHistogram[binInd];
+        }
+    }
+
+    if (ItmStats::kIsEnabled) {
+        expectStats(snapshot, expectedStats);
+    }
+    else {
+        expectAllZero(snapshot);
+    }
+}
+
+TEST(ItmStatsTests, ResetClearsEveryCount) {
+    ExpectedStats expectedStats;
+    evaluateTestProfiles(expectedStats);
+    ItmStats::reset();
+    expectAllZero(ItmStats::takeSnapshot());
+}
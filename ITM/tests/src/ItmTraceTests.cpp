@@ -0,0 +1,400 @@
+/// The trace written must be valid trace-event JSON: complete events that nest within each thread, one path span per
+/// evaluation enclosing the stage spans of that path, and nothing at all when the library is built without
+/// NTIA_ITM_ENABLE_TRACING
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmTrace.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    // Timestamps & durations are written in microseconds with three decimals
+    double constexpr kTimestampTolerance_us { 1.5e-3 };
+
+    /// Just enough of JSON to check a trace: parse() throws std::runtime_error on anything that is not strict JSON
+    struct JsonValue {
+        enum Type { Null, Bool, Number, String, Array, Object };
+
+        Type m_type = Null;
+        bool m_bool = false;
+        double m_number = 0.0;
+        std::string m_string;
+        std::vector<JsonValue> m_array;
+        std::vector<std::pair<std::string, JsonValue>> m_object;
+
+        const JsonValue* find(const std::string& key) const {
+            for (const auto& [memberKey, memberValue] : m_object) {
+                if (memberKey == key) {
+                    return &memberValue;
+                }
+            }
+            return nullptr;
+        }
+    };
+
+    class JsonParser {
+    public:
+        explicit JsonParser(const std::string& text) : m_text(text) {
+        }
+
+        JsonValue parse() {
+            JsonValue value = parseValue();
+            skipSpace();
+            if (m_pos != m_text.size()) {
+                fail("trailing characters");
+            }
+            return value;
+        }
+
+    private:
+        [[noreturn]] void fail(const std::string& what) const {
+            std::ostringstream oStrStream;
+            oStrStream << "Invalid JSON at offset " << m_pos << ": " << what;
+            throw std::runtime_error(oStrStream.str());
+        }
+
+        void skipSpace() {
+            while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+                m_pos++;
+            }
+        }
+
+        void expect(const char c) {
+            skipSpace();
+            if (m_pos >= m_text.size() || m_text[m_pos] != c) {
+                fail(std::string("expected '") + c + "'");
+            }
+            m_pos++;
+        }
+
+        bool consumeLiteral(const std::string& literal) {
+            if (m_text.compare(m_pos, literal.size(), literal) != 0) {
+                return false;
+            }
+            m_pos += literal.size();
+            return true;
+        }
+
+        JsonValue parseValue() {
+            skipSpace();
+            if (m_pos >= m_text.size()) {
+                fail("unexpected end");
+            }
+
+            JsonValue value;
+            const char c = m_text[m_pos];
+            if (c == '{') {
+                value.m_type = JsonValue::Object;
+                m_pos++;
+                skipSpace();
+                if (m_pos < m_text.size() && m_text[m_pos] == '}') {
+                    m_pos++;
+                    return value;
+                }
+                while (true) {
+                    skipSpace();
+                    std::string key = parseString();
+                    expect(':');
+                    value.m_object.emplace_back(std::move(key), parseValue());
+                    skipSpace();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                        m_pos++;
+                        continue;
+                    }
+                    expect('}');
+                    return value;
+                }
+            }
+            if (c == '[') {
+                value.m_type = JsonValue::Array;
+                m_pos++;
+                skipSpace();
+                if (m_pos < m_text.size() && m_text[m_pos] == ']') {
+                    m_pos++;
+                    return value;
+                }
+                while (true) {
+                    value.m_array.push_back(parseValue());
+                    skipSpace();
+                    if (m_pos < m_text.size() && m_text[m_pos] == ',') {
+                        m_pos++;
+                        continue;
+                    }
+                    expect(']');
+                    return value;
+                }
+            }
+            if (c == '"') {
+                value.m_type = JsonValue::String;
+                value.m_string = parseString();
+                return value;
+            }
+            if (consumeLiteral("true")) {
+                value.m_type = JsonValue::Bool;
+                value.m_bool = true;
+                return value;
+            }
+            if (consumeLiteral("false")) {
+                value.m_type = JsonValue::Bool;
+                return value;
+            }
+            if (consumeLiteral("null")) {
+                return value;
+            }
+            return parseNumber();
+        }
+
+        std::string parseString() {
+            if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+                fail("expected a string");
+            }
+            m_pos++;
+            std::string str;
+            while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+                if (static_cast<unsigned char>(m_text[m_pos]) < 0x20u) {
+                    fail("control character in string");
+                }
+                if (m_text[m_pos] == '\\') {
+                    m_pos++;
+                    if (m_pos >= m_text.size() || std::string("\"\\/bfnrtu").find(m_text[m_pos]) == std::string::npos) {
+                        fail("bad escape");
+                    }
+                }
+                str.push_back(m_text[m_pos++]);
+            }
+            if (m_pos >= m_text.size()) {
+                fail("unterminated string");
+            }
+            m_pos++;
+            return str;
+        }
+
+        JsonValue parseNumber() {
+            // -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+            const std::size_t startPos = m_pos;
+            const auto skipDigits = [this]() {
+                const std::size_t digitsPos = m_pos;
+                while (m_pos < m_text.size() && std::isdigit(static_cast<unsigned char>(m_text[m_pos]))) {
+                    m_pos++;
+                }
+                return m_pos - digitsPos;
+            };
+            if (m_pos < m_text.size() && m_text[m_pos] == '-') {
+                m_pos++;
+            }
+            const std::size_t intStartPos = m_pos;
+            if (skipDigits() == 0u || (m_text[intStartPos] == '0' && m_pos - intStartPos > 1u)) {
+                fail("bad number");
+            }
+            if (m_pos < m_text.size() && m_text[m_pos] == '.') {
+                m_pos++;
+                if (skipDigits() == 0u) {
+                    fail("bad fraction");
+                }
+            }
+            if (m_pos < m_text.size() && (m_text[m_pos] == 'e' || m_text[m_pos] == 'E')) {
+                m_pos++;
+                if (m_pos < m_text.size() && (m_text[m_pos] == '+' || m_text[m_pos] == '-')) {
+                    m_pos++;
+                }
+                if (skipDigits() == 0u) {
+                    fail("bad exponent");
+                }
+            }
+
+            JsonValue value;
+            value.m_type = JsonValue::Number;
+            value.m_number = std::stod(m_text.substr(startPos, m_pos - startPos));
+            return value;
+        }
+
+        const std::string& m_text;
+        std::size_t m_pos = 0u;
+    };
+
+    /// A complete ("X") event of the trace
+    struct TraceSpan {
+        std::string m_name;
+        std::string m_category;
+        std::uint64_t m_threadNum;
+        double m_startTimestamp_us;
+        double m_endTimestamp_us;
+        bool m_hasPathId;
+        std::uint64_t m_pathId;
+    };
+
+    JsonValue readTraceJson(const std::string& filePath) {
+        std::ifstream inStream(filePath);
+        std::stringstream textStream;
+        textStream << inStream.rdbuf();
+        return JsonParser(textStream.str()).parse();
+    }
+
+    const JsonValue& getMember(const JsonValue& object, const std::string& key, const JsonValue::Type type) {
+        const JsonValue* value = object.find(key);
+        if (value == nullptr || value->m_type != type) {
+            throw std::runtime_error("Missing or mistyped member " + key);
+        }
+        return *value;
+    }
+
+    /// Check the events of a trace and return its spans
+    std::vector<TraceSpan> readTraceSpans(const JsonValue& trace) {
+        EXPECT_EQ(trace.m_type, JsonValue::Object);
+        const JsonValue& eventList = getMember(trace, "traceEvents", JsonValue::Array);
+
+        std::vector<TraceSpan> spanList;
+        for (const JsonValue& event : eventList.m_array) {
+            EXPECT_EQ(event.m_type, JsonValue::Object);
+            const std::string& phase = getMember(event, "ph", JsonValue::String).m_string;
+            getMember(event, "name", JsonValue::String);
+            getMember(event, "pid", JsonValue::Number);
+
+            // Metadata names the process & threads; everything else is a complete event, which carries its own begin & end
+            if (phase == "M") {
+                getMember(event, "args", JsonValue::Object);
+                continue;
+            }
+            EXPECT_EQ(phase, "X");
+
+            TraceSpan span;
+            span.m_name = getMember(event, "name", JsonValue::String).m_string;
+            span.m_category = getMember(event, "cat", JsonValue::String).m_string;
+            span.m_threadNum = static_cast<std::uint64_t>(getMember(event, "tid", JsonValue::Number).m_number);
+            span.m_startTimestamp_us = getMember(event, "ts", JsonValue::Number).m_number;
+            const double duration_us = getMember(event, "dur", JsonValue::Number).m_number;
+            EXPECT_GE(span.m_startTimestamp_us, 0.0) << span.m_name;
+            EXPECT_GE(duration_us, 0.0) << span.m_name;
+            span.m_endTimestamp_us = span.m_startTimestamp_us + duration_us;
+
+            const JsonValue* args = event.find("args");
+            span.m_hasPathId = args != nullptr;
+            span.m_pathId = span.m_hasPathId ? static_cast<std::uint64_t>(getMember(*args, "path", JsonValue::Number).m_number) : 0u;
+            spanList.push_back(span);
+        }
+        return spanList;
+    }
+
+    std::string makeTracePath(const std::string& name) {
+        return ::testing::TempDir() + name;
+    }
+}
+
+TEST(ItmTraceTests, WritesNestedSpansPerPath) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+
+    // The paths evaluated while recording, tagged with IDs of our own, and one evaluated after
+    std::uint64_t constexpr kFirstPathId { 1000u };
+    std::map<std::uint64_t, PropagationMode> propModeMap;
+    ItmTrace::start();
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::uint64_t pathId = kFirstPathId + propModeMap.size();
+        const ItmTrace::PathIdScope pathIdScope(pathId);
+        const ItmResults results = calculator.calcItmLoss_P2P_dB(makeSyntheticProfile_m(numPointsMinusTx, seed++), kSyntheticSampleResolution_m);
+        propModeMap[pathId] = results.m_intermResults.m_propMode;
+    }
+    ItmTrace::stop();
+    calculator.calcItmLoss_P2P_dB(makeSyntheticProfile_m(150u), kSyntheticSampleResolution_m);
+
+    const std::string tracePath = makeTracePath("ItmTraceTests_WritesNestedSpansPerPath.json");
+    ItmTrace::writeTraceJson(tracePath);
+    JsonValue trace;
+    ASSERT_NO_THROW(trace = readTraceJson(tracePath));
+    std::vector<TraceSpan> spanList;
+    ASSERT_NO_THROW(spanList = readTraceSpans(trace));
+
+    if (!ItmTrace::kIsEnabled) {
+        EXPECT_TRUE(spanList.empty());
+        return;
+    }
+    EXPECT_EQ(getMember(getMember(trace, "otherData", JsonValue::Object), "droppedEvents", JsonValue::Number).m_number, 0.0);
+
+    // Spans of each thread must nest: in order of start (outer first), each one lies within the innermost open span or
+    // after it has ended
+    std::stable_sort(spanList.begin(), spanList.end(), [](const TraceSpan& lhs, const TraceSpan& rhs) {
+        if (lhs.m_threadNum != rhs.m_threadNum) {
+            return lhs.m_threadNum < rhs.m_threadNum;
+        }
+        if (lhs.m_startTimestamp_us != rhs.m_startTimestamp_us) {
+            return lhs.m_startTimestamp_us < rhs.m_startTimestamp_us;
+        }
+        return lhs.m_endTimestamp_us > rhs.m_endTimestamp_us;
+    });
+
+    std::map<std::uint64_t, std::map<std::string, std::size_t>> stageCountMap;
+    std::vector<const TraceSpan*> openSpanList;
+    for (const TraceSpan& span : spanList) {
+        while (!openSpanList.empty() && (openSpanList.back()->m_threadNum != span.m_threadNum ||
+                    span.m_startTimestamp_us >= openSpanList.back()->m_endTimestamp_us - kTimestampTolerance_us)) {
+            openSpanList.pop_back();
+        }
+        if (!openSpanList.empty()) {
+            EXPECT_LE(span.m_endTimestamp_us, openSpanList.back()->m_endTimestamp_us + kTimestampTolerance_us)
+                        << span.m_name << " overlaps the end of " << openSpanList.back()->m_name;
+        }
+
+        ASSERT_TRUE(span.m_hasPathId) << span.m_name;
+        ASSERT_TRUE(propModeMap.contains(span.m_pathId)) << span.m_name << " of path " << span.m_pathId;
+        if (span.m_category == "path") {
+            EXPECT_EQ(span.m_name, "P2P path");
+            EXPECT_TRUE(openSpanList.empty()) << "path " << span.m_pathId << " inside another span";
+            EXPECT_TRUE(stageCountMap.emplace(span.m_pathId, std::map<std::string, std::size_t>()).second)
+                        << "path " << span.m_pathId << " traced twice";
+        }
+        else {
+            EXPECT_EQ(span.m_category, "stage");
+            ASSERT_FALSE(openSpanList.empty()) << span.m_name << " outside any path span";
+            EXPECT_EQ(openSpanList.front()->m_pathId, span.m_pathId) << span.m_name;
+            stageCountMap[span.m_pathId][span.m_name]++;
+        }
+        openSpanList.push_back(&span);
+    }
+
+    // One path span per path, each with the stages its evaluation goes through
+    ASSERT_EQ(stageCountMap.size(), propModeMap.size());
+    for (const auto& [pathId, stageCounts] : stageCountMap) {
+        const auto countStage = [&stageCounts](const ItmStage stage) {
+            const auto countIter = stageCounts.find(ItmStats::getStageName(stage));
+            return (countIter == stageCounts.end()) ? 0u : countIter->second;
+        };
+        EXPECT_EQ(countStage(ItmStage::Initialize_P2P), 1u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::Horizons), 1u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::TerrainIrregularity), 1u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::LongleyRice), 1u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::Diffraction), 2u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::Troposcatter), (propModeMap.at(pathId) == LineOfSight) ? 0u : 2u) << "path " << pathId;
+        EXPECT_EQ(countStage(ItmStage::Variability), 2u) << "path " << pathId;
+    }
+}
+
+TEST(ItmTraceTests, StartDropsEarlierSpans) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    ItmTrace::start();
+    calculator.calcItmLoss_P2P_dB(makeSyntheticProfile_m(150u), kSyntheticSampleResolution_m);
+    ItmTrace::start();
+    ItmTrace::stop();
+    EXPECT_FALSE(ItmTrace::isRecording());
+
+    const std::string tracePath = makeTracePath("ItmTraceTests_StartDropsEarlierSpans.json");
+    ItmTrace::writeTraceJson(tracePath);
+    std::vector<TraceSpan> spanList;
+    ASSERT_NO_THROW(spanList = readTraceSpans(readTraceJson(tracePath)));
+    EXPECT_TRUE(spanList.empty());
+}
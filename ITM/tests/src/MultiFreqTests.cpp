@@ -0,0 +1,47 @@
+/// The multi-frequency evaluation must give each frequency the loss & mode of a single-path evaluation at that frequency
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+TEST(MultiFreqTests, MatchesSinglePathEvaluations) {
+    const std::vector<double> freqList_MHz { 20.0, 150.0, 900.0, 3500.0, 12000.0, 20000.0 };
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    ItmWorkspace workspace;
+
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        std::vector<double> attenList_dB(freqList_MHz.size());
+        std::vector<PropagationMode> propModeList(freqList_MHz.size());
+        calculator.calcItmLoss_P2P_multiFreq_dB(terrainHeightList_m, kSyntheticSampleResolution_m, freqList_MHz, attenList_dB,
+                    propModeList, workspace);
+
+        for (std::size_t freqInd = 0; freqInd < freqList_MHz.size(); freqInd++) {
+            const ItmCommonCalculator freqCalculator = makeTestCalculator(15.0, 3.0, freqList_MHz[freqInd]);
+            const ItmResults results = freqCalculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+            EXPECT_DOUBLE_EQ(attenList_dB[freqInd], results.m_atten_dB) << numPointsMinusTx << " points, " << freqList_MHz[freqInd] << " MHz";
+            EXPECT_EQ(propModeList[freqInd], results.m_intermResults.m_propMode) << numPointsMinusTx << " points, " << freqList_MHz[freqInd] << " MHz";
+        }
+    }
+}
+
+TEST(MultiFreqTests, RejectsUnsupportedFrequencies) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(150u);
+    const std::vector<double> freqList_MHz { 900.0, 25.0e3 };
+    std::vector<double> attenList_dB(2u);
+    std::vector<PropagationMode> propModeList(2u);
+    ItmWorkspace workspace;
+    EXPECT_THROW(calculator.calcItmLoss_P2P_multiFreq_dB(terrainHeightList_m, kSyntheticSampleResolution_m, freqList_MHz, attenList_dB,
+                propModeList, workspace), std::domain_error);
+}
@@ -0,0 +1,73 @@
+/// Evaluations through a PreparedTerrainProfile (running sums in place of per-window sums) must match those reading the
+/// raw heights, to within the rounding of the running sums
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/PreparedTerrainProfile.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    double constexpr kLossTolerance_dB { 1.0e-6 };
+}
+
+TEST(PreparedProfileTests, MatchesRawProfileEvaluations) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    ItmWorkspace workspace;
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        for (const double hillHeight_m : { 0.0, 80.0 }) {
+            const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++, hillHeight_m);
+            const ItmResults rawResults = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+
+            const PreparedTerrainProfile preparedProfile(terrainHeightList_m, kSyntheticSampleResolution_m);
+            const ItmResults preparedResults = calculator.calcItmLoss_P2P_dB(preparedProfile, false, workspace);
+            EXPECT_NEAR(preparedResults.m_atten_dB, rawResults.m_atten_dB, kLossTolerance_dB) << numPointsMinusTx << " points";
+            EXPECT_EQ(preparedResults.m_intermResults.m_propMode, rawResults.m_intermResults.m_propMode) << numPointsMinusTx << " points";
+            EXPECT_NEAR(preparedResults.m_intermResults.m_terrainIrreg_m, rawResults.m_intermResults.m_terrainIrreg_m, 1.0e-6);
+            EXPECT_NEAR(preparedResults.m_intermResults.m_txEffHeight_m, rawResults.m_intermResults.m_txEffHeight_m, 1.0e-6);
+            EXPECT_NEAR(preparedResults.m_intermResults.m_rxEffHeight_m, rawResults.m_intermResults.m_rxEffHeight_m, 1.0e-6);
+
+            const ItmLossResult leanResult = calculator.calcItmLoss_P2P_dB(preparedProfile, LossAndMode, workspace);
+            EXPECT_NEAR(leanResult.m_atten_dB, rawResults.m_atten_dB, kLossTolerance_dB) << numPointsMinusTx << " points";
+            EXPECT_EQ(leanResult.m_propMode, rawResults.m_intermResults.m_propMode) << numPointsMinusTx << " points";
+
+            // The workspace must not be left pointing at the prepared profile
+            EXPECT_EQ(workspace.m_preparedProfile, nullptr);
+        }
+    }
+}
+
+TEST(PreparedProfileTests, RunningSumsMatchDirectSums) {
+    const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(1200u, 7u);
+    const PreparedTerrainProfile preparedProfile(terrainHeightList_m, kSyntheticSampleResolution_m);
+
+    for (const auto& [startInd, endInd] : { std::pair<std::size_t, std::size_t>{ 0u, 1200u }, { 17u, 18u }, { 120u, 1080u }, { 600u, 600u } }) {
+        double heightSum_m = 0.0;
+        for (std::size_t pointInd = startInd; pointInd <= endInd; pointInd++) {
+            heightSum_m += terrainHeightList_m[pointInd];
+        }
+        EXPECT_NEAR(preparedProfile.calcMeanHeight_m(startInd, endInd), heightSum_m / static_cast<double>(endInd - startInd + 1u), 1.0e-9);
+    }
+
+    // Least squares fit over the full window, against the direct fit of the calculator reading raw heights
+    const MathHelpers::TerrainFitResults preparedFit = preparedProfile.fitTerrainProfile_linearLeastSquares(450.0, 33000.0);
+    const MathHelpers::TerrainFitResults directFit = MathHelpers::fitTerrainProfile_linearLeastSquares(terrainHeightList_m,
+                kSyntheticSampleResolution_m, 450.0, 33000.0);
+    EXPECT_NEAR(preparedFit.m_y1Value, directFit.m_y1Value, 1.0e-6);
+    EXPECT_NEAR(preparedFit.m_y2Value, directFit.m_y2Value, 1.0e-6);
+}
+
+TEST(PreparedProfileTests, RejectsProfilesOfFewerThanTwoPoints) {
+    const std::vector<double> terrainHeightList_m { 100.0 };
+    EXPECT_THROW(PreparedTerrainProfile(terrainHeightList_m, kSyntheticSampleResolution_m), std::domain_error);
+    EXPECT_THROW(PreparedTerrainProfile(std::span<const double>(), kSyntheticSampleResolution_m), std::domain_error);
+}
@@ -0,0 +1,64 @@
+/// The radial sweep must give every receiver position the loss & mode of a single-path evaluation of the radial up to it
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    void expectRadialMatchesSinglePaths(const ItmCommonCalculator& calculator, const std::vector<double>& radialHeightList_m,
+                const std::size_t firstRxInd) {
+        const std::size_t numRxPoints = radialHeightList_m.size() - firstRxInd;
+        std::vector<double> attenList_dB(numRxPoints);
+        std::vector<PropagationMode> propModeList(numRxPoints);
+        ItmWorkspace workspace;
+        calculator.calcItmLoss_P2P_radial_dB(radialHeightList_m, kSyntheticSampleResolution_m, firstRxInd, attenList_dB, propModeList,
+                    workspace);
+        EXPECT_EQ(workspace.m_preparedProfile, nullptr);
+
+        for (std::size_t rxInd = firstRxInd; rxInd < radialHeightList_m.size(); rxInd++) {
+            const ItmResults results = calculator.calcItmLoss_P2P_dB(std::span<const double>(radialHeightList_m).first(rxInd + 1u),
+                        kSyntheticSampleResolution_m, false, workspace);
+            EXPECT_NEAR(attenList_dB[rxInd - firstRxInd], results.m_atten_dB, 1.0e-6) << radialHeightList_m.size() << " points, Rx " << rxInd;
+            EXPECT_EQ(propModeList[rxInd - firstRxInd], results.m_intermResults.m_propMode) << radialHeightList_m.size() << " points, Rx " << rxInd;
+        }
+    }
+}
+
+TEST(RadialTests, MatchesSinglePathEvaluations) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        expectRadialMatchesSinglePaths(calculator, makeSyntheticProfile_m(numPointsMinusTx, seed++), 1u);
+    }
+}
+
+TEST(RadialTests, MatchesSinglePathEvaluationsOverFlatTerrain) {
+    // Gently rough terrain keeps the Rx in line of sight of the Tx for longer
+    const ItmCommonCalculator calculator = makeTestCalculator(30.0, 10.0);
+    expectRadialMatchesSinglePaths(calculator, makeSyntheticProfile_m(1200u, 7u, 0.0), 5u);
+}
+
+TEST(RadialTests, RejectsBadReceiverRange) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const std::vector<double> radialHeightList_m = makeSyntheticProfile_m(150u);
+    std::vector<double> attenList_dB(radialHeightList_m.size());
+    std::vector<PropagationMode> propModeList(radialHeightList_m.size());
+    ItmWorkspace workspace;
+    for (const std::size_t firstRxInd : { std::size_t { 0u }, radialHeightList_m.size() }) {
+        EXPECT_THROW(calculator.calcItmLoss_P2P_radial_dB(radialHeightList_m, kSyntheticSampleResolution_m, firstRxInd, attenList_dB,
+                    propModeList, workspace), std::domain_error);
+    }
+    std::vector<double> shortAttenList_dB(10u);
+    EXPECT_THROW(calculator.calcItmLoss_P2P_radial_dB(radialHeightList_m, kSyntheticSampleResolution_m, 1u, shortAttenList_dB,
+                propModeList, workspace), std::domain_error);
+}
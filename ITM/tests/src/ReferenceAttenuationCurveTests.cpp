@@ -0,0 +1,88 @@
+/// A reference attenuation curve prepared once over a distance range must give what a full area mode evaluation gives at each distance
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmConstructs.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/ReferenceAttenuationCurve.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    /// @brief Distances spread evenly over [minDist_km, maxDist_km], both ends included
+    std::vector<double> makeDistList_km(const double& minDist_km, const double& maxDist_km, const std::size_t numDists) {
+        std::vector<double> distList_km(numDists);
+        for (std::size_t distInd = 0; distInd < numDists; distInd++) {
+            distList_km[distInd] = minDist_km + (maxDist_km - minDist_km) * distInd / (numDists - 1u);
+        }
+        return distList_km;
+    }
+
+    /// @brief Check a curve prepared over [minDist_km, maxDist_km] against single area evaluations at every distance in between
+    void expectCurveMatchesAreaEvaluations(const double& txHeight_m, const double& rxHeight_m, const SitingCriteria& txSitingCriteria,
+                const SitingCriteria& rxSitingCriteria, const double& terrainIrreg_m, const double& minDist_km, const double& maxDist_km) {
+        const std::vector<double> distList_km = makeDistList_km(minDist_km, maxDist_km, 61u);
+        std::vector<double> pathDistList_m(distList_km.size());
+        for (std::size_t distInd = 0; distInd < distList_km.size(); distInd++) {
+            pathDistList_m[distInd] = distList_km[distInd] * 1.0e3;
+        }
+
+        ItmWorkspace workspace;
+        const ItmCommonCalculator curveCalculator = makeTestCalculator(txHeight_m, rxHeight_m, 900.0);
+        const ReferenceAttenuationCurve refAttenCurve = curveCalculator.prepareRefAttenCurve_area(txSitingCriteria, rxSitingCriteria,
+                    terrainIrreg_m, minDist_km, maxDist_km, workspace);
+        std::vector<double> refAttenList_dB(distList_km.size());
+        std::vector<PropagationMode> propModeList(distList_km.size());
+        refAttenCurve.calcRefAtten_dB(pathDistList_m, refAttenList_dB, propModeList);
+
+        for (std::size_t distInd = 0; distInd < distList_km.size(); distInd++) {
+            ItmCommonCalculator linkCalculator = makeTestCalculator(txHeight_m, rxHeight_m, 900.0);
+            const ItmResults results = linkCalculator.calcItmLoss_area_dB(txSitingCriteria, rxSitingCriteria, distList_km[distInd], terrainIrreg_m);
+
+            PropagationMode propMode = NotSet;
+            const double refAtten_dB = refAttenCurve.calcRefAtten_dB(pathDistList_m[distInd], propMode);
+            EXPECT_DOUBLE_EQ(refAtten_dB, results.m_intermResults.m_refAtten_dB) << distList_km[distInd] << " km";
+            EXPECT_EQ(propMode, results.m_intermResults.m_propMode) << distList_km[distInd] << " km";
+
+            // The span form is the single distance form applied to each entry
+            EXPECT_EQ(refAttenList_dB[distInd], refAtten_dB) << distList_km[distInd] << " km";
+            EXPECT_EQ(propModeList[distInd], propMode) << distList_km[distInd] << " km";
+        }
+    }
+}
+
+TEST(ReferenceAttenuationCurveTests, MatchesAreaEvaluationsOverEveryRegion) {
+    // Line of sight through diffraction into troposcatter
+    expectCurveMatchesAreaEvaluations(15.0, 3.0, Careful, Random, 90.0, 1.0, 400.0);
+    expectCurveMatchesAreaEvaluations(200.0, 10.0, VeryCareful, Careful, 30.0, 1.0, 600.0);
+}
+
+TEST(ReferenceAttenuationCurveTests, MatchesAreaEvaluationsOverOneRegion) {
+    const ReferenceAttenuationCurve fullCurve = makeTestCalculator(15.0, 3.0, 900.0).prepareRefAttenCurve_area(Careful, Random, 90.0, 1.0, 400.0);
+    const double smoothEarthMaxLoSDist_km = fullCurve.getSmoothEarthMaxLoSDist_m() * 1.0e-3;
+
+    // Curves prepared for only the line-of-sight or only the trans-horizon distances skip the other region's terms
+    expectCurveMatchesAreaEvaluations(15.0, 3.0, Careful, Random, 90.0, 1.0, 0.9 * smoothEarthMaxLoSDist_km);
+    expectCurveMatchesAreaEvaluations(15.0, 3.0, Careful, Random, 90.0, 1.1 * smoothEarthMaxLoSDist_km, 400.0);
+}
+
+TEST(ReferenceAttenuationCurveTests, RejectsDistancesOfUnpreparedRegions) {
+    ItmCommonCalculator calculator = makeTestCalculator(15.0, 3.0, 900.0);
+    const double smoothEarthMaxLoSDist_km = calculator.prepareRefAttenCurve_area(Careful, Random, 90.0, 1.0, 400.0)
+                .getSmoothEarthMaxLoSDist_m() * 1.0e-3;
+
+    PropagationMode propMode = NotSet;
+    const ReferenceAttenuationCurve losCurve = calculator.prepareRefAttenCurve_area(Careful, Random, 90.0, 1.0, 0.5 * smoothEarthMaxLoSDist_km);
+    EXPECT_THROW(losCurve.calcRefAtten_dB(2.0 * smoothEarthMaxLoSDist_km * 1.0e3, propMode), std::domain_error);
+
+    const ReferenceAttenuationCurve transHorizonCurve = calculator.prepareRefAttenCurve_area(Careful, Random, 90.0,
+                2.0 * smoothEarthMaxLoSDist_km, 400.0);
+    EXPECT_THROW(transHorizonCurve.calcRefAtten_dB(0.5 * smoothEarthMaxLoSDist_km * 1.0e3, propMode), std::domain_error);
+}
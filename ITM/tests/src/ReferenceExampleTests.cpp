@@ -0,0 +1,96 @@
+/// Point-to-point evaluation of the cmd_examples profile (pfl.txt), against the intermediate values & loss table of the
+/// NTIA ITM v1.3 reference output o_p2pcr_tbl.txt (inputs of i_p2pcr_tbl.txt). Values are compared to the precision
+/// printed in the reference output
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/VariabilityCalculator.h>
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace NTIA::ITM;
+
+namespace {
+    /// @brief Profile of a terrain file: number of points not counting the Tx, resolution (meters), then the heights
+    struct ExampleProfile {
+        double m_sampleResolution_m = 0.0;
+        std::vector<double> m_terrainHeightList_m;
+    };
+
+    ExampleProfile readExampleProfile(const std::string& filePath) {
+        std::ifstream inStream(filePath);
+        std::vector<double> valueList;
+        std::string field;
+        while (std::getline(inStream, field, ',')) {
+            valueList.push_back(std::stod(field));
+        }
+        if (valueList.size() < 4u) {
+            return {};
+        }
+        return { valueList[1], std::vector<double>(valueList.begin() + 2, valueList.end()) };
+    }
+
+    ItmCommonCalculator makeExampleCalculator() {
+        // i_p2pcr_tbl.txt: climate 5 = continental temperate, pol 1 = vertical, mdvar 1 = accidental
+        return ItmCommonCalculator(15.0, 3.0, Temperate, 301.0, 3500.0, false, 15.0, 0.005, AccidentalMode, 50.0, 50.0, 50.0);
+    }
+
+    class ReferenceExampleTests : public testing::Test {
+    protected:
+        void SetUp() override {
+            m_profile = readExampleProfile(NTIA_ITM_CMD_EXAMPLES_DIR "/pfl.txt");
+            ASSERT_EQ(m_profile.m_terrainHeightList_m.size(), 143u);
+            m_results = m_calculator.calcItmLoss_P2P_dB(m_profile.m_terrainHeightList_m, m_profile.m_sampleResolution_m, false, m_workspace);
+        }
+
+        const ItmCommonCalculator m_calculator = makeExampleCalculator();
+        ExampleProfile m_profile;
+        ItmWorkspace m_workspace;
+        ItmResults m_results;
+    };
+}
+
+TEST_F(ReferenceExampleTests, IntermediateValuesMatchReference) {
+    const IntermResults& intermResults = m_results.m_intermResults;
+    EXPECT_EQ(intermResults.m_propMode, LineOfSight);
+    EXPECT_NEAR(intermResults.m_fsplAtten_dB, 114.5, 0.05);
+    EXPECT_NEAR(intermResults.m_terrainProfile.m_pathDist_km, 3.635, 0.0005);
+    EXPECT_NEAR(intermResults.m_txHorizonAngle_rad * 1.0e3, -1.949, 0.0005);
+    EXPECT_NEAR(intermResults.m_rxHorizonAngle_rad * 1.0e3, -0.856, 0.0005);
+    EXPECT_NEAR(intermResults.m_txHorizonDist_m, 14868.0, 0.5);
+    EXPECT_NEAR(intermResults.m_rxHorizonDist_m, 6494.0, 0.5);
+    EXPECT_NEAR(intermResults.m_txEffHeight_m, 15.0, 0.05);
+    EXPECT_NEAR(intermResults.m_rxEffHeight_m, 3.0, 0.05);
+    EXPECT_NEAR(intermResults.m_surfRefract_N, 251.5, 0.05);
+    EXPECT_NEAR(intermResults.m_terrainIrreg_m, 3.2, 0.05);
+    EXPECT_NEAR(intermResults.m_refAtten_dB, 0.0, 0.05);
+}
+
+TEST_F(ReferenceExampleTests, LossTableMatchesReference) {
+    const std::array<double, 3> confidenceFracList { 0.1, 0.6, 0.9 };
+    const std::array<double, 3> reliabilityFracList { 0.1, 0.65, 0.9 };
+    // Rows of reliability, columns of confidence, as printed
+    const std::array<std::array<double, 3>, 3> expectedLossTable_dB {{
+        { 110.9, 117.2, 129.1 },
+        { 110.9, 117.4, 129.2 },
+        { 110.9, 117.5, 129.3 }
+    }};
+
+    std::array<double, 9> lossTable_dB {};
+    const VariabilityCalculator variabilityCalculator = m_calculator.createVariabilityCalculator(m_results);
+    variabilityCalculator.calcVariabilityLoss_CR_dB(m_results.m_intermResults.m_refAtten_dB, confidenceFracList, reliabilityFracList,
+                lossTable_dB);
+    for (std::size_t relInd = 0; relInd < reliabilityFracList.size(); relInd++) {
+        for (std::size_t confInd = 0; confInd < confidenceFracList.size(); confInd++) {
+            EXPECT_NEAR(lossTable_dB[confInd * reliabilityFracList.size() + relInd] + m_results.m_intermResults.m_fsplAtten_dB,
+                        expectedLossTable_dB[relInd][confInd], 0.05) << "reliability " << reliabilityFracList[relInd]
+                        << ", confidence " << confidenceFracList[confInd];
+        }
+    }
+}
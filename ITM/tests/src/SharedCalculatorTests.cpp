@@ -0,0 +1,82 @@
+/// One const calculator shared by several threads, each with its own workspace, must give every path the results of
+/// evaluating the paths one after another
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    std::size_t constexpr kNumThreads { 4u };
+    std::size_t constexpr kNumRepeats { 20u };
+
+    /// What each evaluation of a path gave
+    struct PathResults {
+        double m_atten_dB = 0.0;
+        double m_refAtten_dB = 0.0;
+        double m_terrainIrreg_m = 0.0;
+        PropagationMode m_propMode = NotSet;
+        ItmLossResult m_lossOnly {};
+    };
+
+    PathResults evaluatePath(const ItmCommonCalculator& calculator, const std::vector<double>& terrainHeightList_m, ItmWorkspace& workspace) {
+        const ItmResults results = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+        return { results.m_atten_dB, results.m_intermResults.m_refAtten_dB, results.m_intermResults.m_terrainIrreg_m,
+                    results.m_intermResults.m_propMode,
+                    calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, LossOnly, workspace) };
+    }
+}
+
+TEST(SharedCalculatorTests, ThreadsMatchSerialResults) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    std::vector<std::vector<double>> profileList;
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        profileList.push_back(makeSyntheticProfile_m(numPointsMinusTx, seed++));
+        profileList.push_back(makeSyntheticProfile_m(numPointsMinusTx, seed++, 250.0));
+    }
+    const std::size_t numProfiles = profileList.size();
+
+    std::vector<PathResults> serialResultsList;
+    ItmWorkspace serialWorkspace;
+    for (const std::vector<double>& terrainHeightList_m : profileList) {
+        serialResultsList.push_back(evaluatePath(calculator, terrainHeightList_m, serialWorkspace));
+    }
+
+    // Each thread starts at a different profile, so short & long paths overlap with each other in the workspaces
+    std::vector<std::vector<PathResults>> threadResultsList(kNumThreads, std::vector<PathResults>(kNumRepeats * numProfiles));
+    std::vector<std::thread> threadList;
+    for (std::size_t threadInd = 0; threadInd < kNumThreads; threadInd++) {
+        threadList.emplace_back([&, threadInd]() {
+            ItmWorkspace workspace;
+            for (std::size_t evalInd = 0; evalInd < kNumRepeats * numProfiles; evalInd++) {
+                const std::size_t profileInd = (evalInd + threadInd * 3u) % numProfiles;
+                threadResultsList[threadInd][evalInd] = evaluatePath(calculator, profileList[profileInd], workspace);
+            }
+        });
+    }
+    for (std::thread& thread : threadList) {
+        thread.join();
+    }
+
+    for (std::size_t threadInd = 0; threadInd < kNumThreads; threadInd++) {
+        for (std::size_t evalInd = 0; evalInd < kNumRepeats * numProfiles; evalInd++) {
+            const std::size_t profileInd = (evalInd + threadInd * 3u) % numProfiles;
+            const PathResults& results = threadResultsList[threadInd][evalInd];
+            const PathResults& serialResults = serialResultsList[profileInd];
+            ASSERT_EQ(results.m_atten_dB, serialResults.m_atten_dB) << "thread " << threadInd << ", profile " << profileInd;
+            ASSERT_EQ(results.m_refAtten_dB, serialResults.m_refAtten_dB) << "thread " << threadInd << ", profile " << profileInd;
+            ASSERT_EQ(results.m_terrainIrreg_m, serialResults.m_terrainIrreg_m) << "thread " << threadInd << ", profile " << profileInd;
+            ASSERT_EQ(results.m_propMode, serialResults.m_propMode) << "thread " << threadInd << ", profile " << profileInd;
+            ASSERT_EQ(results.m_lossOnly.m_atten_dB, serialResults.m_lossOnly.m_atten_dB) << "thread " << threadInd << ", profile " << profileInd;
+        }
+    }
+}
@@ -0,0 +1,104 @@
+/// Profiles read through a borrowed span must give the results of the std::vector form, which keeps its own copy, at
+/// every ResultLevel
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    void expectSameIntermResults(const IntermResults& spanResults, const IntermResults& vectorResults, const std::size_t numPointsMinusTx) {
+        EXPECT_DOUBLE_EQ(spanResults.m_terrainProfile.m_pathDist_km, vectorResults.m_terrainProfile.m_pathDist_km) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_terrainIrreg_m, vectorResults.m_terrainIrreg_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_txEffHeight_m, vectorResults.m_txEffHeight_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_rxEffHeight_m, vectorResults.m_rxEffHeight_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_txHorizonDist_m, vectorResults.m_txHorizonDist_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_rxHorizonDist_m, vectorResults.m_rxHorizonDist_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(spanResults.m_refAtten_dB, vectorResults.m_refAtten_dB) << numPointsMinusTx << " points";
+        EXPECT_EQ(spanResults.m_propMode, vectorResults.m_propMode) << numPointsMinusTx << " points";
+    }
+}
+
+TEST(SpanInputTests, MatchesVectorInput) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        // The profile sits in the middle of a larger buffer, so the span is a true view rather than the whole of a vector
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        std::vector<double> bufferList_m(3u, -1.0e3);
+        bufferList_m.insert(bufferList_m.end(), terrainHeightList_m.begin(), terrainHeightList_m.end());
+        bufferList_m.insert(bufferList_m.end(), 3u, 5.0e3);
+        const std::span<const double> terrainView_m = std::span<const double>(bufferList_m).subspan(3u, terrainHeightList_m.size());
+
+        const ItmResults vectorResults = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m);
+        const ItmResults borrowedResults = calculator.calcItmLoss_P2P_dB(terrainView_m, kSyntheticSampleResolution_m, false);
+        const ItmResults storedResults = calculator.calcItmLoss_P2P_dB(terrainView_m, kSyntheticSampleResolution_m, true);
+
+        EXPECT_DOUBLE_EQ(borrowedResults.m_atten_dB, vectorResults.m_atten_dB) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(storedResults.m_atten_dB, vectorResults.m_atten_dB) << numPointsMinusTx << " points";
+        expectSameIntermResults(borrowedResults.m_intermResults, vectorResults.m_intermResults, numPointsMinusTx);
+        expectSameIntermResults(storedResults.m_intermResults, vectorResults.m_intermResults, numPointsMinusTx);
+
+        // Only the stored forms hand back the heights
+        EXPECT_TRUE(borrowedResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m.empty());
+        const std::span<const double> vectorHeightList_m = vectorResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+        const std::span<const double> storedHeightList_m = storedResults.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+        EXPECT_EQ(std::vector<double>(vectorHeightList_m.begin(), vectorHeightList_m.end()), terrainHeightList_m);
+        EXPECT_EQ(std::vector<double>(storedHeightList_m.begin(), storedHeightList_m.end()), terrainHeightList_m);
+    }
+}
+
+TEST(SpanInputTests, StoredProfileOutlivesTheCallersHeights) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    const std::vector<double> expectedHeightList_m = makeSyntheticProfile_m(150u);
+    ItmResults results;
+    {
+        std::vector<double> terrainHeightList_m = expectedHeightList_m;
+        results = calculator.calcItmLoss_P2P_dB(std::span<const double>(terrainHeightList_m), kSyntheticSampleResolution_m, true);
+        terrainHeightList_m.assign(terrainHeightList_m.size(), 0.0);
+    }
+
+    // A copy of the results keeps its own storage too
+    const ItmResults resultsCopy = results;
+    results = ItmResults();
+    const std::span<const double> heightList_m = resultsCopy.m_intermResults.m_terrainProfile.m_terrainHeightList_m;
+    EXPECT_TRUE(resultsCopy.m_intermResults.m_terrainProfile.ownsTerrainHeights());
+    EXPECT_EQ(std::vector<double>(heightList_m.begin(), heightList_m.end()), expectedHeightList_m);
+}
+
+TEST(SpanInputTests, ResultLevelsMatchFullEvaluations) {
+    ItmCommonCalculator calculator = makeTestCalculator();
+    ItmWorkspace workspace;
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        const ItmResults fullResults = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m);
+
+        for (const ResultLevel resultLevel : { LossOnly, LossAndMode, FullResults }) {
+            // Through the calculator's own workspace, then through the caller's
+            const ItmLossResult ownResult = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, resultLevel);
+            const ItmLossResult workspaceResult = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m,
+                        resultLevel, workspace);
+
+            const PropagationMode expectedPropMode = (resultLevel == LossOnly) ? NotSet : fullResults.m_intermResults.m_propMode;
+            for (const ItmLossResult& leanResult : { ownResult, workspaceResult }) {
+                EXPECT_DOUBLE_EQ(leanResult.m_atten_dB, fullResults.m_atten_dB) << numPointsMinusTx << " points, level " << resultLevel;
+                EXPECT_EQ(leanResult.m_propMode, expectedPropMode) << numPointsMinusTx << " points, level " << resultLevel;
+            }
+
+            // At FullResults the intermediate values are left in the workspace
+            if (resultLevel == FullResults) {
+                expectSameIntermResults(workspace.m_itmResults.m_intermResults, fullResults.m_intermResults, numPointsMinusTx);
+                EXPECT_DOUBLE_EQ(workspace.m_itmResults.m_intermResults.m_fsplAtten_dB, fullResults.m_intermResults.m_fsplAtten_dB);
+            }
+        }
+    }
+}
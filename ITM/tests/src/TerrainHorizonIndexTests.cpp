@@ -0,0 +1,76 @@
+/// Horizons found on the curvature adjusted terrain hulls must be those of a scan over every point of the profile
+
+#include "TestHelpers.h"
+
+#include <ITM/HorizonScan.h>
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmConstructs.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/PreparedTerrainProfile.h>
+#include <ITM/TerrainHorizonIndex.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+TEST(TerrainHorizonIndexTests, MatchesScanAtEveryAntennaHeight) {
+    const double effEarthCurvature_perM = ItmHelpers::calcEffEarthCurvature_perM(ItmHelpers::calcSurfaceRefractivity_N(301.0, 150.0));
+    const std::vector<double> antennaHeightList_m { 0.5, 3.0, 10.0, 30.0, 100.0, 400.0, 3000.0 };
+
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        TerrainProfile terrainProfile;
+        terrainProfile.setTerrainHeights(terrainHeightList_m, false);
+        terrainProfile.m_numPointsMinusTx = numPointsMinusTx;
+        terrainProfile.m_sampleResolution_m = kSyntheticSampleResolution_m;
+        terrainProfile.m_pathDist_km = numPointsMinusTx * kSyntheticSampleResolution_m * 1.0e-3;
+        const TerrainHorizonIndex horizonIndex(terrainProfile, effEarthCurvature_perM);
+
+        std::vector<double> txDistList_m(numPointsMinusTx);
+        std::vector<double> rxDistList_m(numPointsMinusTx);
+        HorizonScan::fillTxDistances(txDistList_m, kSyntheticSampleResolution_m);
+        HorizonScan::fillRxDistances(rxDistList_m, terrainProfile.m_pathDist_km * 1.0e3, kSyntheticSampleResolution_m);
+
+        for (const double& antennaHeight_m : antennaHeightList_m) {
+            const double txRadial_m = terrainHeightList_m.front() + antennaHeight_m;
+            const HorizonScan::HorizonCandidate txCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, txDistList_m, txRadial_m,
+                        1.0 / effEarthCurvature_perM);
+            const HorizonPoint txHorizonPoint = horizonIndex.findTxHorizon(txRadial_m);
+            EXPECT_EQ(txHorizonPoint.m_pointInd, txCandidate.m_pointInd) << numPointsMinusTx << " points, Tx at " << antennaHeight_m << " m";
+            EXPECT_DOUBLE_EQ(txHorizonPoint.m_angle_rad, txCandidate.m_angle_rad) << numPointsMinusTx << " points, Tx at " << antennaHeight_m << " m";
+            EXPECT_DOUBLE_EQ(txHorizonPoint.m_dist_m, txDistList_m[txCandidate.m_pointInd]) << numPointsMinusTx << " points, Tx at " << antennaHeight_m << " m";
+
+            const double rxRadial_m = terrainHeightList_m.back() + antennaHeight_m;
+            const HorizonScan::HorizonCandidate rxCandidate = HorizonScan::findHorizonPoint(terrainHeightList_m, rxDistList_m, rxRadial_m,
+                        1.0 / effEarthCurvature_perM);
+            const HorizonPoint rxHorizonPoint = horizonIndex.findRxHorizon(rxRadial_m);
+            EXPECT_EQ(rxHorizonPoint.m_pointInd, rxCandidate.m_pointInd) << numPointsMinusTx << " points, Rx at " << antennaHeight_m << " m";
+            EXPECT_DOUBLE_EQ(rxHorizonPoint.m_angle_rad, rxCandidate.m_angle_rad) << numPointsMinusTx << " points, Rx at " << antennaHeight_m << " m";
+            EXPECT_DOUBLE_EQ(rxHorizonPoint.m_dist_m, rxDistList_m[rxCandidate.m_pointInd]) << numPointsMinusTx << " points, Rx at " << antennaHeight_m << " m";
+        }
+    }
+}
+
+TEST(TerrainHorizonIndexTests, IndexedProfileMatchesRawProfile) {
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    ItmWorkspace workspace;
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        PreparedTerrainProfile preparedProfile(terrainHeightList_m, kSyntheticSampleResolution_m);
+        preparedProfile.buildHorizonIndex(301.0);
+        ASSERT_NE(preparedProfile.getHorizonIndex(), nullptr);
+
+        const ItmResults indexedResults = calculator.calcItmLoss_P2P_dB(preparedProfile, false, workspace);
+        const ItmResults rawResults = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+        EXPECT_DOUBLE_EQ(indexedResults.m_intermResults.m_txHorizonDist_m, rawResults.m_intermResults.m_txHorizonDist_m) << numPointsMinusTx << " points";
+        EXPECT_DOUBLE_EQ(indexedResults.m_intermResults.m_rxHorizonDist_m, rawResults.m_intermResults.m_rxHorizonDist_m) << numPointsMinusTx << " points";
+        EXPECT_NEAR(indexedResults.m_atten_dB, rawResults.m_atten_dB, 1.0e-6) << numPointsMinusTx << " points";
+        EXPECT_EQ(indexedResults.m_intermResults.m_propMode, rawResults.m_intermResults.m_propMode) << numPointsMinusTx << " points";
+    }
+}
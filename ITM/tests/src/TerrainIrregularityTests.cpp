@@ -0,0 +1,101 @@
+/// delta_h from the fixed-capacity estimator must match the reference ITM's ComputeDeltaH(), which resamples the profile
+/// one step at a time and sorts every difference from the fit to find the 10% & 90% points
+
+#include "TestHelpers.h"
+
+#include <ITM/MathHelpers.h>
+#include <ITM/TerrainIrregularityEstimator.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <span>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    /// @brief delta_h as the reference ITM computes it (heap buffers, full sort)
+    double calcReferenceTerrainIrreg_m(const std::vector<double>& terrainHeightList_m, const double& sampleResolution_m,
+                const double& distToStart_m, const double& distToEnd_m) {
+        const std::size_t numPointsMinusTx = terrainHeightList_m.size() - 1u;
+        double xStart = distToStart_m / sampleResolution_m;
+        double xEnd = distToEnd_m / sampleResolution_m;
+        if (xEnd - xStart < 2.0) {
+            return 0.0;
+        }
+
+        const int tenPercentInd = std::min(std::max(4, static_cast<int>(0.1 * (xEnd - xStart + 8.0))), 25);
+        const int numAdjustedPoints = 10 * tenPercentInd - 5;
+        const double adjustedNumPointsMinusTx = numAdjustedPoints - 1;
+
+        std::vector<double> adjustedHeightList_m(numAdjustedPoints);
+        xEnd = (xEnd - xStart) / adjustedNumPointsMinusTx;
+        std::size_t xInd = static_cast<std::size_t>(xStart);
+        xStart -= static_cast<double>(xInd + 1u);
+        for (int adjustedInd = 0; adjustedInd < numAdjustedPoints; adjustedInd++) {
+            while (xStart > 0.0 && xInd + 1u < numPointsMinusTx) {
+                xStart -= 1.0;
+                xInd++;
+            }
+            adjustedHeightList_m[adjustedInd] = terrainHeightList_m[xInd + 1u] + (terrainHeightList_m[xInd + 1u] - terrainHeightList_m[xInd]) * xStart;
+            xStart += xEnd;
+        }
+
+        MathHelpers::TerrainFitResults fitResults = MathHelpers::fitTerrainProfile_linearLeastSquares(adjustedHeightList_m, 1.0, 0.0,
+                    adjustedNumPointsMinusTx);
+        fitResults.m_y2Value = (fitResults.m_y2Value - fitResults.m_y1Value) / adjustedNumPointsMinusTx;
+
+        std::vector<double> diffList_m(numAdjustedPoints);
+        for (int adjustedInd = 0; adjustedInd < numAdjustedPoints; adjustedInd++) {
+            diffList_m[adjustedInd] = adjustedHeightList_m[adjustedInd] - fitResults.m_y1Value;
+            fitResults.m_y1Value += fitResults.m_y2Value;
+        }
+        std::sort(diffList_m.begin(), diffList_m.end(), std::greater<double>());
+        const double q10 = diffList_m[tenPercentInd - 1];
+        const double q90 = diffList_m[numAdjustedPoints - tenPercentInd];
+
+        return (q10 - q90) / (1.0 - 0.8 * std::exp(-(distToEnd_m - distToStart_m) / 50.0e3));
+    }
+}
+
+TEST(TerrainIrregularityTests, MatchesSortedReference) {
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        for (const double& hillHeight_m : { 0.0, 80.0 }) {
+            const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++, hillHeight_m);
+            const double pathDist_m = numPointsMinusTx * kSyntheticSampleResolution_m;
+
+            // Windows from the whole path down to ones too short for any estimate, including fractional sample offsets
+            for (const double& startFrac : { 0.0, 0.013, 0.1, 0.37 }) {
+                for (const double& endFrac : { 1.0, 0.9, 0.55, 0.4 }) {
+                    const double distToStart_m = startFrac * pathDist_m;
+                    const double distToEnd_m = endFrac * pathDist_m;
+                    TerrainIrregularityEstimator estimator;
+                    EXPECT_DOUBLE_EQ(estimator.calcTerrainIrreg_m(terrainHeightList_m, kSyntheticSampleResolution_m, distToStart_m, distToEnd_m),
+                                calcReferenceTerrainIrreg_m(terrainHeightList_m, kSyntheticSampleResolution_m, distToStart_m, distToEnd_m))
+                                << numPointsMinusTx << " points, window [" << distToStart_m << ", " << distToEnd_m << "] m";
+                }
+            }
+        }
+    }
+}
+
+TEST(TerrainIrregularityTests, ReusedEstimatorMatchesFreshOne) {
+    // One estimator carried along profiles of every length (longest first, so shorter ones can't lean on a larger earlier state)
+    TerrainIrregularityEstimator reusedEstimator;
+    std::vector<std::size_t> profileLengthList = getTestProfileLengths();
+    std::reverse(profileLengthList.begin(), profileLengthList.end());
+    unsigned int seed = 1u;
+    for (const std::size_t numPointsMinusTx : profileLengthList) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+        const double pathDist_m = numPointsMinusTx * kSyntheticSampleResolution_m;
+        TerrainIrregularityEstimator freshEstimator;
+        EXPECT_DOUBLE_EQ(reusedEstimator.calcTerrainIrreg_m(terrainHeightList_m, kSyntheticSampleResolution_m, 0.05 * pathDist_m, 0.95 * pathDist_m),
+                    freshEstimator.calcTerrainIrreg_m(terrainHeightList_m, kSyntheticSampleResolution_m, 0.05 * pathDist_m, 0.95 * pathDist_m))
+                    << numPointsMinusTx << " points";
+    }
+}
@@ -0,0 +1,265 @@
+/// A profile file must give back the profiles written to it, within the precision of its height encoding, and refuse to
+/// open a file whose header, sections or offsets don't hold together
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/TerrainProfileFile.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    // Byte offsets of the header fields (see TerrainProfileFile)
+    std::size_t constexpr kVersionPos { 8u };
+    std::size_t constexpr kHeightEncodingPos { 12u };
+    std::size_t constexpr kNumHeightsPos { 24u };
+    std::size_t constexpr kOffsetListStartPos { 32u };
+    std::size_t constexpr kHeightStartPos { 56u };
+    std::size_t constexpr kHeaderSize_bytes { 64u };
+
+    struct ProfileSet {
+        std::vector<double> m_terrainHeightBuffer_m;
+        std::vector<std::size_t> m_profileOffsetList;
+        std::vector<double> m_sampleResolutionList_m;
+    };
+
+    /// Test profiles of every length, plus a flat one, placed a few entries into the buffer
+    ProfileSet makeProfileSet() {
+        ProfileSet profileSet;
+        profileSet.m_terrainHeightBuffer_m.assign(3u, -1.0e3);
+        profileSet.m_profileOffsetList.push_back(profileSet.m_terrainHeightBuffer_m.size());
+        unsigned int seed = 1u;
+        for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+            const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, seed++);
+            profileSet.m_terrainHeightBuffer_m.insert(profileSet.m_terrainHeightBuffer_m.end(), terrainHeightList_m.begin(), terrainHeightList_m.end());
+            profileSet.m_profileOffsetList.push_back(profileSet.m_terrainHeightBuffer_m.size());
+            profileSet.m_sampleResolutionList_m.push_back(kSyntheticSampleResolution_m + seed);
+        }
+        profileSet.m_terrainHeightBuffer_m.insert(profileSet.m_terrainHeightBuffer_m.end(), 40u, 123.25);
+        profileSet.m_profileOffsetList.push_back(profileSet.m_terrainHeightBuffer_m.size());
+        profileSet.m_sampleResolutionList_m.push_back(90.0);
+        return profileSet;
+    }
+
+    std::vector<char> readBytes(const std::string& filePath) {
+        std::ifstream inStream(filePath, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(inStream), std::istreambuf_iterator<char>());
+    }
+
+    void writeBytes(const std::string& filePath, const std::vector<char>& byteList) {
+        std::ofstream outStream(filePath, std::ios::binary | std::ios::trunc);
+        outStream.write(byteList.data(), static_cast<std::streamsize>(byteList.size()));
+    }
+
+    template <typename T>
+    T readField(const std::vector<char>& byteList, const std::size_t pos) {
+        T value;
+        std::memcpy(&value, byteList.data() + pos, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void writeField(std::vector<char>& byteList, const std::size_t pos, const T& value) {
+        std::memcpy(byteList.data() + pos, &value, sizeof(T));
+    }
+}
+
+TEST(TerrainProfileFileTests, RoundTripsEveryEncoding) {
+    const std::string directoryPath = makeTestDirectory("TerrainProfileFileTests_RoundTripsEveryEncoding");
+    const ProfileSet profileSet = makeProfileSet();
+    const std::size_t numProfiles = profileSet.m_sampleResolutionList_m.size();
+    const std::size_t firstOffset = profileSet.m_profileOffsetList.front();
+
+    for (const TerrainProfileFile::HeightEncoding heightEncoding : { TerrainProfileFile::Float64, TerrainProfileFile::Float32,
+                TerrainProfileFile::ScaledInt16 }) {
+        const std::string filePath = directoryPath + "/profiles_" + std::to_string(heightEncoding) + ".bin";
+        TerrainProfileFile::write(filePath, profileSet.m_terrainHeightBuffer_m, profileSet.m_profileOffsetList,
+                    profileSet.m_sampleResolutionList_m, heightEncoding);
+        EXPECT_EQ(std::filesystem::file_size(filePath) % 8u, 0u) << "encoding " << heightEncoding;
+
+        const TerrainProfileFile profileFile(filePath);
+        EXPECT_EQ(profileFile.getHeightEncoding(), heightEncoding);
+        ASSERT_EQ(profileFile.getNumProfiles(), numProfiles) << "encoding " << heightEncoding;
+
+        // Offsets come back relative to the first profile
+        for (std::size_t offsetInd = 0; offsetInd <= numProfiles; offsetInd++) {
+            EXPECT_EQ(profileFile.getProfileOffsetList()[offsetInd], profileSet.m_profileOffsetList[offsetInd] - firstOffset);
+        }
+        EXPECT_TRUE(std::ranges::equal(profileFile.getSampleResolutionList_m(), profileSet.m_sampleResolutionList_m));
+
+        std::vector<double> decodeBuffer_m;
+        for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+            const std::span<const double> expectedHeightList_m = std::span<const double>(profileSet.m_terrainHeightBuffer_m).subspan(
+                        profileSet.m_profileOffsetList[profileInd], profileSet.m_profileOffsetList[profileInd + 1u] - profileSet.m_profileOffsetList[profileInd]);
+            ASSERT_EQ(profileFile.getNumPoints(profileInd), expectedHeightList_m.size());
+
+            // Float32 keeps 24 bits of each height, ScaledInt16 a 65535th of each profile's range
+            const auto [minIter, maxIter] = std::minmax_element(expectedHeightList_m.begin(), expectedHeightList_m.end());
+            const double maxHeightError_m = (heightEncoding == TerrainProfileFile::Float64) ? 0.0
+                        : (heightEncoding == TerrainProfileFile::Float32) ? std::max(std::abs(*minIter), std::abs(*maxIter)) * 0x1.0p-24
+                        : (*maxIter - *minIter) / 131068.0 + 1.0e-9;
+
+            const std::span<const double> heightList_m = profileFile.readHeights_m(profileInd, decodeBuffer_m);
+            ASSERT_EQ(heightList_m.size(), expectedHeightList_m.size());
+            for (std::size_t pointInd = 0; pointInd < heightList_m.size(); pointInd++) {
+                ASSERT_NEAR(heightList_m[pointInd], expectedHeightList_m[pointInd], maxHeightError_m)
+                            << "encoding " << heightEncoding << ", profile " << profileInd << ", point " << pointInd;
+            }
+        }
+    }
+}
+
+TEST(TerrainProfileFileTests, Float64FileFeedsTheCalculatorFromTheMapping) {
+    const std::string directoryPath = makeTestDirectory("TerrainProfileFileTests_Float64FileFeedsTheCalculatorFromTheMapping");
+    const ProfileSet profileSet = makeProfileSet();
+    const std::string filePath = directoryPath + "/profiles.bin";
+    TerrainProfileFile::write(filePath, profileSet.m_terrainHeightBuffer_m, profileSet.m_profileOffsetList,
+                profileSet.m_sampleResolutionList_m, TerrainProfileFile::Float64);
+    const TerrainProfileFile profileFile(filePath);
+
+    // The batch reads the buffer in place, and must agree with each profile evaluated from the caller's copy
+    const ItmCommonCalculator calculator = makeTestCalculator();
+    const std::size_t numProfiles = profileFile.getNumProfiles();
+    std::vector<double> attenList_dB(numProfiles);
+    std::vector<PropagationMode> propModeList(numProfiles);
+    ItmWorkspace workspace;
+    calculator.calcItmLoss_P2P_batch_dB(profileFile.getHeightBuffer_m(), profileFile.getProfileOffsetList(),
+                profileFile.getSampleResolutionList_m(), attenList_dB, propModeList, workspace);
+    for (std::size_t profileInd = 0; profileInd < numProfiles; profileInd++) {
+        const std::vector<double> terrainHeightList_m(profileSet.m_terrainHeightBuffer_m.begin() + profileSet.m_profileOffsetList[profileInd],
+                    profileSet.m_terrainHeightBuffer_m.begin() + profileSet.m_profileOffsetList[profileInd + 1u]);
+        const ItmResults results = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, profileSet.m_sampleResolutionList_m[profileInd],
+                    false, workspace);
+        EXPECT_DOUBLE_EQ(attenList_dB[profileInd], results.m_atten_dB) << "profile " << profileInd;
+        EXPECT_EQ(propModeList[profileInd], results.m_intermResults.m_propMode) << "profile " << profileInd;
+    }
+
+    // Reads of another encoding's heights are refused
+    EXPECT_THROW(profileFile.getFloat32Heights_m(0u), std::domain_error);
+    EXPECT_THROW(profileFile.getScaledInt16Heights(0u), std::domain_error);
+    EXPECT_THROW(profileFile.getHeightScale(0u), std::domain_error);
+}
+
+TEST(TerrainProfileFileTests, ConvertsTestDataProfiles) {
+    const std::string directoryPath = makeTestDirectory("TerrainProfileFileTests_ConvertsTestDataProfiles");
+    const std::string csvFilePath = std::string(NTIA_ITM_TEST_DATA_DIR) + "/pfls.csv";
+    const std::string filePath = directoryPath + "/pfls.bin";
+    const std::size_t numProfiles = TerrainProfileFile::convertCsv(csvFilePath, filePath, TerrainProfileFile::Float64);
+    const TerrainProfileFile profileFile(filePath);
+    ASSERT_EQ(profileFile.getNumProfiles(), numProfiles);
+
+    // Each line: number of points not counting the Tx, resolution, heights
+    std::ifstream inStream(csvFilePath);
+    std::string line;
+    std::size_t profileInd = 0u;
+    while (std::getline(inStream, line) && profileInd < numProfiles) {
+        std::vector<double> valueList;
+        std::istringstream lineStream(line);
+        for (std::string value; std::getline(lineStream, value, ',');) {
+            if (!value.empty() && value != "\r") {
+                valueList.push_back(std::stod(value));
+            }
+        }
+        ASSERT_GE(valueList.size(), 4u);
+        EXPECT_EQ(profileFile.getNumPoints(profileInd), static_cast<std::size_t>(valueList[0]) + 1u);
+        EXPECT_DOUBLE_EQ(profileFile.getSampleResolutionList_m()[profileInd], valueList[1]);
+        EXPECT_TRUE(std::ranges::equal(profileFile.getHeights_m(profileInd), std::span<const double>(valueList).subspan(2u)))
+                    << "profile " << profileInd;
+        profileInd++;
+    }
+    EXPECT_EQ(profileInd, numProfiles);
+}
+
+TEST(TerrainProfileFileTests, RejectsBrokenFiles) {
+    const std::string directoryPath = makeTestDirectory("TerrainProfileFileTests_RejectsBrokenFiles");
+    const ProfileSet profileSet = makeProfileSet();
+    const std::string goodFilePath = directoryPath + "/good.bin";
+    TerrainProfileFile::write(goodFilePath, profileSet.m_terrainHeightBuffer_m, profileSet.m_profileOffsetList,
+                profileSet.m_sampleResolutionList_m, TerrainProfileFile::ScaledInt16);
+    const std::vector<char> goodByteList = readBytes(goodFilePath);
+    ASSERT_NO_THROW(TerrainProfileFile { goodFilePath });
+
+    const std::uint64_t numHeights = readField<std::uint64_t>(goodByteList, kNumHeightsPos);
+    const std::uint64_t offsetListStart = readField<std::uint64_t>(goodByteList, kOffsetListStartPos);
+    const std::uint64_t heightStart = readField<std::uint64_t>(goodByteList, kHeightStartPos);
+    const std::size_t numProfiles = profileSet.m_sampleResolutionList_m.size();
+
+    const auto expectRejected = [&](const std::string& name, const std::vector<char>& byteList) {
+        const std::string filePath = directoryPath + "/" + name + ".bin";
+        writeBytes(filePath, byteList);
+        EXPECT_THROW(TerrainProfileFile { filePath }, std::runtime_error) << name;
+    };
+
+    std::vector<char> byteList = goodByteList;
+    byteList[3] = 'X';
+    expectRejected("bad_magic", byteList);
+
+    byteList = goodByteList;
+    writeField<std::uint32_t>(byteList, kVersionPos, 2u);
+    expectRejected("bad_version", byteList);
+
+    byteList = goodByteList;
+    writeField<std::uint32_t>(byteList, kHeightEncodingPos, 7u);
+    expectRejected("bad_encoding", byteList);
+
+    // Truncated: within the header, after the header, within the offsets, & within the heights
+    for (const std::size_t sizeBytes : { std::size_t { 10u }, kHeaderSize_bytes, static_cast<std::size_t>(offsetListStart + 16u),
+                static_cast<std::size_t>(heightStart + numHeights) }) {
+        byteList.assign(goodByteList.begin(), goodByteList.begin() + static_cast<std::ptrdiff_t>(sizeBytes));
+        expectRejected("truncated_" + std::to_string(sizeBytes), byteList);
+    }
+
+    // Sections out of place: past the end, or misaligned
+    byteList = goodByteList;
+    writeField<std::uint64_t>(byteList, kHeightStartPos, goodByteList.size() + 8u);
+    expectRejected("heights_past_end", byteList);
+    byteList = goodByteList;
+    writeField<std::uint64_t>(byteList, kOffsetListStartPos, offsetListStart + 4u);
+    expectRejected("misaligned_offsets", byteList);
+
+    // Offsets past the heights, decreasing, or leaving a profile with a single point
+    byteList = goodByteList;
+    writeField<std::uint64_t>(byteList, offsetListStart + numProfiles * sizeof(std::uint64_t), numHeights + 1u);
+    expectRejected("offsets_past_heights", byteList);
+    byteList = goodByteList;
+    writeField<std::uint64_t>(byteList, offsetListStart + sizeof(std::uint64_t), 0u);
+    expectRejected("decreasing_offsets", byteList);
+    byteList = goodByteList;
+    writeField<std::uint64_t>(byteList, offsetListStart + sizeof(std::uint64_t), 1u);
+    expectRejected("one_point_profile", byteList);
+
+    EXPECT_THROW(TerrainProfileFile { directoryPath + "/missing.bin" }, std::runtime_error);
+}
+
+TEST(TerrainProfileFileTests, WriteRejectsInconsistentProfiles) {
+    const std::string filePath = makeTestDirectory("TerrainProfileFileTests_WriteRejectsInconsistentProfiles") + "/profiles.bin";
+    const std::vector<double> terrainHeightBuffer_m { 10.0, 11.0, 12.0, 13.0, 14.0 };
+    const std::vector<double> sampleResolutionList_m { 30.0, 30.0 };
+
+    const auto expectRejected = [&](const std::vector<std::size_t>& profileOffsetList, std::span<const double> resolutionList_m,
+                const TerrainProfileFile::HeightEncoding heightEncoding) {
+        EXPECT_THROW(TerrainProfileFile::write(filePath, terrainHeightBuffer_m, profileOffsetList, resolutionList_m, heightEncoding),
+                    std::domain_error);
+    };
+    expectRejected({ 0u, 2u, 5u }, sampleResolutionList_m, static_cast<TerrainProfileFile::HeightEncoding>(7u));
+    expectRejected({ 0u, 2u, 5u }, std::span<const double>(sampleResolutionList_m).first(1u), TerrainProfileFile::Float64);
+    expectRejected({}, {}, TerrainProfileFile::Float64);
+    expectRejected({ 0u, 1u, 5u }, sampleResolutionList_m, TerrainProfileFile::Float64);
+    expectRejected({ 0u, 3u, 6u }, sampleResolutionList_m, TerrainProfileFile::Float64);
+}
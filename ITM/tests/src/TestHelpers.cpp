@@ -0,0 +1,80 @@
+#include "TestHelpers.h"
+
+#include <ITM/DemTile.h>
+#include <ITM/DemTileStore.h>
+
+#include <gtest/gtest.h>
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+
+namespace NTIA::ITM::Tests {
+    ItmCommonCalculator makeTestCalculator(const double& txHeight_m, const double& rxHeight_m, const double& freq_MHz) {
+        return ItmCommonCalculator(txHeight_m, rxHeight_m, Temperate, 301.0, freq_MHz, false, 15.0, 0.005, AccidentalMode,
+                    50.0, 50.0, 50.0);
+    }
+
+    std::vector<double> makeSyntheticProfile_m(const std::size_t numPointsMinusTx, const unsigned int seed, const double& hillHeight_m) {
+        // A couple of long hills over the path, plus small scale roughness
+        std::mt19937 randomEngine(seed);
+        std::uniform_real_distribution<double> roughnessDistrib_m(-5.0, 5.0);
+        const double hillPeriod = static_cast<double>(numPointsMinusTx) / 2.0 + 1.0;
+
+        std::vector<double> terrainHeightList_m(numPointsMinusTx + 1u);
+        for (std::size_t pointInd = 0; pointInd <= numPointsMinusTx; pointInd++) {
+            terrainHeightList_m[pointInd] = 300.0 + hillHeight_m * std::sin(2.0 * M_PI * pointInd / hillPeriod)
+                        + 20.0 * std::sin(0.37 * pointInd) + roughnessDistrib_m(randomEngine);
+        }
+        return terrainHeightList_m;
+    }
+
+    const std::vector<std::size_t>& getTestProfileLengths() {
+        // 30 m apart: 300 m to 120 km
+        static const std::vector<std::size_t> numPointsMinusTxList { 10u, 33u, 150u, 511u, 1200u, 4000u };
+        return numPointsMinusTxList;
+    }
+
+    std::int16_t getSyntheticDemSample_m(const std::size_t rowInd, const std::size_t colInd) {
+        if ((rowInd >= 600u && rowInd < 610u && colInd >= 600u && colInd < 610u) || (rowInd == 300u && colInd == 300u)) {
+            return DemTile::kVoidHeight;
+        }
+
+        // Hills a few km across, plus +/- 20 m of roughness from one sample to the next
+        const double hillHeight_m = 100.0 + 150.0 * std::sin(rowInd / 80.0) * std::cos(colInd / 60.0);
+        const int roughness_m = static_cast<int>((rowInd * 7919u + colInd * 104729u) % 41u) - 20;
+        return static_cast<std::int16_t>(std::lround(hillHeight_m) + roughness_m);
+    }
+
+    std::string writeSyntheticDemTile(const std::string& directoryPath, const int southLat_deg, const int westLon_deg) {
+        // Big-endian, row by row from the northern edge
+        std::vector<char> byteList(2u * kSyntheticDemNumSamplesPerSide * kSyntheticDemNumSamplesPerSide);
+        for (std::size_t rowInd = 0; rowInd < kSyntheticDemNumSamplesPerSide; rowInd++) {
+            for (std::size_t colInd = 0; colInd < kSyntheticDemNumSamplesPerSide; colInd++) {
+                const std::uint16_t sample = static_cast<std::uint16_t>(getSyntheticDemSample_m(rowInd, colInd));
+                const std::size_t byteInd = 2u * (rowInd * kSyntheticDemNumSamplesPerSide + colInd);
+                byteList[byteInd] = static_cast<char>(sample >> 8);
+                byteList[byteInd + 1u] = static_cast<char>(sample & 0xFFu);
+            }
+        }
+
+        const std::string filePath = (std::filesystem::path(directoryPath) / DemTileStore::makeTileFileName(southLat_deg, westLon_deg)).string();
+        std::ofstream outStream(filePath, std::ios::binary | std::ios::trunc);
+        outStream.write(byteList.data(), static_cast<std::streamsize>(byteList.size()));
+        outStream.close();
+        if (!outStream) {
+            throw std::runtime_error("Unable to write " + filePath);
+        }
+        return filePath;
+    }
+
+    std::string makeTestDirectory(const std::string& name) {
+        const std::filesystem::path directoryPath = std::filesystem::path(::testing::TempDir()) / name;
+        std::filesystem::remove_all(directoryPath);
+        std::filesystem::create_directories(directoryPath);
+        return directoryPath.string();
+    }
+} // end namespace
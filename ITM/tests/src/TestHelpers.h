@@ -0,0 +1,56 @@
+#ifndef ITM_TEST_HELPERS_H
+#define ITM_TEST_HELPERS_H
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmConstructs.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace NTIA::ITM::Tests {
+    // Sample resolution of the synthetic terrain profiles (meters)
+    double constexpr kSyntheticSampleResolution_m { 30.0 };
+
+    /// @brief Calculator for the synthetic profiles: continental temperate over average ground, vertical polarization
+    /// @param txHeight_m Structural height of Tx (meters)
+    /// @param rxHeight_m Structural height of Rx (meters)
+    /// @param freq_MHz Frequency (MHz)
+    ItmCommonCalculator makeTestCalculator(const double& txHeight_m = 15.0, const double& rxHeight_m = 3.0, const double& freq_MHz = 3500.0);
+
+    /// @brief Rolling terrain profile, the same on every call for the same arguments
+    /// @param numPointsMinusTx Number of points in the profile, not including the Tx
+    /// @param seed Seed of the small scale roughness
+    /// @param hillHeight_m Amplitude of the long hills (0 gives gently rough, nearly flat terrain)
+    /// @return Terrain heights (meters), kSyntheticSampleResolution_m apart
+    std::vector<double> makeSyntheticProfile_m(const std::size_t numPointsMinusTx, const unsigned int seed = 1u,
+                const double& hillHeight_m = 80.0);
+
+    /// @brief Profile lengths (number of points not including the Tx) spanning line of sight to troposcatter paths
+    const std::vector<std::size_t>& getTestProfileLengths();
+
+    // Samples per side of the synthetic SRTM tiles (3 arc-second)
+    std::size_t constexpr kSyntheticDemNumSamplesPerSide { 1201u };
+
+    /// @brief Sample of the synthetic SRTM tiles: rolling, rough terrain from below sea level to a few hundred meters, with
+    /// a 10 x 10 block of void samples at rows & columns [600, 610) and a lone void sample at row 300, column 300
+    /// @param rowInd Row of the sample (0 = northern edge)
+    /// @param colInd Column of the sample (0 = western edge)
+    /// @return Height (meters), or DemTile::kVoidHeight
+    std::int16_t getSyntheticDemSample_m(const std::size_t rowInd, const std::size_t colInd);
+
+    /// @brief Write a synthetic tile (see getSyntheticDemSample_m()) under its SRTM name
+    /// @param directoryPath Directory to write it to
+    /// @param southLat_deg Latitude of the south-west corner of the tile (degrees)
+    /// @param westLon_deg Longitude of the south-west corner of the tile (degrees)
+    /// @return Path of the .hgt file
+    std::string writeSyntheticDemTile(const std::string& directoryPath, const int southLat_deg, const int westLon_deg);
+
+    /// @brief Empty directory of one test's own, under the test temporary directory
+    /// @param name Name of the directory (e.g. the test's name)
+    /// @return Path of the directory
+    std::string makeTestDirectory(const std::string& name);
+} // end namespace
+
+#endif // ITM_TEST_HELPERS_H
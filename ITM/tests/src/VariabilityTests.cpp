@@ -0,0 +1,144 @@
+/// Variability of the reference attenuation over time, location & situation (VariabilityCalculator)
+
+#include "TestHelpers.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/MathHelpers.h>
+#include <ITM/VariabilityCalculator.h>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Tests;
+
+namespace {
+    VariabilityCalculator makeVariabilityCalculator(const int varModeCode) {
+        return VariabilityCalculator(Temperate, static_cast<VariabilityMode>(varModeCode), 3500.0, 20.0, 8.0, 90.0, 40.0e3);
+    }
+}
+
+TEST(VariabilityTests, NoLocationVariabilityFlagIgnoresLocation) {
+    const VariabilityCalculator variabilityCalculator = makeVariabilityCalculator(BroadcastMode + NoLocationVariability);
+    EXPECT_DOUBLE_EQ(variabilityCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.1, 0.5),
+                variabilityCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.9, 0.5));
+
+    // Without the flag, location matters
+    const VariabilityCalculator unflaggedCalculator = makeVariabilityCalculator(BroadcastMode);
+    EXPECT_GT(std::abs(unflaggedCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.1, 0.5) - unflaggedCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.9, 0.5)), 1.0);
+}
+
+TEST(VariabilityTests, NoSituationVariabilityFlagDropsDirectSituationVariability) {
+    // At the median time & location, all that is left of the situation variability is its direct part, sigma_S
+    const VariabilityCalculator variabilityCalculator = makeVariabilityCalculator(BroadcastMode + NoSituationVariability);
+    // (the deviate of 0.5 isn't exactly 0, so neither are the remaining terms)
+    EXPECT_NEAR(variabilityCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.5, 0.1),
+                variabilityCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.5, 0.9), 1.0e-4);
+
+    const VariabilityCalculator unflaggedCalculator = makeVariabilityCalculator(BroadcastMode);
+    EXPECT_GT(std::abs(unflaggedCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.5, 0.1) - unflaggedCalculator.calcVariabilityLoss_dB(20.0, 0.5, 0.5, 0.9)), 1.0);
+}
+
+TEST(VariabilityTests, MobileModeWithoutLocationVariabilityMatchesTestData) {
+    // The path of row 4 of testData/p2p.csv (mdvar 12 = mobile mode, location variability eliminated), from pfls.csv
+    std::ifstream inStream(NTIA_ITM_TEST_DATA_DIR "/pfls.csv");
+    std::string line;
+    for (int rowInd = 0; rowInd < 4; rowInd++) {
+        ASSERT_TRUE(std::getline(inStream, line));
+    }
+    std::istringstream lineStream(line);
+    std::vector<double> valueList;
+    std::string field;
+    while (std::getline(lineStream, field, ',')) {
+        valueList.push_back(std::stod(field));
+    }
+    ASSERT_GT(valueList.size(), 2u);
+    const std::vector<double> terrainHeightList_m(valueList.begin() + 2, valueList.end());
+
+    const auto calcLoss_dB = [&](const int varModeCode) {
+        const ItmCommonCalculator calculator(3.0, 5.0, ContinentalSubtropical, 301.0, 5600.0, true, 15.0, 0.008,
+                    static_cast<VariabilityMode>(varModeCode), 90.0, 30.0, 88.0);
+        ItmWorkspace workspace;
+        return calculator.calcItmLoss_P2P_dB(terrainHeightList_m, valueList[1], false, workspace).m_atten_dB;
+    };
+
+    // The expected loss of the row, to the 0.01 dB it is given to
+    EXPECT_NEAR(calcLoss_dB(MobileMode + NoLocationVariability), 183.26, 0.01);
+
+    // Mobile mode takes the time & location fractions together, so without the location spread the loss exceeded 90% of
+    // the time is lower
+    EXPECT_LT(calcLoss_dB(MobileMode + NoLocationVariability), calcLoss_dB(MobileMode) - 0.5);
+}
+
+TEST(VariabilityTests, QuantileListsMatchSingleQuantileEvaluations) {
+    const std::vector<double> fracList { 0.01, 0.1, 0.5, 0.9, 0.99 };
+    for (const int varModeCode : { SingleMessageMode, AccidentalMode, MobileMode, BroadcastMode }) {
+        const VariabilityCalculator variabilityCalculator = makeVariabilityCalculator(varModeCode);
+
+        std::vector<VariabilityQuantiles> quantilesList;
+        for (const double& timeFrac : fracList) {
+            for (const double& locationFrac : fracList) {
+                for (const double& situationFrac : fracList) {
+                    quantilesList.push_back(VariabilityQuantiles { timeFrac, locationFrac, situationFrac });
+                }
+            }
+        }
+        std::vector<double> lossList_dB(quantilesList.size());
+        variabilityCalculator.calcVariabilityLoss_TLS_dB(20.0, quantilesList, lossList_dB);
+        for (std::size_t quantilesInd = 0; quantilesInd < quantilesList.size(); quantilesInd++) {
+            const VariabilityQuantiles& quantiles = quantilesList[quantilesInd];
+            EXPECT_EQ(lossList_dB[quantilesInd], variabilityCalculator.calcVariabilityLoss_dB(20.0, quantiles.m_timeFrac,
+                        quantiles.m_locationFrac, quantiles.m_situationFrac)) << "varMode " << varModeCode << ", entry " << quantilesInd;
+        }
+
+        // Reliability sets the time & location fractions, confidence the situation fraction
+        std::vector<double> lossTable_dB(fracList.size() * fracList.size());
+        variabilityCalculator.calcVariabilityLoss_CR_dB(20.0, fracList, fracList, lossTable_dB);
+        for (std::size_t confInd = 0; confInd < fracList.size(); confInd++) {
+            for (std::size_t relInd = 0; relInd < fracList.size(); relInd++) {
+                EXPECT_EQ(lossTable_dB[confInd * fracList.size() + relInd], variabilityCalculator.calcVariabilityLoss_dB(20.0,
+                            fracList[relInd], fracList[relInd], fracList[confInd])) << "varMode " << varModeCode
+                            << ", confidence " << fracList[confInd] << ", reliability " << fracList[relInd];
+
+                // Callers may also bring their own deviates
+                const double reliabilityDeviate = MathHelpers::calcInvComplCumulDistribFunc(fracList[relInd]);
+                EXPECT_EQ(lossTable_dB[confInd * fracList.size() + relInd], variabilityCalculator.calcVariabilityLossFromDeviates_dB(20.0,
+                            reliabilityDeviate, reliabilityDeviate, MathHelpers::calcInvComplCumulDistribFunc(fracList[confInd])))
+                            << "varMode " << varModeCode << ", confidence " << fracList[confInd] << ", reliability " << fracList[relInd];
+            }
+        }
+    }
+}
+
+TEST(VariabilityTests, PathVariabilityMatchesFullEvaluationsAtOtherQuantiles) {
+    // One full evaluation at the medians gives everything needed to evaluate the path at any other quantiles
+    for (const std::size_t numPointsMinusTx : getTestProfileLengths()) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx);
+        ItmWorkspace workspace;
+        const ItmCommonCalculator medianCalculator(15.0, 3.0, Temperate, 301.0, 3500.0, false, 15.0, 0.005, BroadcastMode, 50.0, 50.0, 50.0);
+        const ItmResults medianResults = medianCalculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+        const VariabilityCalculator variabilityCalculator = medianCalculator.createVariabilityCalculator(medianResults);
+
+        for (const double& percent : { 1.0, 10.0, 50.0, 90.0, 99.0 }) {
+            const ItmCommonCalculator calculator(15.0, 3.0, Temperate, 301.0, 3500.0, false, 15.0, 0.005, BroadcastMode, percent, 100.0 - percent, percent);
+            const ItmResults results = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false, workspace);
+            EXPECT_DOUBLE_EQ(medianResults.m_intermResults.m_fsplAtten_dB + variabilityCalculator.calcVariabilityLoss_dB(
+                        medianResults.m_intermResults.m_refAtten_dB, percent / 100.0, 1.0 - percent / 100.0, percent / 100.0), results.m_atten_dB)
+                        << numPointsMinusTx << " points, " << percent << "%";
+        }
+    }
+}
+
+TEST(VariabilityTests, RejectsUnknownModes) {
+    for (const int varModeCode : { -1, 4, 14, 34 }) {
+        EXPECT_THROW(makeVariabilityCalculator(varModeCode), std::domain_error) << "varMode " << varModeCode;
+        EXPECT_THROW(ItmCommonCalculator(15.0, 3.0, Temperate, 301.0, 3500.0, false, 15.0, 0.005, static_cast<VariabilityMode>(varModeCode),
+                    50.0, 50.0, 50.0), std::domain_error) << "varMode " << varModeCode;
+    }
+}
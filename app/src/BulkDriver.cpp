@@ -0,0 +1,445 @@
+/// Bulk driver: evaluates every row of a p2p.csv or area.csv style parameter file (see testData), writing one result row each.
+///
+///     itm_bulk p2p <params.csv> <profiles.csv> <output.csv> [--threads N] [--rows-per-wave N] [--trace trace.json]
+///     itm_bulk area <params.csv> <output.csv> [--threads N] [--rows-per-wave N] [--trace trace.json]
+///
+/// Rows run through a three stage pipeline, a wave of rows at a time: while the thread pool parses & evaluates one wave,
+/// the next is read from disk and the previous one written out, so neither I/O stage holds up the computation.
+/// Output rows keep the order of the input: row, A__db, mode, then A_expected__db & A_diff__db when the input has an A__db
+/// column, and error (empty unless the row couldn't be evaluated; such rows don't stop the run).
+/// With --trace (library built with NTIA_ITM_ENABLE_TRACING), the stages of every row are written to a trace-event JSON
+/// file, each path tagged with its row number
+
+#include "CsvParsing.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmTrace.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/WorkStealingThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::App;
+
+namespace {
+    // Rows parsed & evaluated by one task; small enough for work stealing to even out long profiles
+    std::size_t constexpr kRowsPerTask { 64u };
+
+    // Default rows per wave for each worker thread
+    std::size_t constexpr kDefaultRowsPerWavePerThread { 1024u };
+
+    enum class DriverMode {
+        PointToPoint,
+        Area
+    };
+
+    /// @brief Columns of the parameter file
+    struct ParamColumns {
+        explicit ParamColumns(const CsvHeader& header, const std::string& filePath, const DriverMode mode) {
+            m_txHeight = header.getColumn("h_tx__meter", filePath);
+            m_rxHeight = header.getColumn("h_rx__meter", filePath);
+            m_relPermittivity = header.getColumn("epsilon", filePath);
+            m_conductivity = header.getColumn("sigma", filePath);
+            m_refractivity = header.getColumn("N_0", filePath);
+            m_freq = header.getColumn("f__mhz", filePath);
+            m_polarization = header.getColumn("pol", filePath);
+            m_climate = header.getColumn("climate", filePath);
+            m_timePercent = header.getColumn("time", filePath);
+            m_locationPercent = header.getColumn("location", filePath);
+            m_situationPercent = header.getColumn("situation", filePath);
+            m_varMode = header.getColumn("mdvar", filePath);
+            m_expectedAtten = header.findColumn("A__db");
+            if (mode == DriverMode::Area) {
+                m_terrainIrregularity = header.getColumn("delta_h__meter", filePath);
+                m_dist = header.getColumn("d__km", filePath);
+                m_txSitingCriteria = header.getColumn("tx_siting_criteria", filePath);
+                m_rxSitingCriteria = header.getColumn("rx_siting_criteria", filePath);
+            }
+        }
+
+        std::size_t m_txHeight, m_rxHeight, m_relPermittivity, m_conductivity, m_refractivity, m_freq, m_polarization, m_climate;
+        std::size_t m_timePercent, m_locationPercent, m_situationPercent, m_varMode, m_expectedAtten;
+        std::size_t m_terrainIrregularity = CsvHeader::kMissingColumn;
+        std::size_t m_dist = CsvHeader::kMissingColumn;
+        std::size_t m_txSitingCriteria = CsvHeader::kMissingColumn;
+        std::size_t m_rxSitingCriteria = CsvHeader::kMissingColumn;
+    };
+
+    /// @brief One wave of rows as it moves through the pipeline: raw lines, then formatted output
+    struct Wave {
+        std::size_t m_firstRowNum = 0u;                         // Number of the first row of the wave (1 = first row after the header)
+        std::string m_paramText;
+        std::vector<LineReader::LineBounds> m_paramLineList;
+        std::string m_profileText;
+        std::vector<LineReader::LineBounds> m_profileLineList;
+        std::vector<std::string> m_outputList;                  // Output text of each task
+
+        void clear(const std::size_t firstRowNum) {
+            m_firstRowNum = firstRowNum;
+            m_paramText.clear();
+            m_paramLineList.clear();
+            m_profileText.clear();
+            m_profileLineList.clear();
+        }
+
+        std::size_t getNumRows() const {
+            return m_paramLineList.size();
+        }
+
+        std::string_view getParamLine(const std::size_t rowInd) const {
+            const LineReader::LineBounds& bounds = m_paramLineList[rowInd];
+            return std::string_view(m_paramText).substr(bounds.m_startInd, bounds.m_endInd - bounds.m_startInd);
+        }
+
+        std::string_view getProfileLine(const std::size_t rowInd) const {
+            const LineReader::LineBounds& bounds = m_profileLineList[rowInd];
+            return std::string_view(m_profileText).substr(bounds.m_startInd, bounds.m_endInd - bounds.m_startInd);
+        }
+    };
+
+    /// @brief Working state of one worker thread, reused from one row to the next
+    struct WorkerScratch {
+        std::vector<std::string_view> m_paramFieldList;
+        std::vector<std::string_view> m_profileFieldList;
+        std::vector<double> m_terrainHeightList_m;
+        ItmWorkspace m_workspace;
+    };
+
+    double readNumber(const std::vector<std::string_view>& fieldList, const std::size_t columnInd, const char* name) {
+        double value;
+        if (columnInd >= fieldList.size() || !parseDouble(fieldList[columnInd], value)) {
+            throw std::runtime_error(std::string("bad or missing ") + name);
+        }
+        return value;
+    }
+
+    int readCode(const std::vector<std::string_view>& fieldList, const std::size_t columnInd, const char* name,
+                const int minValue, const int maxValue) {
+        int value;
+        if (columnInd >= fieldList.size() || !parseInt(fieldList[columnInd], minValue, maxValue, value)) {
+            std::ostringstream oStrStream;
+            oStrStream << "bad or missing " << name << " (expected an integer in [" << minValue << ", " << maxValue << "])";
+            throw std::runtime_error(oStrStream.str());
+        }
+        return value;
+    }
+
+    /// @brief Calculator configured with the parameters of one row (validated, so out of range rows throw)
+    ItmCommonCalculator makeCalculator(const std::vector<std::string_view>& fieldList, const ParamColumns& columns) {
+        // mdvar may carry +10 / +20 flags eliminating location / situation variability, handed on with the mode
+        const int varMode = readCode(fieldList, columns.m_varMode, "mdvar", 0, 33);
+        if (varMode % 10 > BroadcastMode) {
+            throw std::runtime_error("bad mdvar (mode must be 0 - 3, plus 10 and/or 20)");
+        }
+
+        return ItmCommonCalculator(readNumber(fieldList, columns.m_txHeight, "h_tx__meter"),
+                    readNumber(fieldList, columns.m_rxHeight, "h_rx__meter"),
+                    static_cast<RadioClimate>(readCode(fieldList, columns.m_climate, "climate", 1, 7) - 1),
+                    readNumber(fieldList, columns.m_refractivity, "N_0"),
+                    readNumber(fieldList, columns.m_freq, "f__mhz"),
+                    readCode(fieldList, columns.m_polarization, "pol", 0, 1) == 0,
+                    readNumber(fieldList, columns.m_relPermittivity, "epsilon"),
+                    readNumber(fieldList, columns.m_conductivity, "sigma"),
+                    static_cast<VariabilityMode>(varMode),
+                    readNumber(fieldList, columns.m_timePercent, "time"),
+                    readNumber(fieldList, columns.m_locationPercent, "location"),
+                    readNumber(fieldList, columns.m_situationPercent, "situation"));
+    }
+
+    /// @brief Evaluate one row
+    /// @param paramFieldList Fields of the row's parameter line
+    /// @param profileLine Row's profile line (point-to-point mode only)
+    ItmLossResult evaluateRow(const std::vector<std::string_view>& paramFieldList, std::string_view profileLine, const DriverMode mode,
+                const ParamColumns& columns, WorkerScratch& scratch) {
+        ItmCommonCalculator calculator = makeCalculator(paramFieldList, columns);
+
+        if (mode == DriverMode::Area) {
+            const ItmResults itmResults = calculator.calcItmLoss_area_dB(
+                        static_cast<SitingCriteria>(readCode(paramFieldList, columns.m_txSitingCriteria, "tx_siting_criteria", 0, 2)),
+                        static_cast<SitingCriteria>(readCode(paramFieldList, columns.m_rxSitingCriteria, "rx_siting_criteria", 0, 2)),
+                        readNumber(paramFieldList, columns.m_dist, "d__km"),
+                        readNumber(paramFieldList, columns.m_terrainIrregularity, "delta_h__meter"));
+            return ItmLossResult { itmResults.m_atten_dB, itmResults.m_intermResults.m_propMode };
+        }
+
+        // Profile row: number of points not counting the Tx, resolution (meters), then the heights
+        std::vector<std::string_view>& profileFieldList = scratch.m_profileFieldList;
+        splitFields(profileLine, profileFieldList);
+        double numPointsMinusTx;
+        double sampleResolution_m;
+        if (profileFieldList.size() < 4u || !parseDouble(profileFieldList[0], numPointsMinusTx)
+                    || !parseDouble(profileFieldList[1], sampleResolution_m)
+                    || numPointsMinusTx + 3.0 != static_cast<double>(profileFieldList.size())) {
+            throw std::runtime_error("profile point count doesn't match the number of heights");
+        }
+        scratch.m_terrainHeightList_m.resize(profileFieldList.size() - 2u);
+        for (std::size_t pointInd = 0; pointInd < scratch.m_terrainHeightList_m.size(); pointInd++) {
+            if (!parseDouble(profileFieldList[pointInd + 2u], scratch.m_terrainHeightList_m[pointInd])) {
+                throw std::runtime_error("bad profile height at point " + std::to_string(pointInd));
+            }
+        }
+
+        // Only the loss & mode are written out, so none of the intermediate values are kept
+        return calculator.calcItmLoss_P2P_dB(scratch.m_terrainHeightList_m, sampleResolution_m, LossAndMode, scratch.m_workspace);
+    }
+
+    /// @brief Parse, evaluate & format one task's rows of a wave
+    /// @return Number of rows which couldn't be evaluated
+    std::size_t runTask(Wave& wave, const std::size_t taskInd, const DriverMode mode, const ParamColumns& columns,
+                WorkerScratch& scratch) {
+        const std::size_t startRowInd = taskInd * kRowsPerTask;
+        const std::size_t endRowInd = std::min(startRowInd + kRowsPerTask, wave.getNumRows());
+        const bool hasExpectedAtten = (columns.m_expectedAtten != CsvHeader::kMissingColumn);
+
+        std::string& output = wave.m_outputList[taskInd];
+        output.clear();
+        std::size_t numErrors = 0u;
+        for (std::size_t rowInd = startRowInd; rowInd < endRowInd; rowInd++) {
+            splitFields(wave.getParamLine(rowInd), scratch.m_paramFieldList);
+
+            std::optional<ItmLossResult> lossResult;
+            std::string errorMessage;
+            try {
+                const ItmTrace::PathIdScope pathIdScope(wave.m_firstRowNum + rowInd);
+                lossResult = evaluateRow(scratch.m_paramFieldList, (mode == DriverMode::PointToPoint) ? wave.getProfileLine(rowInd) : std::string_view(),
+                            mode, columns, scratch);
+            }
+            catch (const std::exception& error) {
+                errorMessage = error.what();
+                numErrors++;
+            }
+
+            output.append(std::to_string(wave.m_firstRowNum + rowInd));
+            output.push_back(',');
+            if (lossResult.has_value()) {
+                appendDouble(output, lossResult->m_atten_dB);
+                output.push_back(',');
+                output.append(std::to_string(static_cast<int>(lossResult->m_propMode)));
+            }
+            else {
+                output.push_back(',');
+            }
+            if (hasExpectedAtten) {
+                double expectedAtten_dB;
+                output.push_back(',');
+                if (columns.m_expectedAtten < scratch.m_paramFieldList.size()
+                            && parseDouble(scratch.m_paramFieldList[columns.m_expectedAtten], expectedAtten_dB)) {
+                    appendDouble(output, expectedAtten_dB);
+                    output.push_back(',');
+                    if (lossResult.has_value()) {
+                        appendDouble(output, lossResult->m_atten_dB - expectedAtten_dB);
+                    }
+                }
+                else {
+                    output.push_back(',');
+                }
+            }
+            output.push_back(',');
+            if (!errorMessage.empty()) {
+                appendQuotedField(output, errorMessage);
+            }
+            output.push_back('\n');
+        }
+        return numErrors;
+    }
+
+    struct DriverOptions {
+        DriverMode m_mode = DriverMode::PointToPoint;
+        std::string m_paramFilePath;
+        std::string m_profileFilePath;
+        std::string m_outputFilePath;
+        std::size_t m_numThreads = 0u;
+        std::size_t m_rowsPerWave = 0u;
+        std::string m_traceFilePath;
+    };
+
+    void printUsage() {
+        std::cerr << "Usage:\n"
+                    << "    itm_bulk p2p <params.csv> <profiles.csv> <output.csv> [--threads N] [--rows-per-wave N] [--trace trace.json]\n"
+                    << "    itm_bulk area <params.csv> <output.csv> [--threads N] [--rows-per-wave N] [--trace trace.json]\n"
+                    << "Parameter & profile files are in the format of testData/p2p.csv, pfls.csv & area.csv (one profile row per\n"
+                    << "parameter row).\n";
+    }
+
+    bool parseOptions(const int argc, char* argv[], DriverOptions& options) {
+        std::vector<std::string> positionalList;
+        for (int argInd = 1; argInd < argc; argInd++) {
+            const std::string arg = argv[argInd];
+            if ((arg == "--threads" || arg == "--rows-per-wave") && argInd + 1 < argc) {
+                const long value = std::strtol(argv[++argInd], nullptr, 10);
+                if (value < 0) {
+                    return false;
+                }
+                (arg == "--threads" ? options.m_numThreads : options.m_rowsPerWave) = static_cast<std::size_t>(value);
+            }
+            else if (arg == "--trace" && argInd + 1 < argc) {
+                options.m_traceFilePath = argv[++argInd];
+            }
+            else if (!arg.empty() && arg[0] == '-') {
+                return false;
+            }
+            else {
+                positionalList.push_back(arg);
+            }
+        }
+
+        if (positionalList.size() == 4u && positionalList[0] == "p2p") {
+            options.m_mode = DriverMode::PointToPoint;
+            options.m_paramFilePath = positionalList[1];
+            options.m_profileFilePath = positionalList[2];
+            options.m_outputFilePath = positionalList[3];
+            return true;
+        }
+        if (positionalList.size() == 3u && positionalList[0] == "area") {
+            options.m_mode = DriverMode::Area;
+            options.m_paramFilePath = positionalList[1];
+            options.m_outputFilePath = positionalList[2];
+            return true;
+        }
+        return false;
+    }
+
+    std::size_t runDriver(const DriverOptions& options) {
+        LineReader paramReader(options.m_paramFilePath);
+        std::optional<LineReader> profileReader;
+        if (options.m_mode == DriverMode::PointToPoint) {
+            profileReader.emplace(options.m_profileFilePath);
+        }
+
+        std::string headerText;
+        std::vector<LineReader::LineBounds> headerBoundsList;
+        if (paramReader.readLines(1u, headerText, headerBoundsList) == 0u) {
+            throw std::runtime_error("ERROR: " + options.m_paramFilePath + " is empty");
+        }
+        const ParamColumns columns(CsvHeader(headerText), options.m_paramFilePath, options.m_mode);
+
+        std::ofstream outStream(options.m_outputFilePath, std::ios::binary | std::ios::trunc);
+        if (!outStream) {
+            throw std::runtime_error("ERROR: Unable to open " + options.m_outputFilePath + " for writing");
+        }
+        outStream << ((columns.m_expectedAtten != CsvHeader::kMissingColumn) ? "row,A__db,mode,A_expected__db,A_diff__db,error\n"
+                    : "row,A__db,mode,error\n");
+
+        WorkStealingThreadPool threadPool(options.m_numThreads);
+        std::vector<WorkerScratch> scratchList(threadPool.getNumThreads());
+        const std::size_t rowsPerWave = (options.m_rowsPerWave > 0u) ? options.m_rowsPerWave
+                    : kDefaultRowsPerWavePerThread * threadPool.getNumThreads();
+
+        // Stage 1: read the raw lines of a wave (parsing is left to the workers)
+        const auto readWave = [&](Wave& wave, const std::size_t firstRowNum) {
+            wave.clear(firstRowNum);
+            paramReader.readLines(rowsPerWave, wave.m_paramText, wave.m_paramLineList);
+            if (profileReader.has_value()) {
+                profileReader->readLines(wave.getNumRows(), wave.m_profileText, wave.m_profileLineList);
+                if (wave.m_profileLineList.size() != wave.getNumRows()) {
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: " << profileReader->getFilePath() << " has fewer profile rows than "
+                                << options.m_paramFilePath << " has parameter rows (" << firstRowNum + wave.m_profileLineList.size() - 1u << ")";
+                    throw std::runtime_error(oStrStream.str());
+                }
+            }
+        };
+
+        // Stage 3: write a wave's output, in task order
+        const auto writeWave = [&](const Wave& wave) {
+            const std::size_t numTasks = (wave.getNumRows() + kRowsPerTask - 1u) / kRowsPerTask;
+            for (std::size_t taskInd = 0; taskInd < numTasks; taskInd++) {
+                outStream.write(wave.m_outputList[taskInd].data(), static_cast<std::streamsize>(wave.m_outputList[taskInd].size()));
+            }
+            if (!outStream) {
+                throw std::runtime_error("ERROR: Unable to write " + options.m_outputFilePath);
+            }
+        };
+
+        // Three waves in rotation: one being read, one evaluated, one written. Should a stage throw, the pending futures
+        // are waited on as they go out of scope, before the waves & output stream they use
+        std::array<Wave, 3> waveList;
+        std::size_t waveInd = 0u;
+        std::size_t numRows = 0u;
+        std::size_t numErrors = 0u;
+        std::future<void> writeFuture;
+
+        readWave(waveList[0], 1u);
+        while (waveList[waveInd].getNumRows() > 0u) {
+            Wave& wave = waveList[waveInd];
+            Wave& nextWave = waveList[(waveInd + 1u) % 3u];
+            std::future<void> readFuture = std::async(std::launch::async, readWave, std::ref(nextWave), wave.m_firstRowNum + wave.getNumRows());
+
+            // Stage 2: parse & evaluate on the thread pool
+            const std::size_t numTasks = (wave.getNumRows() + kRowsPerTask - 1u) / kRowsPerTask;
+            if (wave.m_outputList.size() < numTasks) {
+                wave.m_outputList.resize(numTasks);
+            }
+            std::vector<std::size_t> taskErrorCountList(numTasks, 0u);
+            threadPool.run(numTasks, [&](const std::size_t taskInd, const std::size_t threadInd) {
+                taskErrorCountList[taskInd] = runTask(wave, taskInd, options.m_mode, columns, scratchList[threadInd]);
+            });
+            numRows += wave.getNumRows();
+            for (const std::size_t taskErrorCount : taskErrorCountList) {
+                numErrors += taskErrorCount;
+            }
+
+            // The previous wave must be written before this one, and before its buffers come round to be read into again
+            if (writeFuture.valid()) {
+                writeFuture.get();
+            }
+            writeFuture = std::async(std::launch::async, writeWave, std::cref(wave));
+            readFuture.get();
+            waveInd = (waveInd + 1u) % 3u;
+        }
+        if (writeFuture.valid()) {
+            writeFuture.get();
+        }
+        outStream.flush();
+
+        std::cerr << numRows << " rows evaluated, " << numErrors << " with errors\n";
+        return numErrors;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    DriverOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    if (!options.m_traceFilePath.empty() && !ItmTrace::kIsEnabled) {
+        std::cerr << "--trace needs the library built with NTIA_ITM_ENABLE_TRACING\n";
+        return 2;
+    }
+
+    try {
+        const auto startTime = std::chrono::steady_clock::now();
+        if (!options.m_traceFilePath.empty()) {
+            ItmTrace::start();
+        }
+        const std::size_t numErrors = runDriver(options);
+        const double elapsed_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        std::cerr << "Elapsed: " << elapsed_s << " s\n";
+        if (!options.m_traceFilePath.empty()) {
+            ItmTrace::stop();
+            ItmTrace::writeTraceJson(options.m_traceFilePath);
+        }
+        return (numErrors > 0u) ? 1 : 0;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 2;
+    }
+}
@@ -0,0 +1,158 @@
+#include "CsvParsing.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace NTIA::ITM::App {
+    namespace {
+        // Initial size of a line reader's buffer (grown if a single line is longer)
+        std::size_t constexpr kReadBufferSize_bytes { std::size_t{1u} << 20u };
+
+        std::string_view trimBlanks(std::string_view text) {
+            while (!text.empty() && (text.front() == ' ' || text.front() == '\t')) {
+                text.remove_prefix(1u);
+            }
+            while (!text.empty() && (text.back() == ' ' || text.back() == '\t' || text.back() == '\r')) {
+                text.remove_suffix(1u);
+            }
+            return text;
+        }
+    }
+
+    LineReader::LineReader(const std::string& filePath)
+                : m_filePath(filePath), m_inStream(filePath, std::ios::binary), m_buffer(kReadBufferSize_bytes),
+                m_bufferStartInd(0u), m_bufferEndInd(0u) {
+        if (!m_inStream) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: LineReader::LineReader(): Unable to open " << filePath;
+            throw std::runtime_error(oStrStream.str());
+        }
+    }
+
+    bool LineReader::refillBuffer() {
+        if (!m_inStream) {
+            return false;
+        }
+
+        const std::size_t numUnreadBytes = m_bufferEndInd - m_bufferStartInd;
+        if (numUnreadBytes == m_buffer.size()) {
+            // A single line fills the whole buffer
+            m_buffer.resize(2u * m_buffer.size());
+        }
+        std::memmove(m_buffer.data(), m_buffer.data() + m_bufferStartInd, numUnreadBytes);
+        m_bufferStartInd = 0u;
+        m_bufferEndInd = numUnreadBytes;
+
+        m_inStream.read(m_buffer.data() + m_bufferEndInd, static_cast<std::streamsize>(m_buffer.size() - m_bufferEndInd));
+        const std::size_t numReadBytes = static_cast<std::size_t>(m_inStream.gcount());
+        m_bufferEndInd += numReadBytes;
+        return numReadBytes > 0u;
+    }
+
+    std::size_t LineReader::readLines(const std::size_t maxNumLines, std::string& text, std::vector<LineBounds>& lineBoundsList) {
+        std::size_t numLines = 0u;
+        while (numLines < maxNumLines) {
+            const char* bufferStart = m_buffer.data() + m_bufferStartInd;
+            const char* lineEnd = static_cast<const char*>(std::memchr(bufferStart, '\n', m_bufferEndInd - m_bufferStartInd));
+
+            std::string_view line;
+            if (lineEnd != nullptr) {
+                line = std::string_view(bufferStart, static_cast<std::size_t>(lineEnd - bufferStart));
+                m_bufferStartInd += line.size() + 1u;
+            }
+            else if (refillBuffer()) {
+                continue;
+            }
+            else if (m_bufferStartInd < m_bufferEndInd) {
+                // Last line, with no newline after it
+                line = std::string_view(m_buffer.data() + m_bufferStartInd, m_bufferEndInd - m_bufferStartInd);
+                m_bufferStartInd = m_bufferEndInd;
+            }
+            else {
+                break;
+            }
+
+            line = trimBlanks(line);
+            if (line.empty()) {
+                continue;
+            }
+            lineBoundsList.push_back({ text.size(), text.size() + line.size() });
+            text.append(line);
+            numLines++;
+        }
+        return numLines;
+    }
+
+    void splitFields(std::string_view line, std::vector<std::string_view>& fieldList) {
+        fieldList.clear();
+        while (true) {
+            const std::size_t commaInd = line.find(',');
+            fieldList.push_back(trimBlanks(line.substr(0u, commaInd)));
+            if (commaInd == std::string_view::npos) {
+                return;
+            }
+            line.remove_prefix(commaInd + 1u);
+        }
+    }
+
+    bool parseDouble(std::string_view field, double& value) {
+        // from_chars takes no leading '+', which some writers emit
+        if (!field.empty() && field.front() == '+') {
+            field.remove_prefix(1u);
+        }
+        const std::from_chars_result result = std::from_chars(field.data(), field.data() + field.size(), value);
+        return result.ec == std::errc() && result.ptr == field.data() + field.size();
+    }
+
+    bool parseInt(std::string_view field, const int minValue, const int maxValue, int& value) {
+        // Integers are parsed as numbers, so that "5.0" (as some tools write them) is taken too
+        double number;
+        if (!parseDouble(field, number) || number != std::floor(number) || number < minValue || number > maxValue) {
+            return false;
+        }
+        value = static_cast<int>(number);
+        return true;
+    }
+
+    void appendDouble(std::string& text, const double& value) {
+        char buffer[32];
+        const std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        text.append(buffer, result.ptr);
+    }
+
+    void appendQuotedField(std::string& text, std::string_view field) {
+        text.push_back('"');
+        for (const char fieldChar : field) {
+            if (fieldChar == '"') {
+                text.push_back('"');
+            }
+            text.push_back((fieldChar == '\n' || fieldChar == '\r') ? ' ' : fieldChar);
+        }
+        text.push_back('"');
+    }
+
+    CsvHeader::CsvHeader(std::string_view line) {
+        std::vector<std::string_view> fieldList;
+        splitFields(line, fieldList);
+        m_nameList.assign(fieldList.begin(), fieldList.end());
+    }
+
+    std::size_t CsvHeader::findColumn(std::string_view name) const {
+        const auto nameIter = std::find(m_nameList.begin(), m_nameList.end(), name);
+        return (nameIter != m_nameList.end()) ? static_cast<std::size_t>(nameIter - m_nameList.begin()) : kMissingColumn;
+    }
+
+    std::size_t CsvHeader::getColumn(std::string_view name, const std::string& filePath) const {
+        const std::size_t columnInd = findColumn(name);
+        if (columnInd == kMissingColumn) {
+            std::ostringstream oStrStream;
+            oStrStream << "ERROR: CsvHeader::getColumn(): " << filePath << " has no " << name << " column";
+            throw std::runtime_error(oStrStream.str());
+        }
+        return columnInd;
+    }
+} // end namespace
@@ -0,0 +1,88 @@
+#ifndef ITM_APP_CSV_PARSING_H
+#define ITM_APP_CSV_PARSING_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace NTIA::ITM::App {
+    /// @brief Lines of a text file read a block at a time, for splitting large inputs into chunks of rows without parsing them.
+    /// Blank lines are skipped and trailing carriage returns dropped, so both LF & CRLF files read the same
+    class LineReader {
+    public:
+        /// @brief Bounds [m_startInd, m_endInd) of one line within the text it was appended to
+        struct LineBounds {
+            std::size_t m_startInd;
+            std::size_t m_endInd;
+        };
+
+        /// @param filePath Path of the file to read
+        explicit LineReader(const std::string& filePath);
+
+        /// @brief Read the next lines of the file
+        /// @param maxNumLines Largest number of lines to read
+        /// @param text Text the lines are appended to
+        /// @param lineBoundsList List the bounds of each line within text are appended to
+        /// @return Number of lines read (0 once the file is exhausted)
+        std::size_t readLines(const std::size_t maxNumLines, std::string& text, std::vector<LineBounds>& lineBoundsList);
+
+        /// @return Path of the file being read
+        const std::string& getFilePath() const {
+            return m_filePath;
+        }
+
+    private:
+        /// @brief Move the unread part of the buffer to its start and top it up from the file
+        /// @return Whether any more bytes were read
+        bool refillBuffer();
+
+        std::string m_filePath;
+        std::ifstream m_inStream;
+        std::vector<char> m_buffer;
+        std::size_t m_bufferStartInd;       // First unread byte of the buffer
+        std::size_t m_bufferEndInd;         // End of the valid bytes of the buffer
+    };
+
+    /// @brief Split a line into comma separated fields (no quoting), each trimmed of surrounding blanks
+    /// @param line Line to split
+    /// @param fieldList Output fields, viewing the line (cleared first)
+    void splitFields(std::string_view line, std::vector<std::string_view>& fieldList);
+
+    /// @brief Parse a whole field as a number, with std::from_chars (locale independent, no allocation)
+    /// @param field Field to parse
+    /// @param value Output value
+    /// @return Whether the field held a number and nothing else
+    bool parseDouble(std::string_view field, double& value);
+
+    /// @brief Parse a whole field as an integer in [minValue, maxValue]
+    /// @return Whether the field held such an integer and nothing else
+    bool parseInt(std::string_view field, const int minValue, const int maxValue, int& value);
+
+    /// @brief Append a number in its shortest form that reads back exactly, with std::to_chars
+    void appendDouble(std::string& text, const double& value);
+
+    /// @brief Append a field quoted as CSV, so that commas & quotes within it survive
+    void appendQuotedField(std::string& text, std::string_view field);
+
+    /// @brief Column of each name in a header line
+    class CsvHeader {
+    public:
+        /// @param line Header line
+        explicit CsvHeader(std::string_view line);
+
+        /// @return Column of the field with the given name, or kMissingColumn if there is none
+        std::size_t findColumn(std::string_view name) const;
+
+        /// @return Column of the field with the given name, throwing std::runtime_error (naming the file) if there is none
+        std::size_t getColumn(std::string_view name, const std::string& filePath) const;
+
+        static constexpr std::size_t kMissingColumn = static_cast<std::size_t>(-1);
+
+    private:
+        std::vector<std::string> m_nameList;
+    };
+} // end namespace
+
+#endif // ITM_APP_CSV_PARSING_H
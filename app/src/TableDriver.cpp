@@ -0,0 +1,625 @@
+/// Table driver: expands an input file in the format of cmd_examples/i_*.txt into its full table of results, written in
+/// the layout of the reference driver's outputs (cmd_examples/o_*.txt).
+///
+///     itm_table -i <input.txt> [-t <terrain.txt>] -o <output.txt> -mode p2p|area [-dbg] [--threads N]
+///
+/// Inputs are "name,value[,value...]" lines. In area mode d__km may describe a sweep, a start then (end, step) pairs:
+/// "10,100,10,1000,100" runs 10 - 100 km every 10 km, then 200 - 1000 km every 100 km. Confidence & reliability may each
+/// list several values, which are crossed into a table. Whatever the rows share is prepared once (the area mode reference
+/// attenuation curve over the whole sweep, or the point-to-point path), then the rows are evaluated on a thread pool.
+/// Errors surface as exceptions rather than ITM return codes / warning flags, so the output holds no warning flags line
+
+#include "CsvParsing.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmHelpers.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/ReferenceAttenuationCurve.h>
+#include <ITM/VariabilityCalculator.h>
+#include <ITM/WorkStealingThreadPool.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <ctime>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::App;
+
+namespace {
+    // Table rows evaluated by one task
+    std::size_t constexpr kRowsPerTask { 16u };
+
+    // Longest distance sweep expanded (guards against a step far smaller than its range)
+    std::size_t constexpr kMaxNumDists { std::size_t{1u} << 24u };
+
+    // Widths of the name & value columns of the output
+    int constexpr kNameWidth { 25 };
+    int constexpr kValueWidth { 13 };
+
+    // Widths of the first & remaining columns of the area & point-to-point tables
+    int constexpr kAreaKeyWidth { 13 };
+    int constexpr kP2PKeyWidth { 15 };
+    int constexpr kTableValueWidth { 10 };
+
+    std::array<const char*, 3> constexpr kSitingCriteriaNameList { "Random", "Careful", "Very Careful" };
+    std::array<const char*, 7> constexpr kClimateNameList { "Equatorial", "Continental Subtropical", "Maritime Subtropical",
+                "Desert", "Continental Temperate", "Maritime Temperate Over Land", "Maritime Temperate Over Sea" };
+    std::array<const char*, 2> constexpr kPolarizationNameList { "Horizontal", "Vertical" };
+    std::array<const char*, 4> constexpr kVarModeNameList { "Single Message Mode", "Accidental Mode", "Mobile Mode", "Broadcast Mode" };
+    std::array<const char*, 4> constexpr kPropModeNameList { "Not Set", "Line of Sight", "Diffraction", "Troposcatter" };
+
+    enum class DriverMode {
+        PointToPoint,
+        Area
+    };
+
+    /// @brief One line of the input file: its values, and their text as given (echoed to the output)
+    struct InputParam {
+        std::string m_text;
+        std::vector<double> m_valueList;
+    };
+
+    /// @brief Parameters of the input file, by name
+    class InputParamMap {
+    public:
+        explicit InputParamMap(const std::string& filePath) : m_filePath(filePath) {
+            LineReader reader(filePath);
+            std::string text;
+            std::vector<LineReader::LineBounds> lineBoundsList;
+            reader.readLines(std::numeric_limits<std::size_t>::max(), text, lineBoundsList);
+
+            std::vector<std::string_view> fieldList;
+            for (const LineReader::LineBounds& bounds : lineBoundsList) {
+                const std::string_view line = std::string_view(text).substr(bounds.m_startInd, bounds.m_endInd - bounds.m_startInd);
+                splitFields(line, fieldList);
+
+                InputParam param;
+                param.m_text = line.substr(std::min(line.find(',') + 1u, line.size()));
+                param.m_valueList.resize(fieldList.size() - 1u);
+                bool isValid = (fieldList.size() > 1u);
+                for (std::size_t valueInd = 0; isValid && valueInd < param.m_valueList.size(); valueInd++) {
+                    isValid = parseDouble(fieldList[valueInd + 1u], param.m_valueList[valueInd]);
+                }
+                if (!isValid) {
+                    std::ostringstream oStrStream;
+                    oStrStream << "ERROR: " << filePath << ": expected name,value[,value...] (line \"" << line << "\")";
+                    throw std::runtime_error(oStrStream.str());
+                }
+                m_paramMap[std::string(fieldList[0])] = std::move(param);
+            }
+        }
+
+        bool has(const std::string& name) const {
+            return m_paramMap.count(name) > 0u;
+        }
+
+        /// @return Parameter of the given name, throwing std::runtime_error if the file has none
+        const InputParam& get(const std::string& name) const {
+            const auto paramIter = m_paramMap.find(name);
+            if (paramIter == m_paramMap.end()) {
+                throw std::runtime_error("ERROR: " + m_filePath + " has no " + name + " value");
+            }
+            return paramIter->second;
+        }
+
+        /// @return Value of a parameter taking one value only
+        double getValue(const std::string& name) const {
+            const InputParam& param = get(name);
+            if (param.m_valueList.size() != 1u) {
+                throw std::runtime_error("ERROR: " + m_filePath + ": " + name + " takes a single value");
+            }
+            return param.m_valueList[0];
+        }
+
+        /// @return Value of a parameter taking one integer code in [minValue, maxValue]
+        int getCode(const std::string& name, const int minValue, const int maxValue) const {
+            const double value = getValue(name);
+            if (value != std::floor(value) || value < minValue || value > maxValue) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: " << m_filePath << ": expected " << name << " to be an integer in [" << minValue << ", " << maxValue << "]";
+                throw std::runtime_error(oStrStream.str());
+            }
+            return static_cast<int>(value);
+        }
+
+    private:
+        std::string m_filePath;
+        std::map<std::string, InputParam> m_paramMap;
+    };
+
+    struct DriverOptions {
+        DriverMode m_mode = DriverMode::PointToPoint;
+        std::string m_inputFilePath;
+        std::string m_terrainFilePath;
+        std::string m_outputFilePath;
+        std::string m_argText;                  // Arguments as given, echoed to the output
+        bool m_writeIntermValues = false;
+        std::size_t m_numThreads = 0u;
+    };
+
+    /// @brief Variability requested by the input file: confidence/reliability (CR) lists, or one set of time/location/situation (TLS)
+    struct VariabilityInputs {
+        bool m_isConfRel = false;
+        std::vector<double> m_confidenceList;
+        std::vector<double> m_reliabilityList;
+        std::vector<double> m_confidenceFracList;
+        std::vector<double> m_reliabilityFracList;
+        double m_timePercent = 50.0;
+        double m_locationPercent = 50.0;
+        double m_situationPercent = 50.0;
+
+        explicit VariabilityInputs(const InputParamMap& inputs) {
+            m_isConfRel = inputs.has("confidence") || inputs.has("reliability");
+            if (!m_isConfRel) {
+                m_timePercent = inputs.getValue("time");
+                m_locationPercent = inputs.getValue("location");
+                m_situationPercent = inputs.getValue("situation");
+                return;
+            }
+
+            m_confidenceList = inputs.get("confidence").m_valueList;
+            m_reliabilityList = inputs.get("reliability").m_valueList;
+            for (const double& confidence : m_confidenceList) {
+                m_confidenceFracList.push_back(confidence / 100.0);
+            }
+            for (const double& reliability : m_reliabilityList) {
+                m_reliabilityFracList.push_back(reliability / 100.0);
+            }
+            for (const double& percent : m_confidenceList) {
+                checkPercent(percent, "confidence");
+            }
+            for (const double& percent : m_reliabilityList) {
+                checkPercent(percent, "reliability");
+            }
+        }
+
+        /// @return Number of losses in each row of the table
+        std::size_t getNumLosses() const {
+            return m_isConfRel ? m_confidenceList.size() * m_reliabilityList.size() : 1u;
+        }
+
+    private:
+        static void checkPercent(const double& percent, const char* name) {
+            if (percent <= 0.0 || percent >= 100.0) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: VariabilityInputs::VariabilityInputs(): Expected 0 < " << name << " < 100 (" << name << " = " << percent << ")";
+                throw std::domain_error(oStrStream.str());
+            }
+        }
+    };
+
+    /// @brief Distances of a d__km sweep: a start, then (end, step) pairs, each run continuing from the end of the last
+    std::vector<double> expandDistSweep_km(const std::vector<double>& sweepList_km) {
+        if (sweepList_km.size() % 2u != 1u) {
+            throw std::runtime_error("ERROR: expected d__km to hold a start, then (end, step) pairs");
+        }
+
+        std::vector<double> distList_km { sweepList_km[0] };
+        for (std::size_t pairInd = 1; pairInd < sweepList_km.size(); pairInd += 2u) {
+            const double startDist_km = distList_km.back();
+            const double& endDist_km = sweepList_km[pairInd];
+            const double& step_km = sweepList_km[pairInd + 1u];
+            if (step_km <= 0.0 || endDist_km < startDist_km || (endDist_km - startDist_km) / step_km > kMaxNumDists) {
+                std::ostringstream oStrStream;
+                oStrStream << "ERROR: expected each d__km (end, step) pair to run forward by a positive step (end = " << endDist_km
+                            << ", step = " << step_km << ")";
+                throw std::runtime_error(oStrStream.str());
+            }
+
+            // Steps are counted rather than accumulated, so that a sweep lands on its end distance exactly
+            const std::size_t numSteps = static_cast<std::size_t>(std::floor((endDist_km - startDist_km) / step_km + 1.0e-9));
+            for (std::size_t stepInd = 1; stepInd <= numSteps; stepInd++) {
+                distList_km.push_back(startDist_km + stepInd * step_km);
+            }
+        }
+        return distList_km;
+    }
+
+    /// @brief Terrain file in the format of cmd_examples/pfl.txt: number of points not counting the Tx, resolution (meters),
+    /// then the heights (meters), separated by commas and/or line breaks
+    void readTerrainFile(const std::string& filePath, std::vector<double>& terrainHeightList_m, double& sampleResolution_m) {
+        LineReader reader(filePath);
+        std::string text;
+        std::vector<LineReader::LineBounds> lineBoundsList;
+        reader.readLines(std::numeric_limits<std::size_t>::max(), text, lineBoundsList);
+
+        std::vector<double> valueList;
+        std::vector<std::string_view> fieldList;
+        for (const LineReader::LineBounds& bounds : lineBoundsList) {
+            splitFields(std::string_view(text).substr(bounds.m_startInd, bounds.m_endInd - bounds.m_startInd), fieldList);
+            for (const std::string_view& field : fieldList) {
+                double value;
+                if (field.empty()) {
+                    continue;
+                }
+                if (!parseDouble(field, value)) {
+                    throw std::runtime_error("ERROR: " + filePath + ": bad terrain value \"" + std::string(field) + "\"");
+                }
+                valueList.push_back(value);
+            }
+        }
+
+        if (valueList.size() < 4u || valueList[0] + 3.0 != static_cast<double>(valueList.size())) {
+            throw std::runtime_error("ERROR: " + filePath + ": profile point count doesn't match the number of heights");
+        }
+        sampleResolution_m = valueList[1];
+        terrainHeightList_m.assign(valueList.begin() + 2, valueList.end());
+    }
+
+    /// @brief Calculator configured with the inputs (validated, so out of range inputs throw)
+    ItmCommonCalculator makeCalculator(const InputParamMap& inputs, const VariabilityInputs& varInputs) {
+        // mdvar may carry +10 / +20 flags eliminating location / situation variability, handed on with the mode
+        const int varMode = inputs.getCode("mdvar", 0, 33);
+        if (varMode % 10 > BroadcastMode) {
+            throw std::runtime_error("ERROR: bad mdvar (mode must be 0 - 3, plus 10 and/or 20)");
+        }
+
+        return ItmCommonCalculator(inputs.getValue("h_tx__meter"), inputs.getValue("h_rx__meter"),
+                    static_cast<RadioClimate>(inputs.getCode("climate", 1, 7) - 1), inputs.getValue("N_0"), inputs.getValue("f__mhz"),
+                    inputs.getCode("pol", 0, 1) == 0, inputs.getValue("epsilon"), inputs.getValue("sigma"),
+                    static_cast<VariabilityMode>(varMode), varInputs.m_timePercent, varInputs.m_locationPercent,
+                    varInputs.m_situationPercent);
+    }
+
+    std::string formatFixed(const double& value, const int numDecimals) {
+        std::ostringstream oStrStream;
+        oStrStream << std::fixed << std::setprecision(numDecimals) << value;
+        return oStrStream.str();
+    }
+
+    /// @brief Write one "name  value  (units)" line; lines with no units aren't padded past their value
+    void writeField(std::ostream& outStream, std::string_view name, std::string_view value, std::string_view units = {}) {
+        outStream << std::left << std::setw(kNameWidth) << name;
+        if (units.empty()) {
+            outStream << value << "\n";
+        }
+        else {
+            outStream << std::setw(kValueWidth) << value << units << "\n";
+        }
+    }
+
+    /// @brief Echo an input parameter, with its units or the name of its code when it holds a single value
+    void writeInput(std::ostream& outStream, const InputParamMap& inputs, const std::string& name, std::string_view units = {},
+                const int numDecimals = -1) {
+        const InputParam& param = inputs.get(name);
+        if (param.m_valueList.size() != 1u) {
+            writeField(outStream, name, param.m_text);
+            return;
+        }
+        writeField(outStream, name, (numDecimals >= 0) ? formatFixed(param.m_valueList[0], numDecimals) : param.m_text, units);
+    }
+
+    template <std::size_t NumNames>
+    void writeCodeInput(std::ostream& outStream, const InputParamMap& inputs, const std::string& name,
+                const std::array<const char*, NumNames>& nameList, const int codeOffset) {
+        const int nameInd = static_cast<int>(inputs.getValue(name)) % 10 - codeOffset;
+        writeInput(outStream, inputs, name, std::string("[") + nameList[nameInd] + "]");
+    }
+
+    void writePreamble(std::ostream& outStream, const InputParamMap& inputs, const VariabilityInputs& varInputs,
+                const DriverOptions& options) {
+        const std::time_t nowTime = std::time(nullptr);
+        char timeText[64];
+        std::strftime(timeText, sizeof(timeText), "%a %b %d %H:%M:%S %Y", std::localtime(&nowTime));
+        writeField(outStream, "Date Generated", timeText);
+        writeField(outStream, "Input Arguments", options.m_argText);
+
+        outStream << "\nInputs\n";
+        writeInput(outStream, inputs, "h_tx__meter", "(meters)");
+        writeInput(outStream, inputs, "h_rx__meter", "(meters)");
+        if (options.m_mode == DriverMode::Area) {
+            writeCodeInput(outStream, inputs, "tx_site_criteria", kSitingCriteriaNameList, 0);
+            writeCodeInput(outStream, inputs, "rx_site_criteria", kSitingCriteriaNameList, 0);
+            writeInput(outStream, inputs, "d__km", "(km)");
+            writeInput(outStream, inputs, "delta_h__meter", "(meters)");
+        }
+        writeCodeInput(outStream, inputs, "climate", kClimateNameList, 1);
+        writeInput(outStream, inputs, "N_0", "(N-Units)", 2);
+        writeInput(outStream, inputs, "f__mhz", "(MHz)", 2);
+        writeCodeInput(outStream, inputs, "pol", kPolarizationNameList, 0);
+        writeInput(outStream, inputs, "epsilon");
+        writeInput(outStream, inputs, "sigma");
+        writeCodeInput(outStream, inputs, "mdvar", kVarModeNameList, 0);
+        if (varInputs.m_isConfRel) {
+            writeInput(outStream, inputs, "confidence");
+            writeInput(outStream, inputs, "reliability");
+        }
+        else {
+            writeInput(outStream, inputs, "time");
+            writeInput(outStream, inputs, "location");
+            writeInput(outStream, inputs, "situation");
+        }
+        if (options.m_mode == DriverMode::Area) {
+            writeField(outStream, "Mode", "Area");
+        }
+        else {
+            writeField(outStream, "Mode", "Point-to-Point");
+            writeField(outStream, "Terrain File", options.m_terrainFilePath);
+        }
+
+        outStream << "\nResults\n";
+        writeField(outStream, "ITM Return Code", "0", "[Success - No Errors]");
+    }
+
+    void writeIntermValues(std::ostream& outStream, const ItmResults& itmResults) {
+        const IntermResults& intermResults = itmResults.m_intermResults;
+        const int propModeInd = static_cast<int>(intermResults.m_propMode);
+
+        outStream << "\nIntermediate Values\n";
+        writeField(outStream, "Free Space", formatFixed(intermResults.m_fsplAtten_dB, 1), "(dB)");
+        writeField(outStream, "d__km", formatFixed(intermResults.m_terrainProfile.m_pathDist_km, 3), "(km)");
+        writeField(outStream, "theta_hzn_tx", formatFixed(intermResults.m_txHorizonAngle_rad * 1.0e3, 3), "(mrad)");
+        writeField(outStream, "theta_hzn_rx", formatFixed(intermResults.m_rxHorizonAngle_rad * 1.0e3, 3), "(mrad)");
+        writeField(outStream, "d_hzn_tx__meter", formatFixed(intermResults.m_txHorizonDist_m, 0), "(meters)");
+        writeField(outStream, "d_hzn_rx__meter", formatFixed(intermResults.m_rxHorizonDist_m, 0), "(meters)");
+        writeField(outStream, "h_e_tx__meter", formatFixed(intermResults.m_txEffHeight_m, 1), "(meters)");
+        writeField(outStream, "h_e_rx__meter", formatFixed(intermResults.m_rxEffHeight_m, 1), "(meters)");
+        writeField(outStream, "N_s", formatFixed(intermResults.m_surfRefract_N, 1), "(N-Units)");
+        writeField(outStream, "delta_h__meter", formatFixed(intermResults.m_terrainIrreg_m, 1), "(meters)");
+        writeField(outStream, "A_ref__db", formatFixed(intermResults.m_refAtten_dB, 1), "(dB)");
+        writeField(outStream, "Mode of Propagation", std::to_string(propModeInd), std::string("[") + kPropModeNameList[propModeInd] + "]");
+    }
+
+    /// @brief Write a percentage list as a table header row, after a blank key column
+    void writeHeaderRow(std::ostream& outStream, std::string_view keyText, const int keyWidth, const std::vector<double>& percentList) {
+        outStream << std::left << std::setw(keyWidth) << keyText;
+        for (const double& percent : percentList) {
+            std::ostringstream oStrStream;
+            oStrStream << percent;
+            outStream << std::setw(kTableValueWidth) << oStrStream.str();
+        }
+        outStream << "\n";
+    }
+
+    void runArea(const InputParamMap& inputs, const VariabilityInputs& varInputs, const DriverOptions& options, std::ostream& outStream) {
+        const std::vector<double> distList_km = expandDistSweep_km(inputs.get("d__km").m_valueList);
+        const SitingCriteria txSitingCriteria = static_cast<SitingCriteria>(inputs.getCode("tx_site_criteria", 0, 2));
+        const SitingCriteria rxSitingCriteria = static_cast<SitingCriteria>(inputs.getCode("rx_site_criteria", 0, 2));
+        const double freq_MHz = inputs.getValue("f__mhz");
+        const ItmCommonCalculator calculator = makeCalculator(inputs, varInputs);
+
+        // Everything but the distance is shared by the rows: the reference attenuation curve over the whole sweep,
+        // and the terminal geometry the variability is worked out from
+        ItmWorkspace workspace;
+        const ReferenceAttenuationCurve refAttenCurve = calculator.prepareRefAttenCurve_area(txSitingCriteria, rxSitingCriteria,
+                    inputs.getValue("delta_h__meter"), *std::min_element(distList_km.begin(), distList_km.end()),
+                    *std::max_element(distList_km.begin(), distList_km.end()), workspace);
+        const ItmResults linkResults = workspace.m_itmResults;
+
+        const std::size_t numDists = distList_km.size();
+        const std::size_t numLosses = varInputs.getNumLosses();
+        std::vector<ItmResults> rowResultsList(numDists);
+        std::vector<double> lossTable_dB(numDists * numLosses);
+
+        WorkStealingThreadPool threadPool(options.m_numThreads);
+        threadPool.run((numDists + kRowsPerTask - 1u) / kRowsPerTask, [&](const std::size_t taskInd, const std::size_t) {
+            const std::size_t endDistInd = std::min((taskInd + 1u) * kRowsPerTask, numDists);
+            for (std::size_t distInd = taskInd * kRowsPerTask; distInd < endDistInd; distInd++) {
+                ItmResults& rowResults = rowResultsList[distInd];
+                rowResults = linkResults;
+
+                IntermResults& intermResults = rowResults.m_intermResults;
+                intermResults.m_terrainProfile.m_pathDist_km = distList_km[distInd];
+                const double pathDist_m = distList_km[distInd] * 1.0e3;
+                PropagationMode propMode = NotSet;
+                intermResults.m_refAtten_dB = refAttenCurve.calcRefAtten_dB(pathDist_m, propMode);
+                intermResults.m_propMode = propMode;
+                intermResults.m_fsplAtten_dB = ItmHelpers::calcFSPL_dB(pathDist_m, freq_MHz);
+
+                const VariabilityCalculator variabilityCalculator = calculator.createVariabilityCalculator(rowResults);
+                const std::span<double> rowLossList_dB(lossTable_dB.data() + distInd * numLosses, numLosses);
+                if (varInputs.m_isConfRel) {
+                    variabilityCalculator.calcVariabilityLoss_CR_dB(intermResults.m_refAtten_dB, varInputs.m_confidenceFracList,
+                                varInputs.m_reliabilityFracList, rowLossList_dB);
+                }
+                else {
+                    rowLossList_dB[0] = variabilityCalculator.calcVariabilityLoss_dB(intermResults.m_refAtten_dB, varInputs.m_timePercent / 100.0,
+                                varInputs.m_locationPercent / 100.0, varInputs.m_situationPercent / 100.0);
+                }
+                for (double& loss_dB : rowLossList_dB) {
+                    loss_dB += intermResults.m_fsplAtten_dB;
+                }
+                rowResults.m_atten_dB = rowLossList_dB[0];
+            }
+        });
+
+        writePreamble(outStream, inputs, varInputs, options);
+
+        // A single result is written as such, with its intermediate values
+        if (numLosses == 1u && numDists == 1u) {
+            writeField(outStream, "Basic Transmission Loss", formatFixed(rowResultsList[0].m_atten_dB, 1), "(dB)");
+            if (options.m_writeIntermValues) {
+                writeIntermValues(outStream, rowResultsList[0]);
+            }
+            return;
+        }
+
+        // Otherwise one table per reliability: a row per distance, then free space & a column per confidence
+        const std::size_t numTables = varInputs.m_isConfRel ? varInputs.m_reliabilityList.size() : 1u;
+        for (std::size_t tableInd = 0; tableInd < numTables; tableInd++) {
+            outStream << "\nBasic Transmission Loss Results (dB)\n";
+            if (!varInputs.m_isConfRel) {
+                outStream << "Distance     Free      Basic\n  (km)       Space     Loss\n";
+            }
+            else {
+                if (numTables > 1u) {
+                    writeHeaderRow(outStream, "Reliability", kAreaKeyWidth, { varInputs.m_reliabilityList[tableInd] });
+                }
+                outStream << "Distance     Free      with Confidence\n";
+                writeHeaderRow(outStream, "  (km)       Space", kAreaKeyWidth + kTableValueWidth, varInputs.m_confidenceList);
+            }
+
+            for (std::size_t distInd = 0; distInd < numDists; distInd++) {
+                std::ostringstream oStrStream;
+                oStrStream << distList_km[distInd];
+                outStream << std::left << std::setw(kAreaKeyWidth) << oStrStream.str()
+                            << std::setw(kTableValueWidth) << formatFixed(rowResultsList[distInd].m_intermResults.m_fsplAtten_dB, 1);
+                const std::size_t numConfs = varInputs.m_isConfRel ? varInputs.m_confidenceList.size() : 1u;
+                for (std::size_t confInd = 0; confInd < numConfs; confInd++) {
+                    const std::size_t lossInd = varInputs.m_isConfRel ? confInd * numTables + tableInd : 0u;
+                    outStream << std::setw(kTableValueWidth) << formatFixed(lossTable_dB[distInd * numLosses + lossInd], 1);
+                }
+                outStream << "\n";
+            }
+        }
+    }
+
+    void runP2P(const InputParamMap& inputs, const VariabilityInputs& varInputs, const DriverOptions& options, std::ostream& outStream) {
+        std::vector<double> terrainHeightList_m;
+        double sampleResolution_m;
+        readTerrainFile(options.m_terrainFilePath, terrainHeightList_m, sampleResolution_m);
+        const ItmCommonCalculator calculator = makeCalculator(inputs, varInputs);
+
+        // Every row shares the one path: evaluate it once, then read the table off its variability
+        ItmWorkspace workspace;
+        ItmResults itmResults = calculator.calcItmLoss_P2P_dB(terrainHeightList_m, sampleResolution_m, false, workspace);
+        const IntermResults& intermResults = itmResults.m_intermResults;
+
+        writePreamble(outStream, inputs, varInputs, options);
+
+        const std::size_t numConfs = varInputs.m_confidenceList.size();
+        const std::size_t numRels = varInputs.m_reliabilityList.size();
+        if (!varInputs.m_isConfRel || numConfs * numRels == 1u) {
+            if (varInputs.m_isConfRel) {
+                double varLoss_dB;
+                calculator.createVariabilityCalculator(itmResults).calcVariabilityLoss_CR_dB(intermResults.m_refAtten_dB,
+                            varInputs.m_confidenceFracList, varInputs.m_reliabilityFracList, std::span<double>(&varLoss_dB, 1u));
+                itmResults.m_atten_dB = intermResults.m_fsplAtten_dB + varLoss_dB;
+            }
+            writeField(outStream, "Basic Transmission Loss", formatFixed(itmResults.m_atten_dB, 1), "(dB)");
+        }
+        else {
+            // A row per reliability, a column per confidence
+            const VariabilityCalculator variabilityCalculator = calculator.createVariabilityCalculator(itmResults);
+            std::vector<double> lossTable_dB(numRels * numConfs);
+            WorkStealingThreadPool threadPool(options.m_numThreads);
+            threadPool.run((numRels + kRowsPerTask - 1u) / kRowsPerTask, [&](const std::size_t taskInd, const std::size_t) {
+                const std::size_t startRelInd = taskInd * kRowsPerTask;
+                const std::size_t numTaskRels = std::min(kRowsPerTask, numRels - startRelInd);
+
+                // The calculator lays its table out a row per confidence
+                std::vector<double> taskLossTable_dB(numConfs * numTaskRels);
+                variabilityCalculator.calcVariabilityLoss_CR_dB(intermResults.m_refAtten_dB, varInputs.m_confidenceFracList,
+                            std::span<const double>(varInputs.m_reliabilityFracList).subspan(startRelInd, numTaskRels), taskLossTable_dB);
+                for (std::size_t relInd = 0; relInd < numTaskRels; relInd++) {
+                    for (std::size_t confInd = 0; confInd < numConfs; confInd++) {
+                        lossTable_dB[(startRelInd + relInd) * numConfs + confInd] = intermResults.m_fsplAtten_dB
+                                    + taskLossTable_dB[confInd * numTaskRels + relInd];
+                    }
+                }
+            });
+
+            outStream << "\nBasic Transmission Loss Results (dB)\nReliability    with Confidence\n";
+            writeHeaderRow(outStream, "", kP2PKeyWidth, varInputs.m_confidenceList);
+            for (std::size_t relInd = 0; relInd < numRels; relInd++) {
+                std::ostringstream oStrStream;
+                oStrStream << varInputs.m_reliabilityList[relInd];
+                outStream << std::left << std::setw(kP2PKeyWidth) << oStrStream.str();
+                for (std::size_t confInd = 0; confInd < numConfs; confInd++) {
+                    outStream << std::setw(kTableValueWidth) << formatFixed(lossTable_dB[relInd * numConfs + confInd], 1);
+                }
+                outStream << "\n";
+            }
+        }
+
+        if (options.m_writeIntermValues) {
+            writeIntermValues(outStream, itmResults);
+        }
+    }
+
+    void printUsage() {
+        std::cerr << "Usage:\n"
+                    << "    itm_table -i <input.txt> [-t <terrain.txt>] -o <output.txt> -mode p2p|area [-dbg] [--threads N]\n"
+                    << "Input & terrain files are in the format of cmd_examples/i_*.txt & pfl.txt (terrain is required in p2p mode).\n"
+                    << "-dbg adds the intermediate values of single results & point-to-point tables.\n";
+    }
+
+    bool parseOptions(const int argc, char* argv[], DriverOptions& options) {
+        bool hasMode = false;
+        for (int argInd = 1; argInd < argc; argInd++) {
+            const std::string arg = argv[argInd];
+            options.m_argText += arg + " ";
+            if (arg == "-dbg") {
+                options.m_writeIntermValues = true;
+                continue;
+            }
+            if (argInd + 1 >= argc) {
+                return false;
+            }
+
+            const std::string value = argv[++argInd];
+            options.m_argText += value + " ";
+            if (arg == "-i") {
+                options.m_inputFilePath = value;
+            }
+            else if (arg == "-t") {
+                options.m_terrainFilePath = value;
+            }
+            else if (arg == "-o") {
+                options.m_outputFilePath = value;
+            }
+            else if (arg == "-mode" && (value == "p2p" || value == "area")) {
+                options.m_mode = (value == "p2p") ? DriverMode::PointToPoint : DriverMode::Area;
+                hasMode = true;
+            }
+            else if (arg == "--threads") {
+                const long numThreads = std::strtol(value.c_str(), nullptr, 10);
+                if (numThreads < 0) {
+                    return false;
+                }
+                options.m_numThreads = static_cast<std::size_t>(numThreads);
+            }
+            else {
+                return false;
+            }
+        }
+        return hasMode && !options.m_inputFilePath.empty() && !options.m_outputFilePath.empty()
+                    && (options.m_mode == DriverMode::Area || !options.m_terrainFilePath.empty());
+    }
+}
+
+int main(int argc, char* argv[]) {
+    DriverOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+
+    try {
+        const InputParamMap inputs(options.m_inputFilePath);
+        const VariabilityInputs varInputs(inputs);
+
+        // The whole output is built before the file is opened, so a failed run leaves no partial output behind
+        std::ostringstream outText;
+        if (options.m_mode == DriverMode::Area) {
+            runArea(inputs, varInputs, options, outText);
+        }
+        else {
+            runP2P(inputs, varInputs, options, outText);
+        }
+
+        std::ofstream outStream(options.m_outputFilePath, std::ios::binary | std::ios::trunc);
+        outStream << outText.str();
+        if (!outStream.flush()) {
+            throw std::runtime_error("ERROR: Unable to write " + options.m_outputFilePath);
+        }
+        return 0;
+    }
+    catch (const std::exception& error) {
+        std::cerr << error.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,47 @@
+# Runs itm_bulk over the p2p.csv (with pfls.csv) or area.csv inputs of testData/ and checks every row against the expected
+# loss of its A__db column. Usage:
+#   cmake -DITM_BULK=<itm_bulk> -DTEST_DATA_DIR=<testData> -DMODE=<p2p|area> -DTOLERANCE_DB=<dB> -DOUTPUT_DIR=<dir> -P CompareBulkOutput.cmake
+#
+# A row fails if |A_diff__db| exceeds the tolerance or if itm_bulk reports an error for it.
+cmake_minimum_required(VERSION 3.25)
+
+set(outputFile "${OUTPUT_DIR}/bulk_${MODE}.csv")
+set(inputArgs "${TEST_DATA_DIR}/${MODE}.csv")
+if (MODE STREQUAL "p2p")
+    list(APPEND inputArgs "${TEST_DATA_DIR}/pfls.csv")
+endif()
+execute_process(COMMAND "${ITM_BULK}" ${MODE} ${inputArgs} "${outputFile}" RESULT_VARIABLE exitCode)
+if (NOT exitCode EQUAL 0)
+    message(FATAL_ERROR "itm_bulk exited with ${exitCode}")
+endif()
+
+file(STRINGS "${outputFile}" lineList)
+list(POP_FRONT lineList headerLine)
+if (NOT headerLine STREQUAL "row,A__db,mode,A_expected__db,A_diff__db,error")
+    message(FATAL_ERROR "Unexpected header: ${headerLine}")
+endif()
+
+list(LENGTH lineList numRows)
+if (numRows EQUAL 0)
+    message(FATAL_ERROR "No rows in ${outputFile}")
+endif()
+
+set(numMismatches 0)
+foreach (line IN LISTS lineList)
+    # row,A__db,mode,A_expected__db,A_diff__db, with an empty error field
+    if (NOT line MATCHES "^([0-9]+),([^,]+),([0-9]),([^,]+),-?([^,]+),$")
+        message(SEND_ERROR "Row not evaluated: ${line}")
+        math(EXPR numMismatches "${numMismatches} + 1")
+        continue()
+    endif()
+
+    # CMake compares numbers as doubles, and the sign was left out of the match
+    if (CMAKE_MATCH_5 GREATER ${TOLERANCE_DB})
+        message(SEND_ERROR "Row ${CMAKE_MATCH_1}: A__db ${CMAKE_MATCH_2}, expected ${CMAKE_MATCH_4} +/- ${TOLERANCE_DB} dB")
+        math(EXPR numMismatches "${numMismatches} + 1")
+    endif()
+endforeach()
+
+if (numMismatches GREATER 0)
+    message(FATAL_ERROR "${numMismatches} of ${numRows} row(s) of ${MODE}.csv off the expected loss")
+endif()
@@ -0,0 +1,61 @@
+# Runs itm_table on one of the examples of cmd_examples/ and compares its output with the example's reference output
+# (written by the NTIA ITM v1.3 driver). Usage:
+#   cmake -DITM_TABLE=<itm_table> -DEXAMPLES_DIR=<cmd_examples> -DEXAMPLE=<name> -DMODE=<p2p|area> -DOUTPUT_DIR=<dir> -P CompareTableOutput.cmake
+# reads i_<name>.txt (& pfl.txt in p2p mode) and compares against o_<name>.txt.
+#
+# The header (versions, date & arguments) and the warning flags, which itm_table doesn't report, are skipped; every other
+# line must match exactly.
+cmake_minimum_required(VERSION 3.25)
+
+set(outputFile "${OUTPUT_DIR}/o_${EXAMPLE}.txt")
+set(terrainArgs "")
+if (MODE STREQUAL "p2p")
+    set(terrainArgs -t pfl.txt)
+endif()
+execute_process(COMMAND "${ITM_TABLE}" -i "i_${EXAMPLE}.txt" ${terrainArgs} -o "${outputFile}" -mode ${MODE} -dbg
+            WORKING_DIRECTORY "${EXAMPLES_DIR}" RESULT_VARIABLE exitCode)
+if (NOT exitCode EQUAL 0)
+    message(FATAL_ERROR "itm_table exited with ${exitCode}")
+endif()
+
+# Lines from the inputs on, without the warning flags
+function(readReportLines filePath outVar)
+    file(STRINGS "${filePath}" lineList)
+    set(reportLineList "")
+    set(isInReport FALSE)
+    foreach (line IN LISTS lineList)
+        if (line STREQUAL "Inputs")
+            set(isInReport TRUE)
+        endif()
+        if (isInReport AND NOT line MATCHES "^ITM Warning Flags")
+            list(APPEND reportLineList "${line}")
+        endif()
+    endforeach()
+    set(${outVar} "${reportLineList}" PARENT_SCOPE)
+endfunction()
+
+readReportLines("${outputFile}" actualLineList)
+readReportLines("${EXAMPLES_DIR}/o_${EXAMPLE}.txt" expectedLineList)
+
+list(LENGTH actualLineList numActualLines)
+list(LENGTH expectedLineList numExpectedLines)
+if (NOT numActualLines EQUAL numExpectedLines)
+    message(FATAL_ERROR "Expected ${numExpectedLines} report lines, got ${numActualLines}")
+endif()
+
+set(numMismatches 0)
+math(EXPR lastLineInd "${numExpectedLines} - 1")
+foreach (lineInd RANGE ${lastLineInd})
+    list(GET actualLineList ${lineInd} actualLine)
+    list(GET expectedLineList ${lineInd} expectedLine)
+    if (actualLine STREQUAL expectedLine)
+        continue()
+    endif()
+
+    message(SEND_ERROR "Mismatch:\n  expected: ${expectedLine}\n  actual:   ${actualLine}")
+    math(EXPR numMismatches "${numMismatches} + 1")
+endforeach()
+
+if (numMismatches GREATER 0)
+    message(FATAL_ERROR "${numMismatches} line(s) of o_${EXAMPLE}.txt differ")
+endif()
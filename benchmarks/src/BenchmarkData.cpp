@@ -0,0 +1,167 @@
+#include "BenchmarkData.h"
+
+#define _USE_MATH_DEFINES
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace NTIA::ITM::Benchmarks {
+    namespace {
+        /// @brief Rows of a CSV file (no quoting) as numbers, with the columns of its header line
+        class CsvTable {
+        public:
+            CsvTable(const std::string& filePath, const bool hasHeader) {
+                std::ifstream inStream(filePath);
+                if (!inStream) {
+                    throw std::runtime_error("ERROR: CsvTable::CsvTable(): Unable to open " + filePath);
+                }
+
+                std::string line;
+                if (hasHeader && std::getline(inStream, line)) {
+                    m_nameList = splitLine(line);
+                }
+                while (std::getline(inStream, line)) {
+                    if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                        continue;
+                    }
+                    std::vector<double> valueList;
+                    for (const std::string& field : splitLine(line)) {
+                        valueList.push_back(std::stod(field));
+                    }
+                    m_rowList.push_back(std::move(valueList));
+                }
+            }
+
+            std::size_t getColumn(const std::string& name) const {
+                for (std::size_t columnInd = 0; columnInd < m_nameList.size(); columnInd++) {
+                    if (m_nameList[columnInd] == name) {
+                        return columnInd;
+                    }
+                }
+                throw std::runtime_error("ERROR: CsvTable::getColumn(): No " + name + " column");
+            }
+
+            const std::vector<std::vector<double>>& getRowList() const {
+                return m_rowList;
+            }
+
+        private:
+            static std::vector<std::string> splitLine(const std::string& line) {
+                std::vector<std::string> fieldList;
+                std::istringstream lineStream(line);
+                std::string field;
+                while (std::getline(lineStream, field, ',')) {
+                    while (!field.empty() && (field.back() == '\r' || field.back() == ' ')) {
+                        field.pop_back();
+                    }
+                    fieldList.push_back(field);
+                }
+                return fieldList;
+            }
+
+            std::vector<std::string> m_nameList;
+            std::vector<std::vector<double>> m_rowList;
+        };
+
+        /// @brief Columns shared by the p2p.csv & area.csv parameter files
+        struct CommonColumns {
+            explicit CommonColumns(const CsvTable& table)
+                        : m_txHeight(table.getColumn("h_tx__meter")), m_rxHeight(table.getColumn("h_rx__meter")),
+                        m_climate(table.getColumn("climate")), m_refractivity(table.getColumn("N_0")), m_freq(table.getColumn("f__mhz")),
+                        m_polarization(table.getColumn("pol")), m_relPermittivity(table.getColumn("epsilon")),
+                        m_conductivity(table.getColumn("sigma")), m_varMode(table.getColumn("mdvar")), m_timePercent(table.getColumn("time")),
+                        m_locationPercent(table.getColumn("location")), m_situationPercent(table.getColumn("situation")) {
+            }
+
+            /// @brief Calculator configured with one row
+            ItmCommonCalculator makeCalculator(const std::vector<double>& row) const {
+                return ItmCommonCalculator(row[m_txHeight], row[m_rxHeight], static_cast<RadioClimate>(static_cast<int>(row[m_climate]) - 1),
+                            row[m_refractivity], row[m_freq], row[m_polarization] == 0.0, row[m_relPermittivity], row[m_conductivity],
+                            static_cast<VariabilityMode>(static_cast<int>(row[m_varMode])), row[m_timePercent], row[m_locationPercent],
+                            row[m_situationPercent]);
+            }
+
+            std::size_t m_txHeight, m_rxHeight, m_climate, m_refractivity, m_freq, m_polarization, m_relPermittivity, m_conductivity;
+            std::size_t m_varMode, m_timePercent, m_locationPercent, m_situationPercent;
+        };
+
+        std::vector<P2PPath> readTestDataPaths_P2P() {
+            const CsvTable paramTable(NTIA_ITM_TEST_DATA_DIR "/p2p.csv", true);
+            const CsvTable profileTable(NTIA_ITM_TEST_DATA_DIR "/pfls.csv", false);
+            const CommonColumns columns(paramTable);
+
+            std::vector<P2PPath> pathList;
+            ItmWorkspace workspace;
+            for (std::size_t rowInd = 0; rowInd < paramTable.getRowList().size() && rowInd < profileTable.getRowList().size(); rowInd++) {
+                // Profile rows: number of points not counting the Tx, resolution (meters), then the heights
+                const std::vector<double>& profileRow = profileTable.getRowList()[rowInd];
+                try {
+                    P2PPath path { columns.makeCalculator(paramTable.getRowList()[rowInd]),
+                                std::vector<double>(profileRow.begin() + 2, profileRow.end()), profileRow[1] };
+                    path.m_calculator.calcItmLoss_P2P_dB(path.m_terrainHeightList_m, path.m_sampleResolution_m, false, workspace);
+                    pathList.push_back(std::move(path));
+                }
+                catch (const std::exception&) {
+                    // Rejected row: not timed
+                }
+            }
+            return pathList;
+        }
+
+        std::vector<AreaLink> readTestDataLinks_area() {
+            const CsvTable paramTable(NTIA_ITM_TEST_DATA_DIR "/area.csv", true);
+            const CommonColumns columns(paramTable);
+            const std::size_t txSitingColumn = paramTable.getColumn("tx_siting_criteria");
+            const std::size_t rxSitingColumn = paramTable.getColumn("rx_siting_criteria");
+            const std::size_t distColumn = paramTable.getColumn("d__km");
+            const std::size_t terrainIrregularityColumn = paramTable.getColumn("delta_h__meter");
+
+            std::vector<AreaLink> linkList;
+            for (const std::vector<double>& row : paramTable.getRowList()) {
+                try {
+                    AreaLink link { columns.makeCalculator(row), static_cast<SitingCriteria>(static_cast<int>(row[txSitingColumn])),
+                                static_cast<SitingCriteria>(static_cast<int>(row[rxSitingColumn])), row[distColumn], row[terrainIrregularityColumn] };
+                    link.m_calculator.calcItmLoss_area_dB(link.m_txSitingCriteria, link.m_rxSitingCriteria, link.m_dist_km,
+                                link.m_terrainIrregularityParam_m);
+                    linkList.push_back(std::move(link));
+                }
+                catch (const std::exception&) {
+                    // Rejected row: not timed
+                }
+            }
+            return linkList;
+        }
+    }
+
+    const std::vector<P2PPath>& getTestDataPaths_P2P() {
+        static const std::vector<P2PPath> pathList = readTestDataPaths_P2P();
+        return pathList;
+    }
+
+    const std::vector<AreaLink>& getTestDataLinks_area() {
+        static const std::vector<AreaLink> linkList = readTestDataLinks_area();
+        return linkList;
+    }
+
+    ItmCommonCalculator makeSyntheticCalculator() {
+        return ItmCommonCalculator(15.0, 3.0, Temperate, 301.0, 3500.0, false, 15.0, 0.005, AccidentalMode, 50.0, 50.0, 50.0);
+    }
+
+    std::vector<double> makeSyntheticProfile_m(const std::size_t numPointsMinusTx, const unsigned int seed) {
+        // A couple of long hills over the path, plus small scale roughness
+        std::mt19937 randomEngine(seed);
+        std::uniform_real_distribution<double> roughnessDistrib_m(-5.0, 5.0);
+        const double hillPeriod = static_cast<double>(numPointsMinusTx) / 2.0 + 1.0;
+
+        std::vector<double> terrainHeightList_m(numPointsMinusTx + 1u);
+        for (std::size_t pointInd = 0; pointInd <= numPointsMinusTx; pointInd++) {
+            terrainHeightList_m[pointInd] = 300.0 + 80.0 * std::sin(2.0 * M_PI * pointInd / hillPeriod) + 20.0 * std::sin(0.37 * pointInd)
+                        + roughnessDistrib_m(randomEngine);
+        }
+        return terrainHeightList_m;
+    }
+} // end namespace
@@ -0,0 +1,47 @@
+#ifndef ITM_BENCHMARK_DATA_H
+#define ITM_BENCHMARK_DATA_H
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmConstructs.h>
+
+#include <cstddef>
+#include <vector>
+
+namespace NTIA::ITM::Benchmarks {
+    // Sample resolution of the synthetic terrain profiles (meters)
+    double constexpr kSyntheticSampleResolution_m { 30.0 };
+
+    /// @brief One row of testData/p2p.csv, with its profile from testData/pfls.csv
+    struct P2PPath {
+        ItmCommonCalculator m_calculator;
+        std::vector<double> m_terrainHeightList_m;
+        double m_sampleResolution_m;
+    };
+
+    /// @brief One row of testData/area.csv
+    struct AreaLink {
+        ItmCommonCalculator m_calculator;
+        SitingCriteria m_txSitingCriteria;
+        SitingCriteria m_rxSitingCriteria;
+        double m_dist_km;
+        double m_terrainIrregularityParam_m;
+    };
+
+    /// @brief Paths of testData/p2p.csv & pfls.csv, read on first use. Rows the library rejects are left out,
+    /// so that the benchmarks time evaluations only
+    const std::vector<P2PPath>& getTestDataPaths_P2P();
+
+    /// @brief Links of testData/area.csv, read on first use (rows the library rejects are left out)
+    const std::vector<AreaLink>& getTestDataLinks_area();
+
+    /// @brief Calculator for the synthetic profiles: a 15 m Tx & 3 m Rx at 3.5 GHz over average ground, continental temperate
+    ItmCommonCalculator makeSyntheticCalculator();
+
+    /// @brief Rolling terrain profile, the same on every call for the same arguments
+    /// @param numPointsMinusTx Number of points in the profile, not including the Tx
+    /// @param seed Seed of the small scale roughness
+    /// @return Terrain heights (meters), kSyntheticSampleResolution_m apart
+    std::vector<double> makeSyntheticProfile_m(const std::size_t numPointsMinusTx, const unsigned int seed = 1u);
+} // end namespace
+
+#endif // ITM_BENCHMARK_DATA_H
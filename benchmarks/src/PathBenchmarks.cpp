@@ -0,0 +1,128 @@
+/// End-to-end benchmarks: whole point-to-point & area mode evaluations, over the paths of testData and over synthetic
+/// profiles of a range of lengths. Each reports the time per path (time/path) and the throughput (paths/s)
+
+#include "BenchmarkData.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/PreparedTerrainProfile.h>
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Benchmarks;
+
+namespace {
+    // Profiles per call of the batch benchmark
+    std::size_t constexpr kNumBatchProfiles { 256u };
+
+    void setPathCounters(benchmark::State& state, const std::size_t numPathsPerIteration) {
+        const double numPaths = static_cast<double>(numPathsPerIteration);
+        state.counters["paths/s"] = benchmark::Counter(numPaths, benchmark::Counter::kIsIterationInvariantRate);
+        state.counters["time/path"] = benchmark::Counter(numPaths, benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+    }
+
+    void BM_P2P_TestData(benchmark::State& state) {
+        const std::vector<P2PPath>& pathList = getTestDataPaths_P2P();
+        ItmWorkspace workspace;
+        for (auto _ : state) {
+            for (const P2PPath& path : pathList) {
+                benchmark::DoNotOptimize(path.m_calculator.calcItmLoss_P2P_dB(path.m_terrainHeightList_m, path.m_sampleResolution_m,
+                            false, workspace).m_atten_dB);
+            }
+        }
+        setPathCounters(state, pathList.size());
+    }
+    BENCHMARK(BM_P2P_TestData);
+
+    // The same paths through profiles prepared up front (as for repeated evaluations of the same terrain)
+    void BM_P2P_TestData_PreparedProfile(benchmark::State& state) {
+        const std::vector<P2PPath>& pathList = getTestDataPaths_P2P();
+        std::vector<PreparedTerrainProfile> preparedProfileList;
+        preparedProfileList.reserve(pathList.size());
+        for (const P2PPath& path : pathList) {
+            preparedProfileList.emplace_back(path.m_terrainHeightList_m, path.m_sampleResolution_m);
+        }
+
+        ItmWorkspace workspace;
+        for (auto _ : state) {
+            for (std::size_t pathInd = 0; pathInd < pathList.size(); pathInd++) {
+                benchmark::DoNotOptimize(pathList[pathInd].m_calculator.calcItmLoss_P2P_dB(preparedProfileList[pathInd], false,
+                            workspace).m_atten_dB);
+            }
+        }
+        setPathCounters(state, pathList.size());
+    }
+    BENCHMARK(BM_P2P_TestData_PreparedProfile);
+
+    void BM_Area_TestData(benchmark::State& state) {
+        // The non-const form evaluates in each calculator's own workspace, so work on copies
+        std::vector<AreaLink> linkList = getTestDataLinks_area();
+        for (auto _ : state) {
+            for (AreaLink& link : linkList) {
+                benchmark::DoNotOptimize(link.m_calculator.calcItmLoss_area_dB(link.m_txSitingCriteria, link.m_rxSitingCriteria,
+                            link.m_dist_km, link.m_terrainIrregularityParam_m).m_atten_dB);
+            }
+        }
+        setPathCounters(state, linkList.size());
+    }
+    BENCHMARK(BM_Area_TestData);
+
+    void BM_P2P_Synthetic(benchmark::State& state) {
+        const ItmCommonCalculator calculator = makeSyntheticCalculator();
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(static_cast<std::size_t>(state.range(0)));
+        ItmWorkspace workspace;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, false,
+                        workspace).m_atten_dB);
+        }
+        setPathCounters(state, 1u);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_P2P_Synthetic)->RangeMultiplier(4)->Range(16, 65536);
+
+    // The same paths at a lean result level (loss & mode only), handing back no ItmResults
+    void BM_P2P_Synthetic_LossAndMode(benchmark::State& state) {
+        const ItmCommonCalculator calculator = makeSyntheticCalculator();
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(static_cast<std::size_t>(state.range(0)));
+        ItmWorkspace workspace;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(calculator.calcItmLoss_P2P_dB(terrainHeightList_m, kSyntheticSampleResolution_m, LossAndMode,
+                        workspace).m_atten_dB);
+        }
+        setPathCounters(state, 1u);
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_P2P_Synthetic_LossAndMode)->RangeMultiplier(4)->Range(16, 65536);
+
+    void BM_P2P_Batch_Synthetic(benchmark::State& state) {
+        const ItmCommonCalculator calculator = makeSyntheticCalculator();
+        const std::size_t numPointsMinusTx = static_cast<std::size_t>(state.range(0));
+
+        // Profiles back-to-back, each with its own roughness
+        std::vector<double> terrainHeightBuffer_m;
+        std::vector<std::size_t> profileOffsetList { 0u };
+        for (std::size_t profileInd = 0; profileInd < kNumBatchProfiles; profileInd++) {
+            const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(numPointsMinusTx, static_cast<unsigned int>(profileInd + 1u));
+            terrainHeightBuffer_m.insert(terrainHeightBuffer_m.end(), terrainHeightList_m.begin(), terrainHeightList_m.end());
+            profileOffsetList.push_back(terrainHeightBuffer_m.size());
+        }
+        const std::vector<double> sampleResolutionList_m(kNumBatchProfiles, kSyntheticSampleResolution_m);
+        std::vector<double> attenList_dB(kNumBatchProfiles);
+        std::vector<PropagationMode> propModeList(kNumBatchProfiles);
+
+        ItmWorkspace workspace;
+        for (auto _ : state) {
+            calculator.calcItmLoss_P2P_batch_dB(terrainHeightBuffer_m, profileOffsetList, sampleResolutionList_m, attenList_dB,
+                        propModeList, workspace);
+            benchmark::DoNotOptimize(attenList_dB.data());
+            benchmark::ClobberMemory();
+        }
+        setPathCounters(state, kNumBatchProfiles);
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kNumBatchProfiles * numPointsMinusTx));
+    }
+    BENCHMARK(BM_P2P_Batch_Synthetic)->RangeMultiplier(8)->Range(64, 4096);
+}
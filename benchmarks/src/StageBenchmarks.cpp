@@ -0,0 +1,181 @@
+/// Microbenchmarks of the individual stages of a point-to-point evaluation, over synthetic profiles of a range of lengths.
+/// Each stage is timed on its own against a workspace left by a full evaluation of the same path, so it reads exactly
+/// the state it would have read within calcItmLoss_P2P_dB()
+
+#include "BenchmarkData.h"
+
+#include <ITM/ItmCommonCalculator.h>
+#include <ITM/ItmWorkspace.h>
+#include <ITM/MathHelpers.h>
+#include <ITM/PreparedTerrainProfile.h>
+#include <ITM/VariabilityCalculator.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace NTIA::ITM {
+    /// @brief Entry points to the private stages of ItmCommonCalculator, which befriends this struct
+    struct ItmStageBenchmarkAccess {
+        static void setHorizonParameters(const ItmCommonCalculator& calculator, ItmWorkspace& workspace) {
+            calculator.setHorizonParameters(workspace, 1.0 / workspace.m_effEarthCurvature_perM);
+        }
+
+        static double calcTerrainIrreg_m(const ItmCommonCalculator& calculator, ItmWorkspace& workspace, const double& distToStart_m,
+                    const double& distToEnd_m) {
+            return calculator.calcTerrainIrreg_m(workspace, distToStart_m, distToEnd_m);
+        }
+
+        static double calcLongleyRiceLoss_dB(const ItmCommonCalculator& calculator, const ItmWorkspace& workspace, PropagationMode& propMode) {
+            return calculator.calcLongleyRiceLoss_dB(workspace, propMode, true);
+        }
+
+        /// @brief Troposcatter loss at a distance, with the angular distance of the line-of-sight region worked out as
+        /// the reference attenuation curve does
+        static double calcTroposcatterLoss_dB(const ItmCommonCalculator& calculator, const ItmWorkspace& workspace,
+                    const double& tropoPathLength_m) {
+            const IntermResults& intermResults = workspace.m_itmResults.m_intermResults;
+            const double effEarthRadius_m = 1.0 / workspace.m_effEarthCurvature_perM;
+            const double actualDist_maxLoS_m = intermResults.m_txHorizonDist_m + intermResults.m_rxHorizonDist_m;
+            const double angularDistInLoS_rad = -std::max(intermResults.m_txHorizonAngle_rad + intermResults.m_rxHorizonAngle_rad,
+                        -actualDist_maxLoS_m / effEarthRadius_m);
+
+            double initialH0_dB = -1.0;
+            return calculator.calcTroposcatterLoss_dB(workspace, tropoPathLength_m, effEarthRadius_m, angularDistInLoS_rad, initialH0_dB);
+        }
+    };
+}
+
+using namespace NTIA::ITM;
+using namespace NTIA::ITM::Benchmarks;
+
+namespace {
+    /// @brief Synthetic path evaluated once, leaving in its workspace the state each stage reads
+    class EvaluatedPath {
+    public:
+        explicit EvaluatedPath(const std::size_t numPointsMinusTx)
+                    : m_calculator(makeSyntheticCalculator()), m_terrainHeightList_m(makeSyntheticProfile_m(numPointsMinusTx)) {
+            m_calculator.calcItmLoss_P2P_dB(m_terrainHeightList_m, kSyntheticSampleResolution_m, false, m_workspace);
+
+            // The evaluation lets go of its view of the heights, which the geometry stages read
+            m_workspace.m_itmResults.m_intermResults.m_terrainProfile.setTerrainHeights(m_terrainHeightList_m, false);
+        }
+
+        double getPathDist_m() const {
+            return m_workspace.m_itmResults.m_intermResults.m_terrainProfile.m_pathDist_km * 1.0e3;
+        }
+
+        ItmCommonCalculator m_calculator;
+        std::vector<double> m_terrainHeightList_m;
+        ItmWorkspace m_workspace;
+    };
+
+    void BM_SetHorizonParameters(benchmark::State& state) {
+        EvaluatedPath path(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state) {
+            ItmStageBenchmarkAccess::setHorizonParameters(path.m_calculator, path.m_workspace);
+            benchmark::DoNotOptimize(path.m_workspace.m_itmResults.m_intermResults.m_txHorizonAngle_rad);
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_SetHorizonParameters)->RangeMultiplier(4)->Range(64, 16384);
+
+    void BM_CalcTerrainIrreg(benchmark::State& state) {
+        EvaluatedPath path(static_cast<std::size_t>(state.range(0)));
+        const double pathDist_m = path.getPathDist_m();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ItmStageBenchmarkAccess::calcTerrainIrreg_m(path.m_calculator, path.m_workspace, 0.0, pathDist_m));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_CalcTerrainIrreg)->RangeMultiplier(4)->Range(64, 16384);
+
+    void BM_FitTerrainProfile_LinearLeastSquares(benchmark::State& state) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(static_cast<std::size_t>(state.range(0)));
+        const double pathDist_m = state.range(0) * kSyntheticSampleResolution_m;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(MathHelpers::fitTerrainProfile_linearLeastSquares(terrainHeightList_m, kSyntheticSampleResolution_m,
+                        0.1 * pathDist_m, 0.9 * pathDist_m));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FitTerrainProfile_LinearLeastSquares)->RangeMultiplier(4)->Range(64, 16384);
+
+    // The same fit answered from the running sums of a prepared profile, which shouldn't grow with the profile length
+    void BM_FitTerrainProfile_PreparedProfile(benchmark::State& state) {
+        const std::vector<double> terrainHeightList_m = makeSyntheticProfile_m(static_cast<std::size_t>(state.range(0)));
+        const PreparedTerrainProfile preparedProfile(terrainHeightList_m, kSyntheticSampleResolution_m);
+        const double pathDist_m = state.range(0) * kSyntheticSampleResolution_m;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(preparedProfile.fitTerrainProfile_linearLeastSquares(0.1 * pathDist_m, 0.9 * pathDist_m));
+        }
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_FitTerrainProfile_PreparedProfile)->RangeMultiplier(4)->Range(64, 16384);
+
+    // Profile lengths of 3 km (line-of-sight), 30 km (diffraction) & 300 km (troposcatter)
+    void BM_CalcLongleyRiceLoss(benchmark::State& state) {
+        EvaluatedPath path(static_cast<std::size_t>(state.range(0)));
+        PropagationMode propMode = NotSet;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ItmStageBenchmarkAccess::calcLongleyRiceLoss_dB(path.m_calculator, path.m_workspace, propMode));
+        }
+        state.counters["mode"] = static_cast<double>(propMode);
+    }
+    BENCHMARK(BM_CalcLongleyRiceLoss)->Arg(100)->Arg(1000)->Arg(10000);
+
+    void BM_CalcTroposcatterLoss(benchmark::State& state) {
+        EvaluatedPath path(static_cast<std::size_t>(state.range(0)));
+        const double pathDist_m = path.getPathDist_m();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(ItmStageBenchmarkAccess::calcTroposcatterLoss_dB(path.m_calculator, path.m_workspace, pathDist_m));
+        }
+    }
+    BENCHMARK(BM_CalcTroposcatterLoss)->Arg(100)->Arg(1000)->Arg(10000);
+
+    void BM_Variability_Construct(benchmark::State& state) {
+        const EvaluatedPath path(1000u);
+        const ItmResults& itmResults = path.m_workspace.m_itmResults;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(path.m_calculator.createVariabilityCalculator(itmResults));
+        }
+    }
+    BENCHMARK(BM_Variability_Construct);
+
+    void BM_Variability_Loss(benchmark::State& state) {
+        const EvaluatedPath path(1000u);
+        const VariabilityCalculator variabilityCalculator = path.m_calculator.createVariabilityCalculator(path.m_workspace.m_itmResults);
+        const double& refAtten_dB = path.m_workspace.m_itmResults.m_intermResults.m_refAtten_dB;
+
+        // Step through the quantiles, so that no call is answered from the last
+        std::uint32_t quantileInd = 0u;
+        for (auto _ : state) {
+            const double quantileFrac = 0.01 + 0.98 * ((quantileInd++ % 97u) / 96.0);
+            benchmark::DoNotOptimize(variabilityCalculator.calcVariabilityLoss_dB(refAtten_dB, quantileFrac, 1.0 - quantileFrac, 0.5));
+        }
+    }
+    BENCHMARK(BM_Variability_Loss);
+
+    // A square confidence x reliability table of the given side
+    void BM_Variability_CRTable(benchmark::State& state) {
+        const EvaluatedPath path(1000u);
+        const VariabilityCalculator variabilityCalculator = path.m_calculator.createVariabilityCalculator(path.m_workspace.m_itmResults);
+        const double& refAtten_dB = path.m_workspace.m_itmResults.m_intermResults.m_refAtten_dB;
+
+        const std::size_t numFracs = static_cast<std::size_t>(state.range(0));
+        std::vector<double> fracList(numFracs);
+        for (std::size_t fracInd = 0; fracInd < numFracs; fracInd++) {
+            fracList[fracInd] = (fracInd + 0.5) / numFracs;
+        }
+        std::vector<double> lossTable_dB(numFracs * numFracs);
+        for (auto _ : state) {
+            variabilityCalculator.calcVariabilityLoss_CR_dB(refAtten_dB, fracList, fracList, lossTable_dB);
+            benchmark::DoNotOptimize(lossTable_dB.data());
+            benchmark::ClobberMemory();
+        }
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lossTable_dB.size()));
+    }
+    BENCHMARK(BM_Variability_CRTable)->Arg(3)->Arg(10)->Arg(100);
+}